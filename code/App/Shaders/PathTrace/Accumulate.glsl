@@ -2,32 +2,64 @@
 
 // ============================================================================
 // PROGRESSIVE ACCUMULATION SHADER
-// Implements running average for noise reduction over multiple frames
+// Implements running average for noise reduction over multiple frames.
+// rgb is the mean color, alpha the mean squared luminance, which together
+// give the per-pixel variance for the noise estimate.
+//
+// Pixels are averaged over their own sample count, kept in a second target
+// along with their relative error: adaptive sampling skips converged pixels
+// (new sample alpha < 0), so counts differ across the image.
 // ============================================================================
 
 in vec2 vUV;
-out vec4 FragColor;
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out vec4 Stats;     // r = samples, g = relative error
 
-uniform sampler2D uNewSample;    // Current frame's path traced result
-uniform sampler2D uAccumulated;  // Previous accumulated result
-uniform int uFrame;              // Frame counter (0 = first frame)
+uniform sampler2D uNewSample;         // Current frame's path traced result
+uniform sampler2D uAccumulated;       // Previous accumulated result
+uniform sampler2D uAccumulatedStats;  // Previous samples / error
+uniform int uFrame;                   // Frame counter (0 = first frame)
+
+// Must match RelativeNoise in CPURenderer.cpp
+#define NOISE_EPSILON 0.01
+#define NOISE_UNKNOWN 1e30
 
 void main()
 {
-    vec3 newColor = texture(uNewSample, vUV).rgb;
-    vec3 accumulated = texture(uAccumulated, vUV).rgb;
+    vec4 newColor = texture(uNewSample, vUV);
+    vec4 accumulated = texture(uAccumulated, vUV);
+    vec4 stats = texture(uAccumulatedStats, vUV);
+    
+    // Skipped by adaptive sampling: nothing changes
+    if (uFrame > 0 && newColor.a < 0.0)
+    {
+        FragColor = accumulated;
+        Stats = stats;
+        return;
+    }
     
     // Running average: (old * n + new) / (n + 1)
     // This converges to the true integral as n -> infinity
+    float n = 0.0;
     if (uFrame == 0)
     {
-        FragColor = vec4(newColor, 1.0);
+        FragColor = newColor;
     }
     else
     {
-        float n = float(uFrame);
-        vec3 result = (accumulated * n + newColor) / (n + 1.0);
-        FragColor = vec4(result, 1.0);
+        n = stats.r;
+        FragColor = (accumulated * n + newColor) / (n + 1.0);
     }
+    n += 1.0;
+    
+    // Relative standard error of the mean luminance
+    float error = NOISE_UNKNOWN;
+    if (n > 1.0)
+    {
+        float mean = dot(FragColor.rgb, vec3(0.2126, 0.7152, 0.0722));
+        float variance = max(FragColor.a - mean * mean, 0.0) * n / (n - 1.0);
+        error = sqrt(variance / n) / (mean + NOISE_EPSILON);
+    }
+    
+    Stats = vec4(n, error, 0.0, 1.0);
 }
-
@@ -25,33 +25,38 @@ uniform float uFocusDistance;
 // Quadrics from C++
 uniform int uNumQuadrics;
 
-// Quadric coefficients as separate arrays (GLSL 410 compatibility)
-uniform float uQuadrics_A[8];
-uniform float uQuadrics_B[8];
-uniform float uQuadrics_C[8];
-uniform float uQuadrics_D[8];
-uniform float uQuadrics_E[8];
-uniform float uQuadrics_F[8];
-uniform float uQuadrics_G[8];
-uniform float uQuadrics_H[8];
-uniform float uQuadrics_I[8];
-uniform float uQuadrics_J[8];
-uniform vec3 uQuadrics_bboxMin[8];
-uniform vec3 uQuadrics_bboxMax[8];
-uniform int uQuadrics_materialIndex[8];
+// Quadric data texture: 11 RGBA32F texels per quadric (see loadQuadric), rows
+// ordered so every BVH leaf and every CSG group is a contiguous range. Texels
+// 9-10 hold origin terms the CPU evaluates at uCameraPosition once per frame.
+uniform sampler2D uQuadricsTex;
+uniform sampler2D uQuadricBVHTex;  // BVH nodes: 2 texels each (see QuadricBVH.h)
 
 // Scene selection
 uniform int uSceneIndex;          // Scene selection index
 
 // OBJ mesh data textures
-uniform sampler2D uTrianglesTex;   // Triangle vertices (width=3, height=numTris)
-uniform sampler2D uNormalsTex;     // Triangle normals
-uniform sampler2D uTriMatTex;      // Triangle material indices
+uniform usampler2D uTrianglesTex;  // Vertex indices + material index (width=1, height=numTris)
+uniform sampler2D uPositionsTex;   // Vertex positions (width=1, height=numVertices)
+uniform sampler2D uNormalsTex;     // Vertex normals (same layout)
 uniform sampler2D uMaterialsTex;   // Material properties
 uniform int uNumTriangles;         // Number of triangles in mesh
 uniform bool uUseOBJScene;         // Whether to use OBJ scene instead of procedural
 uniform bool uShowSkybox;          // Whether to show environment skybox (for quadric meshes)
 
+// Low-discrepancy samples (see Math/Sampler.h): row i holds the dimensions
+// of sample i, four per texel. Type 0 (random) leaves the table unused.
+uniform int uSamplerType;
+uniform sampler2D uSamplerTable;
+uniform int uSamplerTableSize;     // Rows (samples) in uSamplerTable
+
+// Adaptive sampling: uAccumulationStats is the previous accumulation's
+// per-pixel (sample count, relative error), see Accumulate.glsl. Pixels with
+// at least uAdaptiveMinSamples and an error at or below uAdaptiveThreshold
+// are skipped, except on uAdaptiveRefresh frames. 0 = every pixel, always.
+uniform sampler2D uAccumulationStats;
+uniform float uAdaptiveThreshold;
+uniform int uAdaptiveMinSamples;
+uniform bool uAdaptiveRefresh;
 
 // ----------------------------------------------------------------------------
 // CONSTANTS
@@ -63,12 +68,24 @@ uniform bool uShowSkybox;          // Whether to show environment skybox (for qu
 #define EPSILON 0.0001
 #define MAX_DISTANCE 1000.0
 
+// Traversal stack depth (QuadricBVH::MAX_DEPTH)
+#define QUADRIC_BVH_STACK_SIZE 32
+
+// Sampler types and dimensions per bounce (must match Sampler)
+#define SAMPLER_RANDOM 0
+#define SAMPLER_SOBOL 3
+#define SAMPLER_DIMENSIONS_PER_BOUNCE 8
+
 // ----------------------------------------------------------------------------
 // RANDOM NUMBER GENERATION - PCG Hash (High Quality)
 // Based on "Hash Functions for GPU Rendering" - Jarzynski & Olano
 // ----------------------------------------------------------------------------
 uint rngState;
 
+// Samples this pixel already has: its sample index. Equals uFrame unless
+// adaptive sampling skipped it on earlier frames.
+int pixelSample;
+
 uint pcgHash(uint seed)
 {
     uint state = seed * 747796405u + 2891336453u;
@@ -76,8 +93,43 @@ uint pcgHash(uint seed)
     return (word >> 22u) ^ word;
 }
 
+// Low-discrepancy state: the next table dimension of the current bounce
+// and the first one of the next bounce. Draws past the bounce's dimensions
+// fall back to the hash.
+int ldDimension;
+int ldDimensionEnd;
+uint ldPixelHash;
+
+void startSamplerBounce(int bounce)
+{
+    ldDimension = bounce * SAMPLER_DIMENSIONS_PER_BOUNCE;
+    ldDimensionEnd = ldDimension + SAMPLER_DIMENSIONS_PER_BOUNCE;
+}
+
+// Every pixel reads the same table row, so each one shifts it by its own
+// hash: XOR keeps the Owen-scrambled Sobol a (0,m,2)-net, a toroidal shift
+// keeps the stratification of the others
+float sampleTable(int dimension)
+{
+    int row = pixelSample % max(uSamplerTableSize, 1);
+    float value = texelFetch(uSamplerTable, ivec2(dimension / 4, row), 0)[dimension % 4];
+    uint shift = pcgHash(ldPixelHash + uint(dimension) * 0x9E3779B9u);
+
+    if (uSamplerType == SAMPLER_SOBOL)
+    {
+        uint bits = uint(value * 16777216.0) ^ (shift >> 8u);
+        return float(bits) / 16777216.0;
+    }
+    return fract(value + float(shift >> 8u) / 16777216.0);
+}
+
 float randomFloat()
 {
+    if (uSamplerType != SAMPLER_RANDOM && ldDimension < ldDimensionEnd)
+    {
+        return sampleTable(ldDimension++);
+    }
+
     rngState = pcgHash(rngState);
     return float(rngState) / 4294967295.0;
 }
@@ -131,22 +183,15 @@ vec3 randomCosineDirection()
     return vec3(x, y, z);
 }
 
-// Create orthonormal basis from normal (Frisvad's method - fast, robust)
+// Create orthonormal basis from normal (Duff et al. 2017 revision of
+// Frisvad's method: the sign of n.z picks the stable form, no branch)
 mat3 createONB(vec3 n)
 {
-    vec3 t, b;
-    if (n.z < -0.999999)
-    {
-        t = vec3(0.0, -1.0, 0.0);
-        b = vec3(-1.0, 0.0, 0.0);
-    }
-    else
-    {
-        float a = 1.0 / (1.0 + n.z);
-        float bb = -n.x * n.y * a;
-        t = vec3(1.0 - n.x * n.x * a, bb, -n.x);
-        b = vec3(bb, 1.0 - n.y * n.y * a, -n.y);
-    }
+    float s = n.z >= 0.0 ? 1.0 : -1.0;
+    float a = -1.0 / (s + n.z);
+    float bb = n.x * n.y * a;
+    vec3 t = vec3(1.0 + s * n.x * n.x * a, s * bb, -s * n.x);
+    vec3 b = vec3(bb, s + n.y * n.y * a, -n.y);
     return mat3(t, b, n);
 }
 
@@ -392,9 +437,13 @@ struct Quadric
     float D, E, F;      // xy, xz, yz cross terms
     float G, H, I;      // x, y, z linear terms
     float J;            // constant term
-    vec3 bboxMin;       // Bounding box minimum
-    vec3 bboxMax;       // Bounding box maximum
+    vec3 bboxMin;       // Bounding box minimum (object space)
+    vec3 bboxMax;       // Bounding box maximum (object space)
     int materialIndex;
+    mat4 worldToObject; // Inverse instance transform
+    int index;          // Row in the quadric data texture
+    int groupFirst;     // First row of the CSG intersection group
+    int groupCount;     // Members of the group (1 = standalone)
 };
 
 struct HitRecord
@@ -459,8 +508,8 @@ bool intersectPlane(vec3 ro, vec3 rd, Plane plane, inout HitRecord hit)
 }
 
 
-// Ray-bounding box intersection (AABB)
-bool intersectAABB(vec3 ro, vec3 rd, vec3 bboxMin, vec3 bboxMax)
+// Ray-bounding box intersection (AABB), returns entry/exit distances
+bool intersectAABB(vec3 ro, vec3 rd, vec3 bboxMin, vec3 bboxMax, out float tNear, out float tFar)
 {
     vec3 invDir = 1.0 / rd;
     vec3 t0 = (bboxMin - ro) * invDir;
@@ -469,12 +518,48 @@ bool intersectAABB(vec3 ro, vec3 rd, vec3 bboxMin, vec3 bboxMax)
     vec3 tmin = min(t0, t1);
     vec3 tmax = max(t0, t1);
     
-    float tNear = max(max(tmin.x, tmin.y), tmin.z);
-    float tFar = min(min(tmax.x, tmax.y), tmax.z);
+    tNear = max(max(tmin.x, tmin.y), tmin.z);
+    tFar = min(min(tmax.x, tmax.y), tmax.z);
     
     return tNear <= tFar && tFar >= EPSILON;
 }
 
+// Point-in-box test with a small tolerance for hits on the faces
+bool insideAABB(vec3 P, vec3 bboxMin, vec3 bboxMax)
+{
+    return all(greaterThanEqual(P, bboxMin - EPSILON)) && all(lessThanEqual(P, bboxMax + EPSILON));
+}
+
+// Gather quadric i from its row of the data texture
+Quadric loadQuadric(int i)
+{
+    vec4 t0 = texelFetch(uQuadricsTex, ivec2(0, i), 0);
+    vec4 t1 = texelFetch(uQuadricsTex, ivec2(1, i), 0);
+    vec4 t2 = texelFetch(uQuadricsTex, ivec2(2, i), 0);
+    vec4 t3 = texelFetch(uQuadricsTex, ivec2(3, i), 0);
+    vec4 t4 = texelFetch(uQuadricsTex, ivec2(4, i), 0);
+    vec4 t8 = texelFetch(uQuadricsTex, ivec2(8, i), 0);
+    
+    Quadric q;
+    q.A = t0.x; q.B = t0.y; q.C = t0.z; q.D = t0.w;
+    q.E = t1.x; q.F = t1.y; q.G = t1.z; q.H = t1.w;
+    q.I = t2.x; q.J = t2.y;
+    q.bboxMin = t3.xyz;
+    q.materialIndex = int(t3.w);
+    q.bboxMax = t4.xyz;
+    
+    // Texels 5-7 hold the rows of the affine worldToObject matrix
+    q.worldToObject = transpose(mat4(texelFetch(uQuadricsTex, ivec2(5, i), 0),
+                                     texelFetch(uQuadricsTex, ivec2(6, i), 0),
+                                     texelFetch(uQuadricsTex, ivec2(7, i), 0),
+                                     vec4(0.0, 0.0, 0.0, 1.0)));
+    
+    q.index = i;
+    q.groupFirst = int(t8.x);
+    q.groupCount = int(t8.y);
+    return q;
+}
+
 // Evaluate quadric at point P
 // Q(P) = Ax^2 + By^2 + Cz^2 + Dxy + Exz + Fyz + Gx + Hy + Iz + J
 float evaluateQuadric(Quadric q, vec3 P)
@@ -500,55 +585,144 @@ vec3 quadricGradient(Quadric q, vec3 P)
     );
 }
 
-// Ray-quadric intersection
-// Ray: P(t) = ro + t * rd
-// Substitute into quadric equation and solve quadratic: at^2 + bt + c = 0
-bool intersectQuadric(vec3 ro, vec3 rd, Quadric q, inout HitRecord hit)
+// A CSG group is the intersection of the solids f <= 0 of its members (negate
+// a member's coefficients to subtract it). A root of one member is on the
+// group's surface when it lies inside every other member.
+bool insideCSGGroup(Quadric q, vec3 P)
 {
-    // Quadric: Ax² + By² + Cz² + Dxy + Exz + Fyz + Gx + Hy + Iz + J = 0
-    // Ray: P(t) = ro + t*rd
+    for (int j = q.groupFirst; j < q.groupFirst + q.groupCount; j++)
+    {
+        if (j == q.index) continue;
+        
+        Quadric other = loadQuadric(j);
+        vec3 local = (other.worldToObject * vec4(P, 1.0)).xyz;
+        if (evaluateQuadric(other, local) > EPSILON) return false;
+    }
+    return true;
+}
+
+// Roots of Aq*t² + Bq*t + Cq = 0 with t1 <= t2. Planes and rays parallel to a
+// cylinder axis have Aq = 0 and a single root.
+bool solveQuadricRoots(float Aq, float Bq, float Cq, out float t1, out float t2)
+{
+    if (abs(Aq) < 1e-6)
+    {
+        if (abs(Bq) < 1e-6) return false;
+        t1 = t2 = -Cq / Bq;
+        return true;
+    }
     
-    vec3 d = rd;
-    vec3 o = ro;
+    float discriminant = Bq * Bq - 4.0 * Aq * Cq;
+    if (discriminant < 0.0) return false;
     
+    float sqrtDisc = sqrt(discriminant);
+    float r1 = (-Bq - sqrtDisc) / (2.0 * Aq);
+    float r2 = (-Bq + sqrtDisc) / (2.0 * Aq);
+    t1 = min(r1, r2);
+    t2 = max(r1, r2);
+    return true;
+}
+
+// A root counts if it is in range, inside the bounding box and, for CSG
+// members, inside the rest of the group
+bool acceptQuadricRoot(Quadric q, vec3 o, vec3 d, vec3 ro, vec3 rd, float t, float tMin, float tMax)
+{
+    if (t < tMin || t >= tMax || !insideAABB(o + d * t, q.bboxMin, q.bboxMax)) return false;
+    return q.groupCount <= 1 || insideCSGGroup(q, ro + rd * t);
+}
+
+// Coefficient of t² in f(o + t*d): the only term that depends on the
+// direction alone
+float quadricDirectionTerm(Quadric q, vec3 d)
+{
+    return q.A * d.x * d.x + q.B * d.y * d.y + q.C * d.z * d.z +
+           q.D * d.x * d.y + q.E * d.x * d.z + q.F * d.y * d.z;
+}
+
+// Camera rays all start at uCameraPosition, so the terms of f(o + t*d) that
+// depend only on the origin are read from texels 9-10 instead of recomputed:
+// o in object space with Cq = f(o), and ∇f(o) with Bq = ∇f(o)·d.
+void expandCameraRay(Quadric q, vec3 d, out vec3 o, out float Aq, out float Bq, out float Cq)
+{
+    vec4 origin = texelFetch(uQuadricsTex, ivec2(9, q.index), 0);
+    vec4 gradient = texelFetch(uQuadricsTex, ivec2(10, q.index), 0);
+    o = origin.xyz;
+    Aq = quadricDirectionTerm(q, d);
+    Bq = dot(gradient.xyz, d);
+    Cq = origin.w;
+}
+
+// Expand f(o + t*d) into Aq*t² + Bq*t + Cq
+void expandQuadricRay(Quadric q, vec3 o, vec3 d, out float Aq, out float Bq, out float Cq)
+{
     // Coefficient of t²
-    float Aq = q.A * d.x * d.x + q.B * d.y * d.y + q.C * d.z * d.z +
-               q.D * d.x * d.y + q.E * d.x * d.z + q.F * d.y * d.z;
+    Aq = q.A * d.x * d.x + q.B * d.y * d.y + q.C * d.z * d.z +
+         q.D * d.x * d.y + q.E * d.x * d.z + q.F * d.y * d.z;
     
     // Coefficient of t
-    float Bq = 2.0 * (q.A * o.x * d.x + q.B * o.y * d.y + q.C * o.z * d.z) +
-               q.D * (o.x * d.y + o.y * d.x) +
-               q.E * (o.x * d.z + o.z * d.x) +
-               q.F * (o.y * d.z + o.z * d.y) +
-               q.G * d.x + q.H * d.y + q.I * d.z;
+    Bq = 2.0 * (q.A * o.x * d.x + q.B * o.y * d.y + q.C * o.z * d.z) +
+         q.D * (o.x * d.y + o.y * d.x) +
+         q.E * (o.x * d.z + o.z * d.x) +
+         q.F * (o.y * d.z + o.z * d.y) +
+         q.G * d.x + q.H * d.y + q.I * d.z;
     
     // Constant term
-    float Cq = q.A * o.x * o.x + q.B * o.y * o.y + q.C * o.z * o.z +
-               q.D * o.x * o.y + q.E * o.x * o.z + q.F * o.y * o.z +
-               q.G * o.x + q.H * o.y + q.I * o.z + q.J;
+    Cq = q.A * o.x * o.x + q.B * o.y * o.y + q.C * o.z * o.z +
+         q.D * o.x * o.y + q.E * o.x * o.z + q.F * o.y * o.z +
+         q.G * o.x + q.H * o.y + q.I * o.z + q.J;
+}
+
+// Ray-quadric intersection
+// Ray: P(t) = ro + t * rd
+// Substitute into quadric equation and solve quadratic: at^2 + bt + c = 0
+// fromCamera: ro is uCameraPosition, so the cached origin terms apply
+bool intersectQuadric(vec3 ro, vec3 rd, Quadric q, bool fromCamera, inout HitRecord hit)
+{
+    // Quadric: Ax² + By² + Cz² + Dxy + Exz + Fyz + Gx + Hy + Iz + J = 0
+    // Ray: P(t) = ro + t*rd
     
-    // Solve Aq*t² + Bq*t + Cq = 0
-    float discriminant = Bq * Bq - 4.0 * Aq * Cq;
+    // Coefficients are in object space: move the ray there instead.
+    // The direction is not renormalized, so t is the same in both spaces.
+    vec3 d = (q.worldToObject * vec4(rd, 0.0)).xyz;
+    vec3 o;
+    float Aq, Bq, Cq;
+    if (fromCamera)
+    {
+        expandCameraRay(q, d, o, Aq, Bq, Cq);
+    }
+    else
+    {
+        o = (q.worldToObject * vec4(ro, 1.0)).xyz;
+        expandQuadricRay(q, o, d, Aq, Bq, Cq);
+    }
     
-    if (discriminant < 0.0) return false;
+    // Cull against the bounding box. The CPU shrinks it to the part of the
+    // surface inside the user box, so most misses stop here.
+    float boxNear, boxFar;
+    if (!intersectAABB(o, d, q.bboxMin, q.bboxMax, boxNear, boxFar)) return false;
+    // The range is widened by EPSILON so flat boxes (planes in a CSG group)
+    // keep their root; insideAABB below does the exact clip.
+    float tMin = max(EPSILON, boxNear - EPSILON);
+    float tMax = min(hit.t, boxFar + EPSILON);
     
-    float sqrtDisc = sqrt(discriminant);
-    float t1 = (-Bq - sqrtDisc) / (2.0 * Aq);
-    float t2 = (-Bq + sqrtDisc) / (2.0 * Aq);
+    // Solve Aq*t² + Bq*t + Cq = 0
+    float t1, t2;
+    if (!solveQuadricRoots(Aq, Bq, Cq, t1, t2)) return false;
     
     // Try nearest intersection first
     float t = t1;
-    if (t < EPSILON || t >= hit.t)
+    if (!acceptQuadricRoot(q, o, d, ro, rd, t, tMin, tMax))
     {
         t = t2;
-        if (t < EPSILON || t >= hit.t)
+        if (!acceptQuadricRoot(q, o, d, ro, rd, t, tMin, tMax))
             return false;
     }
     
     vec3 P = ro + rd * t;
     
-    // Compute normal via gradient
-    vec3 grad = quadricGradient(q, P);
+    // Compute normal via gradient in object space, then bring it to world
+    // space with the inverse transpose of the instance transform
+    vec3 grad = transpose(mat3(q.worldToObject)) * quadricGradient(q, o + d * t);
     float gradLen = length(grad);
     
     if (gradLen < EPSILON) return false;
@@ -566,6 +740,126 @@ bool intersectQuadric(vec3 ro, vec3 rd, Quadric q, inout HitRecord hit)
     return true;
 }
 
+// Any-hit quadric test for shadow/visibility rays: true if the quadric blocks
+// the segment (EPSILON, tMax). Skips the normal and hit record entirely.
+bool occludedQuadric(vec3 ro, vec3 rd, Quadric q, float tMax)
+{
+    vec3 o = (q.worldToObject * vec4(ro, 1.0)).xyz;
+    vec3 d = (q.worldToObject * vec4(rd, 0.0)).xyz;
+    
+    float boxNear, boxFar;
+    if (!intersectAABB(o, d, q.bboxMin, q.bboxMax, boxNear, boxFar)) return false;
+    float tLo = max(EPSILON, boxNear - EPSILON);
+    float tHi = min(tMax, boxFar + EPSILON);
+    
+    float Aq, Bq, Cq;
+    expandQuadricRay(q, o, d, Aq, Bq, Cq);
+    
+    float t1, t2;
+    if (!solveQuadricRoots(Aq, Bq, Cq, t1, t2)) return false;
+    
+    // Either root blocks the ray if it is accepted
+    return acceptQuadricRoot(q, o, d, ro, rd, t1, tLo, tHi) ||
+           acceptQuadricRoot(q, o, d, ro, rd, t2, tLo, tHi);
+}
+
+// Slab test against BVH node n, clipped to (EPSILON, tMax)
+bool intersectQuadricBVHNode(vec3 ro, vec3 invDir, int n, float tMax, out float tNear)
+{
+    vec3 t0 = (texelFetch(uQuadricBVHTex, ivec2(0, n), 0).xyz - ro) * invDir;
+    vec3 t1 = (texelFetch(uQuadricBVHTex, ivec2(1, n), 0).xyz - ro) * invDir;
+    vec3 tmin = min(t0, t1);
+    vec3 tmax = max(t0, t1);
+    
+    tNear = max(max(tmin.x, tmin.y), max(tmin.z, EPSILON));
+    float tFar = min(min(tmax.x, tmax.y), min(tmax.z, tMax));
+    return tNear <= tFar;
+}
+
+// Walk the quadric BVH, near child first. Closest-hit mode updates hit; any-hit
+// mode returns on the first quadric that blocks (EPSILON, hit.t). Nodes are
+// skipped when popped if a closer hit was found after they were pushed.
+// fromCamera selects the cached origin terms (closest-hit mode only).
+bool traverseQuadricBVH(vec3 ro, vec3 rd, bool anyHit, bool fromCamera, inout HitRecord hit)
+{
+    if (uNumQuadrics <= 0) return false;
+    
+    vec3 invDir = 1.0 / rd;
+    int stack[QUADRIC_BVH_STACK_SIZE];
+    float stackNear[QUADRIC_BVH_STACK_SIZE];
+    int stackSize = 0;
+    bool hitAnything = false;
+    
+    float tRoot;
+    if (!intersectQuadricBVHNode(ro, invDir, 0, hit.t, tRoot)) return false;
+    stack[0] = 0;
+    stackNear[0] = tRoot;
+    stackSize = 1;
+    
+    while (stackSize > 0)
+    {
+        stackSize--;
+        if (stackNear[stackSize] > hit.t) continue;
+        
+        int node = stack[stackSize];
+        int leftOrFirst = int(texelFetch(uQuadricBVHTex, ivec2(0, node), 0).w);
+        int count = int(texelFetch(uQuadricBVHTex, ivec2(1, node), 0).w);
+        
+        // Leaf: a contiguous range of quadric rows
+        if (count > 0)
+        {
+            for (int i = leftOrFirst; i < leftOrFirst + count; i++)
+            {
+                Quadric q = loadQuadric(i);
+                if (anyHit)
+                {
+                    if (occludedQuadric(ro, rd, q, hit.t)) return true;
+                }
+                else if (intersectQuadric(ro, rd, q, fromCamera, hit))
+                {
+                    hitAnything = true;
+                }
+            }
+            continue;
+        }
+        
+        // Interior: the right child follows the left one
+        int nearChild = leftOrFirst;
+        int farChild = leftOrFirst + 1;
+        float tNearChild, tFarChild;
+        bool hitNearChild = intersectQuadricBVHNode(ro, invDir, nearChild, hit.t, tNearChild);
+        bool hitFarChild = intersectQuadricBVHNode(ro, invDir, farChild, hit.t, tFarChild);
+        if (hitNearChild && hitFarChild && tFarChild < tNearChild)
+        {
+            int n = nearChild; nearChild = farChild; farChild = n;
+            float t = tNearChild; tNearChild = tFarChild; tFarChild = t;
+        }
+        else if (!hitNearChild)
+        {
+            nearChild = farChild;
+            tNearChild = tFarChild;
+            hitNearChild = hitFarChild;
+            hitFarChild = false;
+        }
+        
+        // Push the far child first so the near one is popped next
+        if (hitFarChild && stackSize < QUADRIC_BVH_STACK_SIZE)
+        {
+            stack[stackSize] = farChild;
+            stackNear[stackSize] = tFarChild;
+            stackSize++;
+        }
+        if (hitNearChild && stackSize < QUADRIC_BVH_STACK_SIZE)
+        {
+            stack[stackSize] = nearChild;
+            stackNear[stackSize] = tNearChild;
+            stackSize++;
+        }
+    }
+    
+    return hitAnything;
+}
+
 // Ray-triangle intersection (Möller–Trumbore algorithm)
 bool intersectTriangle(vec3 ro, vec3 rd, vec3 v0, vec3 v1, vec3 v2, 
                        vec3 n0, vec3 n1, vec3 n2, int matIdx, inout HitRecord hit)
@@ -608,6 +902,32 @@ bool intersectTriangle(vec3 ro, vec3 rd, vec3 v0, vec3 v1, vec3 v2,
     return true;
 }
 
+// Any-hit Möller–Trumbore test: only reports whether the triangle blocks the
+// segment (EPSILON, tMax), without interpolating normals
+bool occludedTriangle(vec3 ro, vec3 rd, vec3 v0, vec3 v1, vec3 v2, float tMax)
+{
+    vec3 edge1 = v1 - v0;
+    vec3 edge2 = v2 - v0;
+    vec3 h = cross(rd, edge2);
+    float a = dot(edge1, h);
+    
+    if (abs(a) < EPSILON) return false;
+    
+    float f = 1.0 / a;
+    vec3 s = ro - v0;
+    float u = f * dot(s, h);
+    
+    if (u < 0.0 || u > 1.0) return false;
+    
+    vec3 q = cross(s, edge1);
+    float v = f * dot(rd, q);
+    
+    if (v < 0.0 || u + v > 1.0) return false;
+    
+    float t = f * dot(edge2, q);
+    return t >= EPSILON && t <= tMax;
+}
+
 // Get material from OBJ texture data
 Material getMaterialFromTexture(int matIdx)
 {
@@ -640,20 +960,20 @@ bool intersectOBJMesh(vec3 ro, vec3 rd, inout HitRecord hit)
     
     for (int i = 0; i < uNumTriangles; i++)
     {
-        float texY = (float(i) + 0.5) / float(uNumTriangles);
+        // Read vertex indices (xyz) and material index (w)
+        uvec4 tri = texelFetch(uTrianglesTex, ivec2(0, i), 0);
         
         // Read triangle vertices
-        vec3 v0 = texture(uTrianglesTex, vec2(0.5 / 3.0, texY)).xyz;
-        vec3 v1 = texture(uTrianglesTex, vec2(1.5 / 3.0, texY)).xyz;
-        vec3 v2 = texture(uTrianglesTex, vec2(2.5 / 3.0, texY)).xyz;
+        vec3 v0 = texelFetch(uPositionsTex, ivec2(0, int(tri.x)), 0).xyz;
+        vec3 v1 = texelFetch(uPositionsTex, ivec2(0, int(tri.y)), 0).xyz;
+        vec3 v2 = texelFetch(uPositionsTex, ivec2(0, int(tri.z)), 0).xyz;
         
-        // Read triangle normals
-        vec3 n0 = texture(uNormalsTex, vec2(0.5 / 3.0, texY)).xyz;
-        vec3 n1 = texture(uNormalsTex, vec2(1.5 / 3.0, texY)).xyz;
-        vec3 n2 = texture(uNormalsTex, vec2(2.5 / 3.0, texY)).xyz;
+        // Read vertex normals
+        vec3 n0 = texelFetch(uNormalsTex, ivec2(0, int(tri.x)), 0).xyz;
+        vec3 n1 = texelFetch(uNormalsTex, ivec2(0, int(tri.y)), 0).xyz;
+        vec3 n2 = texelFetch(uNormalsTex, ivec2(0, int(tri.z)), 0).xyz;
         
-        // Read material index
-        int matIdx = int(texture(uTriMatTex, vec2(0.5, texY)).r);
+        int matIdx = int(tri.w);
         
         if (intersectTriangle(ro, rd, v0, v1, v2, n0, n1, n2, matIdx, hit))
         {
@@ -664,6 +984,25 @@ bool intersectOBJMesh(vec3 ro, vec3 rd, inout HitRecord hit)
     return hitAnything;
 }
 
+// Any-hit test against the OBJ mesh: returns on the first blocking triangle
+// and reads only the index and position textures
+bool occludedOBJMesh(vec3 ro, vec3 rd, float tMax)
+{
+    for (int i = 0; i < uNumTriangles; i++)
+    {
+        uvec4 tri = texelFetch(uTrianglesTex, ivec2(0, i), 0);
+        
+        vec3 v0 = texelFetch(uPositionsTex, ivec2(0, int(tri.x)), 0).xyz;
+        vec3 v1 = texelFetch(uPositionsTex, ivec2(0, int(tri.y)), 0).xyz;
+        vec3 v2 = texelFetch(uPositionsTex, ivec2(0, int(tri.z)), 0).xyz;
+        
+        if (occludedTriangle(ro, rd, v0, v1, v2, tMax))
+            return true;
+    }
+    
+    return false;
+}
+
 // ----------------------------------------------------------------------------
 // SCENE DEFINITION - Cornell Box inspired
 // ----------------------------------------------------------------------------
@@ -804,8 +1143,8 @@ void initScene()
 
 }
 
-// Scene intersection
-bool intersectScene(vec3 ro, vec3 rd, inout HitRecord hit)
+// Scene intersection (fromCamera: ro is uCameraPosition, see intersectQuadric)
+bool intersectScene(vec3 ro, vec3 rd, bool fromCamera, inout HitRecord hit)
 {
     bool hitAnything = false;
     
@@ -857,31 +1196,51 @@ bool intersectScene(vec3 ro, vec3 rd, inout HitRecord hit)
         if (intersectPlane(ro, rd, rightWall, hit)) hitAnything = true;
     }
 
-    // Quadrics (from uniforms) - DEBUG VERSION
-    for (int i = 0; i < uNumQuadrics && i < 8; i++)
-    {
-        Quadric q;
-        q.A = uQuadrics_A[i];
-        q.B = uQuadrics_B[i];
-        q.C = uQuadrics_C[i];
-        q.D = uQuadrics_D[i];
-        q.E = uQuadrics_E[i];
-        q.F = uQuadrics_F[i];
-        q.G = uQuadrics_G[i];
-        q.H = uQuadrics_H[i];
-        q.I = uQuadrics_I[i];
-        q.J = uQuadrics_J[i];
-        q.bboxMin = uQuadrics_bboxMin[i];
-        q.bboxMax = uQuadrics_bboxMax[i];
-        q.materialIndex = uQuadrics_materialIndex[i];
-
-        bool quadricHit = intersectQuadric(ro, rd, q, hit);
-        if (quadricHit) hitAnything = true;
-    }
+    // Quadrics (BVH over the quadric data texture)
+    if (traverseQuadricBVH(ro, rd, false, fromCamera, hit)) hitAnything = true;
 
     return hitAnything;
 }
 
+// Scene visibility query for shadow rays: true if anything blocks the segment
+// (EPSILON, tMax). Triangles and quadrics use the any-hit tests and stop at
+// the first blocker; the analytic spheres and walls are cheap enough to reuse
+// the closest-hit tests.
+bool occludedScene(vec3 ro, vec3 rd, float tMax)
+{
+    if (uUseOBJScene && uNumTriangles > 0)
+    {
+        if (occludedOBJMesh(ro, rd, tMax)) return true;
+    }
+    else
+    {
+        HitRecord hit;
+        hit.t = tMax;
+        
+        for (int i = 0; i < NUM_SPHERES; i++)
+        {
+            if (intersectSphere(ro, rd, spheres[i], hit)) return true;
+        }
+        
+        Plane walls[5];
+        walls[0] = Plane(vec3(0.0, -3.0, 0.0), vec3(0.0, 1.0, 0.0), 0);
+        walls[1] = Plane(vec3(0.0, 3.0, 0.0), vec3(0.0, -1.0, 0.0), 0);
+        walls[2] = Plane(vec3(0.0, 0.0, -4.0), vec3(0.0, 0.0, 1.0), 0);
+        walls[3] = Plane(vec3(-3.5, 0.0, 0.0), vec3(1.0, 0.0, 0.0), 1);
+        walls[4] = Plane(vec3(3.5, 0.0, 0.0), vec3(-1.0, 0.0, 0.0), 2);
+        for (int i = 0; i < 5; i++)
+        {
+            if (intersectPlane(ro, rd, walls[i], hit)) return true;
+        }
+    }
+    
+    HitRecord quadricHit;
+    quadricHit.t = tMax;
+    if (traverseQuadricBVH(ro, rd, true, false, quadricHit)) return true;
+    
+    return false;
+}
+
 // ----------------------------------------------------------------------------
 // ENVIRONMENT LIGHTING - HDR Sky
 // ----------------------------------------------------------------------------
@@ -951,11 +1310,18 @@ vec3 pathTrace(vec3 rayOrigin, vec3 rayDirection)
     {
         if (bounce >= maxBounces) break;
         
+        // Bounce 0 of the sampler is the camera
+        startSamplerBounce(bounce + 1);
+        
         // hit = scene.intersect(ray)
         HitRecord hit;
         hit.t = MAX_DISTANCE;
         
-        if (!intersectScene(ro, rd, hit))
+        // Primary rays start exactly at the camera unless depth of field
+        // moved the origin, and then share the per-frame quadric origin terms
+        bool cameraRay = bounce == 0 && uAperture <= 0.0;
+        
+        if (!intersectScene(ro, rd, cameraRay, hit))
         {
             // if no hit: return background
             radiance += throughput * sampleEnvironment(rd);
@@ -1051,14 +1417,32 @@ vec3 pathTrace(vec3 rayOrigin, vec3 rayDirection)
 // ----------------------------------------------------------------------------
 void main()
 {
+    ivec2 pixelCoord = ivec2(gl_FragCoord.xy);
+    
+    // Adaptive sampling: a converged pixel takes no sample this frame
+    // (alpha < 0 tells Accumulate.glsl to keep its old value)
+    vec4 stats = uFrame == 0 ? vec4(0.0) : texelFetch(uAccumulationStats, pixelCoord, 0);
+    pixelSample = int(stats.r);
+    if (uAdaptiveThreshold > 0.0 && !uAdaptiveRefresh &&
+        pixelSample >= uAdaptiveMinSamples && stats.g <= uAdaptiveThreshold)
+    {
+        FragColor = vec4(0.0, 0.0, 0.0, -1.0);
+        return;
+    }
+    
     // Initialize scene
     initScene();
 
-    // Initialize RNG with pixel position and frame number
-    ivec2 pixelCoord = ivec2(gl_FragCoord.xy);
-    rngState = uint(pixelCoord.x + pixelCoord.y * int(uResolution.x)) * uint(uFrame * 719393 + 1);
+    // Initialize RNG with pixel position and sample index
+    rngState = uint(pixelCoord.x + pixelCoord.y * int(uResolution.x)) * uint(pixelSample * 719393 + 1);
     rngState = pcgHash(rngState);
     
+    // The table repeats every uSamplerTableSize samples; later passes see it
+    // under a different per-pixel shift
+    uint pixelIndex = uint(pixelCoord.x + pixelCoord.y * int(uResolution.x));
+    ldPixelHash = pcgHash(pixelIndex ^ pcgHash(uint(pixelSample / max(uSamplerTableSize, 1))));
+    startSamplerBounce(0);
+    
     // -------------------------------------------------------------------------
     // MC Path Tracing - Main Loop (per pixel):
     //   for each pixel (i,j) in image:
@@ -1100,8 +1484,11 @@ void main()
     if (luminance > 10.0)
     {
         color *= 10.0 / luminance;
+        luminance = 10.0;
     }
     
-    FragColor = vec4(color, 1.0);
+    // Alpha carries the squared luminance; its running average is the
+    // second moment the noise estimate needs
+    FragColor = vec4(color, luminance * luminance);
 }
 
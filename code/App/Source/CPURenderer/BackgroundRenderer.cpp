@@ -0,0 +1,99 @@
+#include "BackgroundRenderer.h"
+
+#include <chrono>
+
+// ============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+// ============================================================================
+BackgroundRenderer::BackgroundRenderer()
+{
+	m_Thread = std::thread(&BackgroundRenderer::WorkerLoop, this);
+}
+
+BackgroundRenderer::~BackgroundRenderer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Quit = true;
+		m_Pending.reset();
+		m_Cancel.store(true);
+	}
+	m_Wake.notify_one();
+	m_Thread.join();
+}
+
+// ============================================================================
+// JOB CONTROL
+// ============================================================================
+void BackgroundRenderer::Restart(std::shared_ptr<const CPUScene> scene, const RenderCamera& camera, const RenderSettings& settings)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Pending = std::make_unique<Job>(Job{ std::move(scene), camera, settings });
+		m_Cancel.store(true);
+	}
+	m_Wake.notify_one();
+}
+
+void BackgroundRenderer::Stop()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Pending.reset();
+	m_Cancel.store(true);
+}
+
+bool BackgroundRenderer::IsBusy() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Pending || m_Rendering;
+}
+
+bool BackgroundRenderer::TakeResult(Image& image, double& seconds)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (!m_HasResult)
+		return false;
+	
+	image = std::move(m_Result);
+	seconds = m_ResultSeconds;
+	m_HasResult = false;
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+// WorkerLoop
+// ----------------------------------------------------------------------------
+// The cancel flag is cleared under the lock that hands over the job, so a
+// Restart arriving at any later point cancels exactly the render it replaces.
+// ----------------------------------------------------------------------------
+void BackgroundRenderer::WorkerLoop()
+{
+	while (true)
+	{
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Rendering = false;
+			m_Wake.wait(lock, [this] { return m_Quit || m_Pending; });
+			if (m_Quit)
+				return;
+			
+			job = std::move(m_Pending);
+			m_Cancel.store(false);
+			m_Rendering = true;
+		}
+		
+		auto start = std::chrono::steady_clock::now();
+		CPURenderer renderer(*job->Scene);
+		Image image = renderer.Render(job->Camera, job->Settings, &m_Cancel);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (!m_Cancel.load())
+		{
+			m_Result = std::move(image);
+			m_ResultSeconds = seconds;
+			m_HasResult = true;
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "CPURenderer.h"
+
+// ============================================================================
+// BACKGROUND RENDERER - Restartable CPU Render Next to the Interactive Loop
+// ============================================================================
+//
+// Runs CPURenderer::Render on its own thread so the window stays responsive.
+// Restart() replaces the job: the render in flight is cancelled within one
+// tile time and the new one starts right after, so camera moves (anything
+// that resets accumulation) never wait for a stale frame to finish.
+//
+// USAGE EXAMPLE:
+// --------------
+//   BackgroundRenderer background;
+//
+//   // Whenever the view changes
+//   background.Restart(scene, camera, settings);
+//
+//   // Every frame
+//   Image image;
+//   double seconds;
+//   if (background.TakeResult(image, seconds))
+//       image.Write("reference.pfm");
+//
+// ============================================================================
+class BackgroundRenderer
+{
+public:
+	BackgroundRenderer();
+	~BackgroundRenderer();
+	
+	BackgroundRenderer(const BackgroundRenderer&) = delete;
+	BackgroundRenderer& operator=(const BackgroundRenderer&) = delete;
+	
+	// Cancel the current render (if any) and start rendering scene from
+	// camera. The scene is shared so it outlives a cancelled render.
+	void Restart(std::shared_ptr<const CPUScene> scene, const RenderCamera& camera, const RenderSettings& settings);
+	
+	// Cancel the current render and drop any pending job
+	void Stop();
+	
+	// True while a job is pending or rendering
+	bool IsBusy() const;
+	
+	// Moves out the most recent finished image and its render time.
+	// Returns false if no render finished since the last call.
+	bool TakeResult(Image& image, double& seconds);
+
+private:
+	void WorkerLoop();
+	
+	struct Job
+	{
+		std::shared_ptr<const CPUScene> Scene;
+		RenderCamera Camera;
+		RenderSettings Settings;
+	};
+	
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_Wake;
+	std::unique_ptr<Job> m_Pending;
+	bool m_Rendering = false;
+	bool m_Quit = false;
+	
+	// Set by Restart/Stop, cleared by the worker when it picks up a job
+	std::atomic<bool> m_Cancel{ false };
+	
+	Image m_Result;
+	double m_ResultSeconds = 0.0;
+	bool m_HasResult = false;
+	
+	std::thread m_Thread;
+};
@@ -0,0 +1,259 @@
+// ============================================================================
+// cg_render_cpu - Headless CPU Reference Renderer
+// ============================================================================
+//
+// Renders a procedural or OBJ scene on all cores and writes the result to
+// disk. No window or GL context is created. The sample count is fixed, or
+// with --time / --noise as low as the budget or noise target allows.
+//
+// USAGE:
+//   cg_render_cpu [options]
+//
+//   --scene N        Procedural scene 0-3 (default 0, Cornell Box Showcase)
+//   --obj PATH       Render an OBJ scene instead (uses its 'c' camera)
+//   --no-quadrics    Leave out the default quadrics
+//   --width W        Image width  (default 1080)
+//   --height H       Image height (default 600)
+//   --spp N          Samples per pixel (default 64; the cap with --time/--noise,
+//                    default 65536 there)
+//   --time SECONDS   Stop before the wall-clock budget runs out
+//   --noise TARGET   Stop once the relative noise (e.g. 0.01) is reached
+//   --pass N         Samples per pixel per progressive pass (default 4)
+//   --bounces N      Maximum bounces, 1-16 (default 16)
+//   --threads N      Worker threads (default 0 = all cores)
+//   --seed N         RNG seed (default 0)
+//   --sampler NAME   random, stratified, halton or sobol (default sobol)
+//   --skybox         Show the sky for escaping rays
+//   --output PATH    .pfm (linear) or .ppm (tonemapped), default render.pfm
+//
+// DISTRIBUTED (see DistributedRender.h):
+//   --workers N        Render with N local worker processes
+//   --worker-cmd CMD   Add a worker started by CMD, e.g.
+//                      "ssh node2 cg_render_cpu --worker" (repeatable)
+//   --job-size PX      Edge of a distributed job in pixels (default 128)
+//   --job-samples N    Samples per job (default 0 = all)
+//   --worker           Serve jobs on stdin/stdout (started by a coordinator)
+//
+// ============================================================================
+
+#include "DistributedRender.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+static void PrintUsage()
+{
+	std::cout <<
+		"Usage: cg_render_cpu [options]\n"
+		"  --scene N        Procedural scene 0-3 (default 0)\n"
+		"  --obj PATH       Render an OBJ scene instead\n"
+		"  --no-quadrics    Leave out the default quadrics\n"
+		"  --width W        Image width (default 1080)\n"
+		"  --height H       Image height (default 600)\n"
+		"  --spp N          Samples per pixel (default 64; cap with --time/--noise)\n"
+		"  --time SECONDS   Stop before the wall-clock budget runs out\n"
+		"  --noise TARGET   Stop once the relative noise (e.g. 0.01) is reached\n"
+		"  --pass N         Samples per pixel per progressive pass (default 4)\n"
+		"  --bounces N      Maximum bounces, 1-16 (default 16)\n"
+		"  --threads N      Worker threads (default 0 = all cores)\n"
+		"  --seed N         RNG seed (default 0)\n"
+		"  --sampler NAME   random, stratified, halton or sobol (default sobol)\n"
+		"  --skybox         Show the sky for escaping rays\n"
+		"  --output PATH    .pfm (linear) or .ppm (tonemapped), default render.pfm\n"
+		"Distributed:\n"
+		"  --workers N        Render with N local worker processes\n"
+		"  --worker-cmd CMD   Add a worker started by CMD (repeatable)\n"
+		"  --job-size PX      Edge of a distributed job in pixels (default 128)\n"
+		"  --job-samples N    Samples per job (default 0 = all)\n"
+		"  --worker           Serve jobs on stdin/stdout (started by a coordinator)\n";
+}
+
+// Single-quoted for /bin/sh
+static std::string ShellQuote(const std::string& text)
+{
+	std::string quoted = "'";
+	for (char c : text)
+		quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+	return quoted + "'";
+}
+
+int main(int argc, char** argv)
+{
+	SceneDescription description;
+	std::string outputPath = "render.pfm";
+	bool sppGiven = false;
+	bool threadsGiven = false;
+	bool worker = false;
+	int localWorkers = 0;
+	DistributedSettings distributed;
+	RenderSettings settings;
+	
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		auto needsValue = [&]()
+		{
+			if (!value)
+			{
+				std::cerr << "Missing value for " << arg << std::endl;
+				std::exit(1);
+			}
+			i++;
+			return value;
+		};
+		
+		if (!std::strcmp(arg, "--scene"))           description.ProceduralIndex = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--obj"))        description.OBJPath = needsValue();
+		else if (!std::strcmp(arg, "--no-quadrics")) description.Quadrics = false;
+		else if (!std::strcmp(arg, "--width"))      settings.Width = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--height"))     settings.Height = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--spp"))
+		{
+			settings.SamplesPerPixel = std::atoi(needsValue());
+			sppGiven = true;
+		}
+		else if (!std::strcmp(arg, "--time"))       settings.TimeBudget = std::atof(needsValue());
+		else if (!std::strcmp(arg, "--noise"))      settings.NoiseTarget = float(std::atof(needsValue()));
+		else if (!std::strcmp(arg, "--pass"))       settings.PassSamples = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--bounces"))    settings.MaxBounces = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--threads"))
+		{
+			settings.Threads = std::atoi(needsValue());
+			threadsGiven = true;
+		}
+		else if (!std::strcmp(arg, "--seed"))       settings.Seed = uint32_t(std::strtoul(needsValue(), nullptr, 10));
+		else if (!std::strcmp(arg, "--sampler"))
+		{
+			const char* name = needsValue();
+			if (!Sampler::parseType(name, settings.SamplerType))
+			{
+				std::cerr << "Unknown sampler: " << name << std::endl;
+				return 1;
+			}
+		}
+		else if (!std::strcmp(arg, "--skybox"))     description.Skybox = true;
+		else if (!std::strcmp(arg, "--output"))     outputPath = needsValue();
+		else if (!std::strcmp(arg, "--workers"))    localWorkers = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--worker-cmd")) distributed.WorkerCommands.push_back(needsValue());
+		else if (!std::strcmp(arg, "--job-size"))   distributed.JobSize = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--job-samples")) distributed.JobSamples = std::atoi(needsValue());
+		else if (!std::strcmp(arg, "--worker"))     worker = true;
+		else if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h"))
+		{
+			PrintUsage();
+			return 0;
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << arg << std::endl;
+			PrintUsage();
+			return 1;
+		}
+	}
+	
+	// Everything else arrives from the coordinator
+	if (worker)
+		return RunRenderWorker(settings.Threads);
+	
+	if (settings.Width <= 0 || settings.Height <= 0 || settings.SamplesPerPixel <= 0 || settings.PassSamples <= 0)
+	{
+		std::cerr << "Width, height, spp and pass must be positive" << std::endl;
+		return 1;
+	}
+	
+	// A budget or target decides the sample count; spp only caps it
+	bool progressive = settings.TimeBudget > 0.0 || settings.NoiseTarget > 0.0f;
+	if (progressive && !sppGiven)
+		settings.SamplesPerPixel = 65536;
+	
+	// Local workers split the cores unless --threads says otherwise
+	if (localWorkers > 0)
+	{
+		int threads = threadsGiven ? settings.Threads
+			: std::max(int(std::thread::hardware_concurrency()) / localWorkers, 1);
+		std::string command = ShellQuote(argv[0]) + " --worker --threads " + std::to_string(threads);
+		for (int i = 0; i < localWorkers; i++)
+			distributed.WorkerCommands.push_back(command);
+	}
+	
+	bool distribute = !distributed.WorkerCommands.empty();
+	if (distribute && progressive)
+	{
+		std::cerr << "--time and --noise do not combine with distributed rendering" << std::endl;
+		return 1;
+	}
+	if (distribute && distributed.JobSize <= 0)
+	{
+		std::cerr << "Job size must be positive" << std::endl;
+		return 1;
+	}
+	
+	// ------------------------------------------------------------------------
+	// Scene and camera
+	// ------------------------------------------------------------------------
+	CPUScene scene;
+	RenderCamera camera;
+	if (!description.Load(scene, camera))
+		return 1;
+	
+	// ------------------------------------------------------------------------
+	// Render
+	// ------------------------------------------------------------------------
+	std::cout << "Rendering " << settings.Width << "x" << settings.Height << " @ ";
+	if (progressive)
+	{
+		std::cout << "up to " << settings.SamplesPerPixel << " spp";
+		if (settings.TimeBudget > 0.0)
+			std::cout << ", " << settings.TimeBudget << " s budget";
+		if (settings.NoiseTarget > 0.0f)
+			std::cout << ", noise target " << settings.NoiseTarget;
+	}
+	else
+	{
+		std::cout << settings.SamplesPerPixel << " spp";
+	}
+	std::cout << " (" << Sampler::typeName(settings.SamplerType) << ")";
+	if (distribute)
+		std::cout << " on " << distributed.WorkerCommands.size() << " workers";
+	std::cout << "..." << std::endl;
+	
+	RenderStats stats;
+	Image image;
+	if (distribute)
+	{
+		RenderCoordinator coordinator(distributed);
+		bool finished = coordinator.Render(description, camera, settings, image, &stats);
+		
+		const std::vector<WorkerStats>& workers = coordinator.GetWorkerStats();
+		for (size_t i = 0; i < workers.size(); i++)
+		{
+			std::cout << "  worker " << i << ": " << workers[i].Jobs << " jobs"
+			          << (workers[i].Failed ? " (failed)" : "") << std::endl;
+		}
+		
+		if (!finished)
+		{
+			std::cerr << "Distributed render failed" << std::endl;
+			return 1;
+		}
+	}
+	else
+	{
+		CPURenderer renderer(scene);
+		image = renderer.Render(camera, settings, nullptr, &stats);
+	}
+	
+	std::cout << "Done in " << stats.Seconds << " s: " << stats.SamplesPerPixel << " spp, noise "
+	          << stats.NoiseError << " (stopped at " << RenderStats::ReasonName(stats.Reason) << ")" << std::endl;
+	
+	if (!image.Write(outputPath))
+		return 1;
+	
+	std::cout << "Wrote " << outputPath << std::endl;
+	return 0;
+}
@@ -0,0 +1,372 @@
+#include "CPURenderer.h"
+#include "TileScheduler.h"
+#include "Math/MonteCarlo.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static glm::vec3 Reflect(const glm::vec3& I, const glm::vec3& N)
+{
+	return I - 2.0f * glm::dot(N, I) * N;
+}
+
+// GLSL refract(): zero vector on total internal reflection
+static glm::vec3 Refract(const glm::vec3& I, const glm::vec3& N, float eta)
+{
+	float NdotI = glm::dot(N, I);
+	float k = 1.0f - eta * eta * (1.0f - NdotI * NdotI);
+	if (k < 0.0f)
+		return glm::vec3(0.0f);
+	
+	return eta * I - (eta * NdotI + std::sqrt(k)) * N;
+}
+
+static bool IsFinite(const glm::vec3& v)
+{
+	return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+static float Luminance(const glm::vec3& color)
+{
+	return glm::dot(color, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+}
+
+// ============================================================================
+// RENDER STATS
+// ============================================================================
+const char* RenderStats::ReasonName(StopReason reason)
+{
+	switch (reason)
+	{
+		case StopReason::SampleLimit: return "sample limit";
+		case StopReason::NoiseTarget: return "noise target";
+		case StopReason::TimeBudget:  return "time budget";
+		case StopReason::Cancelled:   return "cancelled";
+	}
+	return "unknown";
+}
+
+static constexpr float NOISE_EPSILON = 0.01f;     // Keeps black pixels from dominating
+static constexpr float NOISE_UNKNOWN = 1e30f;
+static constexpr float NOISE_QUANTILE = 0.99f;
+
+float RelativeNoise(float meanLuminance, float meanSquare, float samples)
+{
+	if (samples < 2.0f)
+		return NOISE_UNKNOWN;
+	
+	float variance = std::max(meanSquare - meanLuminance * meanLuminance, 0.0f) * samples / (samples - 1.0f);
+	return std::sqrt(variance / samples) / (meanLuminance + NOISE_EPSILON);
+}
+
+float NoiseQuantile(std::vector<float>& errors)
+{
+	if (errors.empty())
+		return 0.0f;
+	
+	auto quantile = errors.begin() + std::min(size_t(float(errors.size()) * NOISE_QUANTILE), errors.size() - 1);
+	std::nth_element(errors.begin(), quantile, errors.end());
+	return *quantile;
+}
+
+float EstimateNoise(const std::vector<glm::vec3>& sums, const std::vector<float>& sumSquares, const std::vector<float>& counts)
+{
+	std::vector<float> errors;
+	errors.reserve(sums.size());
+	for (size_t i = 0; i < sums.size(); i++)
+	{
+		float n = counts[i];
+		if (n >= 2.0f)
+			errors.push_back(RelativeNoise(Luminance(sums[i]) / n, sumSquares[i] / n, n));
+	}
+	return NoiseQuantile(errors);
+}
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+CPURenderer::CPURenderer(const CPUScene& scene)
+	: m_Scene(scene)
+{
+}
+
+// ============================================================================
+// FRAME SETUP
+// ============================================================================
+CPURenderer::Frame CPURenderer::SetupFrame(const RenderCamera& camera, const RenderSettings& settings) const
+{
+	Frame frame{ camera, settings, Sampler(settings.SamplerType, uint32_t(settings.SamplesPerPixel), settings.Seed) };
+	
+	// Same matrices the window builds (Camera::UpdateProjection / UpdateView)
+	float aspect = float(settings.Width) / float(settings.Height);
+	frame.InverseProjection = glm::inverse(glm::perspective(glm::radians(camera.VerticalFOV), aspect, 0.1f, 100.0f));
+	frame.InverseView = glm::inverse(glm::lookAt(camera.Position, camera.Position + camera.Forward, camera.Up));
+	frame.Right = glm::vec3(frame.InverseView[0]);
+	frame.Up = glm::vec3(frame.InverseView[1]);
+	
+	frame.MaxBounces = settings.MaxBounces > 0 ? std::min(settings.MaxBounces, 16) : 8;
+	
+	// White noise needs no sampler: the stream's own hash is exactly that
+	frame.UseSampler = settings.SamplerType != Sampler::Type::Random;
+	return frame;
+}
+
+// ============================================================================
+// SAMPLE PIXEL
+// ============================================================================
+// main() in the shader, once per sample in [first, end). Samples are added
+// to sum in index order, so the float result does not depend on how the
+// range was split up between calls.
+// ============================================================================
+void CPURenderer::SamplePixel(const Frame& frame, int x, int y, int first, int end, glm::vec3& sum, float& sumSquare) const
+{
+	const RenderSettings& settings = frame.Settings;
+	const RenderCamera& camera = frame.Camera;
+	const Sampler* lowDiscrepancy = frame.UseSampler ? &frame.SampleSequence : nullptr;
+	
+	// Pixel rows run top-down, gl_FragCoord.y bottom-up
+	int glY = settings.Height - 1 - y;
+	uint32_t pixelIndex = uint32_t(x) + uint32_t(glY) * uint32_t(settings.Width);
+	
+	for (int s = first; s < end; s++)
+	{
+		RandomStream stream(pixelIndex, uint32_t(s), settings.Seed, lowDiscrepancy);
+		MonteCarlo::StreamScope scope(stream);
+		
+		// Anti-aliasing jitter (sub-pixel sampling)
+		glm::vec2 jitter(MonteCarlo::randomFloat() - 0.5f, MonteCarlo::randomFloat() - 0.5f);
+		glm::vec2 uv = (glm::vec2(float(x) + 0.5f, float(glY) + 0.5f) + jitter) / glm::vec2(settings.Width, settings.Height);
+		glm::vec2 ndc = uv * 2.0f - 1.0f;
+		
+		glm::vec4 target = frame.InverseProjection * glm::vec4(ndc, 1.0f, 1.0f);
+		glm::vec3 direction = glm::normalize(glm::vec3(frame.InverseView * glm::vec4(glm::normalize(glm::vec3(target) / target.w), 0.0f)));
+		glm::vec3 origin = camera.Position;
+		
+		// Depth of field
+		if (camera.Aperture > 0.0f)
+		{
+			glm::vec3 focalPoint = origin + direction * camera.FocusDistance;
+			Vec3 disk = MonteCarlo::randomInUnitDisk() * camera.Aperture;
+			origin = origin + frame.Right * disk.x + frame.Up * disk.y;
+			direction = glm::normalize(focalPoint - origin);
+		}
+		
+		glm::vec3 color = TracePath(origin, direction, frame.MaxBounces, stream);
+		
+		// Clamp fireflies
+		float luminance = Luminance(color);
+		if (luminance > 10.0f)
+		{
+			color *= 10.0f / luminance;
+			luminance = 10.0f;
+		}
+		
+		sum += color;
+		sumSquare += luminance * luminance;
+	}
+}
+
+// ============================================================================
+// RENDER REGION
+// ============================================================================
+void CPURenderer::RenderRegion(const RenderCamera& camera, const RenderSettings& settings, const Tile& region,
+                               int firstSample, int endSample, glm::vec3* sums, float* sumSquares,
+                               const std::atomic<bool>* cancel) const
+{
+	int regionWidth = region.X1 - region.X0;
+	int regionHeight = region.Y1 - region.Y0;
+	if (regionWidth <= 0 || regionHeight <= 0 || settings.Width <= 0 || settings.Height <= 0)
+		return;
+	
+	Frame frame = SetupFrame(camera, settings);
+	
+	// Tiles go out centre-first; idle workers steal from busy ones
+	TileScheduler scheduler(regionWidth, regionHeight, settings.TileSize);
+	scheduler.Run(settings.Threads, [&](const Tile& tile, int)
+	{
+		for (int y = tile.Y0; y < tile.Y1; y++)
+		{
+			for (int x = tile.X0; x < tile.X1; x++)
+			{
+				size_t index = size_t(y) * size_t(regionWidth) + size_t(x);
+				SamplePixel(frame, region.X0 + x, region.Y0 + y, firstSample, endSample, sums[index], sumSquares[index]);
+			}
+		}
+	}, cancel);
+}
+
+// ============================================================================
+// RENDER
+// ============================================================================
+Image CPURenderer::Render(const RenderCamera& camera, const RenderSettings& settings,
+                          const std::atomic<bool>* cancel, RenderStats* stats) const
+{
+	auto start = std::chrono::steady_clock::now();
+	auto elapsed = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+	
+	RenderStats result;
+	Image image(settings.Width, settings.Height);
+	if (settings.Width <= 0 || settings.Height <= 0 || settings.SamplesPerPixel <= 0)
+	{
+		if (stats)
+			*stats = result;
+		return image;
+	}
+	
+	// Fixed mode is a single pass of SamplesPerPixel
+	bool progressive = settings.TimeBudget > 0.0 || settings.NoiseTarget > 0.0f;
+	int passSamples = progressive ? std::max(settings.PassSamples, 1) : settings.SamplesPerPixel;
+	
+	// Sums carry over between passes
+	std::vector<glm::vec3>& sums = image.Pixels;
+	std::vector<float> sumSquares(sums.size(), 0.0f);
+	std::vector<float> counts;
+	Tile wholeImage{ 0, 0, settings.Width, settings.Height, 0 };
+	
+	int samples = 0;
+	while (true)
+	{
+		double passStart = elapsed();
+		int first = samples;
+		int end = std::min(first + passSamples, settings.SamplesPerPixel);
+		
+		RenderRegion(camera, settings, wholeImage, first, end, sums.data(), sumSquares.data(), cancel);
+		
+		samples = end;
+		result.Passes++;
+		
+		if (cancel && cancel->load())
+		{
+			result.Reason = RenderStats::StopReason::Cancelled;
+			break;
+		}
+		if (samples >= settings.SamplesPerPixel)
+		{
+			result.Reason = RenderStats::StopReason::SampleLimit;
+			break;
+		}
+		
+		// Only progressive mode gets here
+		if (settings.NoiseTarget > 0.0f && samples >= RenderStats::NOISE_MIN_SAMPLES)
+		{
+			counts.assign(sums.size(), float(samples));
+			result.NoiseError = EstimateNoise(sums, sumSquares, counts);
+			if (result.NoiseError <= settings.NoiseTarget)
+			{
+				result.Reason = RenderStats::StopReason::NoiseTarget;
+				break;
+			}
+		}
+		
+		// Stop early rather than overrun: the next pass will take about as
+		// long as this one
+		double now = elapsed();
+		if (settings.TimeBudget > 0.0 && now + (now - passStart) > settings.TimeBudget)
+		{
+			result.Reason = RenderStats::StopReason::TimeBudget;
+			break;
+		}
+	}
+	
+	if (result.Reason != RenderStats::StopReason::NoiseTarget)
+	{
+		counts.assign(sums.size(), float(samples));
+		result.NoiseError = EstimateNoise(sums, sumSquares, counts);
+	}
+	
+	float invSamples = 1.0f / float(samples);
+	for (glm::vec3& pixel : image.Pixels)
+		pixel *= invSamples;
+	
+	result.SamplesPerPixel = samples;
+	result.Seconds = elapsed();
+	if (stats)
+		*stats = result;
+	
+	return image;
+}
+
+// ============================================================================
+// TRACE PATH
+// ============================================================================
+glm::vec3 CPURenderer::TracePath(glm::vec3 origin, glm::vec3 direction, int maxBounces, RandomStream& stream) const
+{
+	MonteCarlo::StreamScope scope(stream);
+	
+	glm::vec3 radiance(0.0f);   // Accumulated color (I)
+	glm::vec3 throughput(1.0f); // Path throughput (product of BRDFs)
+	
+	for (int bounce = 0; bounce < maxBounces; bounce++)
+	{
+		stream.setBounce(uint32_t(bounce) + 1);
+		
+		SceneHit hit;
+		if (!m_Scene.Intersect(origin, direction, hit))
+		{
+			radiance += throughput * m_Scene.SampleEnvironment(direction);
+			break;
+		}
+		
+		const Material& material = m_Scene.GetMaterial(hit);
+		
+		// Direct lighting: emissive surfaces act as lights
+		radiance += throughput * material.Emission * material.EmissionStrength;
+		
+		// Russian roulette (after a few bounces)
+		if (bounce > 3)
+		{
+			float p = std::max(std::max(throughput.r, throughput.g), throughput.b);
+			if (MonteCarlo::randomFloat() > p)
+				break;
+			throughput /= p;
+		}
+		
+		glm::vec3 V = -direction;
+		glm::vec3 N = hit.Normal;
+		
+		if (material.Transmission > 0.0f)
+		{
+			// TRANSMITTED ray, reflected with the Schlick Fresnel probability
+			float eta = hit.FrontFace ? (1.0f / material.IOR) : material.IOR;
+			glm::vec3 refracted = Refract(direction, N, eta);
+			
+			float cosTheta = std::min(glm::dot(V, N), 1.0f);
+			float r0 = (1.0f - eta) / (1.0f + eta);
+			r0 = r0 * r0;
+			float fresnel = r0 + (1.0f - r0) * std::pow(1.0f - cosTheta, 5.0f);
+			
+			if (glm::length(refracted) < 0.001f || MonteCarlo::randomFloat() < fresnel)
+			{
+				direction = Reflect(direction, N);
+			}
+			else
+			{
+				direction = refracted;
+				throughput *= material.Albedo;
+			}
+			origin = hit.Position + direction * SCENE_EPSILON * 10.0f;
+		}
+		else
+		{
+			// DIFFUSE or SPECULAR ray
+			glm::vec3 brdfThroughput;
+			direction = BRDF::Sample(V, N, material, brdfThroughput);
+			throughput *= brdfThroughput;
+			
+			origin = hit.Position + N * SCENE_EPSILON;
+		}
+		
+		if (!IsFinite(throughput))
+			break;
+	}
+	
+	return radiance;
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "CPUScene.h"
+#include "Image.h"
+#include "TileScheduler.h"
+#include "Math/RandomStream.h"
+
+// ============================================================================
+// CPU RENDERER - Headless Multi-threaded Reference Path Tracer
+// ============================================================================
+//
+// A CPU port of PathTrace.glsl: same camera model, same scenes (CPUScene),
+// same material model (BRDF::Sample) and the same path loop (emission,
+// Russian roulette, Fresnel-weighted transmission, firefly clamp).
+//
+// REPRODUCIBILITY:
+// ----------------
+// Every sample draws from a counter-based RandomStream keyed by pixel index,
+// sample index and RenderSettings::Seed, re-keyed per bounce. The first
+// draws of each bounce come from the low-discrepancy Sampler selected by
+// RenderSettings::SamplerType (Owen-scrambled Sobol by default). The output
+// therefore depends only on scene, camera and settings - never on thread
+// count, scheduling or the order samples are taken in - and two runs with
+// the same arguments are bit-identical.
+//
+// PARALLELISM:
+// ------------
+// The image is cut into TileSize² tiles and handed out by a TileScheduler
+// (centre-out order, per-worker deques, work stealing). Setting the cancel
+// flag passed to Render stops it within one tile time.
+//
+// PROGRESSIVE MODE:
+// -----------------
+// With a TimeBudget or NoiseTarget set, samples are taken in passes of
+// PassSamples over the whole image, and rendering stops at the first pass
+// boundary where the noise estimate is below the target, the next pass
+// would overrun the budget, or SamplesPerPixel (now the upper limit) is
+// reached. Samples are added in the same order either way, so a render
+// that stops at N spp is bit-identical to a fixed N spp render.
+//
+// USAGE EXAMPLE:
+// --------------
+//   CPUScene scene;
+//   scene.LoadProcedural(0);
+//
+//   RenderSettings settings;
+//   settings.SamplesPerPixel = 256;
+//
+//   CPURenderer renderer(scene);
+//   Image image = renderer.Render(RenderCamera{}, settings);
+//   image.Write("out.pfm");
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// RenderCamera
+// ----------------------------------------------------------------------------
+// Pinhole / thin lens camera, defaults match Camera in Main.cpp.
+// ----------------------------------------------------------------------------
+struct RenderCamera
+{
+	glm::vec3 Position = glm::vec3(0.0f, 0.0f, 8.0f);
+	glm::vec3 Forward = glm::vec3(0.0f, 0.0f, -1.0f);
+	glm::vec3 Up = glm::vec3(0.0f, 1.0f, 0.0f);
+	
+	float VerticalFOV = 60.0f;
+	float FocusDistance = 8.0f;
+	float Aperture = 0.0f;  // 0 = no DOF
+};
+
+// ----------------------------------------------------------------------------
+// RenderSettings
+// ----------------------------------------------------------------------------
+struct RenderSettings
+{
+	int Width = 1080;
+	int Height = 600;
+	int SamplesPerPixel = 64;
+	int MaxBounces = 16;        // uBounces (16 is the shader loop limit)
+	int Threads = 0;            // 0 = all hardware threads
+	uint32_t Seed = 0;
+	int TileSize = 32;
+	Sampler::Type SamplerType = Sampler::Type::Sobol;
+	
+	// Progressive mode (either one enables it; SamplesPerPixel is the cap)
+	double TimeBudget = 0.0;    // Wall-clock seconds, 0 = no limit
+	float NoiseTarget = 0.0f;   // Relative standard error, 0 = no target
+	int PassSamples = 4;        // Samples per pixel per pass
+};
+
+// ----------------------------------------------------------------------------
+// RenderStats
+// ----------------------------------------------------------------------------
+// What a render achieved. NoiseError is the relative standard error of the
+// mean luminance, sqrt(Var / n) / (mean + 0.01), at the 99th percentile of
+// all pixels (the remaining 1% are mostly firefly-prone caustics that would
+// otherwise hold up the whole image). It needs at least 2 spp, else 0.
+// ----------------------------------------------------------------------------
+struct RenderStats
+{
+	enum class StopReason
+	{
+		SampleLimit,    // SamplesPerPixel reached (always the case in fixed mode)
+		NoiseTarget,
+		TimeBudget,
+		Cancelled
+	};
+	
+	static constexpr int NOISE_MIN_SAMPLES = 16;   // Fewer give too rough a variance to stop on
+	
+	int SamplesPerPixel = 0;
+	int Passes = 0;
+	double Seconds = 0.0;
+	float NoiseError = 0.0f;
+	StopReason Reason = StopReason::SampleLimit;
+	
+	static const char* ReasonName(StopReason reason);
+};
+
+// ============================================================================
+// CPU RENDERER CLASS
+// ============================================================================
+class CPURenderer
+{
+public:
+	explicit CPURenderer(const CPUScene& scene);
+	
+	// ========================================================================
+	// Render
+	// ========================================================================
+	// Renders the scene from camera with SamplesPerPixel samples per pixel
+	// (or fewer, in progressive mode) and returns the linear radiance
+	// average (row 0 at the top). stats, if given, receives the achieved
+	// sample count, time and noise estimate.
+	//
+	// If cancel is set (from any thread) during the render, the remaining
+	// tiles are skipped and the image is incomplete; the caller can tell by
+	// the flag or stats->Reason.
+	// ========================================================================
+	Image Render(const RenderCamera& camera, const RenderSettings& settings,
+	             const std::atomic<bool>* cancel = nullptr, RenderStats* stats = nullptr) const;
+	
+	// ========================================================================
+	// RenderRegion
+	// ========================================================================
+	// Adds samples [firstSample, endSample) of every pixel in region (image
+	// coordinates) to sums and sumSquares (squared clamped luminance), both
+	// row-major over the region. The region is cut into TileSize² tiles for
+	// settings.Threads workers. Render runs this over the whole image once
+	// per pass; a distributed worker runs it once per job.
+	// ========================================================================
+	void RenderRegion(const RenderCamera& camera, const RenderSettings& settings, const Tile& region,
+	                  int firstSample, int endSample, glm::vec3* sums, float* sumSquares,
+	                  const std::atomic<bool>* cancel = nullptr) const;
+	
+	// ========================================================================
+	// TracePath
+	// ========================================================================
+	// Radiance along one camera path (pathTrace in the shader), before the
+	// firefly clamp. Bounce b draws from stream.setBounce(b + 1); bounce 0 of
+	// the stream is left to the camera (jitter, lens).
+	// ========================================================================
+	glm::vec3 TracePath(glm::vec3 origin, glm::vec3 direction, int maxBounces, RandomStream& stream) const;
+
+private:
+	// Per-render constants shared by all pixels
+	struct Frame
+	{
+		const RenderCamera& Camera;
+		const RenderSettings& Settings;
+		Sampler SampleSequence;
+		bool UseSampler = false;
+		glm::mat4 InverseProjection = glm::mat4(1.0f);
+		glm::mat4 InverseView = glm::mat4(1.0f);
+		glm::vec3 Right = glm::vec3(1.0f, 0.0f, 0.0f);
+		glm::vec3 Up = glm::vec3(0.0f, 1.0f, 0.0f);
+		int MaxBounces = 8;
+	};
+	
+	Frame SetupFrame(const RenderCamera& camera, const RenderSettings& settings) const;
+	void SamplePixel(const Frame& frame, int x, int y, int first, int end, glm::vec3& sum, float& sumSquare) const;
+	
+	const CPUScene& m_Scene;
+};
+
+// ============================================================================
+// Noise estimate
+// ============================================================================
+// RelativeNoise: relative standard error of one pixel's mean luminance,
+// given its mean luminance, mean squared luminance and sample count (huge
+// below 2 samples). Accumulate.glsl computes the same per pixel in the
+// window.
+//
+// NoiseQuantile: RenderStats::NoiseError of an image from those per-pixel
+// errors (reorders them).
+//
+// EstimateNoise: the same from per-pixel color sums, squared-luminance sums
+// and sample counts. Pixels with fewer than 2 samples are left out.
+// ============================================================================
+float RelativeNoise(float meanLuminance, float meanSquare, float samples);
+float NoiseQuantile(std::vector<float>& errors);
+float EstimateNoise(const std::vector<glm::vec3>& sums, const std::vector<float>& sumSquares, const std::vector<float>& counts);
\ No newline at end of file
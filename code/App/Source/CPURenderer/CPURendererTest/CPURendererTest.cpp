@@ -0,0 +1,932 @@
+// ============================================================================
+// CPU RENDERER TEST SUITE - Tests for the Headless Renderer
+// ============================================================================
+//
+// This test suite verifies the CPU reference renderer and the parts it is
+// built from:
+//   - Tile scheduling (coverage, work stealing, cancellation)
+//   - Reproducibility (thread count and tile size do not change the image)
+//   - Progressive mode (stopping on the noise target)
+//   - Low-discrepancy samplers (known values, stratification, GPU table)
+//   - Monte Carlo mappings (batch equals scalar, batch speed)
+//   - Distributed rendering (local worker processes, failing workers)
+//   - Scene queries (CSG groups: closest hit and occlusion)
+//
+// Build and run:
+//   ./test.sh
+//
+// ============================================================================
+
+#include "CPURenderer/CPURenderer.h"
+#include "CPURenderer/CPUScene.h"
+#include "CPURenderer/DistributedRender.h"
+#include "CPURenderer/TileScheduler.h"
+#include "Math/MonteCarlo.h"
+#include "Math/Sampler.h"
+#include "Quadric/QuadricCSG.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// ============================================================================
+// TEST FRAMEWORK
+// ============================================================================
+
+namespace TestFramework
+{
+	// Test result tracking
+	static int s_TestsPassed = 0;
+	static int s_TestsFailed = 0;
+	static int s_AssertionsPassed = 0;
+	static int s_AssertionsFailed = 0;
+	static std::string s_CurrentTestName;
+	static bool s_CurrentTestPassed = true;
+	
+	// ANSI color codes
+	constexpr const char* COLOR_GREEN = "\033[32m";
+	constexpr const char* COLOR_RED = "\033[31m";
+	constexpr const char* COLOR_YELLOW = "\033[33m";
+	constexpr const char* COLOR_CYAN = "\033[36m";
+	constexpr const char* COLOR_RESET = "\033[0m";
+	constexpr const char* COLOR_BOLD = "\033[1m";
+	
+	// ----------------------------------------------------------------------------
+	// Assertion Helpers
+	// ----------------------------------------------------------------------------
+	
+	void AssertTrue(bool condition, const std::string& message)
+	{
+		if (condition)
+		{
+			s_AssertionsPassed++;
+		}
+		else
+		{
+			s_AssertionsFailed++;
+			s_CurrentTestPassed = false;
+			std::cerr << "    " << COLOR_RED << "✗ ASSERT FAILED: " << message << COLOR_RESET << std::endl;
+		}
+	}
+	
+	template<typename T>
+	void AssertEqual(T expected, T actual, const std::string& message)
+	{
+		if (expected == actual)
+		{
+			s_AssertionsPassed++;
+		}
+		else
+		{
+			s_AssertionsFailed++;
+			s_CurrentTestPassed = false;
+			std::cerr << "    " << COLOR_RED << "✗ ASSERT FAILED: " << message
+			          << " (expected " << expected << ", got " << actual << ")" << COLOR_RESET << std::endl;
+		}
+	}
+	
+	void AssertFloatNear(double expected, double actual, double tolerance, const std::string& message)
+	{
+		if (std::abs(expected - actual) <= tolerance)
+		{
+			s_AssertionsPassed++;
+		}
+		else
+		{
+			s_AssertionsFailed++;
+			s_CurrentTestPassed = false;
+			std::cerr << "    " << COLOR_RED << "✗ ASSERT FAILED: " << message
+			          << " (expected " << std::setprecision(9) << expected
+			          << ", got " << actual << ")" << COLOR_RESET << std::endl;
+		}
+	}
+	
+	// ----------------------------------------------------------------------------
+	// Test Runner
+	// ----------------------------------------------------------------------------
+	
+	void BeginTest(const std::string& testName)
+	{
+		s_CurrentTestName = testName;
+		s_CurrentTestPassed = true;
+		std::cout << "  " << COLOR_CYAN << "▶ " << testName << COLOR_RESET << std::endl;
+	}
+	
+	void EndTest()
+	{
+		if (s_CurrentTestPassed)
+		{
+			s_TestsPassed++;
+			std::cout << "    " << COLOR_GREEN << "✓ PASSED" << COLOR_RESET << std::endl;
+		}
+		else
+		{
+			s_TestsFailed++;
+			std::cout << "    " << COLOR_RED << "✗ FAILED" << COLOR_RESET << std::endl;
+		}
+	}
+	
+	// Informational line under the current test (timings)
+	void PrintInfo(const std::string& info)
+	{
+		std::cout << "    " << info << std::endl;
+	}
+	
+	void PrintSectionHeader(const std::string& section)
+	{
+		std::cout << std::endl;
+		std::cout << COLOR_BOLD << COLOR_YELLOW << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << COLOR_RESET << std::endl;
+		std::cout << COLOR_BOLD << COLOR_YELLOW << " " << section << COLOR_RESET << std::endl;
+		std::cout << COLOR_BOLD << COLOR_YELLOW << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << COLOR_RESET << std::endl;
+	}
+	
+	void PrintSummary()
+	{
+		std::cout << std::endl;
+		std::cout << COLOR_BOLD << "════════════════════════════════════════" << COLOR_RESET << std::endl;
+		std::cout << COLOR_BOLD << " TEST SUMMARY" << COLOR_RESET << std::endl;
+		std::cout << "════════════════════════════════════════" << std::endl;
+		
+		std::cout << "  Tests:      " << COLOR_GREEN << s_TestsPassed << " passed" << COLOR_RESET;
+		if (s_TestsFailed > 0)
+			std::cout << ", " << COLOR_RED << s_TestsFailed << " failed" << COLOR_RESET;
+		std::cout << std::endl;
+		
+		std::cout << "  Assertions: " << COLOR_GREEN << s_AssertionsPassed << " passed" << COLOR_RESET;
+		if (s_AssertionsFailed > 0)
+			std::cout << ", " << COLOR_RED << s_AssertionsFailed << " failed" << COLOR_RESET;
+		std::cout << std::endl;
+		
+		std::cout << "════════════════════════════════════════" << std::endl;
+		
+		if (s_TestsFailed == 0)
+		{
+			std::cout << COLOR_GREEN << COLOR_BOLD << "  ✓ ALL TESTS PASSED!" << COLOR_RESET << std::endl;
+		}
+		else
+		{
+			std::cout << COLOR_RED << COLOR_BOLD << "  ✗ SOME TESTS FAILED" << COLOR_RESET << std::endl;
+		}
+		
+		std::cout << "════════════════════════════════════════" << std::endl;
+	}
+	
+	int GetExitCode()
+	{
+		return s_TestsFailed > 0 ? 1 : 0;
+	}
+}
+
+using namespace TestFramework;
+
+// ============================================================================
+// TEST SUITE 1: TILE SCHEDULER
+// ============================================================================
+
+void TestTileCoverage()
+{
+	BeginTest("Every tile and pixel is rendered exactly once");
+	
+	// Odd sizes leave partial tiles on the right and bottom edges
+	const int width = 203, height = 117, tileSize = 16;
+	
+	for (int threads : { 1, 3, 8 })
+	{
+		TileScheduler scheduler(width, height, tileSize);
+		const std::vector<Tile>& tiles = scheduler.GetTiles();
+		
+		std::vector<std::atomic<int>> tileRuns(tiles.size());
+		std::vector<std::atomic<int>> pixelRuns(size_t(width) * height);
+		std::atomic<bool> badWorker{ false };
+		
+		bool finished = scheduler.Run(threads, [&](const Tile& tile, int worker)
+		{
+			if (worker < 0 || worker >= threads)
+				badWorker = true;
+			tileRuns[tile.Index]++;
+			for (int y = tile.Y0; y < tile.Y1; y++)
+				for (int x = tile.X0; x < tile.X1; x++)
+					pixelRuns[size_t(y) * width + x]++;
+		});
+		
+		std::string label = std::to_string(threads) + " threads: ";
+		bool tilesOnce = true, pixelsOnce = true;
+		for (const std::atomic<int>& runs : tileRuns)
+			tilesOnce = tilesOnce && runs.load() == 1;
+		for (const std::atomic<int>& runs : pixelRuns)
+			pixelsOnce = pixelsOnce && runs.load() == 1;
+		
+		AssertTrue(finished, label + "Run reports completion");
+		AssertEqual(size_t(13 * 8), tiles.size(), label + "tile count");
+		AssertTrue(tilesOnce, label + "each tile taken exactly once");
+		AssertTrue(pixelsOnce, label + "each pixel covered exactly once");
+		AssertTrue(!badWorker, label + "worker indices in range");
+	}
+	
+	// Centre-out order: the first tile holds the image centre
+	TileScheduler scheduler(width, height, tileSize);
+	const Tile& first = scheduler.GetTiles().front();
+	AssertTrue(first.X0 <= width / 2 && width / 2 < first.X1 && first.Y0 <= height / 2 && height / 2 < first.Y1,
+	           "First tile contains the image centre");
+	
+	EndTest();
+}
+
+void TestTileStealing()
+{
+	BeginTest("Idle workers steal tiles from a slow worker");
+	
+	// Worker 0's tiles are slow, so the others run dry and take from its
+	// deque; without stealing worker 0 would render a quarter of the image
+	TileScheduler scheduler(256, 256, 16);
+	std::vector<std::atomic<int>> tileRuns(scheduler.GetTiles().size());
+	std::atomic<int> workerZeroTiles{ 0 };
+	
+	bool finished = scheduler.Run(4, [&](const Tile& tile, int worker)
+	{
+		tileRuns[tile.Index]++;
+		if (worker == 0)
+		{
+			workerZeroTiles++;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+	});
+	
+	bool tilesOnce = true;
+	for (const std::atomic<int>& runs : tileRuns)
+		tilesOnce = tilesOnce && runs.load() == 1;
+	
+	AssertTrue(finished, "Run reports completion");
+	AssertTrue(tilesOnce, "Each tile taken exactly once while stealing");
+	AssertTrue(scheduler.GetStolenCount() > 0, "Some tiles were stolen");
+	AssertTrue(workerZeroTiles.load() < 256 / 4, "Slow worker rendered less than its share");
+	PrintInfo("Stolen: " + std::to_string(scheduler.GetStolenCount()) +
+	          " | slow worker: " + std::to_string(workerZeroTiles.load()) + " of 256 tiles");
+	
+	EndTest();
+}
+
+void TestTileCancellation()
+{
+	BeginTest("Cancel stops the run within one tile time");
+	
+	// 1024 tiles of 5 ms each would take over a second on four threads
+	TileScheduler scheduler(512, 512, 16);
+	std::atomic<bool> cancel{ false };
+	std::atomic<int> rendered{ 0 };
+	const auto tileTime = std::chrono::milliseconds(5);
+	
+	std::thread canceller([&cancel]
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(30));
+		cancel = true;
+	});
+	
+	auto start = std::chrono::steady_clock::now();
+	bool finished = scheduler.Run(4, [&](const Tile&, int)
+	{
+		std::this_thread::sleep_for(tileTime);
+		rendered++;
+	}, &cancel);
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	canceller.join();
+	
+	AssertTrue(!finished, "Run reports cancellation");
+	AssertTrue(rendered.load() < int(scheduler.GetTiles().size()), "Remaining tiles were skipped");
+	
+	// 30 ms until the flag, one tile in flight per worker, plus generous
+	// slack for a loaded machine
+	AssertTrue(ms < 250.0, "Run returned promptly after cancel");
+	
+	std::ostringstream info;
+	info << std::fixed << std::setprecision(1) << "Returned after " << ms << " ms, "
+	     << rendered.load() << " of " << scheduler.GetTiles().size() << " tiles rendered";
+	PrintInfo(info.str());
+	
+	// A flag that is already set renders nothing
+	rendered = 0;
+	bool ranCancelled = scheduler.Run(4, [&](const Tile&, int) { rendered++; }, &cancel);
+	AssertTrue(!ranCancelled && rendered.load() == 0, "Pre-set cancel flag renders no tile");
+	
+	EndTest();
+}
+
+// ============================================================================
+// TEST SUITE 2: REPRODUCIBILITY
+// ============================================================================
+
+// Small, cheap frame; callers override what they test
+RenderSettings SmallFrameSettings()
+{
+	RenderSettings settings;
+	settings.Width = 64;
+	settings.Height = 48;
+	settings.SamplesPerPixel = 8;
+	settings.MaxBounces = 6;
+	settings.Seed = 7;
+	return settings;
+}
+
+// Number of pixels whose float bits differ between two images
+size_t CountDifferingPixels(const Image& a, const Image& b)
+{
+	if (a.Width != b.Width || a.Height != b.Height)
+		return a.Pixels.size() + b.Pixels.size();
+	
+	size_t differing = 0;
+	for (size_t i = 0; i < a.Pixels.size(); i++)
+		if (std::memcmp(&a.Pixels[i], &b.Pixels[i], sizeof(glm::vec3)) != 0)
+			differing++;
+	return differing;
+}
+
+void TestThreadCountDeterminism()
+{
+	BeginTest("1 and N threads render bit-identical frames");
+	
+	CPUScene scene;
+	scene.LoadProcedural(0);
+	scene.AddDefaultQuadrics();
+	CPURenderer renderer(scene);
+	
+	RenderSettings settings = SmallFrameSettings();
+	settings.Threads = 1;
+	Image reference = renderer.Render(RenderCamera{}, settings);
+	
+	// Different thread counts and tile sizes change which worker takes which
+	// pixel and in what order, never the samples a pixel receives
+	struct Variant { int Threads; int TileSize; };
+	for (Variant variant : { Variant{ 4, 32 }, Variant{ 3, 8 }, Variant{ 8, 5 } })
+	{
+		settings.Threads = variant.Threads;
+		settings.TileSize = variant.TileSize;
+		Image image = renderer.Render(RenderCamera{}, settings);
+		
+		AssertEqual(size_t(0), CountDifferingPixels(reference, image),
+		            std::to_string(variant.Threads) + " threads, tile " + std::to_string(variant.TileSize) +
+		            ": pixels differing from 1 thread");
+	}
+	
+	// Guard against a trivially identical (black) frame
+	bool anyLight = false;
+	for (const glm::vec3& pixel : reference.Pixels)
+		anyLight = anyLight || pixel.x + pixel.y + pixel.z > 0.0f;
+	AssertTrue(anyLight, "Reference frame is not black");
+	
+	EndTest();
+}
+
+void TestNoiseTargetStop()
+{
+	BeginTest("Progressive render stops on a loose noise target");
+	
+	CPUScene scene;
+	scene.LoadProcedural(1);
+	CPURenderer renderer(scene);
+	
+	RenderSettings settings = SmallFrameSettings();
+	settings.Threads = 2;
+	settings.SamplesPerPixel = 1024;    // Cap, far above what the target needs
+	settings.NoiseTarget = 0.75f;       // Reached at about 64 spp on this frame
+	settings.PassSamples = 4;
+	
+	RenderStats stats;
+	Image progressive = renderer.Render(RenderCamera{}, settings, nullptr, &stats);
+	
+	AssertTrue(stats.Reason == RenderStats::StopReason::NoiseTarget,
+	           std::string("Stopped on the noise target (reason: ") + RenderStats::ReasonName(stats.Reason) + ")");
+	AssertTrue(stats.SamplesPerPixel < settings.SamplesPerPixel, "Stopped below the sample cap");
+	AssertTrue(stats.SamplesPerPixel >= RenderStats::NOISE_MIN_SAMPLES, "Took at least NOISE_MIN_SAMPLES");
+	AssertEqual(0, stats.SamplesPerPixel % settings.PassSamples, "Stopped on a pass boundary");
+	AssertTrue(stats.NoiseError > 0.0f && stats.NoiseError <= settings.NoiseTarget, "Noise estimate meets the target");
+	PrintInfo("Stopped at " + std::to_string(stats.SamplesPerPixel) + " spp, noise " +
+	          std::to_string(stats.NoiseError));
+	
+	// Samples are added in the same order either way, so stopping at N spp
+	// gives the fixed N spp image
+	RenderSettings fixed = SmallFrameSettings();
+	fixed.Threads = 2;
+	fixed.SamplesPerPixel = stats.SamplesPerPixel;
+	Image reference = renderer.Render(RenderCamera{}, fixed);
+	AssertEqual(size_t(0), CountDifferingPixels(reference, progressive), "Pixels differing from a fixed-spp render");
+	
+	EndTest();
+}
+
+// ============================================================================
+// TEST SUITE 3: SAMPLERS
+// ============================================================================
+
+// True if the values fall one into each of `strata` equal intervals of [0, 1)
+bool OneInEachStratum(const std::vector<float>& values, uint32_t strata)
+{
+	std::vector<int> hits(strata, 0);
+	for (float value : values)
+	{
+		if (value < 0.0f || value >= 1.0f)
+			return false;
+		hits[std::min(uint32_t(value * float(strata)), strata - 1)]++;
+	}
+	for (int count : hits)
+		if (count != 1)
+			return false;
+	return true;
+}
+
+// Dimension of samples [0, count) of one pixel
+std::vector<float> SamplerColumn(const Sampler& sampler, uint32_t pixel, uint32_t dimension, uint32_t count)
+{
+	std::vector<float> values(count);
+	for (uint32_t i = 0; i < count; i++)
+		values[i] = sampler.get(pixel, i, dimension);
+	return values;
+}
+
+void TestSamplerKnownValues()
+{
+	BeginTest("First points of Sobol, Halton and stratified match known values");
+	
+	// Pixel 0, seed 0, 16 spp: samples 0-3, dimensions 0 and 1. Any change
+	// to hashing or scrambling moves these, and with them every reference
+	// image rendered so far.
+	struct Known { Sampler::Type Type; float Values[4][2]; };
+	const Known known[] =
+	{
+		{ Sampler::Type::Sobol,      { { 0.808514833f, 0.164556801f }, { 0.122656107f, 0.532924891f },
+		                               { 0.298000216f, 0.315455854f }, { 0.735765576f, 0.908546805f } } },
+		{ Sampler::Type::Halton,     { { 0.948533535f, 0.972519636f }, { 0.0261806697f, 0.131800234f },
+		                               { 0.547539115f, 0.568110108f }, { 0.327285439f, 0.779871702f } } },
+		{ Sampler::Type::Stratified, { { 0.322200656f, 0.411209106f }, { 0.0764218569f, 0.620427012f },
+		                               { 0.30395925f, 0.984435856f }, { 0.634519517f, 0.357135952f } } }
+	};
+	
+	for (const Known& entry : known)
+	{
+		Sampler sampler(entry.Type, 16, 0);
+		for (uint32_t i = 0; i < 4; i++)
+			for (uint32_t d = 0; d < 2; d++)
+				AssertFloatNear(entry.Values[i][d], sampler.get(0, i, d), 1e-7,
+				                std::string(Sampler::typeName(entry.Type)) + " sample " + std::to_string(i) +
+				                ", dimension " + std::to_string(d));
+	}
+	
+	// Scrambling keeps the structure of the unscrambled sequences, for
+	// every pixel: the first 2^k Sobol points put one point in each 1/2^k,
+	// the first b^k Halton points one in each 1/b^k of base b, and the
+	// first samplesPerPixel stratified points one in each stratum
+	bool sobolStratified = true, haltonStratified = true, stratifiedStratified = true;
+	Sampler sobol(Sampler::Type::Sobol, 64, 3);
+	Sampler halton(Sampler::Type::Halton, 64, 3);
+	Sampler stratified(Sampler::Type::Stratified, 24, 3);
+	const uint32_t haltonBases[] = { 2, 3, 5, 7 };
+	
+	for (uint32_t pixel : { 0u, 1u, 4097u })
+	{
+		for (uint32_t d = 0; d < 2 * Sampler::DIMENSIONS_PER_BOUNCE; d++)
+		{
+			for (uint32_t count = 2; count <= 64; count *= 2)
+				sobolStratified = sobolStratified && OneInEachStratum(SamplerColumn(sobol, pixel, d, count), count);
+			stratifiedStratified = stratifiedStratified &&
+				OneInEachStratum(SamplerColumn(stratified, pixel, d, 24), 24);
+		}
+		for (uint32_t d = 0; d < 4; d++)
+		{
+			uint32_t base = haltonBases[d];
+			for (uint32_t count = base; count <= 125; count *= base)
+				haltonStratified = haltonStratified && OneInEachStratum(SamplerColumn(halton, pixel, d, count), count);
+		}
+	}
+	
+	AssertTrue(sobolStratified, "Sobol: first 2^k points one per 1/2^k interval");
+	AssertTrue(haltonStratified, "Halton: first b^k points one per 1/b^k interval");
+	AssertTrue(stratifiedStratified, "Stratified: first samplesPerPixel points one per stratum");
+	
+	EndTest();
+}
+
+void TestSamplerTableLayout()
+{
+	BeginTest("Shader table has the uploaded size and matches the CPU sampler");
+	
+	// Main.cpp uploads TABLE_SAMPLES rows of TABLE_DIMENSIONS / 4 RGBA32F
+	// texels; PathTrace.glsl reads dimension d of sample i as component
+	// d % 4 of texel (d / 4, i)
+	const uint32_t samples = Sampler::TABLE_SAMPLES;
+	const uint32_t dimensions = Sampler::TABLE_DIMENSIONS;
+	const uint32_t texelsPerRow = dimensions / 4;
+	
+	AssertEqual(1024u, samples, "Table rows");
+	AssertEqual(136u, dimensions, "Table dimensions (camera + 16 bounces, 8 each)");
+	AssertEqual(34u, texelsPerRow, "RGBA texels per row");
+	
+	for (Sampler::Type type : { Sampler::Type::Stratified, Sampler::Type::Halton, Sampler::Type::Sobol })
+	{
+		std::string name = Sampler::typeName(type);
+		Sampler sampler(type, samples);
+		std::vector<float> table = sampler.buildTable(samples, dimensions);
+		
+		AssertEqual(size_t(samples) * texelsPerRow * 4, table.size(), name + ": table size");
+		if (table.size() != size_t(samples) * dimensions)
+			continue;
+		
+		bool matchesCPU = true, inRange = true, onGrid = true;
+		for (uint32_t i = 0; i < samples; i++)
+		{
+			for (uint32_t d = 0; d < dimensions; d++)
+			{
+				// Offset of component d % 4 of texel (d / 4, i)
+				float value = table[(size_t(i) * texelsPerRow + d / 4) * 4 + d % 4];
+				float scaled = value * 16777216.0f;
+				
+				matchesCPU = matchesCPU && value == sampler.get(0, i, d);
+				inRange = inRange && value >= 0.0f && value < 1.0f;
+				onGrid = onGrid && (type != Sampler::Type::Sobol || scaled == std::floor(scaled));
+			}
+		}
+		
+		AssertTrue(matchesCPU, name + ": texel (d / 4, i)[d % 4] equals Sampler::get(0, i, d)");
+		AssertTrue(inRange, name + ": values in [0, 1)");
+		AssertTrue(onGrid, name + ": Sobol values are multiples of 2^-24 (shader XOR shift)");
+	}
+	
+	EndTest();
+}
+
+// ============================================================================
+// TEST SUITE 4: MONTE CARLO MAPPINGS
+// ============================================================================
+
+// Unit normals covering both hemispheres, plus the -z pole where the
+// orthonormal basis switches branch
+std::vector<Vec3> TestNormals(int count)
+{
+	std::mt19937 generator(1234);
+	std::normal_distribution<float> gaussian;
+	std::vector<Vec3> normals(count);
+	for (int i = 0; i < count; i++)
+		normals[i] = Vec3(gaussian(generator), gaussian(generator), gaussian(generator)).normalized();
+	normals[0] = Vec3(0.0f, 0.0f, -1.0f);
+	normals[1] = Vec3(0.0f, 0.0f, 1.0f);
+	return normals;
+}
+
+void TestMonteCarloBatchMatchesScalar()
+{
+	BeginTest("Batch samplers equal the scalar closed forms");
+	
+	// Not a multiple of the 64-sample block or of any SIMD width, so the
+	// padded tail lanes are exercised
+	const int count = 1000 + 3;
+	
+	// With FMA contraction the lane and scalar code may round differently
+	const float tolerance = 3e-5f;
+	
+	std::vector<float> bx(count), by(count), bz(count);
+	float maxError = 0.0f;
+	bool inDomain = true;
+	
+	// Unit disk
+	MonteCarlo::setSeed(99);
+	MonteCarlo::randomInUnitDisk(bx.data(), by.data(), count);
+	MonteCarlo::setSeed(99);
+	for (int i = 0; i < count; i++)
+	{
+		Vec3 p = MonteCarlo::randomInUnitDisk();
+		maxError = std::max({ maxError, std::abs(p.x - bx[i]), std::abs(p.y - by[i]) });
+		inDomain = inDomain && p.x * p.x + p.y * p.y <= 1.0f + 1e-6f;
+	}
+	AssertTrue(maxError <= tolerance, "Unit disk: batch equals scalar (max error " + std::to_string(maxError) + ")");
+	AssertTrue(inDomain, "Unit disk: samples inside the disk");
+	
+	// Unit ball
+	maxError = 0.0f;
+	MonteCarlo::setSeed(99);
+	MonteCarlo::randomInUnitSphere(bx.data(), by.data(), bz.data(), count);
+	MonteCarlo::setSeed(99);
+	for (int i = 0; i < count; i++)
+	{
+		Vec3 p = MonteCarlo::randomInUnitSphere();
+		maxError = std::max({ maxError, std::abs(p.x - bx[i]), std::abs(p.y - by[i]), std::abs(p.z - bz[i]) });
+		inDomain = inDomain && p.lengthSquared() <= 1.0f + 1e-5f;
+	}
+	AssertTrue(maxError <= tolerance, "Unit ball: batch equals scalar (max error " + std::to_string(maxError) + ")");
+	AssertTrue(inDomain, "Unit ball: samples inside the ball");
+	
+	// Cosine hemisphere around per-sample normals, drawn from a
+	// RandomStream as the renderer does
+	std::vector<Vec3> normals = TestNormals(count);
+	std::vector<float> nx(count), ny(count), nz(count);
+	for (int i = 0; i < count; i++)
+	{
+		nx[i] = normals[i].x;
+		ny[i] = normals[i].y;
+		nz[i] = normals[i].z;
+	}
+	
+	maxError = 0.0f;
+	bool aroundNormal = true;
+	{
+		RandomStream stream(5, 0, 42);
+		MonteCarlo::StreamScope scope(stream);
+		MonteCarlo::randomCosineDirectionInHemisphere(nx.data(), ny.data(), nz.data(),
+		                                              bx.data(), by.data(), bz.data(), count);
+	}
+	{
+		RandomStream stream(5, 0, 42);
+		MonteCarlo::StreamScope scope(stream);
+		for (int i = 0; i < count; i++)
+		{
+			Vec3 d = MonteCarlo::randomCosineDirectionInHemisphere(normals[i]);
+			maxError = std::max({ maxError, std::abs(d.x - bx[i]), std::abs(d.y - by[i]), std::abs(d.z - bz[i]) });
+			aroundNormal = aroundNormal && d.dot(normals[i]) >= -1e-5f && std::abs(d.length() - 1.0f) < 1e-4f;
+		}
+	}
+	AssertTrue(maxError <= tolerance, "Cosine hemisphere: batch equals scalar (max error " + std::to_string(maxError) + ")");
+	AssertTrue(aroundNormal, "Cosine hemisphere: unit directions on the side of the normal");
+	
+	EndTest();
+}
+
+void TestMonteCarloBatchSpeed()
+{
+	BeginTest("Batch cosine sampling is faster than scalar calls");
+	
+	// Timings are informational; the assertion only checks both loops
+	// produced the same samples, so neither was optimised away
+	const int count = 1 << 20;
+	std::vector<Vec3> normals = TestNormals(1024);
+	std::vector<float> nx(count), ny(count), nz(count), x(count), y(count), z(count);
+	for (int i = 0; i < count; i++)
+	{
+		nx[i] = normals[i % 1024].x;
+		ny[i] = normals[i % 1024].y;
+		nz[i] = normals[i % 1024].z;
+	}
+	
+	using Clock = std::chrono::steady_clock;
+	
+	MonteCarlo::setSeed(7);
+	auto start = Clock::now();
+	double scalarSum = 0.0;
+	for (int i = 0; i < count; i++)
+	{
+		Vec3 d = MonteCarlo::randomCosineDirectionInHemisphere(normals[i % 1024]);
+		scalarSum += d.x + d.y + d.z;
+	}
+	double scalarNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+	
+	MonteCarlo::setSeed(7);
+	start = Clock::now();
+	MonteCarlo::randomCosineDirectionInHemisphere(nx.data(), ny.data(), nz.data(), x.data(), y.data(), z.data(), count);
+	double batchSum = 0.0;
+	for (int i = 0; i < count; i++)
+		batchSum += x[i] + y[i] + z[i];
+	double batchNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+	
+	AssertFloatNear(scalarSum, batchSum, 3.0 * count * 3e-5, "Scalar and batch sample sums agree");
+	
+	std::ostringstream info;
+	info << std::fixed << std::setprecision(1) << "1M samples - Scalar: " << scalarNs << " ns | Batch: "
+	     << batchNs << " ns | Speedup: " << std::setprecision(2) << scalarNs / batchNs << "x";
+	PrintInfo(info.str());
+	
+	EndTest();
+}
+
+// ============================================================================
+// TEST SUITE 5: DISTRIBUTED RENDERING
+// ============================================================================
+// CPU_RENDER_WORKER is the cg_render_cpu built next to this test (UNIX only).
+// Local processes stand in for remote machines; the coordinator cannot
+// tell them apart.
+// ============================================================================
+
+#ifdef CPU_RENDER_WORKER
+
+std::string WorkerCommand()
+{
+	return std::string("'") + CPU_RENDER_WORKER + "' --worker --threads 1";
+}
+
+// Scene, settings and the in-process reference the distributed frames are
+// compared against
+struct DistributedFixture
+{
+	SceneDescription Description;
+	RenderSettings Settings = SmallFrameSettings();
+	Image Reference;
+	
+	DistributedFixture()
+	{
+		Description.ProceduralIndex = 0;
+		Description.Quadrics = true;
+		Settings.Threads = 1;
+		
+		CPUScene scene;
+		RenderCamera camera;
+		Description.Load(scene, camera);
+		Reference = CPURenderer(scene).Render(RenderCamera{}, Settings);
+	}
+};
+
+// Several jobs per worker, so every worker holds JOBS_IN_FLIGHT at once
+DistributedSettings SmallJobs(std::vector<std::string> commands)
+{
+	DistributedSettings distributed;
+	distributed.WorkerCommands = std::move(commands);
+	distributed.JobSize = 8;
+	distributed.JobSamples = 0;     // Whole pixels per job: bit-identical merge
+	return distributed;
+}
+
+void TestDistributedMatchesLocal()
+{
+	BeginTest("Two local workers match CPURenderer::Render bit for bit");
+	
+	DistributedFixture fixture;
+	RenderCoordinator coordinator(SmallJobs({ WorkerCommand(), WorkerCommand() }));
+	
+	Image image;
+	bool rendered = coordinator.Render(fixture.Description, RenderCamera{}, fixture.Settings, image);
+	const std::vector<WorkerStats>& workers = coordinator.GetWorkerStats();
+	
+	AssertTrue(rendered, "Coordinator completed the frame");
+	AssertEqual(size_t(0), CountDifferingPixels(fixture.Reference, image), "Pixels differing from Render");
+	AssertEqual(size_t(2), workers.size(), "Stats for both workers");
+	if (workers.size() == 2)
+	{
+		AssertEqual(48, workers[0].Jobs + workers[1].Jobs, "Every 8x8 job of the 64x48 frame merged once");
+		AssertTrue(!workers[0].Failed && !workers[1].Failed, "No worker failed");
+		PrintInfo("Jobs per worker: " + std::to_string(workers[0].Jobs) + " / " + std::to_string(workers[1].Jobs));
+	}
+	
+	EndTest();
+}
+
+void TestDistributedWorkerFailure()
+{
+	BeginTest("Failed workers are dropped and their jobs requeued");
+	
+	DistributedFixture fixture;
+	
+	// A worker that exits at once never gets ready; the other renders the
+	// whole frame
+	{
+		RenderCoordinator coordinator(SmallJobs({ "exit 0", WorkerCommand() }));
+		Image image;
+		bool rendered = coordinator.Render(fixture.Description, RenderCamera{}, fixture.Settings, image);
+		const std::vector<WorkerStats>& workers = coordinator.GetWorkerStats();
+		
+		AssertTrue(rendered, "Exiting worker: frame completed");
+		AssertEqual(size_t(0), CountDifferingPixels(fixture.Reference, image), "Exiting worker: pixels differing from Render");
+		AssertTrue(workers.size() == 2 && workers[0].Failed && workers[0].Jobs == 0, "Exiting worker marked failed");
+		AssertTrue(workers.size() == 2 && !workers[1].Failed && workers[1].Jobs == 48, "Remaining worker took all jobs");
+	}
+	
+	// A worker whose input is cut after the Setup message and a few Job
+	// messages (16-byte header + 28 bytes each) answers those, then dies
+	// mid-frame with jobs in flight; they must go to the other worker.
+	// dd with 1-byte blocks passes each byte on at once (head would
+	// buffer them and stall the exchange).
+	{
+		std::string dying = "dd bs=1 count=400 2>/dev/null | " + WorkerCommand();
+		RenderCoordinator coordinator(SmallJobs({ dying, WorkerCommand() }));
+		Image image;
+		bool rendered = coordinator.Render(fixture.Description, RenderCamera{}, fixture.Settings, image);
+		const std::vector<WorkerStats>& workers = coordinator.GetWorkerStats();
+		
+		AssertTrue(rendered, "Dying worker: frame completed");
+		AssertEqual(size_t(0), CountDifferingPixels(fixture.Reference, image), "Dying worker: pixels differing from Render");
+		AssertTrue(workers.size() == 2 && workers[0].Failed && workers[0].Jobs > 0,
+		           "Dying worker rendered some jobs before failing");
+		AssertTrue(workers.size() == 2 && workers[0].Jobs + workers[1].Jobs == 48, "Every job merged exactly once");
+		if (workers.size() == 2)
+			PrintInfo("Dying worker: " + std::to_string(workers[0].Jobs) + " jobs, other: " +
+			          std::to_string(workers[1].Jobs));
+	}
+	
+	// No usable worker at all
+	{
+		RenderCoordinator coordinator(SmallJobs({ "exit 0", "exit 1" }));
+		Image image;
+		AssertTrue(!coordinator.Render(fixture.Description, RenderCamera{}, fixture.Settings, image),
+		           "Render fails when every worker fails");
+	}
+	
+	EndTest();
+}
+
+#endif
+
+// ============================================================================
+// TEST SUITE 6: SCENE QUERIES
+// ============================================================================
+
+void TestCSGGroupQueries()
+{
+	BeginTest("CSG groups are hit and block rays as one solid");
+	
+	// Capped cylinder (radius 0.5, z in [-1, 1]) moved to z = 20, in front
+	// of the Cornell walls where no sphere is in the way
+	Quadric::QuadricCSG cylinder = Quadric::QuadricCSG::CreateCappedCylinder(0.5f, 2.0f);
+	QuadricGroupPlacement group;
+	for (size_t leaf = 0; leaf < cylinder.GetLeafCount(); leaf++)
+		group.Members.emplace_back(cylinder.GetLeaf(static_cast<int>(leaf)).GetCoefficients(),
+		                           Quadric::BoundingBox(glm::vec3(-0.5f, -0.5f, -1.0f), glm::vec3(0.5f, 0.5f, 1.0f)));
+	group.ObjectToWorld = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 20.0f));
+	group.MaterialIndex = 5;
+	
+	CPUScene scene;
+	scene.LoadProcedural(0);
+	scene.SetQuadrics({}, { group });
+	
+	// Down the axis: the top cap at z = 21
+	const glm::vec3 down(0.0f, 0.0f, -1.0f);
+	SceneHit hit;
+	AssertTrue(scene.Intersect(glm::vec3(0.0f, 0.0f, 30.0f), down, hit), "Axis ray hits the group");
+	AssertFloatNear(9.0, hit.T, 1e-4, "Axis ray stops at the top cap");
+	AssertEqual(5, hit.MaterialIndex, "Group material");
+	AssertTrue(hit.FrontFace, "Entering the cap is a front face");
+	AssertFloatNear(1.0, hit.Normal.z, 1e-4, "Cap normal faces the ray");
+	
+	// From inside, the first boundary is the bottom cap, seen from behind
+	SceneHit inside;
+	AssertTrue(scene.Intersect(glm::vec3(0.0f, 0.0f, 20.0f), down, inside), "Ray from inside hits the group");
+	AssertFloatNear(1.0, inside.T, 1e-4, "Ray from inside leaves through the bottom cap");
+	AssertTrue(!inside.FrontFace, "Leaving the solid is a back face");
+	
+	// Beside the caps the infinite cylinder member is outside the solid;
+	// the ray goes on to the left wall
+	SceneHit beside;
+	AssertTrue(scene.Intersect(glm::vec3(2.0f, 0.0f, 21.5f), glm::vec3(-1.0f, 0.0f, 0.0f), beside), "Side ray hits the wall");
+	AssertFloatNear(5.5, beside.T, 1e-4, "Side ray passes the clipped member");
+	AssertEqual(1, beside.MaterialIndex, "Left wall material");
+	
+	AssertTrue(scene.Occluded(glm::vec3(0.0f, 0.0f, 30.0f), down, 9.5f), "Group blocks a segment through it");
+	AssertTrue(!scene.Occluded(glm::vec3(0.0f, 0.0f, 30.0f), down, 8.5f), "Segment ending before the group is clear");
+	
+	EndTest();
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main()
+{
+	std::cout << std::endl;
+	std::cout << "╔════════════════════════════════════════════════════════════╗" << std::endl;
+	std::cout << "║          CPU RENDERER TEST SUITE                           ║" << std::endl;
+	std::cout << "║          Scheduler, Sampling and Reference Render Tests    ║" << std::endl;
+	std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+	
+	// Suite 1: Tile Scheduler
+	PrintSectionHeader("SUITE 1: Tile Scheduler Tests");
+	TestTileCoverage();
+	TestTileStealing();
+	TestTileCancellation();
+	
+	// Suite 2: Reproducibility
+	PrintSectionHeader("SUITE 2: Reproducibility Tests");
+	TestThreadCountDeterminism();
+	TestNoiseTargetStop();
+	
+	// Suite 3: Samplers
+	PrintSectionHeader("SUITE 3: Sampler Tests");
+	TestSamplerKnownValues();
+	TestSamplerTableLayout();
+	
+	// Suite 4: Monte Carlo Mappings
+	PrintSectionHeader("SUITE 4: Monte Carlo Mapping Tests");
+	TestMonteCarloBatchMatchesScalar();
+	TestMonteCarloBatchSpeed();
+	
+	// Suite 5: Distributed Rendering
+	PrintSectionHeader("SUITE 5: Distributed Rendering Tests");
+#ifdef CPU_RENDER_WORKER
+	TestDistributedMatchesLocal();
+	TestDistributedWorkerFailure();
+#else
+	PrintInfo("Skipped: worker processes need a POSIX build");
+#endif
+	
+	// Suite 6: Scene Queries
+	PrintSectionHeader("SUITE 6: Scene Query Tests");
+	TestCSGGroupQueries();
+	
+	// Print summary
+	PrintSummary();
+	
+	return GetExitCode();
+}
@@ -0,0 +1,429 @@
+#include "CPUScene.h"
+
+#include <iostream>
+#include <limits>
+#include <glm/gtc/matrix_transform.hpp>
+
+// ============================================================================
+// PRIMITIVE INTERSECTION
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// IntersectSphere / IntersectPlane
+// ----------------------------------------------------------------------------
+// Ports of intersectSphere / intersectPlane in PathTrace.glsl.
+// ----------------------------------------------------------------------------
+static bool IntersectSphere(const glm::vec3& ro, const glm::vec3& rd, const SceneSphere& sphere, SceneHit& hit)
+{
+	glm::vec3 oc = ro - sphere.Center;
+	float a = glm::dot(rd, rd);
+	float halfB = glm::dot(oc, rd);
+	float c = glm::dot(oc, oc) - sphere.Radius * sphere.Radius;
+	float discriminant = halfB * halfB - a * c;
+	
+	if (discriminant < 0.0f)
+		return false;
+	
+	float sqrtD = std::sqrt(discriminant);
+	float t = (-halfB - sqrtD) / a;
+	if (t < SCENE_EPSILON || t > hit.T)
+	{
+		t = (-halfB + sqrtD) / a;
+		if (t < SCENE_EPSILON || t > hit.T)
+			return false;
+	}
+	
+	hit.T = t;
+	hit.Position = ro + rd * t;
+	glm::vec3 outwardNormal = (hit.Position - sphere.Center) / sphere.Radius;
+	hit.FrontFace = glm::dot(rd, outwardNormal) < 0.0f;
+	hit.Normal = hit.FrontFace ? outwardNormal : -outwardNormal;
+	hit.MaterialIndex = sphere.MaterialIndex;
+	hit.IsOBJ = false;
+	return true;
+}
+
+static bool IntersectPlane(const glm::vec3& ro, const glm::vec3& rd, const ScenePlane& plane, SceneHit& hit)
+{
+	float denom = glm::dot(plane.Normal, rd);
+	if (std::abs(denom) < SCENE_EPSILON)
+		return false;
+	
+	float t = glm::dot(plane.Point - ro, plane.Normal) / denom;
+	if (t < SCENE_EPSILON || t > hit.T)
+		return false;
+	
+	hit.T = t;
+	hit.Position = ro + rd * t;
+	hit.FrontFace = denom < 0.0f;
+	hit.Normal = hit.FrontFace ? plane.Normal : -plane.Normal;
+	hit.MaterialIndex = plane.MaterialIndex;
+	hit.IsOBJ = false;
+	return true;
+}
+
+// ============================================================================
+// CPU SCENE IMPLEMENTATION
+// ============================================================================
+
+CPUScene::CPUScene()
+{
+	m_SceneManager.SetSceneCache(true);
+	LoadProcedural(0);
+}
+
+// ----------------------------------------------------------------------------
+// LoadProcedural
+// ----------------------------------------------------------------------------
+void CPUScene::LoadProcedural(int sceneIndex)
+{
+	m_UseOBJ = false;
+	m_SceneManager.Clear();
+	m_OBJMaterials.clear();
+	InitProceduralScene(sceneIndex);
+}
+
+// ----------------------------------------------------------------------------
+// InitProceduralScene
+// ----------------------------------------------------------------------------
+// Mirrors initScene in PathTrace.glsl. Keep the two in sync.
+// ----------------------------------------------------------------------------
+void CPUScene::InitProceduralScene(int sceneIndex)
+{
+	// Default materials (used by all scenes)
+	m_Materials = {
+		Material::Create(glm::vec3(0.73f, 0.73f, 0.73f), 0.9f, 0.0f),     // White diffuse (floor/ceiling)
+		Material::Create(glm::vec3(0.65f, 0.05f, 0.05f), 0.9f, 0.0f),     // Red diffuse (left wall)
+		Material::Create(glm::vec3(0.12f, 0.45f, 0.15f), 0.9f, 0.0f),     // Green diffuse (right wall)
+		Material::Create(glm::vec3(0.9f, 0.9f, 0.9f), 0.02f, 1.0f),       // Chrome metal
+		Material::Create(glm::vec3(1.0f, 0.78f, 0.34f), 0.1f, 1.0f),      // Gold metal
+		Material::CreateEmissive(glm::vec3(1.0f, 0.95f, 0.85f), 15.0f),   // Warm area light
+		Material::CreateGlass(glm::vec3(1.0f, 1.0f, 1.0f), 0.0f, 1.5f),   // Clear glass
+		Material::Create(glm::vec3(0.1f, 0.3f, 0.8f), 0.05f, 0.0f),       // Blue glossy
+		Material::Create(glm::vec3(0.95f, 0.93f, 0.88f), 0.4f, 0.0f),     // Rough white
+		Material::Create(glm::vec3(0.85f, 0.5f, 0.2f), 0.3f, 0.5f)        // Bronze
+	};
+	
+	// Cornell box walls (present in every procedural scene)
+	m_Planes = {
+		{ glm::vec3(0.0f, -3.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 0 },   // Floor
+		{ glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 0 },   // Ceiling
+		{ glm::vec3(0.0f, 0.0f, -4.0f), glm::vec3(0.0f, 0.0f, 1.0f), 0 },   // Back wall
+		{ glm::vec3(-3.5f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 1 },   // Left wall
+		{ glm::vec3(3.5f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), 2 }    // Right wall
+	};
+	
+	m_Spheres.clear();
+	
+	// Scene 0: Cornell Box Showcase (default)
+	if (sceneIndex == 0)
+	{
+		m_Spheres = {
+			{ glm::vec3(-1.0f, -2.0f, -1.0f), 1.0f, 3 },    // Large chrome sphere
+			{ glm::vec3(1.5f, -2.2f, 0.5f), 0.8f, 4 },      // Gold sphere
+			{ glm::vec3(0.0f, -2.3f, 1.5f), 0.7f, 6 },      // Glass sphere
+			{ glm::vec3(-2.0f, -2.5f, 1.5f), 0.5f, 7 },     // Blue glossy sphere
+			{ glm::vec3(2.0f, -1.5f, -1.5f), 0.4f, 5 },     // Small emissive sphere (accent light)
+			{ glm::vec3(0.5f, -2.6f, -1.8f), 0.4f, 9 }      // Bronze sphere
+		};
+	}
+	// Scene 1: Simple spheres
+	else if (sceneIndex == 1)
+	{
+		m_Materials[0] = Material::Create(glm::vec3(1.0f, 0.0f, 1.0f), 0.2f, 0.0f);   // Pink diffuse
+		m_Materials[1] = Material::Create(glm::vec3(0.2f, 0.3f, 1.0f), 0.1f, 0.0f);   // Blue diffuse
+		m_Materials[2] = Material::Create(glm::vec3(0.8f, 0.5f, 0.2f), 0.1f, 0.0f);   // Orange emissive
+		m_Materials[2].Emission = m_Materials[2].Albedo;
+		m_Materials[2].EmissionStrength = 2.0f;
+		
+		m_Spheres = {
+			{ glm::vec3(0.0f, 0.0f, 0.0f), 1.0f, 0 },       // Pink sphere at origin
+			{ glm::vec3(2.5f, 0.0f, 0.0f), 1.0f, 2 },       // Orange emissive sphere offset on +X
+			{ glm::vec3(0.0f, -101.0f, 0.0f), 100.0f, 1 }   // Ground sphere using blue material
+		};
+	}
+	// Scene 2: Glass & Metal study
+	else if (sceneIndex == 2)
+	{
+		m_Spheres = {
+			{ glm::vec3(0.0f, -1.5f, 0.0f), 1.5f, 6 },      // Large glass sphere (center)
+			{ glm::vec3(-2.5f, -2.2f, 0.5f), 0.8f, 3 },     // Chrome sphere (left)
+			{ glm::vec3(2.5f, -2.2f, 0.5f), 0.8f, 4 },      // Gold sphere (right)
+			{ glm::vec3(0.0f, -2.5f, -2.0f), 0.5f, 5 }      // Small emissive (behind glass)
+		};
+	}
+	// Scene 3: All metals lineup
+	else if (sceneIndex == 3)
+	{
+		m_Spheres = {
+			{ glm::vec3(-2.0f, -2.0f, 0.0f), 1.0f, 3 },     // Chrome
+			{ glm::vec3(0.0f, -2.0f, 0.0f), 1.0f, 4 },      // Gold
+			{ glm::vec3(2.0f, -2.0f, 0.0f), 1.0f, 9 },      // Bronze
+			{ glm::vec3(0.0f, 1.0f, 2.0f), 0.5f, 5 }        // Emissive light source
+		};
+	}
+}
+
+// ----------------------------------------------------------------------------
+// LoadOBJ
+// ----------------------------------------------------------------------------
+bool CPUScene::LoadOBJ(const std::filesystem::path& path)
+{
+	m_SceneManager.Clear();
+	if (!m_SceneManager.LoadOBJ(path) || m_SceneManager.GetTriangleCount() == 0)
+	{
+		std::cerr << "[CPUScene] Failed to load " << path.string() << std::endl;
+		LoadProcedural(0);
+		return false;
+	}
+	
+	m_OBJMaterials.clear();
+	for (const OBJMaterial& material : m_SceneManager.GetSceneData().Materials)
+		m_OBJMaterials.push_back(Material::FromOBJ(material));
+	
+	// The shader drops the spheres and walls but keeps the default table for quadrics
+	InitProceduralScene(0);
+	m_UseOBJ = true;
+	m_Spheres.clear();
+	m_Planes.clear();
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+// AddQuadric
+// ----------------------------------------------------------------------------
+void CPUScene::AddQuadric(const Quadric::QuadricSurface& shape, const glm::mat4& objectToWorld, int materialIndex)
+{
+	m_QuadricShapes.push_back(shape);
+	m_Quadrics.emplace_back(m_QuadricShapes.back(), objectToWorld);
+	m_QuadricMaterials.push_back(materialIndex);
+	
+	RebuildQuadricBVH();
+}
+
+// ----------------------------------------------------------------------------
+// SetQuadrics
+// ----------------------------------------------------------------------------
+void CPUScene::SetQuadrics(const std::vector<QuadricPlacement>& quadrics,
+                           const std::vector<QuadricGroupPlacement>& groups)
+{
+	m_Quadrics.clear();
+	m_QuadricShapes.clear();
+	m_QuadricMaterials.clear();
+	m_QuadricGroups.clear();
+	
+	m_Quadrics.reserve(quadrics.size());
+	m_QuadricMaterials.reserve(quadrics.size());
+	for (const QuadricPlacement& placement : quadrics)
+	{
+		m_QuadricShapes.push_back(placement.Shape);
+		m_Quadrics.emplace_back(m_QuadricShapes.back(), placement.ObjectToWorld);
+		m_QuadricMaterials.push_back(placement.MaterialIndex);
+	}
+	
+	// Groups are intersected in world space: one leaf per member with the
+	// transformed coefficients, and the union of the member boxes for culling
+	m_QuadricGroups.reserve(groups.size());
+	for (const QuadricGroupPlacement& placement : groups)
+	{
+		if (placement.Members.empty())
+			continue;
+		
+		QuadricGroup group;
+		group.MaterialIndex = placement.MaterialIndex;
+		glm::vec3 worldMin(std::numeric_limits<float>::max());
+		glm::vec3 worldMax(-std::numeric_limits<float>::max());
+		int root = -1;
+		for (const Quadric::QuadricSurface& member : placement.Members)
+		{
+			Quadric::QuadricInstance instance(member, placement.ObjectToWorld);
+			int leaf = group.Solid.AddLeaf(Quadric::QuadricSurface(instance.GetWorldCoefficients()));
+			root = (root < 0) ? leaf : group.Solid.AddIntersection(root, leaf);
+			
+			Quadric::BoundingBox bounds = instance.GetBounds();
+			worldMin = glm::min(worldMin, bounds.Min);
+			worldMax = glm::max(worldMax, bounds.Max);
+		}
+		group.Bounds = Quadric::BoundingBox(worldMin, worldMax);
+		m_QuadricGroups.push_back(group);
+	}
+	
+	RebuildQuadricBVH();
+}
+
+void CPUScene::RebuildQuadricBVH()
+{
+	std::vector<Quadric::BoundingBox> bounds;
+	bounds.reserve(m_Quadrics.size());
+	for (const Quadric::QuadricInstance& quadric : m_Quadrics)
+		bounds.push_back(quadric.GetBounds());
+	m_QuadricBVH.Build(bounds);
+}
+
+// ----------------------------------------------------------------------------
+// AddDefaultQuadrics
+// ----------------------------------------------------------------------------
+// Same surfaces as QuadricManager::InitializeDefaults.
+// ----------------------------------------------------------------------------
+void CPUScene::AddDefaultQuadrics()
+{
+	// Gold sphere of radius 0.6 on the right: x² + y² + z² - 0.36 = 0
+	Quadric::QuadricSurface sphere(Quadric::QuadricCoefficients(1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -0.36f),
+	                               Quadric::BoundingBox(glm::vec3(-0.6f), glm::vec3(0.6f)));
+	AddQuadric(sphere, glm::translate(glm::mat4(1.0f), glm::vec3(2.0f, -2.0f, 0.0f)), 4);
+	
+	// Rough white ellipsoid at the back left: 0.64x² + 0.25y² + z² - 0.16 = 0
+	Quadric::QuadricSurface ellipsoid(Quadric::QuadricCoefficients(0.64f, 0.25f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -0.16f),
+	                                  Quadric::BoundingBox(glm::vec3(-0.5f, -0.8f, -0.4f), glm::vec3(0.5f, 0.8f, 0.4f)));
+	AddQuadric(ellipsoid, glm::translate(glm::mat4(1.0f), glm::vec3(-2.0f, -2.0f, -2.0f)), 8);
+}
+
+// ----------------------------------------------------------------------------
+// Intersect
+// ----------------------------------------------------------------------------
+// Same order as intersectScene: triangles or spheres and walls, then the
+// quadric BVH, each clipped to the closest hit so far.
+// ----------------------------------------------------------------------------
+bool CPUScene::Intersect(const glm::vec3& origin, const glm::vec3& direction, SceneHit& hit) const
+{
+	bool hitAnything = false;
+	
+	if (m_UseOBJ)
+	{
+		TriangleHit triangle = m_SceneManager.Intersect(origin, direction, SCENE_EPSILON, hit.T);
+		if (triangle.Hit)
+		{
+			hit.T = triangle.Distance;
+			hit.Position = triangle.Position;
+			hit.FrontFace = glm::dot(direction, triangle.Normal) < 0.0f;
+			hit.Normal = hit.FrontFace ? triangle.Normal : -triangle.Normal;
+			hit.MaterialIndex = triangle.MaterialIndex;
+			hit.IsOBJ = true;
+			hitAnything = true;
+		}
+	}
+	else
+	{
+		for (const SceneSphere& sphere : m_Spheres)
+			hitAnything |= IntersectSphere(origin, direction, sphere, hit);
+		for (const ScenePlane& plane : m_Planes)
+			hitAnything |= IntersectPlane(origin, direction, plane, hit);
+	}
+	
+	Quadric::BVHIntersectionResult quadric = m_QuadricBVH.IntersectNearest(m_Quadrics, origin, direction, SCENE_EPSILON, hit.T);
+	if (quadric.Hit)
+	{
+		// The instance already turned the normal toward the ray; the facing
+		// comes from the outward gradient (f > 0 outside)
+		const Quadric::QuadricInstance& instance = m_Quadrics[quadric.Index];
+		const glm::mat4& worldToObject = instance.GetInverseTransform();
+		glm::vec3 local = glm::vec3(worldToObject * glm::vec4(quadric.Point, 1.0f));
+		glm::vec3 gradient = glm::transpose(glm::mat3(worldToObject)) * instance.GetShape().CalculateNormal(local);
+		
+		hit.T = quadric.Distance;
+		hit.Position = quadric.Point;
+		hit.Normal = quadric.Normal;
+		hit.FrontFace = glm::dot(direction, gradient) < 0.0f;
+		hit.MaterialIndex = m_QuadricMaterials[quadric.Index];
+		hit.IsOBJ = false;
+		hitAnything = true;
+	}
+	
+	for (const QuadricGroup& group : m_QuadricGroups)
+	{
+		float tNear, tFar;
+		if (!group.Bounds.Intersect(origin, direction, tNear, tFar) || tNear > hit.T)
+			continue;
+		
+		Quadric::IntersectionResult result = group.Solid.Intersect(origin, direction, SCENE_EPSILON, hit.T);
+		if (!result.Hit)
+			continue;
+		
+		// The first boundary is an exit when the ray starts inside the solid
+		hit.T = result.Distance;
+		hit.Position = result.Point;
+		hit.Normal = result.Normal;
+		hit.FrontFace = !group.Solid.Contains(origin + direction * SCENE_EPSILON);
+		hit.MaterialIndex = group.MaterialIndex;
+		hit.IsOBJ = false;
+		hitAnything = true;
+	}
+	
+	return hitAnything;
+}
+
+// ----------------------------------------------------------------------------
+// Occluded
+// ----------------------------------------------------------------------------
+// Same order as occludedScene: triangles and quadrics use their any-hit
+// tests, spheres and walls reuse the closest-hit tests.
+// ----------------------------------------------------------------------------
+bool CPUScene::Occluded(const glm::vec3& origin, const glm::vec3& direction, float tMax) const
+{
+	if (m_UseOBJ)
+	{
+		if (m_SceneManager.Occluded(origin, direction, tMax, SCENE_EPSILON))
+			return true;
+	}
+	else
+	{
+		SceneHit hit;
+		hit.T = tMax;
+		for (const SceneSphere& sphere : m_Spheres)
+		{
+			if (IntersectSphere(origin, direction, sphere, hit))
+				return true;
+		}
+		for (const ScenePlane& plane : m_Planes)
+		{
+			if (IntersectPlane(origin, direction, plane, hit))
+				return true;
+		}
+	}
+	
+	if (m_QuadricBVH.Occluded(m_Quadrics, origin, direction, tMax, SCENE_EPSILON))
+		return true;
+	
+	for (const QuadricGroup& group : m_QuadricGroups)
+	{
+		float tNear, tFar;
+		if (!group.Bounds.Intersect(origin, direction, tNear, tFar) || tNear > tMax)
+			continue;
+		if (group.Solid.Occluded(origin, direction, tMax, SCENE_EPSILON))
+			return true;
+	}
+	
+	return false;
+}
+
+const Material& CPUScene::GetMaterial(const SceneHit& hit) const
+{
+	if (hit.IsOBJ)
+		return m_OBJMaterials[hit.MaterialIndex];
+	return m_Materials[hit.MaterialIndex];
+}
+
+// ----------------------------------------------------------------------------
+// SampleEnvironment
+// ----------------------------------------------------------------------------
+// Gradient sky with sun, from sampleEnvironment in PathTrace.glsl.
+// ----------------------------------------------------------------------------
+glm::vec3 CPUScene::SampleEnvironment(const glm::vec3& direction) const
+{
+	if (!m_ShowSkybox)
+		return glm::vec3(0.0f);
+	
+	float t = 0.5f * (direction.y + 1.0f);
+	glm::vec3 skyColor = glm::mix(glm::vec3(0.8f, 0.85f, 0.9f), glm::vec3(0.4f, 0.6f, 0.9f), t);
+	
+	glm::vec3 sunDir = glm::normalize(glm::vec3(0.5f, 0.8f, 0.3f));
+	float sunDot = std::max(glm::dot(direction, sunDir), 0.0f);
+	glm::vec3 sunColor = glm::vec3(1.0f, 0.95f, 0.85f) * std::pow(sunDot, 256.0f) * 50.0f;
+	glm::vec3 sunGlow = glm::vec3(1.0f, 0.9f, 0.7f) * std::pow(sunDot, 8.0f) * 0.5f;
+	
+	// Ground reflection
+	if (direction.y < 0.0f)
+		skyColor = glm::mix(skyColor, glm::vec3(0.2f, 0.15f, 0.1f), -direction.y);
+	
+	return skyColor * 0.5f + sunColor + sunGlow;
+}
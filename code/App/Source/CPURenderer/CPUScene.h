@@ -0,0 +1,199 @@
+#pragma once
+
+#include <deque>
+#include <filesystem>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Material.h"
+#include "SceneManager/SceneManager.h"
+#include "Quadric/QuadricInstance.h"
+#include "Quadric/QuadricCSG.h"
+#include "Quadric/QuadricBVH.h"
+
+// ============================================================================
+// CPU SCENE - Scene Description for the Headless Renderer
+// ============================================================================
+//
+// Holds the same content the GPU path draws, without any GL state:
+//
+//   - Procedural scenes: the spheres, Cornell walls and 10-entry material
+//     table of initScene / intersectScene in PathTrace.glsl
+//   - OBJ scenes: triangles and MTL materials loaded through SceneManager
+//   - Quadrics: QuadricInstances in a QuadricBVH, drawn in both modes and
+//     shaded with the procedural material table (like the shader)
+//   - CSG groups: the solid intersection of a few quadrics sharing one
+//     transform (csgGroup in QuadricManager), one QuadricCSG per group
+//
+// USAGE EXAMPLE:
+// --------------
+//   CPUScene scene;
+//   scene.LoadProcedural(0);
+//   scene.AddDefaultQuadrics();
+//
+//   SceneHit hit;
+//   if (scene.Intersect(origin, direction, hit))
+//       const Material& material = scene.GetMaterial(hit);
+//
+// ============================================================================
+
+// Self-intersection offset and far plane (EPSILON / MAX_DISTANCE in the shader)
+static constexpr float SCENE_EPSILON = 0.0001f;
+static constexpr float SCENE_MAX_DISTANCE = 1000.0f;
+
+// ----------------------------------------------------------------------------
+// SceneHit
+// ----------------------------------------------------------------------------
+// Closest hit of a ray (HitRecord in the shader). Normal faces the ray.
+// ----------------------------------------------------------------------------
+struct SceneHit
+{
+	float T = SCENE_MAX_DISTANCE;
+	glm::vec3 Position = glm::vec3(0.0f);
+	glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	int MaterialIndex = 0;
+	bool FrontFace = true;
+	bool IsOBJ = false;     // Material comes from the OBJ table
+};
+
+struct SceneSphere
+{
+	glm::vec3 Center;
+	float Radius;
+	int MaterialIndex;
+};
+
+struct ScenePlane
+{
+	glm::vec3 Point;
+	glm::vec3 Normal;
+	int MaterialIndex;
+};
+
+// A quadric shape placed in the world (argument of SetQuadrics)
+struct QuadricPlacement
+{
+	Quadric::QuadricSurface Shape;
+	glm::mat4 ObjectToWorld;
+	int MaterialIndex;
+};
+
+// A CSG group placed in the world (argument of SetQuadrics): the solid where
+// every member's f <= 0, all members sharing one transform
+struct QuadricGroupPlacement
+{
+	std::vector<Quadric::QuadricSurface> Members;
+	glm::mat4 ObjectToWorld;
+	int MaterialIndex;
+};
+
+// ============================================================================
+// CPU SCENE CLASS
+// ============================================================================
+class CPUScene
+{
+public:
+	// Procedural scenes selectable with LoadProcedural (uSceneIndex)
+	static constexpr int NUM_PROCEDURAL_SCENES = 4;
+	
+	CPUScene();
+	
+	// ========================================================================
+	// LoadProcedural
+	// ========================================================================
+	// Switches to procedural scene sceneIndex (0 = Cornell Box Showcase,
+	// 1 = Simple Spheres, 2 = Glass & Metal Study, 3 = Metals Lineup).
+	// Keeps any quadrics.
+	// ========================================================================
+	void LoadProcedural(int sceneIndex);
+	
+	// ========================================================================
+	// LoadOBJ
+	// ========================================================================
+	// Switches to an OBJ scene (triangles replace spheres and walls).
+	// Keeps any quadrics.
+	//
+	// Returns:
+	//   bool - false if the file could not be loaded or has no triangles
+	// ========================================================================
+	bool LoadOBJ(const std::filesystem::path& path);
+	
+	// ========================================================================
+	// AddQuadric / AddDefaultQuadrics / SetQuadrics
+	// ========================================================================
+	// Places a copy of shape in the world. materialIndex refers to the
+	// procedural material table. The BVH is rebuilt on every call, which is
+	// fine for the handful of quadrics a scene file describes.
+	//
+	// AddDefaultQuadrics adds the scene of QuadricManager::InitializeDefaults.
+	// SetQuadrics replaces all quadrics and CSG groups and builds the BVH
+	// once (use it for large sets such as a copy of the editor's scene).
+	// Like the shader, a member root only counts inside every other member;
+	// the members' bounding boxes are only used for culling.
+	// ========================================================================
+	void AddQuadric(const Quadric::QuadricSurface& shape, const glm::mat4& objectToWorld, int materialIndex);
+	void AddDefaultQuadrics();
+	void SetQuadrics(const std::vector<QuadricPlacement>& quadrics,
+	                 const std::vector<QuadricGroupPlacement>& groups = {});
+	
+	// ========================================================================
+	// Intersect
+	// ========================================================================
+	// Closest hit in (SCENE_EPSILON, hit.T) over spheres and walls (or
+	// triangles), quadrics and CSG groups. Updates hit and returns true on
+	// a hit.
+	// ========================================================================
+	bool Intersect(const glm::vec3& origin, const glm::vec3& direction, SceneHit& hit) const;
+	
+	// ========================================================================
+	// Occluded
+	// ========================================================================
+	// Visibility query (occludedScene in the shader): true if anything
+	// blocks (SCENE_EPSILON, tMax). Stops at the first blocker.
+	// ========================================================================
+	bool Occluded(const glm::vec3& origin, const glm::vec3& direction, float tMax) const;
+	
+	// Material of a hit (OBJ table for triangles, procedural table otherwise)
+	const Material& GetMaterial(const SceneHit& hit) const;
+	
+	// Radiance of rays that escape the scene (sampleEnvironment in the shader):
+	// black unless the sky is shown
+	glm::vec3 SampleEnvironment(const glm::vec3& direction) const;
+	
+	void SetShowSkybox(bool show) { m_ShowSkybox = show; }
+	bool IsOBJScene() const { return m_UseOBJ; }
+	
+	// Camera stored in the OBJ file, if any
+	const SceneData& GetOBJSceneData() const { return m_SceneManager.GetSceneData(); }
+
+private:
+	// Materials, spheres and walls of a procedural scene
+	void InitProceduralScene(int sceneIndex);
+	
+	void RebuildQuadricBVH();
+	
+	std::vector<Material> m_Materials;      // Procedural table (materials[] in the shader)
+	std::vector<Material> m_OBJMaterials;
+	std::vector<SceneSphere> m_Spheres;
+	std::vector<ScenePlane> m_Planes;
+	
+	SceneManager m_SceneManager;
+	bool m_UseOBJ = false;
+	bool m_ShowSkybox = false;
+	
+	// Instances point into m_QuadricShapes; a deque never moves its elements
+	std::deque<Quadric::QuadricSurface> m_QuadricShapes;
+	std::vector<Quadric::QuadricInstance> m_Quadrics;
+	std::vector<int> m_QuadricMaterials;
+	Quadric::QuadricBVH m_QuadricBVH;
+	
+	// CSG groups in world space; the box culls rays before the interval walk
+	struct QuadricGroup
+	{
+		Quadric::QuadricCSG Solid;
+		Quadric::BoundingBox Bounds;
+		int MaterialIndex;
+	};
+	std::vector<QuadricGroup> m_QuadricGroups;
+};
@@ -0,0 +1,656 @@
+#include "DistributedRender.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// SCENE DESCRIPTION
+// ============================================================================
+bool SceneDescription::Load(CPUScene& scene, RenderCamera& camera) const
+{
+	if (!OBJPath.empty())
+	{
+		if (!scene.LoadOBJ(OBJPath))
+		{
+			std::cerr << "Failed to load " << OBJPath << std::endl;
+			return false;
+		}
+		
+		const SceneData& data = scene.GetOBJSceneData();
+		if (data.HasCamera)
+		{
+			camera.Position = data.CameraPosition;
+			camera.Forward = glm::normalize(data.CameraTarget - data.CameraPosition);
+			camera.Up = data.CameraUp;
+		}
+	}
+	else
+	{
+		if (ProceduralIndex < 0 || ProceduralIndex >= CPUScene::NUM_PROCEDURAL_SCENES)
+		{
+			std::cerr << "Scene index must be 0-" << CPUScene::NUM_PROCEDURAL_SCENES - 1 << std::endl;
+			return false;
+		}
+		scene.LoadProcedural(ProceduralIndex);
+	}
+	
+	if (Quadrics)
+		scene.AddDefaultQuadrics();
+	scene.SetShowSkybox(Skybox);
+	return true;
+}
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+RenderCoordinator::RenderCoordinator(const DistributedSettings& settings)
+	: m_Settings(settings)
+{
+}
+
+#ifndef _WIN32
+
+// ============================================================================
+// PROTOCOL
+// ============================================================================
+// Every message is a MessageHeader followed by Size payload bytes. Values
+// are written in native byte order.
+// ============================================================================
+static constexpr uint32_t MESSAGE_MAGIC = 0x44524743;  // "CGRD"
+
+enum class MessageType : uint32_t
+{
+	Setup = 1,      // Scene, camera, settings
+	Ready,          // uint8 ok
+	Job,            // int32 id, region X0 Y0 X1 Y1, first, end
+	Result,         // int32 id, then r g b sumSquare per pixel
+	Quit
+};
+
+struct MessageHeader
+{
+	uint32_t Magic;
+	uint32_t Type;
+	uint64_t Size;
+};
+
+// Builds a payload from trivially copyable values
+struct MessageWriter
+{
+	std::vector<uint8_t> Data;
+	
+	template<typename T>
+	void Put(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		Data.insert(Data.end(), bytes, bytes + sizeof(T));
+	}
+	
+	void PutString(const std::string& value)
+	{
+		Put(uint32_t(value.size()));
+		Data.insert(Data.end(), value.begin(), value.end());
+	}
+	
+	void PutVec3(const glm::vec3& value)
+	{
+		Put(value.x);
+		Put(value.y);
+		Put(value.z);
+	}
+};
+
+// Reads a payload back; every Get fails once the data runs out
+struct MessageReader
+{
+	const std::vector<uint8_t>& Data;
+	size_t Offset = 0;
+	
+	template<typename T>
+	bool Get(T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (Data.size() - Offset < sizeof(T))
+			return false;
+		std::memcpy(&value, Data.data() + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return true;
+	}
+	
+	bool GetString(std::string& value)
+	{
+		uint32_t size = 0;
+		if (!Get(size) || Data.size() - Offset < size)
+			return false;
+		value.assign(reinterpret_cast<const char*>(Data.data() + Offset), size);
+		Offset += size;
+		return true;
+	}
+	
+	bool GetVec3(glm::vec3& value)
+	{
+		return Get(value.x) && Get(value.y) && Get(value.z);
+	}
+};
+
+static bool WriteAll(int fd, const void* data, size_t size)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	while (size > 0)
+	{
+		ssize_t written = write(fd, bytes, size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+		bytes += written;
+		size -= size_t(written);
+	}
+	return true;
+}
+
+static bool ReadAll(int fd, void* data, size_t size)
+{
+	uint8_t* bytes = static_cast<uint8_t*>(data);
+	while (size > 0)
+	{
+		ssize_t got = read(fd, bytes, size);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			return false;
+		bytes += got;
+		size -= size_t(got);
+	}
+	return true;
+}
+
+static bool SendMessage(int fd, MessageType type, const MessageWriter& payload = {})
+{
+	MessageHeader header{ MESSAGE_MAGIC, uint32_t(type), uint64_t(payload.Data.size()) };
+	return WriteAll(fd, &header, sizeof(header)) && WriteAll(fd, payload.Data.data(), payload.Data.size());
+}
+
+// Blocks until a whole message has arrived; false on end of stream or a
+// malformed header
+static bool ReceiveMessage(int fd, MessageType& type, std::vector<uint8_t>& payload)
+{
+	MessageHeader header;
+	if (!ReadAll(fd, &header, sizeof(header)) || header.Magic != MESSAGE_MAGIC)
+		return false;
+	
+	type = MessageType(header.Type);
+	payload.resize(size_t(header.Size));
+	return ReadAll(fd, payload.data(), payload.size());
+}
+
+// ----------------------------------------------------------------------------
+// Setup payload
+// ----------------------------------------------------------------------------
+static MessageWriter WriteSetup(const SceneDescription& scene, const RenderCamera& camera, const RenderSettings& settings)
+{
+	MessageWriter writer;
+	writer.Put(int32_t(scene.ProceduralIndex));
+	writer.PutString(scene.OBJPath);
+	writer.Put(uint8_t(scene.Quadrics));
+	writer.Put(uint8_t(scene.Skybox));
+	
+	writer.PutVec3(camera.Position);
+	writer.PutVec3(camera.Forward);
+	writer.PutVec3(camera.Up);
+	writer.Put(camera.VerticalFOV);
+	writer.Put(camera.FocusDistance);
+	writer.Put(camera.Aperture);
+	
+	writer.Put(int32_t(settings.Width));
+	writer.Put(int32_t(settings.Height));
+	writer.Put(int32_t(settings.SamplesPerPixel));
+	writer.Put(int32_t(settings.MaxBounces));
+	writer.Put(settings.Seed);
+	writer.Put(int32_t(settings.TileSize));
+	writer.Put(int32_t(settings.SamplerType));
+	return writer;
+}
+
+static bool ReadSetup(const std::vector<uint8_t>& payload, SceneDescription& scene, RenderCamera& camera, RenderSettings& settings)
+{
+	MessageReader reader{ payload };
+	int32_t proceduralIndex, width, height, samples, bounces, tileSize, samplerType;
+	uint8_t quadrics, skybox;
+	
+	bool ok = reader.Get(proceduralIndex) && reader.GetString(scene.OBJPath) &&
+		reader.Get(quadrics) && reader.Get(skybox) &&
+		reader.GetVec3(camera.Position) && reader.GetVec3(camera.Forward) && reader.GetVec3(camera.Up) &&
+		reader.Get(camera.VerticalFOV) && reader.Get(camera.FocusDistance) && reader.Get(camera.Aperture) &&
+		reader.Get(width) && reader.Get(height) && reader.Get(samples) && reader.Get(bounces) &&
+		reader.Get(settings.Seed) && reader.Get(tileSize) && reader.Get(samplerType);
+	if (!ok || samplerType < 0 || samplerType >= Sampler::TYPE_COUNT)
+		return false;
+	
+	scene.ProceduralIndex = proceduralIndex;
+	scene.Quadrics = quadrics != 0;
+	scene.Skybox = skybox != 0;
+	settings.Width = width;
+	settings.Height = height;
+	settings.SamplesPerPixel = samples;
+	settings.MaxBounces = bounces;
+	settings.TileSize = tileSize;
+	settings.SamplerType = Sampler::Type(samplerType);
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+// Jobs
+// ----------------------------------------------------------------------------
+struct RenderJob
+{
+	Tile Region;
+	int FirstSample;
+	int EndSample;
+};
+
+static int PixelCount(const Tile& region)
+{
+	return (region.X1 - region.X0) * (region.Y1 - region.Y0);
+}
+
+// ============================================================================
+// WORKER PROCESSES
+// ============================================================================
+struct WorkerProcess
+{
+	pid_t Pid = -1;
+	int ToWorker = -1;          // Worker's stdin
+	int FromWorker = -1;        // Worker's stdout
+	bool Alive = false;
+	std::vector<int> InFlight;  // Job ids sent but not answered
+};
+
+// Runs command through /bin/sh with pipes on its stdin and stdout
+static bool StartWorker(const std::string& command, WorkerProcess& worker)
+{
+	int toWorker[2], fromWorker[2];
+	if (pipe(toWorker) != 0)
+		return false;
+	if (pipe(fromWorker) != 0)
+	{
+		close(toWorker[0]);
+		close(toWorker[1]);
+		return false;
+	}
+	
+	// Close-on-exec, so later workers do not inherit this one's pipes (dup2
+	// clears the flag on the copies the child keeps)
+	for (int fd : { toWorker[0], toWorker[1], fromWorker[0], fromWorker[1] })
+		fcntl(fd, F_SETFD, FD_CLOEXEC);
+	
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		for (int fd : { toWorker[0], toWorker[1], fromWorker[0], fromWorker[1] })
+			close(fd);
+		return false;
+	}
+	
+	if (pid == 0)
+	{
+		dup2(toWorker[0], STDIN_FILENO);
+		dup2(fromWorker[1], STDOUT_FILENO);
+		execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+		_exit(127);
+	}
+	
+	close(toWorker[0]);
+	close(fromWorker[1]);
+	worker.Pid = pid;
+	worker.ToWorker = toWorker[1];
+	worker.FromWorker = fromWorker[0];
+	worker.Alive = true;
+	return true;
+}
+
+static void StopWorker(WorkerProcess& worker)
+{
+	if (worker.ToWorker >= 0)
+	{
+		if (worker.Alive)
+			SendMessage(worker.ToWorker, MessageType::Quit);
+		close(worker.ToWorker);
+	}
+	if (worker.FromWorker >= 0)
+		close(worker.FromWorker);
+	if (worker.Pid > 0)
+		waitpid(worker.Pid, nullptr, 0);
+	
+	worker = WorkerProcess{};
+}
+
+// ============================================================================
+// COORDINATOR
+// ============================================================================
+bool RenderCoordinator::Render(const SceneDescription& scene, const RenderCamera& camera, const RenderSettings& settings,
+                               Image& image, RenderStats* stats)
+{
+	auto start = std::chrono::steady_clock::now();
+	
+	m_WorkerStats.assign(m_Settings.WorkerCommands.size(), WorkerStats{});
+	for (size_t i = 0; i < m_WorkerStats.size(); i++)
+		m_WorkerStats[i].Command = m_Settings.WorkerCommands[i];
+	
+	image = Image(settings.Width, settings.Height);
+	if (m_WorkerStats.empty() || settings.Width <= 0 || settings.Height <= 0 || settings.SamplesPerPixel <= 0)
+		return false;
+	
+	// A worker that exits must not take the coordinator down with SIGPIPE
+	signal(SIGPIPE, SIG_IGN);
+	
+	// ------------------------------------------------------------------------
+	// Jobs: centre-out regions, each split into sample ranges
+	// ------------------------------------------------------------------------
+	int jobSamples = m_Settings.JobSamples > 0 ? m_Settings.JobSamples : settings.SamplesPerPixel;
+	TileScheduler regions(settings.Width, settings.Height, m_Settings.JobSize);
+	std::vector<RenderJob> jobs;
+	for (const Tile& region : regions.GetTiles())
+	{
+		for (int first = 0; first < settings.SamplesPerPixel; first += jobSamples)
+			jobs.push_back({ region, first, std::min(first + jobSamples, settings.SamplesPerPixel) });
+	}
+	
+	std::deque<int> pending;
+	for (size_t i = 0; i < jobs.size(); i++)
+		pending.push_back(int(i));
+	
+	// ------------------------------------------------------------------------
+	// Start the workers and wait until each has loaded the scene
+	// ------------------------------------------------------------------------
+	std::vector<WorkerProcess> workers(m_Settings.WorkerCommands.size());
+	auto shutDown = [&]()
+	{
+		for (WorkerProcess& worker : workers)
+			StopWorker(worker);
+	};
+	
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		if (!StartWorker(m_Settings.WorkerCommands[i], workers[i]))
+		{
+			std::cerr << "Failed to start worker: " << m_Settings.WorkerCommands[i] << std::endl;
+			shutDown();
+			return false;
+		}
+	}
+	
+	MessageWriter setup = WriteSetup(scene, camera, settings);
+	for (WorkerProcess& worker : workers)
+		worker.Alive = SendMessage(worker.ToWorker, MessageType::Setup, setup);
+	
+	std::vector<uint8_t> payload;
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		MessageType type;
+		uint8_t ok = 0;
+		if (workers[i].Alive && ReceiveMessage(workers[i].FromWorker, type, payload) && type == MessageType::Ready)
+			MessageReader{ payload }.Get(ok);
+		
+		if (!ok)
+		{
+			std::cerr << "Worker did not get ready: " << m_Settings.WorkerCommands[i] << std::endl;
+			workers[i].Alive = false;
+			m_WorkerStats[i].Failed = true;
+		}
+	}
+	
+	// ------------------------------------------------------------------------
+	// Deal jobs and merge results until every job is in
+	// ------------------------------------------------------------------------
+	std::vector<glm::vec3> sums(image.Pixels.size(), glm::vec3(0.0f));
+	std::vector<float> sumSquares(image.Pixels.size(), 0.0f);
+	std::vector<float> counts(image.Pixels.size(), 0.0f);
+	size_t completed = 0;
+	
+	auto failWorker = [&](size_t i)
+	{
+		WorkerProcess& worker = workers[i];
+		std::cerr << "Worker failed, requeueing " << worker.InFlight.size() << " jobs: "
+		          << m_Settings.WorkerCommands[i] << std::endl;
+		for (int job : worker.InFlight)
+			pending.push_front(job);
+		worker.InFlight.clear();
+		worker.Alive = false;
+		m_WorkerStats[i].Failed = true;
+	};
+	
+	auto mergeResult = [&](size_t i, const std::vector<uint8_t>& data)
+	{
+		MessageReader reader{ data };
+		int32_t id = -1;
+		auto inFlight = workers[i].InFlight.end();
+		if (reader.Get(id))
+			inFlight = std::find(workers[i].InFlight.begin(), workers[i].InFlight.end(), id);
+		if (inFlight == workers[i].InFlight.end() || data.size() != sizeof(int32_t) + size_t(PixelCount(jobs[id].Region)) * 4 * sizeof(float))
+			return false;
+		
+		const RenderJob& job = jobs[id];
+		float samples = float(job.EndSample - job.FirstSample);
+		for (int y = job.Region.Y0; y < job.Region.Y1; y++)
+		{
+			for (int x = job.Region.X0; x < job.Region.X1; x++)
+			{
+				float values[4];
+				reader.Get(values);
+				size_t index = size_t(y) * size_t(settings.Width) + size_t(x);
+				sums[index] += glm::vec3(values[0], values[1], values[2]);
+				sumSquares[index] += values[3];
+				counts[index] += samples;
+			}
+		}
+		
+		workers[i].InFlight.erase(inFlight);
+		m_WorkerStats[i].Jobs++;
+		completed++;
+		return true;
+	};
+	
+	std::vector<pollfd> polls;
+	std::vector<size_t> polled;
+	while (completed < jobs.size())
+	{
+		// Top up every live worker's queue
+		for (size_t i = 0; i < workers.size(); i++)
+		{
+			WorkerProcess& worker = workers[i];
+			while (worker.Alive && !pending.empty() && int(worker.InFlight.size()) < JOBS_IN_FLIGHT)
+			{
+				int id = pending.front();
+				const RenderJob& job = jobs[id];
+				
+				MessageWriter message;
+				message.Put(int32_t(id));
+				message.Put(int32_t(job.Region.X0));
+				message.Put(int32_t(job.Region.Y0));
+				message.Put(int32_t(job.Region.X1));
+				message.Put(int32_t(job.Region.Y1));
+				message.Put(int32_t(job.FirstSample));
+				message.Put(int32_t(job.EndSample));
+				
+				pending.pop_front();
+				worker.InFlight.push_back(id);
+				if (!SendMessage(worker.ToWorker, MessageType::Job, message))
+					failWorker(i);
+			}
+		}
+		
+		polls.clear();
+		polled.clear();
+		for (size_t i = 0; i < workers.size(); i++)
+		{
+			if (workers[i].Alive && !workers[i].InFlight.empty())
+			{
+				polls.push_back({ workers[i].FromWorker, POLLIN, 0 });
+				polled.push_back(i);
+			}
+		}
+		
+		if (polls.empty())
+		{
+			std::cerr << "No workers left with " << jobs.size() - completed << " jobs to go" << std::endl;
+			shutDown();
+			return false;
+		}
+		
+		if (poll(polls.data(), nfds_t(polls.size()), -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			shutDown();
+			return false;
+		}
+		
+		// A readable pipe holds at least the start of a result; the rest is
+		// on its way, so a blocking read of the whole message is fine
+		for (size_t p = 0; p < polls.size(); p++)
+		{
+			if (!(polls[p].revents & (POLLIN | POLLHUP | POLLERR)))
+				continue;
+			
+			size_t i = polled[p];
+			MessageType type;
+			if (!ReceiveMessage(workers[i].FromWorker, type, payload) || type != MessageType::Result || !mergeResult(i, payload))
+				failWorker(i);
+		}
+	}
+	
+	shutDown();
+	
+	// ------------------------------------------------------------------------
+	// Each pixel over its own sample count
+	// ------------------------------------------------------------------------
+	for (size_t i = 0; i < image.Pixels.size(); i++)
+		image.Pixels[i] = sums[i] * (1.0f / counts[i]);
+	
+	if (stats)
+	{
+		*stats = RenderStats{};
+		stats->SamplesPerPixel = settings.SamplesPerPixel;
+		stats->Passes = 1;
+		stats->NoiseError = EstimateNoise(sums, sumSquares, counts);
+		stats->Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	return true;
+}
+
+// ============================================================================
+// WORKER
+// ============================================================================
+int RunRenderWorker(int threads)
+{
+	// The protocol owns stdout; anything else printed goes to stderr
+	int in = STDIN_FILENO;
+	int out = dup(STDOUT_FILENO);
+	dup2(STDERR_FILENO, STDOUT_FILENO);
+	
+	std::unique_ptr<CPUScene> scene;
+	std::unique_ptr<CPURenderer> renderer;
+	RenderCamera camera;
+	RenderSettings settings;
+	
+	MessageType type;
+	std::vector<uint8_t> payload;
+	std::vector<glm::vec3> sums;
+	std::vector<float> sumSquares;
+	while (ReceiveMessage(in, type, payload))
+	{
+		if (type == MessageType::Quit)
+			return 0;
+		
+		if (type == MessageType::Setup)
+		{
+			SceneDescription description;
+			RenderCamera sceneCamera;
+			bool ok = ReadSetup(payload, description, camera, settings);
+			
+			renderer.reset();
+			scene = std::make_unique<CPUScene>();
+			ok = ok && description.Load(*scene, sceneCamera);
+			if (ok)
+				renderer = std::make_unique<CPURenderer>(*scene);
+			settings.Threads = threads;
+			
+			MessageWriter ready;
+			ready.Put(uint8_t(ok));
+			if (!SendMessage(out, MessageType::Ready, ready))
+				return 1;
+			continue;
+		}
+		
+		if (type != MessageType::Job || !renderer)
+		{
+			std::cerr << "[Worker] Unexpected message " << uint32_t(type) << std::endl;
+			return 1;
+		}
+		
+		MessageReader reader{ payload };
+		int32_t id, x0, y0, x1, y1, first, end;
+		if (!(reader.Get(id) && reader.Get(x0) && reader.Get(y0) && reader.Get(x1) && reader.Get(y1) &&
+		      reader.Get(first) && reader.Get(end)) ||
+		    x0 < 0 || y0 < 0 || x1 > settings.Width || y1 > settings.Height || x0 > x1 || y0 > y1)
+		{
+			std::cerr << "[Worker] Malformed job" << std::endl;
+			return 1;
+		}
+		
+		Tile region{ x0, y0, x1, y1, 0 };
+		size_t count = size_t(PixelCount(region));
+		sums.assign(count, glm::vec3(0.0f));
+		sumSquares.assign(count, 0.0f);
+		renderer->RenderRegion(camera, settings, region, first, end, sums.data(), sumSquares.data());
+		
+		MessageWriter result;
+		result.Data.reserve(sizeof(int32_t) + count * 4 * sizeof(float));
+		result.Put(id);
+		for (size_t i = 0; i < count; i++)
+		{
+			result.PutVec3(sums[i]);
+			result.Put(sumSquares[i]);
+		}
+		if (!SendMessage(out, MessageType::Result, result))
+			return 1;
+	}
+	
+	// Coordinator went away without Quit
+	return 0;
+}
+
+#else
+
+// ============================================================================
+// WINDOWS
+// ============================================================================
+bool RenderCoordinator::Render(const SceneDescription&, const RenderCamera&, const RenderSettings&, Image&, RenderStats*)
+{
+	std::cerr << "Distributed rendering needs a POSIX system" << std::endl;
+	return false;
+}
+
+int RunRenderWorker(int)
+{
+	std::cerr << "Distributed rendering needs a POSIX system" << std::endl;
+	return 1;
+}
+
+#endif
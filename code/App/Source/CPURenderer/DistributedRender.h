@@ -0,0 +1,141 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "CPURenderer.h"
+
+// ============================================================================
+// DISTRIBUTED RENDER - Coordinator and Worker Processes
+// ============================================================================
+//
+// One process stops at one machine. RenderCoordinator cuts a frame into
+// jobs (JobSize² regions, optionally split further into sample ranges),
+// deals them to worker processes and merges the float tiles they send back:
+//
+//   coordinator                                worker
+//   -----------                                ------
+//   Setup (scene, camera, settings)  ------>   loads the scene
+//                                    <------   Ready
+//   Job (region, samples [a, b))     ------>   CPURenderer::RenderRegion
+//                                    <------   Result (sums, squared sums)
+//   ...
+//   Quit                             ------>
+//
+// A worker is any shell command whose stdin/stdout speak this protocol:
+// "cg_render_cpu --worker" for a local process, "ssh node7 cg_render_cpu
+// --worker" for another machine (OBJ paths must resolve there as well, and
+// all machines must share the byte order). Local processes stand in for
+// remote ones in tests, since the coordinator cannot tell them apart.
+//
+// SCHEDULING:
+// -----------
+// Jobs go out in the centre-out tile order. Each worker has up to
+// JOBS_IN_FLIGHT jobs queued so it never waits a round trip between jobs,
+// and gets the next one whenever a result comes back, so faster machines
+// take more of the frame. If a worker dies, its unfinished jobs go back to
+// the queue for the others.
+//
+// MERGING:
+// --------
+// Results carry per-pixel sums and the sample range they cover, not
+// averages. The coordinator adds them up and divides each pixel by its own
+// sample count. With whole-range jobs (JobSamples = 0) each pixel arrives
+// in one piece, and the image is bit-identical to CPURenderer::Render with
+// the same settings.
+//
+// POSIX only (fork/exec and pipes); on Windows Render reports an error.
+//
+// USAGE EXAMPLE:
+// --------------
+//   DistributedSettings distributed;
+//   distributed.WorkerCommands = { "cg_render_cpu --worker", "ssh node2 cg_render_cpu --worker" };
+//
+//   RenderCoordinator coordinator(distributed);
+//   Image image;
+//   if (coordinator.Render(sceneDescription, camera, settings, image))
+//       image.Write("out.pfm");
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// SceneDescription
+// ----------------------------------------------------------------------------
+// What to load rather than the loaded scene, so every worker can build its
+// own CPUScene.
+// ----------------------------------------------------------------------------
+struct SceneDescription
+{
+	int ProceduralIndex = 0;
+	std::string OBJPath;        // Non-empty = OBJ scene instead of procedural
+	bool Quadrics = true;       // Add the default quadrics
+	bool Skybox = false;
+	
+	// Loads the scene; camera receives the OBJ's 'c' camera if it has one.
+	// Prints the reason and returns false on failure.
+	bool Load(CPUScene& scene, RenderCamera& camera) const;
+};
+
+// ----------------------------------------------------------------------------
+// DistributedSettings
+// ----------------------------------------------------------------------------
+struct DistributedSettings
+{
+	std::vector<std::string> WorkerCommands;    // One worker process each
+	int JobSize = 128;                          // Job region edge in pixels
+	int JobSamples = 0;                         // Samples per job, 0 = all
+};
+
+// ----------------------------------------------------------------------------
+// WorkerStats
+// ----------------------------------------------------------------------------
+struct WorkerStats
+{
+	std::string Command;
+	int Jobs = 0;           // Results merged from this worker
+	bool Failed = false;    // Died or broke the protocol
+};
+
+// ============================================================================
+// RENDER COORDINATOR CLASS
+// ============================================================================
+class RenderCoordinator
+{
+public:
+	static constexpr int JOBS_IN_FLIGHT = 2;
+	
+	explicit RenderCoordinator(const DistributedSettings& settings);
+	
+	// ========================================================================
+	// Render
+	// ========================================================================
+	// Starts the workers, renders SamplesPerPixel samples per pixel across
+	// them (the progressive settings do not apply) and shuts them down.
+	// settings.Threads is left to each worker's own command line.
+	//
+	// Returns:
+	//   bool - false if a worker command could not be started, or every
+	//          worker failed before the frame was complete
+	// ========================================================================
+	bool Render(const SceneDescription& scene, const RenderCamera& camera, const RenderSettings& settings,
+	            Image& image, RenderStats* stats = nullptr);
+	
+	// Per-worker results of the last Render(), in WorkerCommands order
+	const std::vector<WorkerStats>& GetWorkerStats() const { return m_WorkerStats; }
+
+private:
+	DistributedSettings m_Settings;
+	std::vector<WorkerStats> m_WorkerStats;
+};
+
+// ============================================================================
+// RunRenderWorker
+// ============================================================================
+// Worker side: serves the protocol on stdin/stdout until Quit or end of
+// input, rendering each job with threads threads (0 = all). stdout is
+// redirected to stderr meanwhile, so log lines cannot corrupt the stream.
+//
+// Returns:
+//   int - process exit code
+// ============================================================================
+int RunRenderWorker(int threads);
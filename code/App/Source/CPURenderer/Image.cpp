@@ -0,0 +1,176 @@
+#include "Image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// ============================================================================
+// TONEMAPPING OPERATORS (Display.glsl)
+// ============================================================================
+
+static glm::vec3 TonemapReinhard(const glm::vec3& color)
+{
+	return color / (color + glm::vec3(1.0f));
+}
+
+static glm::vec3 TonemapACES(glm::vec3 color)
+{
+	// sRGB => XYZ => D65_2_D60 => AP1 => RRT_SAT (columns, as in GLSL)
+	const glm::mat3 inputMat(glm::vec3(0.59719f, 0.07600f, 0.02840f),
+	                         glm::vec3(0.35458f, 0.90834f, 0.13383f),
+	                         glm::vec3(0.04823f, 0.01566f, 0.83777f));
+	
+	// ODT_SAT => XYZ => D60_2_D65 => sRGB
+	const glm::mat3 outputMat(glm::vec3(1.60475f, -0.10208f, -0.00327f),
+	                          glm::vec3(-0.53108f, 1.10813f, -0.07276f),
+	                          glm::vec3(-0.07367f, -0.00605f, 1.07602f));
+	
+	color = inputMat * color;
+	
+	// Apply RRT and ODT
+	glm::vec3 a = color * (color + 0.0245786f) - 0.000090537f;
+	glm::vec3 b = color * (0.983729f * color + 0.4329510f) + 0.238081f;
+	color = outputMat * (a / b);
+	
+	return glm::clamp(color, 0.0f, 1.0f);
+}
+
+static glm::vec3 Uncharted2Tonemap(const glm::vec3& x)
+{
+	const float A = 0.15f;  // Shoulder strength
+	const float B = 0.50f;  // Linear strength
+	const float C = 0.10f;  // Linear angle
+	const float D = 0.20f;  // Toe strength
+	const float E = 0.02f;  // Toe numerator
+	const float F = 0.30f;  // Toe denominator
+	
+	return ((x * (A * x + C * B) + D * E) / (x * (A * x + B) + D * F)) - E / F;
+}
+
+static glm::vec3 TonemapUncharted2(const glm::vec3& color)
+{
+	const float W = 11.2f;  // Linear white point value
+	const float exposureBias = 2.0f;
+	
+	glm::vec3 curr = Uncharted2Tonemap(exposureBias * color);
+	glm::vec3 whiteScale = glm::vec3(1.0f) / Uncharted2Tonemap(glm::vec3(W));
+	
+	return curr * whiteScale;
+}
+
+static float Vignette(const glm::vec2& uv, float intensity, float roundness)
+{
+	glm::vec2 centered = uv * 2.0f - 1.0f;
+	float dist = glm::length(centered * glm::vec2(1.0f, roundness)) * intensity;
+	
+	// smoothstep(1.4, 0.5, dist)
+	float t = std::clamp((dist - 1.4f) / (0.5f - 1.4f), 0.0f, 1.0f);
+	return t * t * (3.0f - 2.0f * t);
+}
+
+glm::vec3 ApplyDisplayTransform(glm::vec3 color, const glm::vec2& uv, const DisplaySettings& display)
+{
+	color *= display.Exposure > 0.0f ? display.Exposure : 1.0f;
+	
+	if (display.Tonemapper == 1)
+		color = TonemapReinhard(color);
+	else if (display.Tonemapper == 2)
+		color = TonemapACES(color);
+	else if (display.Tonemapper == 3)
+		color = TonemapUncharted2(color);
+	
+	color *= Vignette(uv, 0.4f, 0.8f);
+	
+	float gamma = display.Gamma > 0.0f ? display.Gamma : 2.2f;
+	for (int c = 0; c < 3; c++)
+		color[c] = std::pow(std::max(color[c], 0.0f), 1.0f / gamma);
+	
+	return glm::clamp(color, 0.0f, 1.0f);
+}
+
+// ============================================================================
+// FILE OUTPUT
+// ============================================================================
+
+bool Image::Write(const std::filesystem::path& path, const DisplaySettings& display) const
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	
+	if (extension == ".pfm")
+		return WritePFM(path);
+	if (extension == ".ppm")
+		return WritePPM(path, display);
+	
+	std::cerr << "[Image] Unsupported output format: " << path.string() << " (use .pfm or .ppm)" << std::endl;
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+// WritePFM
+// ----------------------------------------------------------------------------
+// "PF" header, negative scale for little-endian floats, rows bottom to top.
+// ----------------------------------------------------------------------------
+bool Image::WritePFM(const std::filesystem::path& path) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		std::cerr << "[Image] Cannot open " << path.string() << std::endl;
+		return false;
+	}
+	
+	const uint16_t probe = 1;
+	bool littleEndian = *reinterpret_cast<const uint8_t*>(&probe) == 1;
+	file << "PF\n" << Width << " " << Height << "\n" << (littleEndian ? "-1.0" : "1.0") << "\n";
+	
+	std::vector<float> row(size_t(Width) * 3);
+	for (int y = Height - 1; y >= 0; y--)
+	{
+		for (int x = 0; x < Width; x++)
+		{
+			const glm::vec3& pixel = At(x, y);
+			row[size_t(x) * 3 + 0] = pixel.r;
+			row[size_t(x) * 3 + 1] = pixel.g;
+			row[size_t(x) * 3 + 2] = pixel.b;
+		}
+		file.write(reinterpret_cast<const char*>(row.data()), std::streamsize(row.size() * sizeof(float)));
+	}
+	
+	return bool(file);
+}
+
+// ----------------------------------------------------------------------------
+// WritePPM
+// ----------------------------------------------------------------------------
+// Binary "P6", rows top to bottom, after the display transform.
+// ----------------------------------------------------------------------------
+bool Image::WritePPM(const std::filesystem::path& path, const DisplaySettings& display) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		std::cerr << "[Image] Cannot open " << path.string() << std::endl;
+		return false;
+	}
+	
+	file << "P6\n" << Width << " " << Height << "\n255\n";
+	
+	std::vector<uint8_t> row(size_t(Width) * 3);
+	for (int y = 0; y < Height; y++)
+	{
+		for (int x = 0; x < Width; x++)
+		{
+			glm::vec2 uv((x + 0.5f) / Width, (Height - y - 0.5f) / Height);
+			glm::vec3 color = ApplyDisplayTransform(At(x, y), uv, display);
+			for (int c = 0; c < 3; c++)
+				row[size_t(x) * 3 + c] = static_cast<uint8_t>(color[c] * 255.0f + 0.5f);
+		}
+		file.write(reinterpret_cast<const char*>(row.data()), std::streamsize(row.size()));
+	}
+	
+	return bool(file);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// ============================================================================
+// IMAGE - Linear HDR Framebuffer and File Output
+// ============================================================================
+//
+// Output of the CPU renderer. Two formats, picked by file extension:
+//
+//   .pfm  - Linear float RGB (Portable Float Map). Exact accumulated
+//           radiance, for diffing against the GPU path or another run.
+//   .ppm  - 8-bit binary RGB after the Display.glsl pipeline (exposure,
+//           tonemapping, vignette, gamma), i.e. what the window shows.
+//
+// Both are written without external libraries.
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// DisplaySettings
+// ----------------------------------------------------------------------------
+// Post-processing applied to .ppm output (uniforms of Display.glsl).
+// ----------------------------------------------------------------------------
+struct DisplaySettings
+{
+	float Exposure = 1.0f;
+	float Gamma = 2.2f;
+	int Tonemapper = 2;     // 0 = None, 1 = Reinhard, 2 = ACES, 3 = Uncharted2
+};
+
+// ----------------------------------------------------------------------------
+// Image
+// ----------------------------------------------------------------------------
+// Row-major linear RGB, row 0 at the top.
+// ----------------------------------------------------------------------------
+struct Image
+{
+	int Width = 0;
+	int Height = 0;
+	std::vector<glm::vec3> Pixels;
+	
+	Image() = default;
+	Image(int width, int height)
+		: Width(width), Height(height), Pixels(size_t(width) * size_t(height), glm::vec3(0.0f))
+	{}
+	
+	glm::vec3& At(int x, int y) { return Pixels[size_t(y) * Width + x]; }
+	const glm::vec3& At(int x, int y) const { return Pixels[size_t(y) * Width + x]; }
+	
+	// ========================================================================
+	// Write
+	// ========================================================================
+	// Writes .pfm (linear) or .ppm (display-mapped) depending on the
+	// extension. Returns false on unknown extensions or I/O errors.
+	// ========================================================================
+	bool Write(const std::filesystem::path& path, const DisplaySettings& display = {}) const;
+	
+	bool WritePFM(const std::filesystem::path& path) const;
+	bool WritePPM(const std::filesystem::path& path, const DisplaySettings& display = {}) const;
+};
+
+// Display.glsl for one pixel: exposure, tonemapping, vignette and gamma.
+// uv is the pixel center in [0, 1]² with v = 0 at the bottom.
+glm::vec3 ApplyDisplayTransform(glm::vec3 color, const glm::vec2& uv, const DisplaySettings& display);
@@ -0,0 +1,180 @@
+#include "Material.h"
+#include "SceneManager/SceneManager.h"
+#include "Math/MonteCarlo.h"
+#include "Math/Utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// FACTORIES
+// ============================================================================
+Material Material::Create(const glm::vec3& albedo, float roughness, float metallic)
+{
+	Material m;
+	m.Albedo = albedo;
+	m.Roughness = std::max(roughness, 0.04f);  // Prevent perfect mirror (numerical issues)
+	m.Metallic = metallic;
+	return m;
+}
+
+Material Material::CreateEmissive(const glm::vec3& color, float strength)
+{
+	Material m = Create(color, 1.0f, 0.0f);
+	m.Emission = color;
+	m.EmissionStrength = strength;
+	return m;
+}
+
+Material Material::CreateGlass(const glm::vec3& tint, float roughness, float ior)
+{
+	Material m = Create(tint, roughness, 0.0f);
+	m.IOR = ior;
+	m.Transmission = 1.0f;
+	return m;
+}
+
+Material Material::FromOBJ(const OBJMaterial& material)
+{
+	Material m;
+	m.Albedo = material.Albedo;
+	m.Roughness = std::max(material.Roughness, 0.04f);
+	m.Metallic = material.Metallic;
+	m.Emission = material.Emission;
+	m.EmissionStrength = material.EmissionStrength;
+	m.IOR = material.IOR;
+	m.Transmission = material.Transmission;
+	return m;
+}
+
+// ============================================================================
+// BRDF
+// ============================================================================
+namespace BRDF
+{
+	// Orthonormal basis around n (see MonteCarlo::orthonormalBasis)
+	static void CreateONB(const glm::vec3& n, glm::vec3& t, glm::vec3& b)
+	{
+		Vec3 tangent, bitangent;
+		MonteCarlo::orthonormalBasis(Vec3(n.x, n.y, n.z), tangent, bitangent);
+		t = glm::vec3(tangent.x, tangent.y, tangent.z);
+		b = glm::vec3(bitangent.x, bitangent.y, bitangent.z);
+	}
+	
+	static glm::vec3 Reflect(const glm::vec3& I, const glm::vec3& N)
+	{
+		return I - 2.0f * glm::dot(N, I) * N;
+	}
+	
+	glm::vec3 FresnelSchlick(float cosTheta, const glm::vec3& F0)
+	{
+		return F0 + (glm::vec3(1.0f) - F0) * std::pow(MathUtils::saturate(1.0f - cosTheta), 5.0f);
+	}
+	
+	float DistributionGGX(float NdotH, float roughness)
+	{
+		float a = roughness * roughness;
+		float a2 = a * a;
+		float NdotH2 = NdotH * NdotH;
+		
+		float denom = NdotH2 * (a2 - 1.0f) + 1.0f;
+		denom = PI * denom * denom;
+		
+		return a2 / std::max(denom, 0.0001f);
+	}
+	
+	static float GeometrySchlickGGX(float NdotV, float roughness)
+	{
+		float r = roughness + 1.0f;
+		float k = (r * r) / 8.0f;
+		
+		return NdotV / std::max(NdotV * (1.0f - k) + k, 0.0001f);
+	}
+	
+	float GeometrySmith(float NdotV, float NdotL, float roughness)
+	{
+		return GeometrySchlickGGX(NdotV, roughness) * GeometrySchlickGGX(NdotL, roughness);
+	}
+	
+	glm::vec3 Evaluate(const glm::vec3& V, const glm::vec3& L, const glm::vec3& N, const Material& material)
+	{
+		glm::vec3 H = glm::normalize(V + L);
+		
+		float NdotV = std::max(glm::dot(N, V), 0.0001f);
+		float NdotL = std::max(glm::dot(N, L), 0.0001f);
+		float NdotH = std::max(glm::dot(N, H), 0.0f);
+		float HdotV = std::max(glm::dot(H, V), 0.0f);
+		
+		// Base reflectivity (dielectric = 0.04, metal = albedo)
+		glm::vec3 F0 = glm::mix(glm::vec3(0.04f), material.Albedo, material.Metallic);
+		
+		// Cook-Torrance specular BRDF
+		float D = DistributionGGX(NdotH, material.Roughness);
+		glm::vec3 F = FresnelSchlick(HdotV, F0);
+		float G = GeometrySmith(NdotV, NdotL, material.Roughness);
+		
+		glm::vec3 specular = (D * G * F) / (4.0f * NdotV * NdotL + 0.0001f);
+		
+		// Diffuse BRDF (Lambertian with energy conservation)
+		glm::vec3 kD = (glm::vec3(1.0f) - F) * (1.0f - material.Metallic);
+		glm::vec3 diffuse = kD * material.Albedo * INV_PI;
+		
+		return diffuse + specular;
+	}
+	
+	glm::vec3 SampleGGX(const glm::vec3& N, float roughness)
+	{
+		float a = roughness * roughness;
+		float a2 = a * a;
+		
+		float r1 = MonteCarlo::randomFloat();
+		float r2 = MonteCarlo::randomFloat();
+		
+		float phi = TWO_PI * r1;
+		float cosTheta = std::sqrt((1.0f - r2) / (1.0f + (a2 - 1.0f) * r2));
+		float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+		
+		glm::vec3 T, B;
+		CreateONB(N, T, B);
+		return glm::normalize(T * (sinTheta * std::cos(phi)) + B * (sinTheta * std::sin(phi)) + N * cosTheta);
+	}
+	
+	glm::vec3 Sample(const glm::vec3& V, const glm::vec3& N, const Material& material, glm::vec3& throughput)
+	{
+		// kd probability (diffuse weight)
+		float diffuseWeight = (1.0f - material.Metallic) * 0.5f;
+		
+		if (MonteCarlo::randomFloat() < diffuseWeight)
+		{
+			// DIFFUSE ray, cosine-weighted: pdf = cos(theta) / PI
+			Vec3 sample = MonteCarlo::randomCosineDirectionInHemisphere(Vec3(N.x, N.y, N.z));
+			glm::vec3 L(sample.x, sample.y, sample.z);
+			
+			float NdotL = std::max(glm::dot(N, L), 0.0f);
+			float pdf = NdotL * INV_PI;
+			throughput = Evaluate(V, L, N, material) * NdotL / std::max(pdf, 0.0001f);
+			return L;
+		}
+		
+		// SPECULAR ray: reflect about a GGX half vector
+		glm::vec3 H = SampleGGX(N, material.Roughness);
+		glm::vec3 L = Reflect(-V, H);
+		
+		if (glm::dot(L, N) <= 0.0f)
+		{
+			throughput = glm::vec3(0.0f);
+			return L;
+		}
+		
+		float NdotL = std::max(glm::dot(N, L), 0.0f);
+		float NdotH = std::max(glm::dot(N, H), 0.0f);
+		float HdotV = std::max(glm::dot(H, V), 0.0f);
+		
+		// GGX PDF = D * NdotH / (4 * HdotV)
+		float D = DistributionGGX(NdotH, material.Roughness);
+		float pdf = D * NdotH / (4.0f * HdotV + 0.0001f);
+		
+		throughput = Evaluate(V, L, N, material) * NdotL / std::max(pdf, 0.0001f);
+		return L;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct OBJMaterial;
+
+// ============================================================================
+// MATERIAL - CPU Port of the PathTrace.glsl Material Model
+// ============================================================================
+//
+// Same parameters, factories and Cook-Torrance BRDF as the shader, so the
+// CPU renderer and the GPU path converge to the same image. Random numbers
+// come from MonteCarlo (per-thread generator).
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Material
+// ----------------------------------------------------------------------------
+// PBR Disney-inspired parameters (struct Material in PathTrace.glsl).
+// ----------------------------------------------------------------------------
+struct Material
+{
+	glm::vec3 Albedo = glm::vec3(0.8f);     // Base color
+	float Roughness = 0.9f;                 // Surface roughness [0.04, 1]
+	float Metallic = 0.0f;                  // Metalness [0, 1]
+	glm::vec3 Emission = glm::vec3(0.0f);   // Emissive color
+	float EmissionStrength = 0.0f;          // Emission intensity
+	float IOR = 1.5f;                       // Index of refraction (glass)
+	float Transmission = 0.0f;              // Transmission amount (glass)
+	
+	// createMaterial / createEmissive / createGlass in the shader
+	static Material Create(const glm::vec3& albedo, float roughness, float metallic);
+	static Material CreateEmissive(const glm::vec3& color, float strength);
+	static Material CreateGlass(const glm::vec3& tint, float roughness, float ior);
+	
+	// getMaterialFromTexture in the shader: an MTL material as uploaded by
+	// SceneManager::UploadToGPU
+	static Material FromOBJ(const OBJMaterial& material);
+};
+
+// ============================================================================
+// BRDF - Physically Based Rendering Functions
+// ============================================================================
+namespace BRDF
+{
+	// Fresnel-Schlick approximation
+	glm::vec3 FresnelSchlick(float cosTheta, const glm::vec3& F0);
+	
+	// GGX/Trowbridge-Reitz normal distribution function
+	float DistributionGGX(float NdotH, float roughness);
+	
+	// Smith's geometry function (Schlick-GGX)
+	float GeometrySmith(float NdotV, float NdotL, float roughness);
+	
+	// Full Cook-Torrance BRDF (specular + energy-conserving Lambert)
+	glm::vec3 Evaluate(const glm::vec3& V, const glm::vec3& L, const glm::vec3& N, const Material& material);
+	
+	// GGX half-vector sample around N
+	glm::vec3 SampleGGX(const glm::vec3& N, float roughness);
+	
+	// Choose a diffuse or specular direction (sampleBRDF in the shader).
+	// throughput receives brdf * cos / pdf, zero for samples below the surface.
+	glm::vec3 Sample(const glm::vec3& V, const glm::vec3& N, const Material& material, glm::vec3& throughput);
+}
@@ -0,0 +1,145 @@
+#include "TileScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+// Cuts the image into tiles and sorts them into a square spiral around the
+// image centre: by ring (Chebyshev distance in tiles), then by angle within
+// the ring.
+// ============================================================================
+TileScheduler::TileScheduler(int width, int height, int tileSize)
+{
+	tileSize = std::max(tileSize, 1);
+	int tilesX = (std::max(width, 0) + tileSize - 1) / tileSize;
+	int tilesY = (std::max(height, 0) + tileSize - 1) / tileSize;
+	
+	struct SpiralKey
+	{
+		int Ring;
+		float Angle;
+	};
+	std::vector<SpiralKey> keys;
+	
+	m_Tiles.reserve(size_t(tilesX) * size_t(tilesY));
+	keys.reserve(size_t(tilesX) * size_t(tilesY));
+	for (int ty = 0; ty < tilesY; ty++)
+	{
+		for (int tx = 0; tx < tilesX; tx++)
+		{
+			Tile tile;
+			tile.X0 = tx * tileSize;
+			tile.Y0 = ty * tileSize;
+			tile.X1 = std::min(tile.X0 + tileSize, width);
+			tile.Y1 = std::min(tile.Y0 + tileSize, height);
+			tile.Index = 0;
+			m_Tiles.push_back(tile);
+			
+			// Tile centre relative to the image centre, in tiles
+			float dx = ((tile.X0 + tile.X1) * 0.5f - width * 0.5f) / tileSize;
+			float dy = ((tile.Y0 + tile.Y1) * 0.5f - height * 0.5f) / tileSize;
+			keys.push_back({ int(std::lround(std::max(std::abs(dx), std::abs(dy)))), std::atan2(dy, dx) });
+		}
+	}
+	
+	std::vector<int> order(m_Tiles.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = int(i);
+	
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+	{
+		if (keys[a].Ring != keys[b].Ring)
+			return keys[a].Ring < keys[b].Ring;
+		return keys[a].Angle < keys[b].Angle;
+	});
+	
+	std::vector<Tile> sorted;
+	sorted.reserve(m_Tiles.size());
+	for (int index : order)
+	{
+		sorted.push_back(m_Tiles[index]);
+		sorted.back().Index = int(sorted.size()) - 1;
+	}
+	m_Tiles = std::move(sorted);
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+bool TileScheduler::Run(int threadCount, const TileFunction& function, const std::atomic<bool>* cancel)
+{
+	if (m_Tiles.empty())
+		return true;
+	
+	if (threadCount <= 0)
+		threadCount = int(std::max(std::thread::hardware_concurrency(), 1u));
+	threadCount = std::min(threadCount, int(m_Tiles.size()));
+	
+	// Deal the centre-out order round-robin: every worker starts near the
+	// centre, and the front of each deque stays ahead of the back
+	m_Queues.clear();
+	for (int i = 0; i < threadCount; i++)
+		m_Queues.push_back(std::make_unique<WorkerQueue>());
+	for (size_t i = 0; i < m_Tiles.size(); i++)
+		m_Queues[i % threadCount]->Tiles.push_back(int(i));
+	
+	m_Stolen.store(0, std::memory_order_relaxed);
+	
+	auto worker = [&](int index)
+	{
+		int tile;
+		while (!(cancel && cancel->load(std::memory_order_relaxed)) && NextTile(index, tile))
+			function(m_Tiles[tile], index);
+	};
+	
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (int i = 1; i < threadCount; i++)
+		threads.emplace_back(worker, i);
+	
+	worker(0);
+	
+	for (std::thread& thread : threads)
+		thread.join();
+	
+	return !(cancel && cancel->load(std::memory_order_relaxed));
+}
+
+// ----------------------------------------------------------------------------
+// NextTile
+// ----------------------------------------------------------------------------
+// Tiles are never added during a run, so once every deque has been seen
+// empty there is no work left.
+// ----------------------------------------------------------------------------
+bool TileScheduler::NextTile(int worker, int& tile)
+{
+	{
+		WorkerQueue& own = *m_Queues[worker];
+		std::lock_guard<std::mutex> lock(own.Mutex);
+		if (!own.Tiles.empty())
+		{
+			tile = own.Tiles.front();
+			own.Tiles.pop_front();
+			return true;
+		}
+	}
+	
+	int count = int(m_Queues.size());
+	for (int offset = 1; offset < count; offset++)
+	{
+		WorkerQueue& victim = *m_Queues[(worker + offset) % count];
+		std::lock_guard<std::mutex> lock(victim.Mutex);
+		if (!victim.Tiles.empty())
+		{
+			tile = victim.Tiles.back();
+			victim.Tiles.pop_back();
+			m_Stolen.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	
+	return false;
+}
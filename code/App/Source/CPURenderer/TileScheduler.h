@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ============================================================================
+// TILE SCHEDULER - Work-Stealing Tile Distribution for CPU Rendering
+// ============================================================================
+//
+// Tile cost varies by orders of magnitude (a glass sphere tile traces many
+// more bounces than a background tile), so a static split leaves threads
+// idle while one finishes the expensive region. The scheduler balances
+// dynamically:
+//
+//   - Tiles are ordered in a spiral from the image centre outwards, so the
+//     part of the frame a viewer looks at first finishes first
+//   - The ordered list is dealt round-robin into one deque per worker
+//   - A worker pops from the front of its own deque; when that is empty it
+//     steals from the back of another worker's deque, starting with the
+//     neighbour and moving round the ring
+//
+// Each deque has its own mutex. Locks are taken once per tile (thousands of
+// rays), so they never show up next to the tracing work, and workers only
+// contend while stealing.
+//
+// CANCELLATION:
+// -------------
+// Run() takes an optional flag owned by the caller. Any thread may set it;
+// workers check it before taking each tile, so Run() returns at most one
+// tile time later.
+//
+// USAGE EXAMPLE:
+// --------------
+//   TileScheduler scheduler(width, height, 32);
+//   bool finished = scheduler.Run(threadCount, [&](const Tile& tile, int worker)
+//   {
+//       for (int y = tile.Y0; y < tile.Y1; y++)
+//           for (int x = tile.X0; x < tile.X1; x++)
+//               RenderPixel(x, y);
+//   });
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tile
+// ----------------------------------------------------------------------------
+// Pixel rectangle [X0, X1) x [Y0, Y1), rows counted from the top.
+// ----------------------------------------------------------------------------
+struct Tile
+{
+	int X0, Y0;
+	int X1, Y1;
+	int Index;      // Position in the centre-out order
+};
+
+// ============================================================================
+// TILE SCHEDULER CLASS
+// ============================================================================
+class TileScheduler
+{
+public:
+	using TileFunction = std::function<void(const Tile& tile, int worker)>;
+	
+	TileScheduler(int width, int height, int tileSize);
+	
+	// ========================================================================
+	// Run
+	// ========================================================================
+	// Renders every tile once with threadCount workers (0 = all hardware
+	// threads). The calling thread is worker 0. Blocks until all tiles are
+	// done or the run was cancelled.
+	//
+	// Returns:
+	//   bool - true if every tile was rendered, false if cancel was set
+	// ========================================================================
+	bool Run(int threadCount, const TileFunction& function, const std::atomic<bool>* cancel = nullptr);
+	
+	// Tiles in centre-out order
+	const std::vector<Tile>& GetTiles() const { return m_Tiles; }
+	
+	// Tiles taken from another worker in the last Run()
+	int GetStolenCount() const { return m_Stolen.load(std::memory_order_relaxed); }
+
+private:
+	struct WorkerQueue
+	{
+		std::mutex Mutex;
+		std::deque<int> Tiles;
+	};
+	
+	// Next tile for worker: own front first, then steal a victim's back
+	bool NextTile(int worker, int& tile);
+	
+	std::vector<Tile> m_Tiles;
+	std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+	std::atomic<int> m_Stolen{ 0 };
+};
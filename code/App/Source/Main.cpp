@@ -5,9 +5,13 @@
 #include <iostream>
 #include <filesystem>
 #include <vector>
+#include <algorithm>
 #include <cstdlib>
 #include <chrono>
+#include <memory>
 #include <thread>
+#include <utility>
+#include <map>
 
 #ifdef __APPLE__
 #include <mach-o/dyld.h>
@@ -24,7 +28,10 @@
 #include "Shader.h"
 #include "Renderer.h"
 #include "SceneManager/SceneManager.h"
+#include "SceneManager/QuadricTessellator.h"
 #include "QuadricManager/QuadricManager.h"
+#include "CPURenderer/BackgroundRenderer.h"
+#include "Math/Sampler.h"
 
 // ============================================================================
 // CONFIGURATION
@@ -186,6 +193,7 @@ static GLuint s_VAO = 0;
 static Texture s_PathTraceTexture;
 static Framebuffer s_PathTraceFB;
 static Texture s_AccumTextures[2];
+static Texture s_AccumStatsTextures[2];  // Per pixel: samples, relative error
 static Framebuffer s_AccumFB[2];
 
 static int s_FrameIndex = 0;
@@ -199,31 +207,104 @@ static SceneManager s_SceneManager;
 static bool s_UseOBJScene = false;
 static bool s_UseCornellBoxScene = false;
 
-// Quadric mesh files for cycling with 'M' key
-static const std::vector<std::string> s_QuadricMeshFiles = {
-	"assets/box.obj",                         // 0: Unit Cube
-	"assets/sphere.obj",                      // 1: Icosphere
-	"assets/cylinder.obj",                    // 2: Cylinder
-	"assets/cone.obj",                        // 3: Cone
-	"assets/ellipsoid.obj",                   // 4: Ellipsoid
-	"assets/elliptic_paraboloid.obj",         // 5: Elliptic Paraboloid
-	"assets/hyperbolic_paraboloid.obj",       // 6: Hyperbolic Paraboloid
-	"assets/hyperboloid_one_sheet.obj",       // 7: Hyperboloid One Sheet
-	"assets/hyperboloid_two_sheets.obj"       // 8: Hyperboloid Two Sheets
+// Quadric surfaces previewed with the 'M' key. Each one is tessellated into
+// a few LODs when selected (see QuadricTessellator) instead of being loaded
+// from a fixed-resolution mesh file.
+struct QuadricPreview
+{
+	const char* Name;
+	const char* Material;                 // Material name in quadric_materials.mtl
+	Quadric::QuadricSurface Surface;
 };
-static const std::vector<std::string> s_QuadricMeshNames = {
-	"Box (Cube)",
-	"Sphere (Icosphere)",
-	"Cylinder",
-	"Cone",
-	"Ellipsoid",
-	"Elliptic Paraboloid (Bowl)",
-	"Hyperbolic Paraboloid (Saddle)",
-	"Hyperboloid of One Sheet",
-	"Hyperboloid of Two Sheets"
+static const std::vector<QuadricPreview> s_QuadricPreviews = {
+	{ "Sphere",                         "metallic_gold",   Quadric::QuadricSurface::CreateSphere(1.0f) },
+	{ "Cylinder",                       "diffuse_blue",    Quadric::QuadricSurface::CreateCylinder(1.0f, 2.0f) },
+	{ "Cone",                           "diffuse_red",     Quadric::QuadricSurface::CreateCone(0.4636f, 2.0f) },
+	{ "Ellipsoid",                      "glass_tinted",    Quadric::QuadricSurface::CreateEllipsoid(2.0f, 1.0f, 0.5f) },
+	{ "Elliptic Paraboloid (Bowl)",     "smooth_surface",  Quadric::QuadricSurface::CreateEllipticParaboloid(1.0f, 1.0f, 1.0f) },
+	{ "Hyperbolic Paraboloid (Saddle)", "semi_rough",      Quadric::QuadricSurface::CreateHyperbolicParaboloid(1.0f, 1.0f, 1.0f) },
+	{ "Hyperboloid of One Sheet",       "metallic_chrome", Quadric::QuadricSurface::CreateHyperboloidOneSheet(1.0f, 1.0f, 1.0f, 2.0f) },
+	{ "Hyperboloid of Two Sheets",      "emissive_warm",   Quadric::QuadricSurface::CreateHyperboloidTwoSheets(1.0f, 1.0f, 1.0f, 5.0f) }
 };
+
+// Viewing distances the preview LODs are built for, and their error budget
+static const std::vector<float> s_PreviewLODDistances = { 2.5f, 5.0f, 10.0f, 20.0f, 40.0f };
+static constexpr float PREVIEW_PIXEL_ERROR = 4.0f;
+
+static Quadric::QuadricSurface s_PreviewSurface;     // Current preview, fitted to the 6-unit box
+static std::vector<TessellationLOD> s_PreviewLODs;
+static size_t s_PreviewLOD = 0;
 static int s_CurrentMeshIndex = -1;  // Start at -1 so first press loads index 0
 
+// ============================================================================
+// CPU REFERENCE RENDER
+// ============================================================================
+// 'C' renders the current view on the CPU in the background and writes
+// cpu_reference.pfm. Every accumulation reset restarts it, so a camera move
+// cancels the stale frame within one tile time.
+static constexpr int CPU_REFERENCE_SPP = 64;
+static std::unique_ptr<BackgroundRenderer> s_CPUReference;
+static std::shared_ptr<const CPUScene> s_CPUScene;
+static bool s_CPUSceneDirty = true;  // Scene or quadrics changed since s_CPUScene was built
+
+// ============================================================================
+// SAMPLER
+// ============================================================================
+// 'L' cycles the sample sequence PathTrace.glsl draws from. The shader reads
+// one baked row per frame (see Sampler::buildTable); the CPU reference uses
+// the same type with full per-pixel scrambling.
+static constexpr int SAMPLER_TABLE_SAMPLES = int(Sampler::TABLE_SAMPLES);
+static constexpr int SAMPLER_TABLE_DIMENSIONS = int(Sampler::TABLE_DIMENSIONS);
+static_assert(MAX_BOUNCES == int(Sampler::TABLE_BOUNCES), "Sampler table must cover every bounce of the shader loop");
+static Sampler::Type s_SamplerType = Sampler::Type::Sobol;
+static GLuint s_SamplerTable = 0;
+
+// ============================================================================
+// PROGRESSIVE TARGET
+// ============================================================================
+// 'B' cycles a stopping rule for accumulation: a wall-clock budget or a noise
+// target (RenderStats::NoiseError, estimated every NOISE_CHECK_INTERVAL
+// frames from a read-back of the accumulation buffer). Once it is met the
+// window keeps showing the result without tracing further samples; any
+// accumulation reset starts over.
+struct ProgressiveTarget
+{
+	const char* Name;
+	double TimeBudget;      // Seconds, 0 = none
+	float NoiseTarget;      // 0 = none
+};
+
+static const ProgressiveTarget PROGRESSIVE_TARGETS[] = {
+	{ "Off", 0.0, 0.0f },
+	{ "10 s", 10.0, 0.0f },
+	{ "60 s", 60.0, 0.0f },
+	{ "Noise 0.5", 0.0, 0.5f },
+	{ "Noise 0.2", 0.0, 0.2f },
+	{ "Noise 0.1", 0.0, 0.1f },
+};
+static constexpr int NUM_PROGRESSIVE_TARGETS = int(sizeof(PROGRESSIVE_TARGETS) / sizeof(PROGRESSIVE_TARGETS[0]));
+static constexpr int NOISE_CHECK_INTERVAL = 32;
+
+static int s_ProgressiveTarget = 0;
+static bool s_ProgressiveDone = false;
+static float s_NoiseError = 0.0f;
+static float s_MeanSamples = 0.0f;     // Per pixel, from the same read-back
+static std::chrono::steady_clock::time_point s_AccumulationStart;
+
+// ============================================================================
+// ADAPTIVE SAMPLING
+// ============================================================================
+// 'V' cycles a per-pixel error threshold (RelativeNoise). Pixels below it
+// are masked out of the path trace pass, leaving the time to the ones that
+// are still noisy. Every ADAPTIVE_REFRESH_INTERVAL-th frame traces all
+// pixels anyway, so one whose first samples all missed a rare bright path
+// (zero variance) still gets the chance to find it.
+static const float ADAPTIVE_THRESHOLDS[] = { 0.0f, 0.2f, 0.1f, 0.05f };
+static constexpr int NUM_ADAPTIVE_THRESHOLDS = int(sizeof(ADAPTIVE_THRESHOLDS) / sizeof(ADAPTIVE_THRESHOLDS[0]));
+static constexpr int ADAPTIVE_REFRESH_INTERVAL = 16;
+
+static int s_AdaptiveThreshold = 0;
+
 // ============================================================================
 // UTILITY FUNCTIONS
 // ============================================================================
@@ -255,6 +336,280 @@ static std::filesystem::path GetShaderPath(const std::filesystem::path& shaderNa
 }
 
 
+// ============================================================================
+// QUADRIC PREVIEW
+// ============================================================================
+
+// Same framing NormalizeScene gives OBJ files: centered, largest side 6 units
+static Quadric::QuadricSurface FitPreviewSurface(const Quadric::QuadricSurface& surface)
+{
+	const Quadric::BoundingBox& bounds = surface.GetBounds();
+	glm::vec3 extent = bounds.Max - bounds.Min;
+	glm::vec3 center = (bounds.Min + bounds.Max) * 0.5f;
+	float scale = 6.0f / std::max({ extent.x, extent.y, extent.z });
+	
+	glm::mat4 fit = glm::scale(glm::mat4(1.0f), glm::vec3(scale)) * glm::translate(glm::mat4(1.0f), -center);
+	return Quadric::QuadricSurface(surface.GetCoefficients().Transformed(fit),
+	                               Quadric::TransformBounds(surface.GetBoundingBox(), fit));
+}
+
+// Closest the camera gets to the previewed surface's bounds
+static float DistanceToPreview()
+{
+	const Quadric::BoundingBox& bounds = s_PreviewSurface.GetBounds();
+	glm::vec3 closest = glm::clamp(s_Camera.Position, bounds.Min, bounds.Max);
+	return glm::length(s_Camera.Position - closest);
+}
+
+// Tessellate a preview at every LOD and upload the one matching the camera
+static bool LoadQuadricPreview(int index)
+{
+	const QuadricPreview& preview = s_QuadricPreviews[index];
+	
+	s_SceneManager.Clear();
+	
+	// Materials come from the shared quadric library; without it the
+	// preview falls back to the default material
+	const std::filesystem::path mtlFile = "assets/quadric_materials.mtl";
+	std::vector<std::filesystem::path> mtlPaths = {
+		GetShaderPath(mtlFile),
+		std::filesystem::path("..") / "App" / mtlFile,
+		std::filesystem::path("App") / mtlFile
+	};
+	for (const auto& mtlPath : mtlPaths)
+	{
+		if (std::filesystem::exists(mtlPath) && s_SceneManager.LoadMTL(mtlPath))
+			break;
+	}
+	
+	int materialIndex = 0;
+	const std::vector<OBJMaterial>& materials = s_SceneManager.GetSceneData().Materials;
+	for (size_t i = 0; i < materials.size(); i++)
+	{
+		if (materials[i].Name == preview.Material)
+			materialIndex = static_cast<int>(i);
+	}
+	
+	ScreenErrorMetric metric;
+	metric.VerticalFOV = glm::radians(s_Camera.VerticalFOV);
+	metric.ViewportHeight = s_Height;
+	metric.PixelError = PREVIEW_PIXEL_ERROR;
+	
+	s_PreviewSurface = FitPreviewSurface(preview.Surface);
+	s_PreviewLODs = QuadricTessellator::BuildLODs(s_PreviewSurface, s_PreviewSurface.GetBounds(),
+	                                              s_PreviewLODDistances, metric, materialIndex);
+	s_PreviewLOD = QuadricTessellator::SelectLOD(s_PreviewLODs, DistanceToPreview());
+	
+	std::cout << "LOD triangles:";
+	for (const TessellationLOD& lod : s_PreviewLODs)
+		std::cout << " " << lod.Triangles.size();
+	std::cout << std::endl;
+	
+	s_SceneManager.SetTriangles(s_PreviewLODs[s_PreviewLOD].Triangles);
+	return s_SceneManager.GetTriangleCount() > 0 && s_SceneManager.UploadToGPU();
+}
+
+// Swap in the preview LOD for the current camera distance.
+// Returns true if the geometry changed.
+static bool UpdateQuadricPreviewLOD()
+{
+	if (s_PreviewLODs.empty())
+		return false;
+	
+	size_t lod = QuadricTessellator::SelectLOD(s_PreviewLODs, DistanceToPreview());
+	if (lod == s_PreviewLOD)
+		return false;
+	
+	s_PreviewLOD = lod;
+	s_SceneManager.SetTriangles(s_PreviewLODs[lod].Triangles);
+	s_SceneManager.UploadToGPU();
+	
+	std::cout << "Preview LOD " << lod << ": " << s_SceneManager.GetTriangleCount() << " triangles" << std::endl;
+	return true;
+}
+
+// Copy the current scene and the editor's quadrics into a CPUScene.
+// Returns nullptr for scenes the CPU renderer cannot draw (quadric previews).
+static std::shared_ptr<const CPUScene> BuildCPUScene()
+{
+	auto scene = std::make_shared<CPUScene>();
+	
+	if (s_UseOBJScene && !s_UseCornellBoxScene)
+		return nullptr;
+	
+	if (s_UseCornellBoxScene)
+	{
+		if (!scene->LoadOBJ(GetShaderPath("assets/cornell_box.obj")))
+			return nullptr;
+	}
+	else
+	{
+		scene->LoadProcedural(s_SceneIndex);
+	}
+	
+	// CSG members share their group's transform and material (the group id
+	// is the first member's slot)
+	const QuadricManager& manager = s_QuadricManager;
+	std::vector<QuadricPlacement> quadrics;
+	std::vector<QuadricGroupPlacement> groups;
+	std::map<int, size_t> groupIndex;
+	for (int i = 0; i < manager.GetNumQuadrics(); i++)
+	{
+		const SceneQuadric& q = manager.GetQuadric(i);
+		Quadric::QuadricSurface shape(Quadric::QuadricCoefficients(q.A, q.B, q.C, q.D, q.E, q.F, q.G, q.H, q.I, q.J),
+		                              Quadric::BoundingBox(q.bboxMin, q.bboxMax));
+		if (q.csgGroup < 0)
+		{
+			quadrics.push_back({ shape, q.GetTransform(), q.materialIndex });
+			continue;
+		}
+		
+		auto found = groupIndex.find(q.csgGroup);
+		if (found == groupIndex.end())
+		{
+			groupIndex[q.csgGroup] = groups.size();
+			groups.push_back({ { shape }, q.GetTransform(), q.materialIndex });
+		}
+		else
+		{
+			groups[found->second].Members.push_back(shape);
+		}
+	}
+	scene->SetQuadrics(quadrics, groups);
+	
+	return scene;
+}
+
+// Start (or restart) the CPU reference render of the current view
+static void RestartCPUReference()
+{
+	if (s_CPUSceneDirty || !s_CPUScene)
+	{
+		s_CPUScene = BuildCPUScene();
+		s_CPUSceneDirty = false;
+	}
+	
+	if (!s_CPUScene)
+	{
+		std::cout << "[CPU Reference] Quadric previews are not supported" << std::endl;
+		s_CPUReference->Stop();
+		return;
+	}
+	
+	RenderCamera camera;
+	camera.Position = s_Camera.Position;
+	camera.Forward = s_Camera.Forward;
+	camera.Up = s_Camera.Up;
+	camera.VerticalFOV = s_Camera.VerticalFOV;
+	camera.FocusDistance = s_Camera.FocusDistance;
+	camera.Aperture = s_Camera.Aperture;
+	
+	RenderSettings settings;
+	settings.Width = s_Width;
+	settings.Height = s_Height;
+	settings.SamplesPerPixel = CPU_REFERENCE_SPP;
+	settings.MaxBounces = s_MaxBounces;
+	settings.SamplerType = s_SamplerType;
+	
+	// Keep one core for the window
+	settings.Threads = std::max(int(std::thread::hardware_concurrency()) - 1, 1);
+	
+	s_CPUReference->Restart(s_CPUScene, camera, settings);
+}
+
+// Write the CPU reference image once it has finished
+static void PollCPUReference()
+{
+	Image image;
+	double seconds = 0.0;
+	if (!s_CPUReference || !s_CPUReference->TakeResult(image, seconds))
+		return;
+	
+	DisplaySettings display;
+	display.Exposure = s_Camera.Exposure;
+	display.Gamma = s_Camera.Gamma;
+	display.Tonemapper = s_Camera.Tonemapper;
+	
+	if (image.Write("cpu_reference.pfm", display) && image.Write("cpu_reference.ppm", display))
+	{
+		std::cout << "[CPU Reference] " << image.Width << "x" << image.Height << " @ " << CPU_REFERENCE_SPP
+		          << " spp in " << seconds << " s -> cpu_reference.pfm / .ppm" << std::endl;
+	}
+}
+
+// (Re)build the sample table of s_SamplerType: SAMPLER_TABLE_SAMPLES rows
+// of SAMPLER_TABLE_DIMENSIONS floats, four dimensions per RGBA32F texel
+static void UploadSamplerTable()
+{
+	std::vector<float> table = Sampler(s_SamplerType, SAMPLER_TABLE_SAMPLES)
+		.buildTable(SAMPLER_TABLE_SAMPLES, SAMPLER_TABLE_DIMENSIONS);
+	
+	if (!s_SamplerTable)
+		glGenTextures(1, &s_SamplerTable);
+	
+	glBindTexture(GL_TEXTURE_2D, s_SamplerTable);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, SAMPLER_TABLE_DIMENSIONS / 4, SAMPLER_TABLE_SAMPLES,
+		0, GL_RGBA, GL_FLOAT, table.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Read back the per-pixel stats of an accumulation buffer (see
+// Accumulate.glsl) into s_NoiseError and s_MeanSamples
+static void ReadAccumulationStats(int accumIndex)
+{
+	std::vector<float> texels(size_t(s_Width) * size_t(s_Height) * 4);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, s_AccumFB[accumIndex].Handle);
+	glReadBuffer(GL_COLOR_ATTACHMENT1);
+	glReadPixels(0, 0, s_Width, s_Height, GL_RGBA, GL_FLOAT, texels.data());
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	
+	std::vector<float> errors(texels.size() / 4);
+	double samples = 0.0;
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		samples += texels[i * 4];
+		errors[i] = texels[i * 4 + 1];
+	}
+	
+	s_MeanSamples = errors.empty() ? 0.0f : float(samples / double(errors.size()));
+	s_NoiseError = NoiseQuantile(errors);
+}
+
+// Called after each accumulated frame: stop once the selected target is met
+static void UpdateProgressiveTarget(int accumIndex, float frameTime)
+{
+	const ProgressiveTarget& target = PROGRESSIVE_TARGETS[s_ProgressiveTarget];
+	int samples = s_FrameIndex + 1;
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - s_AccumulationStart).count();
+	
+	const char* reason = nullptr;
+	if (target.NoiseTarget > 0.0f && samples >= RenderStats::NOISE_MIN_SAMPLES && samples % NOISE_CHECK_INTERVAL == 0)
+	{
+		ReadAccumulationStats(accumIndex);
+		if (s_NoiseError <= target.NoiseTarget)
+			reason = "noise target";
+	}
+	
+	// Stop rather than overrun: the next frame takes about as long as this one
+	if (target.TimeBudget > 0.0 && seconds + frameTime > target.TimeBudget)
+	{
+		ReadAccumulationStats(accumIndex);
+		reason = "time budget";
+	}
+	
+	if (reason)
+	{
+		s_ProgressiveDone = true;
+		std::cout << "[Progressive] " << samples << " frames, " << s_MeanSamples << " spp average in " << seconds
+		          << " s, noise " << s_NoiseError << " (stopped at " << reason << ")" << std::endl;
+	}
+}
+
 // ============================================================================
 // IMGUI INTERFACE
 // ============================================================================
@@ -275,7 +630,7 @@ static void RenderImGui()
 		ImGui::Text("Scene/Mesh:");
 		ImGui::BulletText("I: Procedural scenes");
 		ImGui::BulletText("O: Cornell Box");
-		ImGui::BulletText("M/Shift+M: Quadric meshes");
+		ImGui::BulletText("M/Shift+M: Quadric previews");
 
 
 		// if (s_UseOBJScene == false)
@@ -298,6 +653,10 @@ static void RenderImGui()
 		ImGui::BulletText("+/-: Exposure");
 		ImGui::BulletText("Up/Down: Bounces");
 		ImGui::BulletText("F: Toggle DOF");
+		ImGui::BulletText("C: CPU reference render");
+		ImGui::BulletText("L: Cycle sampler");
+		ImGui::BulletText("B: Cycle time/noise target");
+		ImGui::BulletText("V: Cycle adaptive sampling");
 
 		ImGui::End();
 	}
@@ -306,16 +665,24 @@ static void RenderImGui()
 	if (s_QuadricManager.RenderEditor())
 	{
 		s_ResetAccumulation = true;
+		s_CPUSceneDirty = true;
 	}
 	
 	// Stats window
 	ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 200, 10), ImGuiCond_Always);
-	ImGui::SetNextWindowSize(ImVec2(190, 100), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(ImVec2(190, 180), ImGuiCond_Always);
 	ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize);
 	ImGui::Text("Frame: %d", s_FrameIndex);
 	ImGui::Text("Bounces: %d", s_MaxBounces);
 	ImGui::Text("Quadrics: %d/%d", s_QuadricManager.GetNumQuadrics(), QuadricManager::MAX_QUADRICS);
 	ImGui::Text("Exposure: %.2f", s_Camera.Exposure);
+	ImGui::Text("Target: %s%s", PROGRESSIVE_TARGETS[s_ProgressiveTarget].Name, s_ProgressiveDone ? " (done)" : "");
+	ImGui::Text("Noise: %.3f", s_NoiseError);
+	ImGui::Text("Avg spp: %.1f", s_MeanSamples);
+	if (ADAPTIVE_THRESHOLDS[s_AdaptiveThreshold] > 0.0f)
+		ImGui::Text("Adaptive: %.2f", ADAPTIVE_THRESHOLDS[s_AdaptiveThreshold]);
+	else
+		ImGui::Text("Adaptive: Off");
 	ImGui::End();
 	
 	ImGui::Render();
@@ -374,6 +741,33 @@ static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, i
 		std::cout << "Tonemapper: " << names[s_Camera.Tonemapper] << std::endl;
 	}
 
+	// Sampler cycling
+	if (key == GLFW_KEY_L && action == GLFW_PRESS)
+	{
+		s_SamplerType = Sampler::Type((int(s_SamplerType) + 1) % Sampler::TYPE_COUNT);
+		UploadSamplerTable();
+		s_ResetAccumulation = true;
+		std::cout << "Sampler: " << Sampler::typeName(s_SamplerType) << std::endl;
+	}
+	
+	// Progressive target cycling (accumulation resumes if the new target
+	// is not met yet)
+	if (key == GLFW_KEY_B && action == GLFW_PRESS)
+	{
+		s_ProgressiveTarget = (s_ProgressiveTarget + 1) % NUM_PROGRESSIVE_TARGETS;
+		s_ProgressiveDone = false;
+		std::cout << "Progressive target: " << PROGRESSIVE_TARGETS[s_ProgressiveTarget].Name << std::endl;
+	}
+	
+	// Adaptive sampling threshold cycling (takes effect on the next frame;
+	// samples taken so far are kept)
+	if (key == GLFW_KEY_V && action == GLFW_PRESS)
+	{
+		s_AdaptiveThreshold = (s_AdaptiveThreshold + 1) % NUM_ADAPTIVE_THRESHOLDS;
+		s_ProgressiveDone = false;
+		std::cout << "Adaptive sampling: " << ADAPTIVE_THRESHOLDS[s_AdaptiveThreshold] << " (0 = off)" << std::endl;
+	}
+	
 	// Exposure controls
 	if (key == GLFW_KEY_EQUAL && action == GLFW_PRESS)
 	{
@@ -409,6 +803,21 @@ static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, i
 		std::cout << "DOF: " << (s_Camera.Aperture > 0 ? "ON" : "OFF") << std::endl;
 	}
 
+	// CPU reference render (restarts with every accumulation reset)
+	if (key == GLFW_KEY_C && action == GLFW_PRESS)
+	{
+		if (s_CPUReference)
+		{
+			s_CPUReference.reset();
+		}
+		else
+		{
+			s_CPUReference = std::make_unique<BackgroundRenderer>();
+			s_ResetAccumulation = true;
+		}
+		std::cout << "CPU Reference: " << (s_CPUReference ? "ON" : "OFF") << std::endl;
+	}
+	
 	// Toggle Quadric Editor (ImGui)
 	if (key == GLFW_KEY_G && action == GLFW_PRESS)
 	{
@@ -430,6 +839,7 @@ static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, i
 		s_UseCornellBoxScene = false; // Not using Cornell Box OBJ
 		s_SceneIndex = (s_SceneIndex + 1) % NUM_SCENES;
 		s_ResetAccumulation = true;
+		s_CPUSceneDirty = true;
 		
 		// Reset camera to default position for procedural scenes
 		s_Camera.Position = glm::vec3(0.0f, 0.0f, 8.0f);
@@ -455,6 +865,7 @@ static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, i
 				s_UseOBJScene = true;
 				s_UseCornellBoxScene = true;
 				s_ResetAccumulation = true;
+				s_CPUSceneDirty = true;
 				
 				// Use camera from OBJ if available
 				const SceneData& scene = s_SceneManager.GetSceneData();
@@ -477,73 +888,47 @@ static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, i
 		}
 	}
 	
-	// Cycle through quadric mesh OBJ files (M = next, Shift+M = previous)
+	// Cycle through tessellated quadric previews (M = next, Shift+M = previous)
 	if (key == GLFW_KEY_M && action == GLFW_PRESS)
 	{
-		int numMeshes = static_cast<int>(s_QuadricMeshFiles.size());
+		int numPreviews = static_cast<int>(s_QuadricPreviews.size());
 		
-		// Shift+M = previous mesh, M = next mesh
+		// Shift+M = previous surface, M = next surface
 		if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
 			glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
 		{
-			s_CurrentMeshIndex = (s_CurrentMeshIndex - 1 + numMeshes) % numMeshes;
+			s_CurrentMeshIndex = (s_CurrentMeshIndex - 1 + numPreviews) % numPreviews;
 		}
 		else
 		{
-			s_CurrentMeshIndex = (s_CurrentMeshIndex + 1) % numMeshes;
+			s_CurrentMeshIndex = (s_CurrentMeshIndex + 1) % numPreviews;
 		}
 		
-		std::filesystem::path objPath = GetShaderPath(s_QuadricMeshFiles[s_CurrentMeshIndex]);
 		std::cout << "\n━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
-		std::cout << "[Quadric " << s_CurrentMeshIndex << "/" << (numMeshes - 1) << "] "
-				  << s_QuadricMeshNames[s_CurrentMeshIndex] << std::endl;
+		std::cout << "[Quadric " << s_CurrentMeshIndex << "/" << (numPreviews - 1) << "] "
+				  << s_QuadricPreviews[s_CurrentMeshIndex].Name << std::endl;
 		std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
 		
-		s_SceneManager.Clear();
-		bool loaded = false;
-		
-		// Try primary path
-		if (s_SceneManager.LoadOBJ(objPath))
-		{
-			loaded = true;
-		}
-		else
-		{
-			// Try alternative paths for different working directories
-			std::vector<std::filesystem::path> altPaths = {
-				std::filesystem::path("..") / "App" / s_QuadricMeshFiles[s_CurrentMeshIndex],
-				std::filesystem::path("App") / s_QuadricMeshFiles[s_CurrentMeshIndex],
-				std::filesystem::current_path() / s_QuadricMeshFiles[s_CurrentMeshIndex]
-			};
-			
-			for (const auto& altPath : altPaths)
-			{
-				if (std::filesystem::exists(altPath) && s_SceneManager.LoadOBJ(altPath))
-				{
-					loaded = true;
-					break;
-				}
-			}
-		}
+		// Default camera for quadric surfaces - positioned to see the whole
+		// surface. Set first: the starting LOD depends on it.
+		s_Camera.Position = glm::vec3(0.0f, 2.0f, 10.0f);
+		s_Camera.Forward = glm::normalize(glm::vec3(0.0f, -0.2f, -1.0f));
+		s_Camera.Up = glm::vec3(0.0f, 1.0f, 0.0f);
+		s_Camera.RecalculateView();
 		
-		if (loaded && s_SceneManager.UploadToGPU())
+		if (LoadQuadricPreview(s_CurrentMeshIndex))
 		{
 			s_UseOBJScene = true;
 			s_UseCornellBoxScene = false;
 			s_ResetAccumulation = true;
-			
-			// Default camera for quadric surfaces - positioned to see the whole mesh
-			s_Camera.Position = glm::vec3(0.0f, 2.0f, 10.0f);
-			s_Camera.Forward = glm::normalize(glm::vec3(0.0f, -0.2f, -1.0f));
-			s_Camera.Up = glm::vec3(0.0f, 1.0f, 0.0f);
-			s_Camera.RecalculateView();
+			s_CPUSceneDirty = true;
 			
 			std::cout << "Triangles: " << s_SceneManager.GetTriangleCount() 
-					  << " | Materials: " << s_SceneManager.GetMaterialCount() << std::endl;
+					  << " (LOD " << s_PreviewLOD << ") | Materials: " << s_SceneManager.GetMaterialCount() << std::endl;
 		}
 		else
 		{
-			std::cerr << "Failed to load mesh file" << std::endl;
+			std::cerr << "Failed to tessellate quadric" << std::endl;
 		}
 	}
 }
@@ -573,6 +958,8 @@ static bool InitializeFramebuffers()
 	{
 		if (s_AccumTextures[i].Handle)
 			glDeleteTextures(1, &s_AccumTextures[i].Handle);
+		if (s_AccumStatsTextures[i].Handle)
+			glDeleteTextures(1, &s_AccumStatsTextures[i].Handle);
 		if (s_AccumFB[i].Handle)
 			glDeleteFramebuffers(1, &s_AccumFB[i].Handle);
 	}
@@ -590,9 +977,10 @@ static bool InitializeFramebuffers()
 	for (int i = 0; i < 2; i++)
 	{
 		s_AccumTextures[i] = CreateTexture(s_Width, s_Height);
+		s_AccumStatsTextures[i] = CreateTexture(s_Width, s_Height);
 		s_AccumFB[i] = CreateFramebufferWithTexture(s_AccumTextures[i]);
 		
-		if (!s_AccumFB[i].Handle)
+		if (!s_AccumFB[i].Handle || !AttachExtraTextureToFramebuffer(s_AccumFB[i], s_AccumStatsTextures[i], 1))
 		{
 			std::cerr << "Failed to create accumulation framebuffer " << i << std::endl;
 			return false;
@@ -629,7 +1017,7 @@ static bool InitializeShaders()
 // ============================================================================
 // RENDER PASSES
 // ============================================================================
-static void RenderPathTrace()
+static void RenderPathTrace(int srcAccumIndex)
 {
 	// Render new sample to dedicated path trace framebuffer
 	glBindFramebuffer(GL_FRAMEBUFFER, s_PathTraceFB.Handle);
@@ -649,6 +1037,21 @@ static void RenderPathTrace()
 	glUniform1f(glGetUniformLocation(s_PathTraceShader, "uFocusDistance"), s_Camera.FocusDistance);
 	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uSceneIndex"), s_SceneIndex);
 	
+	// Sample table (units 2-7 hold the scene and quadric textures)
+	glActiveTexture(GL_TEXTURE8);
+	glBindTexture(GL_TEXTURE_2D, s_SamplerTable);
+	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uSamplerTable"), 8);
+	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uSamplerType"), int(s_SamplerType));
+	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uSamplerTableSize"), SAMPLER_TABLE_SAMPLES);
+	
+	// Adaptive sampling reads the previous frame's per-pixel stats
+	glActiveTexture(GL_TEXTURE9);
+	glBindTexture(GL_TEXTURE_2D, s_AccumStatsTextures[srcAccumIndex].Handle);
+	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uAccumulationStats"), 9);
+	glUniform1f(glGetUniformLocation(s_PathTraceShader, "uAdaptiveThreshold"), ADAPTIVE_THRESHOLDS[s_AdaptiveThreshold]);
+	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uAdaptiveMinSamples"), RenderStats::NOISE_MIN_SAMPLES);
+	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uAdaptiveRefresh"), s_FrameIndex % ADAPTIVE_REFRESH_INTERVAL == 0);
+	
 	// OBJ scene uniforms
 	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uUseOBJScene"), s_UseOBJScene ? 1 : 0);
 
@@ -656,8 +1059,11 @@ static void RenderPathTrace()
 	// CornellBox scene uniforms
 	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uUseCornellBoxScene"), s_UseCornellBoxScene ? 1 : 0);
 
-	// Show skybox when a quadric mesh is loaded via M/Shift+M
+	// Show skybox when a quadric preview is loaded via M/Shift+M
 	glUniform1i(glGetUniformLocation(s_PathTraceShader, "uShowSkybox"), s_CurrentMeshIndex >= 0 && s_UseCornellBoxScene == 0 ? 1 : 0);
+	
+	// Sampler units are needed by procedural scenes too (see SetTextureUnits)
+	SceneManager::SetTextureUnits(s_PathTraceShader);
 	if (s_UseOBJScene && s_SceneManager.GetTriangleCount() > 0)
 	{
 		s_SceneManager.BindTextures(s_PathTraceShader);
@@ -667,8 +1073,9 @@ static void RenderPathTrace()
 		glUniform1i(glGetUniformLocation(s_PathTraceShader, "uNumTriangles"), 0);
 	}
 	
-	// Pass quadrics to shader via QuadricManager
-	s_QuadricManager.UploadToShader(s_PathTraceShader);
+	// Pass quadrics to shader via QuadricManager (camera rays reuse the
+	// origin terms it evaluates at uCameraPosition)
+	s_QuadricManager.UploadToShader(s_PathTraceShader, s_Camera.Position);
 	
 	glBindVertexArray(s_VAO);
 	glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -694,6 +1101,10 @@ static void RenderAccumulate(int srcAccumIndex, int dstAccumIndex)
 	glBindTexture(GL_TEXTURE_2D, s_AccumTextures[srcAccumIndex].Handle);
 	glUniform1i(glGetUniformLocation(s_AccumulateShader, "uAccumulated"), 1);
 	
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, s_AccumStatsTextures[srcAccumIndex].Handle);
+	glUniform1i(glGetUniformLocation(s_AccumulateShader, "uAccumulatedStats"), 2);
+	
 	glUniform1i(glGetUniformLocation(s_AccumulateShader, "uFrame"), s_FrameIndex);
 	
 	glBindVertexArray(s_VAO);
@@ -786,6 +1197,9 @@ int main()
 	// Initialize quadrics with defaults
 	s_QuadricManager.InitializeDefaults();
 	
+	// Reload OBJ scenes from their .cgscene cache when it is up to date
+	s_SceneManager.SetSceneCache(true);
+	
 	// Initialize resources
 	if (!InitializeShaders())
 	{
@@ -799,10 +1213,12 @@ int main()
 		return EXIT_FAILURE;
 	}
 
+	UploadSamplerTable();
+	
 	std::cout << "\n=== SCENE CONTROLS ===" << std::endl;
 	std::cout << "I: Procedural scenes" << std::endl;
 	std::cout << "O: Cornell Box" << std::endl;
-	std::cout << "M: Quadric meshes (Shift+M: previous)" << std::endl;
+	std::cout << "M: Quadric previews (Shift+M: previous)" << std::endl;
 
 	std::cout << "\n=== CONTROLS ===" << std::endl;
 	std::cout << "Right Mouse + WASD: Move camera" << std::endl;
@@ -813,6 +1229,9 @@ int main()
 	std::cout << "+/-: Adjust exposure" << std::endl;
 	std::cout << "Up/Down: Adjust bounces" << std::endl;
 	std::cout << "F: Toggle depth of field" << std::endl;
+	std::cout << "L: Cycle sampler (" << Sampler::typeName(s_SamplerType) << ")" << std::endl;
+	std::cout << "B: Cycle time/noise target (" << PROGRESSIVE_TARGETS[s_ProgressiveTarget].Name << ")" << std::endl;
+	std::cout << "V: Cycle adaptive sampling threshold" << std::endl;
 	std::cout << "G: Toggle Quadric Editor (ImGui)" << std::endl;
 	std::cout << "H: Toggle Help" << std::endl;
 	std::cout << "ESC: Quit" << std::endl;
@@ -835,8 +1254,8 @@ int main()
 		if (fpsTimer >= 1.0f)
 		{
 			char title[256];
-			snprintf(title, sizeof(title), "Cinematic Path Tracer | %d FPS | Frame %d | %d bounces", 
-				fpsCounter, s_FrameIndex, s_MaxBounces);
+			snprintf(title, sizeof(title), "Cinematic Path Tracer | %d FPS | Frame %d | %d bounces%s", 
+				fpsCounter, s_FrameIndex, s_MaxBounces, s_ProgressiveDone ? " | done" : "");
 			glfwSetWindowTitle(window, title);
 			fpsTimer = 0.0f;
 			fpsCounter = 0;
@@ -848,6 +1267,12 @@ int main()
 			s_ResetAccumulation = true;
 		}
 		
+		// Quadric previews follow the camera through their LODs
+		if (s_UseOBJScene && !s_UseCornellBoxScene && UpdateQuadricPreviewLOD())
+		{
+			s_ResetAccumulation = true;
+		}
+		
 		// Handle resize
 		int width, height;
 		glfwGetFramebufferSize(window, &width, &height);
@@ -860,27 +1285,42 @@ int main()
 			s_ResetAccumulation = true;
 		}
 		
-		// Reset accumulation
+		// Reset accumulation (and restart the CPU reference from the new view)
 		if (s_ResetAccumulation)
 		{
 			s_FrameIndex = 0;
 			s_ResetAccumulation = false;
+			s_ProgressiveDone = false;
+			s_NoiseError = 0.0f;
+			s_AccumulationStart = std::chrono::steady_clock::now();
+			
+			if (s_CPUReference)
+				RestartCPUReference();
 		}
 		
+		PollCPUReference();
+		
 		// Ping-pong accumulation buffer indices
 		// srcAccum: where previous accumulated result is stored
 		// dstAccum: where new accumulated result will be written
 		int srcAccum = s_FrameIndex % 2;
 		int dstAccum = 1 - srcAccum;
 		
-		// Pass 1: Path trace new sample → s_PathTraceFB
-		RenderPathTrace();
-		
-		// Pass 2: Accumulate (new sample + prev accum → dst accum)
-		RenderAccumulate(srcAccum, dstAccum);
+		// Once the progressive target is met, srcAccum holds the final result
+		bool accumulate = !s_ProgressiveDone;
+		if (accumulate)
+		{
+			// Pass 1: Path trace new sample → s_PathTraceFB
+			RenderPathTrace(srcAccum);
+			
+			// Pass 2: Accumulate (new sample + prev accum → dst accum)
+			RenderAccumulate(srcAccum, dstAccum);
+			
+			UpdateProgressiveTarget(dstAccum, deltaTime);
+		}
 		
 		// Pass 3: Display the accumulated result
-		RenderDisplay(dstAccum);
+		RenderDisplay(accumulate ? dstAccum : srcAccum);
 		
 		// Pass 4: Render ImGui
 		RenderImGui();
@@ -888,10 +1328,13 @@ int main()
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 		
-		s_FrameIndex++;
+		if (accumulate)
+			s_FrameIndex++;
 	}
 	
 	// Cleanup
+	s_CPUReference.reset();
+	
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
 	ImGui::DestroyContext();
@@ -902,8 +1345,10 @@ int main()
 	for (int i = 0; i < 2; i++)
 	{
 		glDeleteTextures(1, &s_AccumTextures[i].Handle);
+		glDeleteTextures(1, &s_AccumStatsTextures[i].Handle);
 		glDeleteFramebuffers(1, &s_AccumFB[i].Handle);
 	}
+	glDeleteTextures(1, &s_SamplerTable);
 	glDeleteProgram(s_PathTraceShader);
 	glDeleteProgram(s_AccumulateShader);
 	glDeleteProgram(s_DisplayShader);
@@ -1,15 +1,13 @@
 #include "MonteCarlo.h"
+#include "Simd.h"
+#include "Vec3Simd.h"
 
-#define _USE_MATH_DEFINES
-#include <cmath>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include <algorithm>
 
 // Static members initialization
-std::mt19937 MonteCarlo::generator;
-std::uniform_real_distribution<float> MonteCarlo::distribution(0.0f, 1.0f);
+thread_local std::mt19937 MonteCarlo::generator;
+thread_local std::uniform_real_distribution<float> MonteCarlo::distribution(0.0f, 1.0f);
+thread_local RandomStream* MonteCarlo::stream = nullptr;
 
 void MonteCarlo::init() {
     std::random_device rd;
@@ -20,7 +18,18 @@ void MonteCarlo::setSeed(unsigned int seed) {
     generator.seed(seed);
 }
 
+MonteCarlo::StreamScope::StreamScope(RandomStream& bound) : previous(stream) {
+    stream = &bound;
+}
+
+MonteCarlo::StreamScope::~StreamScope() {
+    stream = previous;
+}
+
 float MonteCarlo::randomFloat() {
+    if (stream) {
+        return stream->nextFloat();
+    }
     return distribution(generator);
 }
 
@@ -28,15 +37,154 @@ float MonteCarlo::randomFloat(float min, float max) {
     return min + (max - min) * randomFloat();
 }
 
-Vec3 MonteCarlo::randomInUnitSphere() {
-    while (true) {
-        Vec3 p(randomFloat(-1, 1), randomFloat(-1, 1), randomFloat(-1, 1));
-        if (p.lengthSquared() < 1) {
-            return p;
+// ============================================================================
+// SAMPLE MAPPINGS
+// ============================================================================
+// Templated on the lane type: float for the scalar API, Simd::FloatN for the
+// batch API. Both run the same operations, so they give the same samples.
+// ============================================================================
+namespace {
+
+const float QUARTER_PI = 0.78539816f;
+
+// sin and cos of x in [-pi/4, pi/4] (Taylor series, error below 2e-8)
+template <typename T>
+void sinCosQuarterPi(T x, T& s, T& c) {
+    using Simd::splat;
+    T x2 = x * x;
+    s = x * (splat<T>(1.0f) + x2 * (splat<T>(-1.0f / 6.0f) + x2 * (splat<T>(1.0f / 120.0f)
+          + x2 * (splat<T>(-1.0f / 5040.0f) + x2 * splat<T>(1.0f / 362880.0f)))));
+    c = splat<T>(1.0f) + x2 * (splat<T>(-0.5f) + x2 * (splat<T>(1.0f / 24.0f) + x2 * (splat<T>(-1.0f / 720.0f)
+          + x2 * (splat<T>(1.0f / 40320.0f) + x2 * splat<T>(-1.0f / 3628800.0f)))));
+}
+
+// Cube root of u in [0, 1): Halley steps from u^(1/4), which is at most 4x
+// too large for the smallest nonzero 24-bit uniform. Five steps always
+// converge, so the count is fixed.
+template <typename T>
+T cubeRoot01(T u) {
+    using Simd::splat;
+    T v = Simd::max(u, splat<T>(1e-30f));
+    T y = Simd::sqrt(Simd::sqrt(v));
+    for (int i = 0; i < 5; i++) {
+        T y3 = y * y * y;
+        y = y * (y3 + v + v) / (y3 + y3 + v);
+    }
+    return Simd::select(u > splat<T>(0.0f), y, splat<T>(0.0f));
+}
+
+// Shirley-Chiu concentric map of [0,1)^2 onto the unit disk. Square rings
+// go to circles, so strata stay compact and nothing is rejected. Each wedge
+// needs an angle in [-pi/4, pi/4] only; the other wedge swaps sin and cos.
+template <typename T>
+void concentricDisk(T u1, T u2, T& x, T& y) {
+    using Simd::splat;
+    T a = u1 * splat<T>(2.0f) - splat<T>(1.0f);
+    T b = u2 * splat<T>(2.0f) - splat<T>(1.0f);
+
+    auto useA = Simd::abs(a) > Simd::abs(b);
+    T r = Simd::select(useA, a, b);
+    T other = Simd::select(useA, b, a);
+    T safeR = Simd::select(Simd::abs(r) > splat<T>(0.0f), r, splat<T>(1.0f));
+
+    T s, c;
+    sinCosQuarterPi(splat<T>(QUARTER_PI) * (other / safeR), s, c);
+    x = r * Simd::select(useA, c, s);
+    y = r * Simd::select(useA, s, c);
+}
+
+// Cosine-weighted hemisphere around +z: lift the disk (Malley's method)
+template <typename T>
+void cosineHemisphere(T u1, T u2, T& x, T& y, T& z) {
+    concentricDisk(u1, u2, x, y);
+    z = Simd::sqrt(Simd::max(Simd::splat<T>(1.0f) - x * x - y * y, Simd::splat<T>(0.0f)));
+}
+
+// Uniform point in the unit ball: the disk mapped area-preservingly onto
+// the sphere (z = 1 - 2r^2), scaled by a cube-root distributed radius
+template <typename T>
+void unitBall(T u1, T u2, T u3, T& x, T& y, T& z) {
+    using Simd::splat;
+    T dx, dy;
+    concentricDisk(u1, u2, dx, dy);
+    T r2 = dx * dx + dy * dy;
+    T radius = cubeRoot01(u3);
+    T scale = splat<T>(2.0f) * Simd::sqrt(Simd::max(splat<T>(1.0f) - r2, splat<T>(0.0f))) * radius;
+
+    x = dx * scale;
+    y = dy * scale;
+    z = (splat<T>(1.0f) - splat<T>(2.0f) * r2) * radius;
+}
+
+// Duff et al.: the z sign picks the stable branch of Frisvad's basis
+template <typename T>
+void orthonormalBasisLanes(const Vec3Lanes<T>& n, Vec3Lanes<T>& t, Vec3Lanes<T>& b) {
+    using Simd::splat;
+    T sign = Simd::select(n.z >= splat<T>(0.0f), splat<T>(1.0f), splat<T>(-1.0f));
+    T a = splat<T>(-1.0f) / (sign + n.z);
+    T c = n.x * n.y * a;
+
+    t = { splat<T>(1.0f) + sign * n.x * n.x * a, sign * c, -(sign * n.x) };
+    b = { c, sign + n.y * n.y * a, -n.y };
+}
+
+template <typename T>
+Vec3Lanes<T> cosineAroundNormal(T u1, T u2, const Vec3Lanes<T>& n) {
+    T lx, ly, lz;
+    cosineHemisphere(u1, u2, lx, ly, lz);
+
+    Vec3Lanes<T> t, b;
+    orthonormalBasisLanes(n, t, b);
+    return t * lx + b * ly + n * lz;
+}
+
+// ----------------------------------------------------------------------------
+// Batch driver: samples go through fixed-size blocks so the lane loop never
+// reads past the caller's arrays. In each block the uniforms are drawn
+// sample by sample (the scalar order), then mapped NATIVE_WIDTH at a time.
+// ----------------------------------------------------------------------------
+const int BLOCK_SIZE = 64;
+static_assert(BLOCK_SIZE % Simd::NATIVE_WIDTH == 0, "Blocks must hold whole lane groups");
+
+struct Block {
+    alignas(32) float in[6][BLOCK_SIZE];
+    alignas(32) float out[3][BLOCK_SIZE];
+};
+
+// Fill block.in[0..dimensions) with uniforms for n samples; lanes past n get
+// a harmless 0.5
+void drawUniforms(Block& block, int dimensions, int n) {
+    for (int d = 0; d < dimensions; d++) {
+        std::fill(block.in[d] + n, block.in[d] + BLOCK_SIZE, 0.5f);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int d = 0; d < dimensions; d++) {
+            block.in[d][i] = MonteCarlo::randomFloat();
         }
     }
 }
 
+void copyOut(const Block& block, float* const* outputs, int outputCount, int start, int n) {
+    for (int c = 0; c < outputCount; c++) {
+        std::copy(block.out[c], block.out[c] + n, outputs[c] + start);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// SCALAR SAMPLING
+// ============================================================================
+Vec3 MonteCarlo::randomInUnitSphere() {
+    float u1 = randomFloat();
+    float u2 = randomFloat();
+    float u3 = randomFloat();
+
+    Vec3 p;
+    unitBall(u1, u2, u3, p.x, p.y, p.z);
+    return p;
+}
+
 Vec3 MonteCarlo::randomInHemisphere(const Vec3& normal) {
     Vec3 inUnitSphere = randomInUnitSphere();
     // If in same hemisphere as normal, return it; otherwise, flip it
@@ -48,41 +196,103 @@ Vec3 MonteCarlo::randomInHemisphere(const Vec3& normal) {
 }
 
 Vec3 MonteCarlo::randomInUnitDisk() {
-    while (true) {
-        Vec3 p(randomFloat(-1, 1), randomFloat(-1, 1), 0);
-        if (p.lengthSquared() < 1) {
-            return p;
+    float u1 = randomFloat();
+    float u2 = randomFloat();
+
+    Vec3 p;
+    concentricDisk(u1, u2, p.x, p.y);
+    return p;
+}
+
+Vec3 MonteCarlo::randomCosineDirection() {
+    float u1 = randomFloat();
+    float u2 = randomFloat();
+
+    Vec3 d;
+    cosineHemisphere(u1, u2, d.x, d.y, d.z);
+    return d;
+}
+
+Vec3 MonteCarlo::randomCosineDirectionInHemisphere(const Vec3& normal) {
+    float u1 = randomFloat();
+    float u2 = randomFloat();
+
+    Vec3Lanes<float> d = cosineAroundNormal(u1, u2, Vec3Lanes<float>{ normal.x, normal.y, normal.z });
+    return Vec3(d.x, d.y, d.z);
+}
+
+void MonteCarlo::orthonormalBasis(const Vec3& normal, Vec3& tangent, Vec3& bitangent) {
+    Vec3Lanes<float> t, b;
+    orthonormalBasisLanes(Vec3Lanes<float>{ normal.x, normal.y, normal.z }, t, b);
+    tangent = Vec3(t.x, t.y, t.z);
+    bitangent = Vec3(b.x, b.y, b.z);
+}
+
+// ============================================================================
+// BATCH SAMPLING
+// ============================================================================
+void MonteCarlo::randomInUnitSphere(float* x, float* y, float* z, int count) {
+    using Simd::FloatN;
+    Block block;
+    float* outputs[3] = { x, y, z };
+
+    for (int start = 0; start < count; start += BLOCK_SIZE) {
+        int n = std::min(BLOCK_SIZE, count - start);
+        drawUniforms(block, 3, n);
+
+        for (int i = 0; i < n; i += Simd::NATIVE_WIDTH) {
+            FloatN px, py, pz;
+            unitBall(FloatN::load(block.in[0] + i), FloatN::load(block.in[1] + i), FloatN::load(block.in[2] + i),
+                     px, py, pz);
+            px.store(block.out[0] + i);
+            py.store(block.out[1] + i);
+            pz.store(block.out[2] + i);
         }
+        copyOut(block, outputs, 3, start, n);
     }
 }
 
-Vec3 MonteCarlo::randomCosineDirection() {
-    float r1 = randomFloat();
-    float r2 = randomFloat();
-    float z = std::sqrt(1 - r2);
+void MonteCarlo::randomInUnitDisk(float* x, float* y, int count) {
+    using Simd::FloatN;
+    Block block;
+    float* outputs[2] = { x, y };
 
-    float phi = 2 * M_PI * r1;
-    float x = std::cos(phi) * std::sqrt(r2);
-    float y = std::sin(phi) * std::sqrt(r2);
+    for (int start = 0; start < count; start += BLOCK_SIZE) {
+        int n = std::min(BLOCK_SIZE, count - start);
+        drawUniforms(block, 2, n);
 
-    return Vec3(x, y, z);
+        for (int i = 0; i < n; i += Simd::NATIVE_WIDTH) {
+            FloatN px, py;
+            concentricDisk(FloatN::load(block.in[0] + i), FloatN::load(block.in[1] + i), px, py);
+            px.store(block.out[0] + i);
+            py.store(block.out[1] + i);
+        }
+        copyOut(block, outputs, 2, start, n);
+    }
 }
 
-Vec3 MonteCarlo::randomCosineDirectionInHemisphere(const Vec3& normal) {
-    // Generate cosine-weighted direction in local space
-    Vec3 localDir = randomCosineDirection();
-    
-    // Create orthonormal coordinate system from normal
-    Vec3 a;
-    if (std::abs(normal.x) > 0.9) {
-        a = Vec3(0, 1, 0);
-    } else {
-        a = Vec3(1, 0, 0);
+void MonteCarlo::randomCosineDirectionInHemisphere(const float* nx, const float* ny, const float* nz,
+                                                   float* x, float* y, float* z, int count) {
+    using Simd::FloatN;
+    Block block;
+    float* outputs[3] = { x, y, z };
+
+    for (int start = 0; start < count; start += BLOCK_SIZE) {
+        int n = std::min(BLOCK_SIZE, count - start);
+        drawUniforms(block, 2, n);
+
+        // Normals go through the block too; padding lanes get +z
+        const float* normals[3] = { nx, ny, nz };
+        for (int c = 0; c < 3; c++) {
+            std::copy(normals[c] + start, normals[c] + start + n, block.in[2 + c]);
+            std::fill(block.in[2 + c] + n, block.in[2 + c] + BLOCK_SIZE, c == 2 ? 1.0f : 0.0f);
+        }
+
+        for (int i = 0; i < n; i += Simd::NATIVE_WIDTH) {
+            Vec3xN normal = Vec3xN::load(block.in[2] + i, block.in[3] + i, block.in[4] + i);
+            Vec3xN d = cosineAroundNormal(FloatN::load(block.in[0] + i), FloatN::load(block.in[1] + i), normal);
+            d.store(block.out[0] + i, block.out[1] + i, block.out[2] + i);
+        }
+        copyOut(block, outputs, 3, start, n);
     }
-    
-    Vec3 tangent = normal.cross(a).normalized();
-    Vec3 bitangent = normal.cross(tangent);
-    
-    // Transform from local basis to world basis
-    return tangent * localDir.x + bitangent * localDir.y + normal * localDir.z;
 }
@@ -2,11 +2,12 @@
 #define MONTECARLO_H
 
 #include "Vec3.h"
+#include "RandomStream.h"
 #include <random>
 
 class MonteCarlo {
 public:
-    // Initialize the random number generator
+    // Initialize the random number generator (of the calling thread)
     static void init();
     static void setSeed(unsigned int seed);
 
@@ -29,9 +30,45 @@ public:
     static Vec3 randomCosineDirection();
     static Vec3 randomCosineDirectionInHemisphere(const Vec3& normal);
 
+    // Tangent and bitangent completing a unit normal to an orthonormal basis,
+    // without branches (Duff et al., "Building an Orthonormal Basis,
+    // Revisited", JCGT 2017)
+    static void orthonormalBasis(const Vec3& normal, Vec3& tangent, Vec3& bitangent);
+
+    // Batch versions for packet tracing: fill count samples into separate x,
+    // y (and z) arrays. Every mapping is closed-form, so no lane ever waits
+    // on a rejection loop. Numbers are drawn in the same order as count
+    // scalar calls, and sample i equals the i-th scalar result up to rounding.
+    static void randomInUnitSphere(float* x, float* y, float* z, int count);
+    static void randomInUnitDisk(float* x, float* y, int count);
+
+    // Sample i is cosine-distributed around normal (nx[i], ny[i], nz[i])
+    static void randomCosineDirectionInHemisphere(const float* nx, const float* ny, const float* nz,
+                                                  float* x, float* y, float* z, int count);
+
+    // While a StreamScope is alive, every function above draws from its
+    // RandomStream on the calling thread instead of the mt19937. Scopes nest;
+    // the previous stream is restored on destruction.
+    class StreamScope {
+    public:
+        explicit StreamScope(RandomStream& stream);
+        ~StreamScope();
+
+        StreamScope(const StreamScope&) = delete;
+        StreamScope& operator=(const StreamScope&) = delete;
+
+    private:
+        RandomStream* previous;
+    };
+
 private:
-    static std::mt19937 generator;
-    static std::uniform_real_distribution<float> distribution;
+    // One generator per thread: render threads never share state, and a
+    // thread that seeds it (e.g. per pixel) gets a reproducible sequence
+    static thread_local std::mt19937 generator;
+    static thread_local std::uniform_real_distribution<float> distribution;
+
+    // Stream bound by the innermost StreamScope of this thread, or nullptr
+    static thread_local RandomStream* stream;
 };
 
 #endif
@@ -0,0 +1,105 @@
+#ifndef RANDOMSTREAM_H
+#define RANDOMSTREAM_H
+
+// ============================================================================
+// RANDOM STREAM - Counter-based random numbers for parallel rendering
+// ============================================================================
+// A stream holds no generator state, only a key and a counter. Each draw is
+// a pure hash of (pixel, sample, seed, bounce, draw index), so:
+//
+//   - the numbers a path sees do not depend on which thread traced it, in
+//     what order, or how many other samples ran before it
+//   - starting a stream costs nothing (an mt19937 seed fills 2.5 KB)
+//   - threads never share state, so nothing needs a lock
+//
+// The hash is pcg4d from "Hash Functions for GPU Rendering" (Jarzynski &
+// Olano), the paper pcgHash in PathTrace.glsl comes from. One hash yields
+// four 32-bit outputs, which are handed out before the next counter step.
+//
+// MonteCarlo draws from the stream bound to the calling thread (see
+// MonteCarlo::StreamScope), so the sampling routines need no extra argument.
+//
+// With a Sampler attached, the first Sampler::DIMENSIONS_PER_BOUNCE floats
+// of each bounce come from its low-discrepancy sequence; any further draws
+// (and nextUInt) fall back to the hash.
+// ============================================================================
+
+#include "Sampler.h"
+
+#include <cstdint>
+
+class RandomStream {
+public:
+    RandomStream(uint32_t pixel, uint32_t sample, uint32_t seed = 0, const Sampler* sampler = nullptr)
+        : m_Pixel(pixel), m_Sample(sample), m_Seed(seed), m_Sampler(sampler) {}
+
+    // Start the numbers of a new bounce. Bounce b always sees the same
+    // sequence, however many numbers earlier bounces consumed.
+    void setBounce(uint32_t bounce) {
+        m_Bounce = bounce;
+        m_Counter = 0;
+        m_Available = 0;
+        m_Dimension = 0;
+    }
+
+    uint32_t nextUInt() {
+        if (m_Available == 0) {
+            refill();
+        }
+        return m_Block[4 - m_Available--];
+    }
+
+    // Uniform in [0, 1): the top 24 bits, so 1.0 is never returned
+    float nextFloat() {
+        if (m_Sampler && m_Dimension < Sampler::DIMENSIONS_PER_BOUNCE) {
+            return m_Sampler->get(m_Pixel, m_Sample, m_Bounce * Sampler::DIMENSIONS_PER_BOUNCE + m_Dimension++);
+        }
+        return float(nextUInt() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // pcg4d: four 32-bit inputs to four well-mixed 32-bit outputs
+    static void pcg4d(uint32_t v[4]) {
+        for (int i = 0; i < 4; i++) {
+            v[i] = v[i] * 1664525u + 1013904223u;
+        }
+
+        v[0] += v[1] * v[3];
+        v[1] += v[2] * v[0];
+        v[2] += v[0] * v[1];
+        v[3] += v[1] * v[2];
+
+        for (int i = 0; i < 4; i++) {
+            v[i] ^= v[i] >> 16u;
+        }
+
+        v[0] += v[1] * v[3];
+        v[1] += v[2] * v[0];
+        v[2] += v[0] * v[1];
+        v[3] += v[1] * v[2];
+    }
+
+private:
+    void refill() {
+        // Bounce in the high bits of the counter word: 65536 blocks of four
+        // numbers per bounce before two bounces could overlap
+        m_Block[0] = m_Pixel;
+        m_Block[1] = m_Sample;
+        m_Block[2] = m_Seed;
+        m_Block[3] = (m_Bounce << 16) | (m_Counter++ & 0xFFFFu);
+        pcg4d(m_Block);
+        m_Available = 4;
+    }
+
+    uint32_t m_Pixel;
+    uint32_t m_Sample;
+    uint32_t m_Seed;
+    const Sampler* m_Sampler;
+    uint32_t m_Bounce = 0;
+    uint32_t m_Counter = 0;
+    uint32_t m_Dimension = 0;   // Sampler dimensions used in this bounce
+
+    uint32_t m_Block[4] = {};
+    int m_Available = 0;
+};
+
+#endif
@@ -3,21 +3,75 @@
 
 #include "Vec3.h"
 
+// Besides origin and direction, a ray caches what every box test needs:
+// the inverse direction and which face of each slab it enters first. Change
+// the direction through setDirection() so the cache stays in sync.
 class Ray {
 public:
     Point3 origin;
     Vec3 direction;
+    Vec3 invDirection;   // 1 / direction (+-inf on zero components)
+    int sign[3];         // 1 if invDirection[a] < 0 (also for -0), else 0
+
+    // Optional differentials: the rays through the neighbouring pixels in
+    // x and y, for footprint estimates
+    bool hasDifferentials = false;
+    Point3 rxOrigin, ryOrigin;
+    Vec3 rxDirection, ryDirection;
 
     // Constructors
-    Ray() {}
-    Ray(const Point3& origin, const Vec3& direction) 
-        : origin(origin), direction(direction) {}
+    Ray() : Ray(Point3(), Vec3(0, 0, -1)) {}
+    Ray(const Point3& origin, const Vec3& direction)
+        : origin(origin) {
+        setDirection(direction);
+    }
+
+    void setDirection(const Vec3& d) {
+        direction = d;
+        invDirection = Vec3(1.0f / d.x, 1.0f / d.y, 1.0f / d.z);
+        sign[0] = invDirection.x < 0;
+        sign[1] = invDirection.y < 0;
+        sign[2] = invDirection.z < 0;
+    }
+
+    void setDifferentials(const Point3& rxO, const Vec3& rxD, const Point3& ryO, const Vec3& ryD) {
+        rxOrigin = rxO;
+        rxDirection = rxD;
+        ryOrigin = ryO;
+        ryDirection = ryD;
+        hasDifferentials = true;
+    }
+
+    // Scale the pixel spacing the differentials stand for (e.g. by
+    // 1/sqrt(spp) when each pixel takes several samples)
+    void scaleDifferentials(float s) {
+        rxOrigin = origin + (rxOrigin - origin) * s;
+        ryOrigin = origin + (ryOrigin - origin) * s;
+        rxDirection = direction + (rxDirection - direction) * s;
+        ryDirection = direction + (ryDirection - direction) * s;
+    }
 
     // Calculate point along the ray: P(t) = origin + t * direction
     Point3 at(float t) const {
         return origin + t * direction;
     }
 
+    // Division-free slab test against the box [bounds[0], bounds[1]],
+    // clipped to [tMin, tMax]. A ray parallel to a slab gets +-inf there;
+    // one lying exactly in a slab plane gets NaN, which fails both compares,
+    // so that slab does not clip (boundaries count as inside).
+    bool intersectBox(const Point3 bounds[2], float tMin, float tMax, float& tNear, float& tFar) const {
+        tNear = tMin;
+        tFar = tMax;
+        for (int a = 0; a < 3; a++) {
+            float entry = (bounds[sign[a]][a] - origin[a]) * invDirection[a];
+            float exit = (bounds[1 - sign[a]][a] - origin[a]) * invDirection[a];
+            tNear = entry > tNear ? entry : tNear;
+            tFar = exit < tFar ? exit : tFar;
+        }
+        return tNear <= tFar;
+    }
+
     // Getters
     Point3 getOrigin() const { return origin; }
     Vec3 getDirection() const { return direction; }
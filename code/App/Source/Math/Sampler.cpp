@@ -0,0 +1,249 @@
+#include "Sampler.h"
+#include "RandomStream.h"
+
+#include <algorithm>
+
+// ============================================================================
+// HASHING AND PERMUTATIONS
+// ============================================================================
+namespace {
+
+// Largest float below 1
+const float ONE_MINUS_EPSILON = 0.99999994f;
+
+uint32_t hash2(uint32_t a, uint32_t b) {
+    uint32_t v[4] = { a, b, 0x9E3779B9u, 0x85EBCA6Bu };
+    RandomStream::pcg4d(v);
+    return v[0];
+}
+
+uint32_t hash3(uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t v[4] = { a, b, c, 0x85EBCA6Bu };
+    RandomStream::pcg4d(v);
+    return v[0];
+}
+
+float toFloat(uint32_t bits) {
+    return std::min(float(bits >> 8) * (1.0f / 16777216.0f), ONE_MINUS_EPSILON);
+}
+
+uint32_t reverseBits(uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+// Burley's improved Laine-Karras hash: bit i of the result depends only on
+// bits 0..i of x, which is what makes it an Owen scramble once the bits
+// are reversed
+uint32_t laineKarrasPermutation(uint32_t x, uint32_t seed) {
+    x += seed;
+    x ^= x * 0x6C50B47Cu;
+    x ^= x * 0xB82F1E52u;
+    x ^= x * 0xC7AFE638u;
+    x ^= x * 0x8D22F6E6u;
+    return x;
+}
+
+uint32_t nestedUniformScramble(uint32_t x, uint32_t seed) {
+    return reverseBits(laineKarrasPermutation(reverseBits(x), seed));
+}
+
+// Kensler's hashed permutation of [0, length) ("Correlated Multi-Jittered
+// Sampling", 2013). Cycle-walks within the next power of two, so the loop
+// runs less than twice on average.
+uint32_t permute(uint32_t i, uint32_t length, uint32_t p) {
+    uint32_t w = length - 1;
+    w |= w >> 1;
+    w |= w >> 2;
+    w |= w >> 4;
+    w |= w >> 8;
+    w |= w >> 16;
+
+    do {
+        i ^= p;
+        i *= 0xE170893Du;
+        i ^= p >> 16;
+        i ^= (i & w) >> 4;
+        i ^= p >> 8;
+        i *= 0x0929EB3Fu;
+        i ^= p >> 23;
+        i ^= (i & w) >> 1;
+        i *= 1 | p >> 27;
+        i *= 0x6935FA69u;
+        i ^= (i & w) >> 11;
+        i *= 0x74DCB303u;
+        i ^= (i & w) >> 2;
+        i *= 0x9E501CC3u;
+        i ^= (i & w) >> 2;
+        i *= 0xC860A3DFu;
+        i &= w;
+        i ^= i >> 5;
+    } while (i >= length);
+
+    return (i + p) % length;
+}
+
+// ----------------------------------------------------------------------------
+// Sobol direction numbers for the first four dimensions (Joe & Kuo):
+// dimension 0 is the van der Corput sequence, 1-3 use the primitive
+// polynomials x + 1, x^2 + x + 1 and x^3 + x + 1
+// ----------------------------------------------------------------------------
+struct SobolDirections {
+    uint32_t v[4][32];
+
+    SobolDirections() {
+        struct Polynomial { uint32_t degree; uint32_t a; uint32_t m[3]; };
+        const Polynomial polynomials[3] = {
+            { 1, 0, { 1, 0, 0 } },
+            { 2, 1, { 1, 3, 0 } },
+            { 3, 1, { 1, 3, 1 } }
+        };
+
+        for (uint32_t bit = 0; bit < 32; bit++) {
+            v[0][bit] = 1u << (31 - bit);
+        }
+
+        for (int d = 1; d < 4; d++) {
+            const Polynomial& p = polynomials[d - 1];
+            for (uint32_t bit = 0; bit < 32; bit++) {
+                if (bit < p.degree) {
+                    v[d][bit] = p.m[bit] << (31 - bit);
+                    continue;
+                }
+
+                uint32_t value = v[d][bit - p.degree] ^ (v[d][bit - p.degree] >> p.degree);
+                for (uint32_t k = 1; k < p.degree; k++) {
+                    if ((p.a >> (p.degree - 1 - k)) & 1) {
+                        value ^= v[d][bit - k];
+                    }
+                }
+                v[d][bit] = value;
+            }
+        }
+    }
+};
+
+const SobolDirections SOBOL;
+
+uint32_t sobolSample(uint32_t index, uint32_t dimension) {
+    uint32_t x = 0;
+    for (uint32_t bit = 0; index != 0; bit++, index >>= 1) {
+        if (index & 1) {
+            x ^= SOBOL.v[dimension][bit];
+        }
+    }
+    return x;
+}
+
+const uint32_t PRIMES[32] = {
+    2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131
+};
+
+} // namespace
+
+// ============================================================================
+// SAMPLER
+// ============================================================================
+Sampler::Sampler(Type type, uint32_t samplesPerPixel, uint32_t seed)
+    : type(type), samplesPerPixel(std::max(samplesPerPixel, 1u)), seed(seed) {}
+
+const char* Sampler::typeName(Type type) {
+    switch (type) {
+        case Type::Random:     return "random";
+        case Type::Stratified: return "stratified";
+        case Type::Halton:     return "halton";
+        case Type::Sobol:      return "sobol";
+    }
+    return "unknown";
+}
+
+bool Sampler::parseType(const std::string& name, Type& type) {
+    for (int i = 0; i < TYPE_COUNT; i++) {
+        if (name == typeName(Type(i))) {
+            type = Type(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+float Sampler::get(uint32_t pixel, uint32_t index, uint32_t dimension) const {
+    uint32_t pixelSeed = hash2(pixel, seed);
+
+    switch (type) {
+        case Type::Stratified: return stratified(pixelSeed, index, dimension);
+        case Type::Halton:     return halton(pixelSeed, index, dimension);
+        case Type::Sobol:      return sobol(pixelSeed, index, dimension);
+        case Type::Random:     break;
+    }
+    return toFloat(hash3(pixelSeed, index, dimension));
+}
+
+std::vector<float> Sampler::buildTable(uint32_t samples, uint32_t dimensions) const {
+    std::vector<float> table(size_t(samples) * dimensions);
+    for (uint32_t i = 0; i < samples; i++) {
+        for (uint32_t d = 0; d < dimensions; d++) {
+            table[size_t(i) * dimensions + d] = get(0, i, d);
+        }
+    }
+    return table;
+}
+
+// ----------------------------------------------------------------------------
+// Stratified: sample i falls in stratum permute(i) of each dimension. Past
+// samplesPerPixel the strata are revisited in a fresh order.
+// ----------------------------------------------------------------------------
+float Sampler::stratified(uint32_t pixelSeed, uint32_t index, uint32_t dimension) const {
+    uint32_t pass = index / samplesPerPixel;
+    uint32_t dimensionSeed = hash3(pixelSeed, dimension, pass);
+
+    uint32_t stratum = permute(index % samplesPerPixel, samplesPerPixel, dimensionSeed);
+    float jitter = toFloat(hash3(dimensionSeed, index, 0x68E31DA4u));
+    return std::min((float(stratum) + jitter) / float(samplesPerPixel), ONE_MINUS_EPSILON);
+}
+
+// ----------------------------------------------------------------------------
+// Halton: radical inverse with every digit permuted by a permutation chosen
+// from the digits above it (Owen scrambling in base b). Digits continue past
+// the end of index, so the low bits are random rather than zero.
+// ----------------------------------------------------------------------------
+float Sampler::halton(uint32_t pixelSeed, uint32_t index, uint32_t dimension) const {
+    const uint32_t primeCount = sizeof(PRIMES) / sizeof(PRIMES[0]);
+    uint32_t base = PRIMES[dimension % primeCount];
+    uint32_t digitSeed = hash2(pixelSeed, dimension);
+
+    double invBase = 1.0 / base;
+    double scale = invBase;
+    double result = 0.0;
+    uint32_t prefix = 0;
+
+    // Stop once a digit no longer changes a float
+    while (scale > 1e-8) {
+        uint32_t digit = index % base;
+        index /= base;
+
+        result += permute(digit, base, hash2(digitSeed, prefix)) * scale;
+        prefix = prefix * base + digit + 1;
+        scale *= invBase;
+    }
+
+    return std::min(float(result), ONE_MINUS_EPSILON);
+}
+
+// ----------------------------------------------------------------------------
+// Sobol: dimension d uses Sobol dimension d % 4 in group d / 4. Each group
+// shuffles the index and scrambles every component with its own seed.
+// ----------------------------------------------------------------------------
+float Sampler::sobol(uint32_t pixelSeed, uint32_t index, uint32_t dimension) const {
+    uint32_t groupSeed = hash2(pixelSeed, dimension / 4);
+    uint32_t component = dimension % 4;
+
+    uint32_t shuffled = nestedUniformScramble(index, groupSeed);
+    uint32_t x = sobolSample(shuffled, component);
+    x = nestedUniformScramble(x, hash2(groupSeed, component));
+    return toFloat(x);
+}
@@ -0,0 +1,81 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+// ============================================================================
+// SAMPLER - Low-discrepancy sample values per pixel, sample and dimension
+// ============================================================================
+// White noise converges at O(N^-1/2). Point sets that cover [0,1)^d evenly
+// converge faster on the smooth parts of the integrand (pixel footprint,
+// lens, BSDF lobes). Every type here is indexed, like RandomStream: a value
+// is a pure function of (pixel, sample index, dimension), so samples can be
+// taken in any order on any thread.
+//
+//   Random      - hashed white noise (the baseline)
+//   Stratified  - each dimension split into samplesPerPixel strata, visited
+//                 in a per-pixel random order, jittered inside the stratum
+//                 (padded 1D / Latin hypercube stratification)
+//   Halton      - radical inverse in the d-th prime base, Owen-scrambled
+//                 digit by digit per pixel
+//   Sobol       - Owen-scrambled, index-shuffled Sobol in groups of four
+//                 dimensions (Burley, "Practical Hash-based Owen
+//                 Scrambling", JCGT 2020); groups are decorrelated by seed
+//
+// Paths use DIMENSIONS_PER_BOUNCE consecutive dimensions per bounce (the
+// camera counts as bounce 0), so a given bounce always lands on the same
+// dimensions whatever earlier bounces did. See RandomStream.
+//
+// The shader cannot afford scrambling per pixel, so buildTable() bakes one
+// scrambled sequence into a texture and PathTrace.glsl decorrelates pixels
+// with a per-pixel shift (XOR for Sobol, toroidal for the others).
+// ============================================================================
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Sampler {
+public:
+    enum class Type { Random = 0, Stratified = 1, Halton = 2, Sobol = 3 };
+    static constexpr int TYPE_COUNT = 4;
+
+    // Dimensions reserved for each bounce (bounce 0 = camera)
+    static constexpr uint32_t DIMENSIONS_PER_BOUNCE = 8;
+
+    // Size of the shader's table (uSamplerTable): TABLE_SAMPLES rows, each
+    // covering the camera and the 16 bounces of the shader loop, four
+    // dimensions per RGBA32F texel
+    static constexpr uint32_t TABLE_SAMPLES = 1024;
+    static constexpr uint32_t TABLE_BOUNCES = 16;
+    static constexpr uint32_t TABLE_DIMENSIONS = (TABLE_BOUNCES + 1) * DIMENSIONS_PER_BOUNCE;
+    static_assert(TABLE_DIMENSIONS % 4 == 0, "Table rows must fill whole RGBA texels");
+
+    // samplesPerPixel sets the stratum count of Type::Stratified; the other
+    // types are progressive and ignore it
+    explicit Sampler(Type type = Type::Sobol, uint32_t samplesPerPixel = 64, uint32_t seed = 0);
+
+    Type getType() const { return type; }
+
+    static const char* typeName(Type type);
+
+    // "random", "stratified", "halton" or "sobol"; returns false otherwise
+    static bool parseType(const std::string& name, Type& type);
+
+    // Value in [0, 1) of a dimension of sample index in pixel
+    float get(uint32_t pixel, uint32_t index, uint32_t dimension) const;
+
+    // Values of pixel 0 for the shader: `samples` rows of `dimensions`
+    // floats, row-major (texel (d / 4, i) holds dimensions d..d+3 of sample i).
+    // Sobol values are multiples of 2^-24, which the shader's XOR shift relies on.
+    std::vector<float> buildTable(uint32_t samples, uint32_t dimensions) const;
+
+private:
+    float stratified(uint32_t pixelSeed, uint32_t index, uint32_t dimension) const;
+    float halton(uint32_t pixelSeed, uint32_t index, uint32_t dimension) const;
+    float sobol(uint32_t pixelSeed, uint32_t index, uint32_t dimension) const;
+
+    Type type;
+    uint32_t samplesPerPixel;
+    uint32_t seed;
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// ============================================================================
+// SIMD LANES - Thin wrappers over SSE/AVX2 with a portable scalar fallback
+// ============================================================================
+// Float4/Mask4 map to one SSE register, Float8/Mask8 to one AVX register.
+// Without AVX, Float8 is emulated with two Float4 halves; without SSE (e.g.
+// ARM builds) every operation falls back to plain scalar loops, so code
+// written against these types compiles everywhere.
+//
+// FloatN/MaskN alias the widest type the current build can run natively.
+// ============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__AVX2__)
+    #define SIMD_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SIMD_SSE 1
+#endif
+
+#if defined(SIMD_AVX2) || defined(SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+namespace Simd {
+
+// ============================================================================
+// 4-WIDE LANES
+// ============================================================================
+#if defined(SIMD_SSE)
+
+struct Mask4 {
+    __m128 v;
+};
+
+struct Float4 {
+    __m128 v;
+
+    static Float4 broadcast(float x) { return {_mm_set1_ps(x)}; }
+    static Float4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float4 operator/(Float4 a, Float4 b) { return {_mm_div_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a) { return {_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))}; }
+
+// a * b + c
+inline Float4 fmadd(Float4 a, Float4 b, Float4 c) {
+#if defined(__FMA__)
+    return {_mm_fmadd_ps(a.v, b.v, c.v)};
+#else
+    return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+
+inline Float4 sqrt(Float4 a) { return {_mm_sqrt_ps(a.v)}; }
+inline Float4 min(Float4 a, Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float4 max(Float4 a, Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Float4 abs(Float4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+
+inline Mask4 operator<(Float4 a, Float4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mask4 operator>(Float4 a, Float4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mask4 operator>=(Float4 a, Float4 b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+
+inline Mask4 operator&(Mask4 a, Mask4 b) { return {_mm_and_ps(a.v, b.v)}; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return {_mm_or_ps(a.v, b.v)}; }
+inline Mask4 operator!(Mask4 a) { return {_mm_xor_ps(a.v, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+
+// mask ? a : b, per lane
+inline Float4 select(Mask4 m, Float4 a, Float4 b) {
+    return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))};
+}
+
+// One bit per lane, lane 0 in bit 0
+inline int bits(Mask4 m) { return _mm_movemask_ps(m.v); }
+
+#else // Scalar fallback
+
+struct Mask4 {
+    bool v[4];
+};
+
+struct Float4 {
+    float v[4];
+
+    static Float4 broadcast(float x) { return {{x, x, x, x}}; }
+    static Float4 load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    void store(float* p) const { for (int i = 0; i < 4; i++) p[i] = v[i]; }
+};
+
+#define SIMD_LANEWISE4(expr) \
+    Float4 r; for (int i = 0; i < 4; i++) r.v[i] = (expr); return r;
+#define SIMD_MASKWISE4(expr) \
+    Mask4 r; for (int i = 0; i < 4; i++) r.v[i] = (expr); return r;
+
+inline Float4 operator+(Float4 a, Float4 b) { SIMD_LANEWISE4(a.v[i] + b.v[i]) }
+inline Float4 operator-(Float4 a, Float4 b) { SIMD_LANEWISE4(a.v[i] - b.v[i]) }
+inline Float4 operator*(Float4 a, Float4 b) { SIMD_LANEWISE4(a.v[i] * b.v[i]) }
+inline Float4 operator/(Float4 a, Float4 b) { SIMD_LANEWISE4(a.v[i] / b.v[i]) }
+inline Float4 operator-(Float4 a) { SIMD_LANEWISE4(-a.v[i]) }
+inline Float4 fmadd(Float4 a, Float4 b, Float4 c) { SIMD_LANEWISE4(a.v[i] * b.v[i] + c.v[i]) }
+inline Float4 sqrt(Float4 a) { SIMD_LANEWISE4(std::sqrt(a.v[i])) }
+// Operand order matches minps/maxps: the second operand wins on NaN
+inline Float4 min(Float4 a, Float4 b) { SIMD_LANEWISE4(a.v[i] < b.v[i] ? a.v[i] : b.v[i]) }
+inline Float4 max(Float4 a, Float4 b) { SIMD_LANEWISE4(a.v[i] > b.v[i] ? a.v[i] : b.v[i]) }
+inline Float4 abs(Float4 a) { SIMD_LANEWISE4(std::abs(a.v[i])) }
+
+inline Mask4 operator<(Float4 a, Float4 b) { SIMD_MASKWISE4(a.v[i] < b.v[i]) }
+inline Mask4 operator<=(Float4 a, Float4 b) { SIMD_MASKWISE4(a.v[i] <= b.v[i]) }
+inline Mask4 operator>(Float4 a, Float4 b) { SIMD_MASKWISE4(a.v[i] > b.v[i]) }
+inline Mask4 operator>=(Float4 a, Float4 b) { SIMD_MASKWISE4(a.v[i] >= b.v[i]) }
+
+inline Mask4 operator&(Mask4 a, Mask4 b) { SIMD_MASKWISE4(a.v[i] && b.v[i]) }
+inline Mask4 operator|(Mask4 a, Mask4 b) { SIMD_MASKWISE4(a.v[i] || b.v[i]) }
+inline Mask4 operator!(Mask4 a) { SIMD_MASKWISE4(!a.v[i]) }
+
+inline Float4 select(Mask4 m, Float4 a, Float4 b) { SIMD_LANEWISE4(m.v[i] ? a.v[i] : b.v[i]) }
+
+inline int bits(Mask4 m) {
+    int result = 0;
+    for (int i = 0; i < 4; i++) result |= (m.v[i] ? 1 : 0) << i;
+    return result;
+}
+
+#undef SIMD_LANEWISE4
+#undef SIMD_MASKWISE4
+
+#endif
+
+// ============================================================================
+// 8-WIDE LANES
+// ============================================================================
+#if defined(SIMD_AVX2)
+
+struct Mask8 {
+    __m256 v;
+};
+
+struct Float8 {
+    __m256 v;
+
+    static Float8 broadcast(float x) { return {_mm256_set1_ps(x)}; }
+    static Float8 load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+inline Float8 operator+(Float8 a, Float8 b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline Float8 operator-(Float8 a, Float8 b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline Float8 operator*(Float8 a, Float8 b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline Float8 operator/(Float8 a, Float8 b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline Float8 operator-(Float8 a) { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+
+inline Float8 fmadd(Float8 a, Float8 b, Float8 c) {
+#if defined(__FMA__)
+    return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#else
+    return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+
+inline Float8 sqrt(Float8 a) { return {_mm256_sqrt_ps(a.v)}; }
+inline Float8 min(Float8 a, Float8 b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline Float8 max(Float8 a, Float8 b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline Float8 abs(Float8 a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+
+inline Mask8 operator<(Float8 a, Float8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline Mask8 operator<=(Float8 a, Float8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline Mask8 operator>(Float8 a, Float8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline Mask8 operator>=(Float8 a, Float8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+
+inline Mask8 operator&(Mask8 a, Mask8 b) { return {_mm256_and_ps(a.v, b.v)}; }
+inline Mask8 operator|(Mask8 a, Mask8 b) { return {_mm256_or_ps(a.v, b.v)}; }
+inline Mask8 operator!(Mask8 a) { return {_mm256_xor_ps(a.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+
+inline Float8 select(Mask8 m, Float8 a, Float8 b) { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+
+inline int bits(Mask8 m) { return _mm256_movemask_ps(m.v); }
+
+#else // Two 4-wide halves
+
+struct Mask8 {
+    Mask4 lo, hi;
+};
+
+struct Float8 {
+    Float4 lo, hi;
+
+    static Float8 broadcast(float x) { return {Float4::broadcast(x), Float4::broadcast(x)}; }
+    static Float8 load(const float* p) { return {Float4::load(p), Float4::load(p + 4)}; }
+    void store(float* p) const { lo.store(p); hi.store(p + 4); }
+};
+
+inline Float8 operator+(Float8 a, Float8 b) { return {a.lo + b.lo, a.hi + b.hi}; }
+inline Float8 operator-(Float8 a, Float8 b) { return {a.lo - b.lo, a.hi - b.hi}; }
+inline Float8 operator*(Float8 a, Float8 b) { return {a.lo * b.lo, a.hi * b.hi}; }
+inline Float8 operator/(Float8 a, Float8 b) { return {a.lo / b.lo, a.hi / b.hi}; }
+inline Float8 operator-(Float8 a) { return {-a.lo, -a.hi}; }
+inline Float8 fmadd(Float8 a, Float8 b, Float8 c) { return {fmadd(a.lo, b.lo, c.lo), fmadd(a.hi, b.hi, c.hi)}; }
+inline Float8 sqrt(Float8 a) { return {sqrt(a.lo), sqrt(a.hi)}; }
+inline Float8 min(Float8 a, Float8 b) { return {min(a.lo, b.lo), min(a.hi, b.hi)}; }
+inline Float8 max(Float8 a, Float8 b) { return {max(a.lo, b.lo), max(a.hi, b.hi)}; }
+inline Float8 abs(Float8 a) { return {abs(a.lo), abs(a.hi)}; }
+
+inline Mask8 operator<(Float8 a, Float8 b) { return {a.lo < b.lo, a.hi < b.hi}; }
+inline Mask8 operator<=(Float8 a, Float8 b) { return {a.lo <= b.lo, a.hi <= b.hi}; }
+inline Mask8 operator>(Float8 a, Float8 b) { return {a.lo > b.lo, a.hi > b.hi}; }
+inline Mask8 operator>=(Float8 a, Float8 b) { return {a.lo >= b.lo, a.hi >= b.hi}; }
+
+inline Mask8 operator&(Mask8 a, Mask8 b) { return {a.lo & b.lo, a.hi & b.hi}; }
+inline Mask8 operator|(Mask8 a, Mask8 b) { return {a.lo | b.lo, a.hi | b.hi}; }
+inline Mask8 operator!(Mask8 a) { return {!a.lo, !a.hi}; }
+
+inline Float8 select(Mask8 m, Float8 a, Float8 b) { return {select(m.lo, a.lo, b.lo), select(m.hi, a.hi, b.hi)}; }
+
+inline int bits(Mask8 m) { return bits(m.lo) | (bits(m.hi) << 4); }
+
+#endif
+
+// ============================================================================
+// 1-WIDE LANES
+// ============================================================================
+// Plain float/bool under the same names, so a kernel templated on its lane
+// type also instantiates as scalar code (and agrees with the wide version).
+inline float fmadd(float a, float b, float c) { return a * b + c; }
+inline float sqrt(float a) { return std::sqrt(a); }
+inline float min(float a, float b) { return a < b ? a : b; }
+inline float max(float a, float b) { return a > b ? a : b; }
+inline float abs(float a) { return std::abs(a); }
+inline float select(bool m, float a, float b) { return m ? a : b; }
+
+// x in every lane
+template <typename T> inline T splat(float x);
+template <> inline float splat<float>(float x) { return x; }
+template <> inline Float4 splat<Float4>(float x) { return Float4::broadcast(x); }
+template <> inline Float8 splat<Float8>(float x) { return Float8::broadcast(x); }
+
+// ============================================================================
+// COMMON HELPERS
+// ============================================================================
+template <typename MaskT>
+inline bool any(MaskT m) { return bits(m) != 0; }
+
+template <typename MaskT>
+inline bool none(MaskT m) { return bits(m) == 0; }
+
+// Widest lane group the build can execute natively
+#if defined(SIMD_AVX2)
+using FloatN = Float8;
+using MaskN = Mask8;
+constexpr int NATIVE_WIDTH = 8;
+#else
+using FloatN = Float4;
+using MaskN = Mask4;
+constexpr int NATIVE_WIDTH = 4;
+#endif
+
+} // namespace Simd
+
+#endif
@@ -4,47 +4,102 @@
 #include <cmath>
 #include <iostream>
 
+// Everything except the stream operator is inline, so vector math compiles
+// to straight-line code in the caller (no cross-TU call per operator), and
+// everything but length/normalization is constexpr. 4/8-wide versions for
+// packet code live in Vec3Simd.h.
 class Vec3 {
 public:
     float x, y, z;
 
     // Constructors
-    Vec3() : x(0), y(0), z(0) {}
-    Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vec3() : x(0), y(0), z(0) {}
+    constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
 
     // Arithmetic operators
-    Vec3 operator+(const Vec3& v) const;
-    Vec3 operator-(const Vec3& v) const;
-    Vec3 operator*(float t) const;
-    Vec3 operator/(float t) const;
-    Vec3 operator-() const;
-    
-    Vec3& operator+=(const Vec3& v);
-    Vec3& operator-=(const Vec3& v);
-    Vec3& operator*=(float t);
-    Vec3& operator/=(float t);
+    constexpr Vec3 operator+(const Vec3& v) const { return Vec3(x + v.x, y + v.y, z + v.z); }
+    constexpr Vec3 operator-(const Vec3& v) const { return Vec3(x - v.x, y - v.y, z - v.z); }
+    constexpr Vec3 operator*(float t) const { return Vec3(x * t, y * t, z * t); }
+    constexpr Vec3 operator/(float t) const { return Vec3(x / t, y / t, z / t); }
+    constexpr Vec3 operator-() const { return Vec3(-x, -y, -z); }
+
+    constexpr Vec3& operator+=(const Vec3& v) {
+        x += v.x;
+        y += v.y;
+        z += v.z;
+        return *this;
+    }
+
+    constexpr Vec3& operator-=(const Vec3& v) {
+        x -= v.x;
+        y -= v.y;
+        z -= v.z;
+        return *this;
+    }
+
+    constexpr Vec3& operator*=(float t) {
+        x *= t;
+        y *= t;
+        z *= t;
+        return *this;
+    }
+
+    constexpr Vec3& operator/=(float t) {
+        return *this *= 1 / t;
+    }
 
     // Dot product
-    float dot(const Vec3& v) const;
-    
+    constexpr float dot(const Vec3& v) const {
+        return x * v.x + y * v.y + z * v.z;
+    }
+
     // Cross product
-    Vec3 cross(const Vec3& v) const;
-    
+    constexpr Vec3 cross(const Vec3& v) const {
+        return Vec3(
+            y * v.z - z * v.y,
+            z * v.x - x * v.z,
+            x * v.y - y * v.x
+        );
+    }
+
     // Length
-    float length() const;
-    float lengthSquared() const;
-    
+    float length() const { return std::sqrt(lengthSquared()); }
+    constexpr float lengthSquared() const { return x * x + y * y + z * z; }
+
     // Normalization
-    Vec3 normalized() const;
-    void normalize();
+    Vec3 normalized() const {
+        float len = length();
+        if (len > 0) {
+            return *this / len;
+        }
+        return *this;
+    }
+
+    void normalize() {
+        float len = length();
+        if (len > 0) {
+            *this /= len;
+        }
+    }
 
     // Index access
-    float operator[](int i) const;
-    float& operator[](int i);
+    constexpr float operator[](int i) const {
+        if (i == 0) return x;
+        if (i == 1) return y;
+        return z;
+    }
+
+    constexpr float& operator[](int i) {
+        if (i == 0) return x;
+        if (i == 1) return y;
+        return z;
+    }
 };
 
 // Operator for scalar multiplication from the left
-Vec3 operator*(float t, const Vec3& v);
+constexpr Vec3 operator*(float t, const Vec3& v) {
+    return v * t;
+}
 
 // Output operator for debugging
 std::ostream& operator<<(std::ostream& os, const Vec3& v);
@@ -0,0 +1,112 @@
+#ifndef VEC3SIMD_H
+#define VEC3SIMD_H
+
+// ============================================================================
+// VEC3 LANES - Structure-of-arrays Vec3 for packet code
+// ============================================================================
+// Vec3Lanes<F> holds one Vec3 per lane of F: x, y and z are each a full
+// register, so a dot product is two fmadds over 4 or 8 vectors at once
+// with no shuffles. The backend is whatever Simd.h picked for F (SSE, AVX2
+// or the scalar fallback).
+//
+//   Vec3x4  - 4 lanes (Simd::Float4)
+//   Vec3x8  - 8 lanes (Simd::Float8)
+//   Vec3xN  - the widest native width (Simd::FloatN)
+//
+// F = float also works, which lets one templated kernel serve both the
+// scalar and the packet path (see MonteCarlo.cpp).
+//
+// USAGE EXAMPLE:
+// --------------
+//   Vec3x8 n = Vec3x8::load(nx, ny, nz);     // 8 normals from SoA arrays
+//   Vec3x8 l = Vec3x8::broadcast(lightDir);
+//   Simd::Float8 cosTheta = Simd::max(n.dot(l), Simd::Float8::broadcast(0.0f));
+// ============================================================================
+
+#include "Simd.h"
+#include "Vec3.h"
+
+template <typename F>
+struct Vec3Lanes {
+    F x, y, z;
+
+    static constexpr int WIDTH = int(sizeof(F) / sizeof(float));
+
+    // The same vector in every lane
+    static Vec3Lanes broadcast(const Vec3& v) {
+        return { Simd::splat<F>(v.x), Simd::splat<F>(v.y), Simd::splat<F>(v.z) };
+    }
+
+    // WIDTH vectors from three component arrays (unaligned)
+    static Vec3Lanes load(const float* xs, const float* ys, const float* zs) {
+        return { F::load(xs), F::load(ys), F::load(zs) };
+    }
+
+    void store(float* xs, float* ys, float* zs) const {
+        x.store(xs);
+        y.store(ys);
+        z.store(zs);
+    }
+
+    // Vector in lane i (slow: goes through memory; for tails and debugging)
+    Vec3 lane(int i) const {
+        float xs[WIDTH], ys[WIDTH], zs[WIDTH];
+        store(xs, ys, zs);
+        return Vec3(xs[i], ys[i], zs[i]);
+    }
+
+    Vec3Lanes operator+(const Vec3Lanes& v) const { return { x + v.x, y + v.y, z + v.z }; }
+    Vec3Lanes operator-(const Vec3Lanes& v) const { return { x - v.x, y - v.y, z - v.z }; }
+    Vec3Lanes operator*(F t) const { return { x * t, y * t, z * t }; }
+    Vec3Lanes operator/(F t) const { return *this * (Simd::splat<F>(1.0f) / t); }
+    Vec3Lanes operator-() const { return { -x, -y, -z }; }
+
+    Vec3Lanes& operator+=(const Vec3Lanes& v) { return *this = *this + v; }
+    Vec3Lanes& operator-=(const Vec3Lanes& v) { return *this = *this - v; }
+    Vec3Lanes& operator*=(F t) { return *this = *this * t; }
+
+    F dot(const Vec3Lanes& v) const {
+        return Simd::fmadd(x, v.x, Simd::fmadd(y, v.y, z * v.z));
+    }
+
+    Vec3Lanes cross(const Vec3Lanes& v) const {
+        return {
+            y * v.z - z * v.y,
+            z * v.x - x * v.z,
+            x * v.y - y * v.x
+        };
+    }
+
+    F lengthSquared() const { return dot(*this); }
+    F length() const { return Simd::sqrt(lengthSquared()); }
+
+    // Zero-length lanes are returned unchanged, as in Vec3::normalized
+    Vec3Lanes normalized() const {
+        F len = length();
+        F zero = Simd::splat<F>(0.0f);
+        F scale = Simd::select(len > zero, Simd::splat<F>(1.0f) / Simd::select(len > zero, len, Simd::splat<F>(1.0f)),
+                               Simd::splat<F>(1.0f));
+        return *this * scale;
+    }
+};
+
+template <typename F>
+inline Vec3Lanes<F> operator*(F t, const Vec3Lanes<F>& v) {
+    return v * t;
+}
+
+namespace Simd {
+
+// mask ? a : b, per lane
+template <typename M, typename F>
+inline Vec3Lanes<F> select(M m, const Vec3Lanes<F>& a, const Vec3Lanes<F>& b) {
+    return { select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z) };
+}
+
+} // namespace Simd
+
+using Vec3x4 = Vec3Lanes<Simd::Float4>;
+using Vec3x8 = Vec3Lanes<Simd::Float8>;
+using Vec3xN = Vec3Lanes<Simd::FloatN>;
+
+#endif
@@ -3,12 +3,51 @@
 // ============================================================================
 
 #include "Quadric.h"
+#include "../Math/Simd.h"
 #include <cmath>
 #include <algorithm>
 #include <limits>
 
 namespace Quadric
 {
+	// ============================================================================
+	// COEFFICIENTS - MATRIX FORM
+	// ============================================================================
+	
+	glm::mat4 QuadricCoefficients::ToMatrix() const
+	{
+		// glm is column-major; Q is symmetric so the layout reads the same
+		return glm::mat4(
+			A,        D * 0.5f, E * 0.5f, G * 0.5f,
+			D * 0.5f, B,        F * 0.5f, H * 0.5f,
+			E * 0.5f, F * 0.5f, C,        I * 0.5f,
+			G * 0.5f, H * 0.5f, I * 0.5f, J
+		);
+	}
+	
+	QuadricCoefficients QuadricCoefficients::FromMatrix(const glm::mat4& Q)
+	{
+		QuadricCoefficients coeffs;
+		coeffs.A = Q[0][0];
+		coeffs.B = Q[1][1];
+		coeffs.C = Q[2][2];
+		coeffs.D = Q[0][1] + Q[1][0];
+		coeffs.E = Q[0][2] + Q[2][0];
+		coeffs.F = Q[1][2] + Q[2][1];
+		coeffs.G = Q[0][3] + Q[3][0];
+		coeffs.H = Q[1][3] + Q[3][1];
+		coeffs.I = Q[2][3] + Q[3][2];
+		coeffs.J = Q[3][3];
+		return coeffs;
+	}
+	
+	QuadricCoefficients QuadricCoefficients::Transformed(const glm::mat4& objectToWorld) const
+	{
+		// World point p maps to object point M⁻¹p, so f'(p) = f(M⁻¹p)
+		glm::mat4 worldToObject = glm::inverse(objectToWorld);
+		return FromMatrix(glm::transpose(worldToObject) * ToMatrix() * worldToObject);
+	}
+	
 	// ============================================================================
 	// BOUNDING BOX IMPLEMENTATION
 	// ============================================================================
@@ -23,26 +62,71 @@ namespace Quadric
 	bool BoundingBox::Intersect(const glm::vec3& origin, const glm::vec3& direction,
 	                           float& tMin, float& tMax) const
 	{
-		// AABB ray intersection using slab method
-		float t1 = (Min.x - origin.x) / direction.x;
-		float t2 = (Max.x - origin.x) / direction.x;
+		return Intersect(Ray(origin, direction), tMin, tMax);
+	}
+	
+	bool BoundingBox::Intersect(const Ray& ray, float& tMin, float& tMax) const
+	{
+		// AABB ray intersection using slab method; unclipped, so a ray
+		// starting inside gets a negative entry distance
+		const float infinity = std::numeric_limits<float>::infinity();
+		return IntersectSlabs(Min, Max, ray, -infinity, infinity, tMin, tMax) && tMax >= 0.0f;
+	}
+	
+	/// Slab test for 8 rays; offsets are (Min - origin) and (Max - origin).
+	/// Same rules as IntersectSlabs: the sign of each inverse direction picks
+	/// the entry plane, and NaN distances (a ray lying in a slab plane) are
+	/// dropped because max/min return their second operand on NaN.
+	static Simd::Mask8 IntersectSlabs8(const float* offsetMin, const float* offsetMax,
+	                                  Simd::Float8 ix, Simd::Float8 iy, Simd::Float8 iz,
+	                                  Simd::Float8& tNear, Simd::Float8& tFar)
+	{
+		using Simd::Float8;
 		
-		tMin = std::min(t1, t2);
-		tMax = std::max(t1, t2);
+		const Float8 zero = Float8::broadcast(0.0f);
+		const Float8 inverse[3] = { ix, iy, iz };
 		
-		t1 = (Min.y - origin.y) / direction.y;
-		t2 = (Max.y - origin.y) / direction.y;
+		tNear = Float8::broadcast(-std::numeric_limits<float>::infinity());
+		tFar = Float8::broadcast(std::numeric_limits<float>::infinity());
+		for (int axis = 0; axis < 3; axis++)
+		{
+			Simd::Mask8 negative = inverse[axis] < zero;
+			Float8 low = Float8::broadcast(offsetMin[axis]);
+			Float8 high = Float8::broadcast(offsetMax[axis]);
+			
+			Float8 entry = Simd::select(negative, high, low) * inverse[axis];
+			Float8 exit = Simd::select(negative, low, high) * inverse[axis];
+			tNear = Simd::max(entry, tNear);
+			tFar = Simd::min(exit, tFar);
+		}
 		
-		tMin = std::max(tMin, std::min(t1, t2));
-		tMax = std::min(tMax, std::max(t1, t2));
+		return (tFar >= tNear) & (tFar >= zero);
+	}
+	
+	template <int N>
+	uint32_t BoundingBox::IntersectPacket(const RayPacket<N>& packet, float* tMin, float* tMax) const
+	{
+		using Simd::Float8;
 		
-		t1 = (Min.z - origin.z) / direction.z;
-		t2 = (Max.z - origin.z) / direction.z;
+		// The origin is shared, so the slab offsets are too
+		const glm::vec3 offsetMin = Min - packet.Origin;
+		const glm::vec3 offsetMax = Max - packet.Origin;
 		
-		tMin = std::max(tMin, std::min(t1, t2));
-		tMax = std::min(tMax, std::max(t1, t2));
+		uint32_t mask = 0;
+		for (int i = 0; i < N; i += 8)
+		{
+			Float8 tNear, tFar;
+			Simd::Mask8 hit = IntersectSlabs8(&offsetMin.x, &offsetMax.x,
+			                                  Float8::load(packet.InvDirX + i),
+			                                  Float8::load(packet.InvDirY + i),
+			                                  Float8::load(packet.InvDirZ + i),
+			                                  tNear, tFar);
+			tNear.store(tMin + i);
+			tFar.store(tMax + i);
+			mask |= (uint32_t)Simd::bits(hit) << i;
+		}
 		
-		return tMax >= tMin && tMax >= 0.0f;
+		return mask;
 	}
 	
 	// ============================================================================
@@ -61,6 +145,7 @@ namespace Quadric
 		, m_BoundingBox()
 		, m_UseBoundingBox(false)
 	{
+		UpdateBounds();
 	}
 	
 	QuadricSurface::QuadricSurface(const QuadricCoefficients& coeffs, const BoundingBox& bbox)
@@ -68,16 +153,41 @@ namespace Quadric
 		, m_BoundingBox(bbox)
 		, m_UseBoundingBox(true)
 	{
+		UpdateBounds();
 	}
 	
 	void QuadricSurface::SetCoefficients(const QuadricCoefficients& coeffs)
 	{
 		m_Coefficients = coeffs;
+		UpdateBounds();
 	}
 	
 	void QuadricSurface::SetBoundingBox(const BoundingBox& bbox)
 	{
 		m_BoundingBox = bbox;
+		UpdateBounds();
+	}
+	
+	void QuadricSurface::SetBoundingBoxEnabled(bool enabled)
+	{
+		m_UseBoundingBox = enabled;
+		UpdateBounds();
+	}
+	
+	void QuadricSurface::UpdateBounds()
+	{
+		if (m_UseBoundingBox)
+		{
+			// Shrink the user box to the surface; if the surface misses it
+			// entirely, keep the user box so nothing changes
+			if (!ComputeClippedExtent(m_Coefficients, m_BoundingBox, m_Bounds))
+				m_Bounds = m_BoundingBox;
+			m_HasBounds = true;
+		}
+		else
+		{
+			m_HasBounds = ComputeBoundedExtent(m_Coefficients, m_Bounds);
+		}
 	}
 	
 	bool QuadricSurface::SolveQuadratic(float A, float B, float C, float& t0, float& t1) const
@@ -117,11 +227,12 @@ namespace Quadric
 		IntersectionResult result;
 		result.Hit = false;
 		
-		// Check bounding box first if enabled
-		if (m_UseBoundingBox)
+		// Cull against the tight bounds first. They enclose every point of the
+		// surface inside the user box, so clipping below is unaffected.
+		if (m_HasBounds)
 		{
 			float boxTMin, boxTMax;
-			if (!m_BoundingBox.Intersect(rayOrigin, rayDirection, boxTMin, boxTMax))
+			if (!m_Bounds.Intersect(rayOrigin, rayDirection, boxTMin, boxTMax))
 				return result;
 			
 			// Restrict search range to bounding box
@@ -130,54 +241,9 @@ namespace Quadric
 		}
 		
 		// Ray equation: P(t) = O + tD, where O = origin, D = direction
-		// Substitute into quadric equation and solve for t
-		
-		const float& A = m_Coefficients.A;
-		const float& B = m_Coefficients.B;
-		const float& C = m_Coefficients.C;
-		const float& D = m_Coefficients.D;
-		const float& E = m_Coefficients.E;
-		const float& F = m_Coefficients.F;
-		const float& G = m_Coefficients.G;
-		const float& H = m_Coefficients.H;
-		const float& I = m_Coefficients.I;
-		const float& J = m_Coefficients.J;
-		
-		const glm::vec3& O = rayOrigin;
-		const glm::vec3& d = rayDirection;
-		
-		// Compute coefficients for the quadratic equation: at² + bt + c = 0
-		
-		// Coefficient of t²
-		float a = A * d.x * d.x + 
-		         B * d.y * d.y + 
-		         C * d.z * d.z +
-		         D * d.x * d.y + 
-		         E * d.x * d.z + 
-		         F * d.y * d.z;
-		
-		// Coefficient of t
-		float b = 2.0f * A * O.x * d.x + 
-		         2.0f * B * O.y * d.y + 
-		         2.0f * C * O.z * d.z +
-		         D * (O.x * d.y + O.y * d.x) + 
-		         E * (O.x * d.z + O.z * d.x) + 
-		         F * (O.y * d.z + O.z * d.y) +
-		         G * d.x + 
-		         H * d.y + 
-		         I * d.z;
-		
-		// Constant term
-		float c = A * O.x * O.x + 
-		         B * O.y * O.y + 
-		         C * O.z * O.z +
-		         D * O.x * O.y + 
-		         E * O.x * O.z + 
-		         F * O.y * O.z +
-		         G * O.x + 
-		         H * O.y + 
-		         I * O.z + 
-		         J;
+		// Substitute into quadric equation: at² + bt + c = 0
+		float a, b, c;
+		ExpandRay(rayOrigin, rayDirection, a, b, c);
 		
 		// Solve quadratic equation
 		float t0, t1;
@@ -235,6 +301,214 @@ namespace Quadric
 		return result;
 	}
 	
+	bool QuadricSurface::Occluded(const glm::vec3& rayOrigin,
+	                              const glm::vec3& rayDirection,
+	                              float tMax, float tMin) const
+	{
+		if (m_HasBounds)
+		{
+			float boxTMin, boxTMax;
+			if (!m_Bounds.Intersect(rayOrigin, rayDirection, boxTMin, boxTMax))
+				return false;
+			
+			tMin = std::max(tMin, boxTMin);
+			tMax = std::min(tMax, boxTMax);
+		}
+		
+		float a, b, c;
+		ExpandRay(rayOrigin, rayDirection, a, b, c);
+		
+		float t0, t1;
+		if (!SolveQuadratic(a, b, c, t0, t1))
+			return false;
+		
+		// Either root blocks the ray if it is in range and not clipped away;
+		// no hit record or normal is built
+		for (float t : { t0, t1 })
+		{
+			if (t < tMin || t > tMax)
+				continue;
+			if (!m_UseBoundingBox || m_BoundingBox.Contains(rayOrigin + t * rayDirection))
+				return true;
+		}
+		
+		return false;
+	}
+	
+	void QuadricSurface::ExpandRay(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                               float& a, float& b, float& c) const
+	{
+		const float& A = m_Coefficients.A;
+		const float& B = m_Coefficients.B;
+		const float& C = m_Coefficients.C;
+		const float& D = m_Coefficients.D;
+		const float& E = m_Coefficients.E;
+		const float& F = m_Coefficients.F;
+		const float& G = m_Coefficients.G;
+		const float& H = m_Coefficients.H;
+		const float& I = m_Coefficients.I;
+		const float& J = m_Coefficients.J;
+		
+		const glm::vec3& O = rayOrigin;
+		const glm::vec3& d = rayDirection;
+		
+		// Coefficient of t²
+		a = A * d.x * d.x + 
+		    B * d.y * d.y + 
+		    C * d.z * d.z +
+		    D * d.x * d.y + 
+		    E * d.x * d.z + 
+		    F * d.y * d.z;
+		
+		// Coefficient of t
+		b = 2.0f * A * O.x * d.x + 
+		    2.0f * B * O.y * d.y + 
+		    2.0f * C * O.z * d.z +
+		    D * (O.x * d.y + O.y * d.x) + 
+		    E * (O.x * d.z + O.z * d.x) + 
+		    F * (O.y * d.z + O.z * d.y) +
+		    G * d.x + 
+		    H * d.y + 
+		    I * d.z;
+		
+		// Constant term
+		c = A * O.x * O.x + 
+		    B * O.y * O.y + 
+		    C * O.z * O.z +
+		    D * O.x * O.y + 
+		    E * O.x * O.z + 
+		    F * O.y * O.z +
+		    G * O.x + 
+		    H * O.y + 
+		    I * O.z + 
+		    J;
+	}
+	
+	// ----------------------------------------------------------------------------
+	// Packet intersection
+	// ----------------------------------------------------------------------------
+	// With a shared origin O, substituting P(t) = O + tD gives
+	//   f(O + tD) = Q(D)t² + (∇f(O)·D)t + f(O)
+	// where Q is the second-degree part. f(O) and ∇f(O) are computed once per
+	// packet, so each ray only pays for its direction terms. Root selection and
+	// bounding box handling match Intersect.
+	// ----------------------------------------------------------------------------
+	template <int N>
+	uint32_t QuadricSurface::IntersectPacket(const RayPacket<N>& packet,
+	                                         PacketIntersectionResult<N>& result,
+	                                         float tMin, float tMax) const
+	{
+		using Simd::Float8;
+		using Simd::Mask8;
+		using Simd::fmadd;
+		
+		const glm::vec3& O = packet.Origin;
+		
+		// Origin-only terms
+		const Float8 c = Float8::broadcast(Evaluate(O));
+		const glm::vec3 gradient = CalculateNormal(O);
+		const Float8 gx = Float8::broadcast(gradient.x);
+		const Float8 gy = Float8::broadcast(gradient.y);
+		const Float8 gz = Float8::broadcast(gradient.z);
+		
+		const Float8 A = Float8::broadcast(m_Coefficients.A);
+		const Float8 B = Float8::broadcast(m_Coefficients.B);
+		const Float8 C = Float8::broadcast(m_Coefficients.C);
+		const Float8 D = Float8::broadcast(m_Coefficients.D);
+		const Float8 E = Float8::broadcast(m_Coefficients.E);
+		const Float8 F = Float8::broadcast(m_Coefficients.F);
+		
+		const Float8 ox = Float8::broadcast(O.x), oy = Float8::broadcast(O.y), oz = Float8::broadcast(O.z);
+		const Float8 minX = Float8::broadcast(m_BoundingBox.Min.x), maxX = Float8::broadcast(m_BoundingBox.Max.x);
+		const Float8 minY = Float8::broadcast(m_BoundingBox.Min.y), maxY = Float8::broadcast(m_BoundingBox.Max.y);
+		const Float8 minZ = Float8::broadcast(m_BoundingBox.Min.z), maxZ = Float8::broadcast(m_BoundingBox.Max.z);
+		const glm::vec3 offsetMin = m_Bounds.Min - O;
+		const glm::vec3 offsetMax = m_Bounds.Max - O;
+		
+		const Float8 zero = Float8::broadcast(0.0f);
+		const Float8 half = Float8::broadcast(0.5f);
+		const Float8 four = Float8::broadcast(4.0f);
+		const Float8 epsilon = Float8::broadcast(1e-6f);
+		const Float8 noHit = Float8::broadcast(std::numeric_limits<float>::infinity());
+		
+		result.HitMask = 0;
+		for (int i = 0; i < N; i += 8)
+		{
+			const Float8 dx = Float8::load(packet.DirX + i);
+			const Float8 dy = Float8::load(packet.DirY + i);
+			const Float8 dz = Float8::load(packet.DirZ + i);
+			
+			Float8 rangeMin = Float8::broadcast(tMin);
+			Float8 rangeMax = Float8::broadcast(tMax);
+			Mask8 active = zero <= zero;   // All lanes
+			
+			// Cull against the tight bounds first
+			if (m_HasBounds)
+			{
+				Float8 boxTMin, boxTMax;
+				active = IntersectSlabs8(&offsetMin.x, &offsetMax.x,
+				                         Float8::load(packet.InvDirX + i),
+				                         Float8::load(packet.InvDirY + i),
+				                         Float8::load(packet.InvDirZ + i),
+				                         boxTMin, boxTMax);
+				if (Simd::none(active))
+				{
+					noHit.store(result.Distance + i);
+					continue;
+				}
+				
+				rangeMin = Simd::max(rangeMin, boxTMin);
+				rangeMax = Simd::min(rangeMax, boxTMax);
+			}
+			
+			// a = Q(D) = Ax² + By² + Cz² + Dxy + Exz + Fyz evaluated at D
+			Float8 a = dx * fmadd(A, dx, fmadd(D, dy, E * dz));
+			a = fmadd(dy, fmadd(B, dy, F * dz), a);
+			a = fmadd(C * dz, dz, a);
+			
+			// b = ∇f(O)·D
+			Float8 b = fmadd(gx, dx, fmadd(gy, dy, gz * dz));
+			
+			// Quadratic branch (same root selection as SolveQuadratic)
+			Float8 discriminant = b * b - four * a * c;
+			Mask8 isLinear = Simd::abs(a) < epsilon;
+			Mask8 hasRoots = (!isLinear) & (discriminant >= zero);
+			Float8 sqrtDisc = Simd::sqrt(Simd::max(discriminant, zero));
+			Float8 q = select(b < zero, (-b - sqrtDisc) * half, (-b + sqrtDisc) * half);
+			Float8 r0 = q / a;
+			Float8 r1 = c / q;
+			Float8 t0 = Simd::min(r0, r1);
+			Float8 t1 = Simd::max(r0, r1);
+			
+			// Linear branch: bt + c = 0
+			if (Simd::any(isLinear))
+			{
+				Mask8 linear = isLinear & (!(Simd::abs(b) < epsilon));
+				Float8 rLinear = -c / b;
+				t0 = select(linear, rLinear, t0);
+				t1 = select(linear, rLinear, t1);
+				hasRoots = hasRoots | linear;
+			}
+			
+			Mask8 valid0 = active & hasRoots & (t0 >= rangeMin) & (t0 <= rangeMax);
+			Mask8 valid1 = active & hasRoots & (t1 >= rangeMin) & (t1 <= rangeMax);
+			
+			// If bounding box is enabled, the hit point must be inside
+			if (m_UseBoundingBox)
+			{
+				Float8 x0 = fmadd(t0, dx, ox), y0 = fmadd(t0, dy, oy), z0 = fmadd(t0, dz, oz);
+				Float8 x1 = fmadd(t1, dx, ox), y1 = fmadd(t1, dy, oy), z1 = fmadd(t1, dz, oz);
+				valid0 = valid0 & (x0 >= minX) & (x0 <= maxX) & (y0 >= minY) & (y0 <= maxY) & (z0 >= minZ) & (z0 <= maxZ);
+				valid1 = valid1 & (x1 >= minX) & (x1 <= maxX) & (y1 >= minY) & (y1 <= maxY) & (z1 >= minZ) & (z1 <= maxZ);
+			}
+			
+			select(valid0, t0, select(valid1, t1, noHit)).store(result.Distance + i);
+			result.HitMask |= (uint32_t)Simd::bits(valid0 | valid1) << i;
+		}
+		
+		return result.HitMask;
+	}
+	
 	float QuadricSurface::Evaluate(const glm::vec3& point) const
 	{
 		const float& A = m_Coefficients.A;
@@ -431,33 +705,221 @@ namespace Quadric
 		return QuadricSurface(coeffs, bbox);
 	}
 	
+	QuadricSurface QuadricSurface::CreatePlane(const glm::vec3& normal, float offset)
+	{
+		// n·p - offset = 0
+		QuadricCoefficients coeffs;
+		coeffs.G = normal.x;
+		coeffs.H = normal.y;
+		coeffs.I = normal.z;
+		coeffs.J = -offset;
+		
+		return QuadricSurface(coeffs);
+	}
+	
 	// ============================================================================
 	// UTILITY FUNCTIONS
 	// ============================================================================
 	
 	bool IsQuadricBounded(const QuadricCoefficients& coeffs)
 	{
-		// A quadric is bounded if all second-degree terms have the same sign
-		// and none are zero (ellipsoid case)
+		// A quadric is bounded if its second-degree part is positive or
+		// negative definite (ellipsoid case). Sylvester's criterion on
+		//     | A    D/2  E/2 |
+		// M = | D/2  B    F/2 |
+		//     | E/2  F/2  C   |
+		// scaled so the largest term is 1, making the thresholds relative.
+		float scale = std::max({ std::abs(coeffs.A), std::abs(coeffs.B), std::abs(coeffs.C),
+		                         std::abs(coeffs.D), std::abs(coeffs.E), std::abs(coeffs.F) });
+		if (scale < 1e-12f)
+			return false;
+		
+		float a = coeffs.A / scale, b = coeffs.B / scale, c = coeffs.C / scale;
+		float d = coeffs.D * 0.5f / scale, e = coeffs.E * 0.5f / scale, f = coeffs.F * 0.5f / scale;
+		
+		float minor1 = a;
+		float minor2 = a * b - d * d;
+		float minor3 = a * (b * c - f * f) - d * (d * c - f * e) + e * (d * f - b * e);
+		
+		bool positiveDefinite = minor1 > 1e-6f && minor2 > 1e-6f && minor3 > 1e-6f;
+		bool negativeDefinite = minor1 < -1e-6f && minor2 > 1e-6f && minor3 < -1e-6f;
+		return positiveDefinite || negativeDefinite;
+	}
+	
+	// ----------------------------------------------------------------------------
+	// Tight bounds
+	// ----------------------------------------------------------------------------
+	// In matrix form f(p) = pᵀMp + 2bᵀp + J, with M the upper 3x3 of
+	// ToMatrix() and b = (G, H, I) / 2. Results are padded slightly so float
+	// error at the extremes never culls a real hit.
+	// ----------------------------------------------------------------------------
+	
+	static BoundingBox PadBounds(const glm::vec3& min, const glm::vec3& max)
+	{
+		float largest = std::max({ std::abs(min.x), std::abs(min.y), std::abs(min.z),
+		                           std::abs(max.x), std::abs(max.y), std::abs(max.z) });
+		glm::vec3 pad(1e-4f * (1.0f + largest));
+		return BoundingBox(min - pad, max + pad);
+	}
+	
+	/// Points where f = 0 along the line p0 + s·dir (dir normalized); returns the count
+	static int IntersectLine(const glm::mat3& M, const glm::vec3& b, float J,
+	                         const glm::vec3& p0, const glm::vec3& dir, glm::vec3 points[2])
+	{
+		// f(p0 + s·dir) = (dirᵀM dir)s² + 2((Mp0 + b)·dir)s + f(p0)
+		glm::vec3 Mp0 = M * p0;
+		float a = glm::dot(dir, M * dir);
+		float halfB = glm::dot(Mp0 + b, dir);
+		float c = glm::dot(p0, Mp0) + 2.0f * glm::dot(b, p0) + J;
+		
+		if (std::abs(a) < 1e-6f)
+		{
+			if (std::abs(halfB) < 1e-6f)
+				return 0;
+			
+			points[0] = p0 - (c / (2.0f * halfB)) * dir;
+			return 1;
+		}
+		
+		float discriminant = halfB * halfB - a * c;
+		if (discriminant < 0.0f)
+			return 0;
+		
+		float sqrtDiscriminant = std::sqrt(discriminant);
+		points[0] = p0 + ((-halfB - sqrtDiscriminant) / a) * dir;
+		points[1] = p0 + ((-halfB + sqrtDiscriminant) / a) * dir;
+		return 2;
+	}
+	
+	bool ComputeBoundedExtent(const QuadricCoefficients& coeffs, BoundingBox& bounds)
+	{
+		if (!IsQuadricBounded(coeffs))
+			return false;
+		
+		// Completing the square around c = -M⁻¹b gives (p - c)ᵀM(p - c) = k with
+		// k = bᵀM⁻¹b - J. The extent along axis i is then sqrt(k·(M⁻¹)ᵢᵢ).
+		glm::mat4 Q = coeffs.ToMatrix();
+		glm::mat3 M = glm::mat3(Q);
+		glm::vec3 b(Q[3]);
 		
-		int positiveCount = 0;
-		int negativeCount = 0;
-		int zeroCount = 0;
+		glm::mat3 inverseM = glm::inverse(M);
+		glm::vec3 center = -(inverseM * b);
+		float k = -glm::dot(b, center) - coeffs.J;
 		
-		if (coeffs.A > 1e-6f) positiveCount++;
-		else if (coeffs.A < -1e-6f) negativeCount++;
-		else zeroCount++;
+		glm::vec3 halfExtent;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float squared = k * inverseM[axis][axis];
+			if (squared < 0.0f)
+				return false;   // Empty (imaginary ellipsoid)
+			halfExtent[axis] = std::sqrt(squared);
+		}
+		
+		bounds = PadBounds(center - halfExtent, center + halfExtent);
+		return true;
+	}
+	
+	bool ComputeClippedExtent(const QuadricCoefficients& coeffs, const BoundingBox& clip, BoundingBox& bounds)
+	{
+		// Scaling f does not move the surface; normalize so thresholds are relative
+		float scale = std::max({ std::abs(coeffs.A), std::abs(coeffs.B), std::abs(coeffs.C),
+		                         std::abs(coeffs.D), std::abs(coeffs.E), std::abs(coeffs.F),
+		                         std::abs(coeffs.G), std::abs(coeffs.H), std::abs(coeffs.I) });
+		if (scale < 1e-12f)
+			return false;
+		
+		glm::mat4 Q = coeffs.ToMatrix();
+		glm::mat3 M = glm::mat3(Q) * (1.0f / scale);
+		glm::vec3 b = glm::vec3(Q[3]) / scale;
+		float J = coeffs.J / scale;
 		
-		if (coeffs.B > 1e-6f) positiveCount++;
-		else if (coeffs.B < -1e-6f) negativeCount++;
-		else zeroCount++;
+		const glm::vec3& lo = clip.Min;
+		const glm::vec3& hi = clip.Max;
+		float tolerance = 1e-4f * (1.0f + std::max({ std::abs(lo.x), std::abs(lo.y), std::abs(lo.z),
+		                                             std::abs(hi.x), std::abs(hi.y), std::abs(hi.z) }));
 		
-		if (coeffs.C > 1e-6f) positiveCount++;
-		else if (coeffs.C < -1e-6f) negativeCount++;
-		else zeroCount++;
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+		bool found = false;
 		
-		// Bounded if all three are positive (ellipsoid)
-		return (positiveCount == 3 && negativeCount == 0);
+		// Each extreme of a coordinate over (surface ∩ box) lies on a line cut
+		// out by two linear constraints (rows · p = rhs); the candidates are
+		// where that line meets the surface.
+		auto addCandidates = [&](glm::vec3 row1, float rhs1, glm::vec3 row2, float rhs2)
+		{
+			float length1 = glm::length(row1), length2 = glm::length(row2);
+			if (length1 < 1e-6f || length2 < 1e-6f)
+				return;   // Constraint is constant; a lower-dimensional case covers it
+			row1 /= length1; rhs1 /= length1;
+			row2 /= length2; rhs2 /= length2;
+			
+			glm::vec3 dir = glm::cross(row1, row2);
+			float lengthSquared = glm::dot(dir, dir);
+			if (lengthSquared < 1e-12f)
+				return;
+			
+			glm::vec3 p0 = (rhs1 * glm::cross(row2, dir) + rhs2 * glm::cross(dir, row1)) / lengthSquared;
+			dir /= std::sqrt(lengthSquared);
+			
+			glm::vec3 points[2];
+			int count = IntersectLine(M, b, J, p0, dir, points);
+			for (int i = 0; i < count; i++)
+			{
+				const glm::vec3& p = points[i];
+				if (p.x < lo.x - tolerance || p.y < lo.y - tolerance || p.z < lo.z - tolerance ||
+				    p.x > hi.x + tolerance || p.y > hi.y + tolerance || p.z > hi.z + tolerance)
+					continue;
+				
+				glm::vec3 clamped = glm::clamp(p, lo, hi);
+				boundsMin = glm::min(boundsMin, clamped);
+				boundsMax = glm::max(boundsMax, clamped);
+				found = true;
+			}
+		};
+		
+		const glm::vec3 unit[3] = { glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 1) };
+		
+		for (int axis = 0; axis < 3; axis++)
+		{
+			int j = (axis + 1) % 3;
+			int k = (axis + 2) % 3;
+			
+			// Interior: ∂f/∂x_j = ∂f/∂x_k = 0, i.e. Mp + b has no j, k component
+			addCandidates(M[j], -b[j], M[k], -b[k]);
+			
+			// Faces x_j = const or x_k = const: the remaining gradient term vanishes
+			for (float value : { lo[j], hi[j] })
+				addCandidates(unit[j], value, M[k], -b[k]);
+			for (float value : { lo[k], hi[k] })
+				addCandidates(unit[k], value, M[j], -b[j]);
+			
+			// Box edges parallel to the axis
+			for (float valueJ : { lo[j], hi[j] })
+				for (float valueK : { lo[k], hi[k] })
+					addCandidates(unit[j], valueJ, unit[k], valueK);
+		}
+		
+		if (!found)
+			return false;
+		
+		BoundingBox padded = PadBounds(boundsMin, boundsMax);
+		bounds = BoundingBox(glm::max(padded.Min, lo), glm::min(padded.Max, hi));
+		return true;
+	}
+	
+	BoundingBox TransformBounds(const BoundingBox& box, const glm::mat4& transform)
+	{
+		// Center moves with the transform; each half extent is the sum of the
+		// absolute column contributions (Arvo's method)
+		glm::vec3 center = (box.Min + box.Max) * 0.5f;
+		glm::vec3 halfExtent = (box.Max - box.Min) * 0.5f;
+		
+		glm::vec3 newCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+		glm::vec3 newHalfExtent(0.0f);
+		for (int column = 0; column < 3; column++)
+			newHalfExtent += glm::abs(glm::vec3(transform[column])) * halfExtent[column];
+		
+		return BoundingBox(newCenter - newHalfExtent, newCenter + newHalfExtent);
 	}
 	
 	const char* GetQuadricTypeName(const QuadricCoefficients& coeffs)
@@ -499,4 +961,13 @@ namespace Quadric
 		return "Quadric Surface";
 	}
 	
+	// ============================================================================
+	// PACKET INSTANTIATIONS
+	// ============================================================================
+	
+	template uint32_t BoundingBox::IntersectPacket<8>(const RayPacket<8>&, float*, float*) const;
+	template uint32_t BoundingBox::IntersectPacket<16>(const RayPacket<16>&, float*, float*) const;
+	template uint32_t QuadricSurface::IntersectPacket<8>(const RayPacket<8>&, PacketIntersectionResult<8>&, float, float) const;
+	template uint32_t QuadricSurface::IntersectPacket<16>(const RayPacket<16>&, PacketIntersectionResult<16>&, float, float) const;
+	
 } // namespace Quadric
@@ -9,6 +9,7 @@
 
 #include <glm/glm.hpp>
 #include <optional>
+#include <cstdint>
 
 namespace Quadric
 {
@@ -42,6 +43,141 @@ namespace Quadric
 		                   float g, float h, float i, float j)
 			: A(a), B(b), C(c), D(d), E(e), F(f), G(g), H(h), I(i), J(j)
 		{}
+		
+		/// Symmetric 4x4 matrix form Q with f(p) = [p 1]ᵀ Q [p 1]
+		///     | A    D/2  E/2  G/2 |
+		/// Q = | D/2  B    F/2  H/2 |
+		///     | E/2  F/2  C    I/2 |
+		///     | G/2  H/2  I/2  J   |
+		glm::mat4 ToMatrix() const;
+		
+		/// Inverse of ToMatrix (Q is symmetrized first)
+		static QuadricCoefficients FromMatrix(const glm::mat4& Q);
+		
+		/// Coefficients of the surface after applying an affine transform:
+		/// Q' = M⁻ᵀ Q M⁻¹
+		QuadricCoefficients Transformed(const glm::mat4& objectToWorld) const;
+	};
+	
+	/// Ray with the per-ray terms of a slab test computed once: the inverse
+	/// direction (±inf on zero components, signed like the component) and
+	/// a sign bit per axis telling which box face is entered first. Build it
+	/// once per ray and every box test after that is division-free.
+	struct Ray
+	{
+		glm::vec3 Origin = glm::vec3(0.0f);
+		glm::vec3 Direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		glm::vec3 InverseDirection = 1.0f / glm::vec3(0.0f, 0.0f, -1.0f);
+		uint32_t SignMask = 0b100;   // Bit a set if InverseDirection[a] < 0 (also for -0)
+		
+		/// Optional differentials: the rays through the neighbouring pixels
+		/// in x and y, for footprint estimates (texture filtering, LOD)
+		bool HasDifferentials = false;
+		glm::vec3 RxOrigin = glm::vec3(0.0f), RxDirection = glm::vec3(0.0f);
+		glm::vec3 RyOrigin = glm::vec3(0.0f), RyDirection = glm::vec3(0.0f);
+		
+		Ray() = default;
+		Ray(const glm::vec3& origin, const glm::vec3& direction)
+			: Origin(origin)
+		{
+			SetDirection(direction);
+		}
+		
+		/// Change the direction and refresh the cached terms
+		void SetDirection(const glm::vec3& direction)
+		{
+			Direction = direction;
+			InverseDirection = 1.0f / direction;
+			SignMask = (InverseDirection.x < 0.0f ? 1u : 0u)
+			         | (InverseDirection.y < 0.0f ? 2u : 0u)
+			         | (InverseDirection.z < 0.0f ? 4u : 0u);
+		}
+		
+		bool IsNegative(int axis) const { return (SignMask >> axis) & 1u; }
+		
+		glm::vec3 At(float t) const { return Origin + t * Direction; }
+		
+		void SetDifferentials(const glm::vec3& rxOrigin, const glm::vec3& rxDirection,
+		                      const glm::vec3& ryOrigin, const glm::vec3& ryDirection)
+		{
+			RxOrigin = rxOrigin;
+			RxDirection = rxDirection;
+			RyOrigin = ryOrigin;
+			RyDirection = ryDirection;
+			HasDifferentials = true;
+		}
+		
+		/// Scale the pixel spacing the differentials stand for (e.g. by
+		/// 1/sqrt(spp) when each pixel takes several samples)
+		void ScaleDifferentials(float scale)
+		{
+			RxOrigin = Origin + (RxOrigin - Origin) * scale;
+			RyOrigin = Origin + (RyOrigin - Origin) * scale;
+			RxDirection = Direction + (RxDirection - Direction) * scale;
+			RyDirection = Direction + (RyDirection - Direction) * scale;
+		}
+	};
+	
+	/// Division-free slab test of ray against [boxMin, boxMax], clipped to
+	/// [tMin, tMax]. The sign bits pick the entry face, so no min/max sorts
+	/// the two planes. Zero direction components are handled by IEEE rules:
+	/// a ray parallel to a slab gets ±inf (inside or outside for all t), and
+	/// a ray lying exactly in a slab plane gets NaN, which fails both
+	/// comparisons so that slab does not clip (boundaries count as inside).
+	inline bool IntersectSlabs(const glm::vec3& boxMin, const glm::vec3& boxMax, const Ray& ray,
+	                           float tMin, float tMax, float& tNear, float& tFar)
+	{
+		tNear = tMin;
+		tFar = tMax;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			bool negative = ray.IsNegative(axis);
+			float entry = ((negative ? boxMax[axis] : boxMin[axis]) - ray.Origin[axis]) * ray.InverseDirection[axis];
+			float exit = ((negative ? boxMin[axis] : boxMax[axis]) - ray.Origin[axis]) * ray.InverseDirection[axis];
+			tNear = entry > tNear ? entry : tNear;
+			tFar = exit < tFar ? exit : tFar;
+		}
+		return tNear <= tFar;
+	}
+	
+	/// Coherent rays sharing one origin (e.g. the primary rays of a pixel tile).
+	/// Directions are stored one array per component; N is 8 or 16.
+	/// SetDirection also caches the inverse direction for the slab tests, so
+	/// write directions through it.
+	template <int N>
+	struct RayPacket
+	{
+		static_assert(N == 8 || N == 16, "RayPacket holds 8 or 16 rays");
+		
+		glm::vec3 Origin = glm::vec3(0.0f);
+		float DirX[N] = {};
+		float DirY[N] = {};
+		float DirZ[N] = {};
+		float InvDirX[N] = {};
+		float InvDirY[N] = {};
+		float InvDirZ[N] = {};
+		
+		void SetDirection(int i, const glm::vec3& direction)
+		{
+			DirX[i] = direction.x;
+			DirY[i] = direction.y;
+			DirZ[i] = direction.z;
+			InvDirX[i] = 1.0f / direction.x;
+			InvDirY[i] = 1.0f / direction.y;
+			InvDirZ[i] = 1.0f / direction.z;
+		}
+		
+		glm::vec3 GetDirection(int i) const { return glm::vec3(DirX[i], DirY[i], DirZ[i]); }
+	};
+	
+	/// Result of a packet intersection (bit i of HitMask is set if ray i hit)
+	template <int N>
+	struct PacketIntersectionResult
+	{
+		uint32_t HitMask = 0;
+		float Distance[N] = {};   // Only meaningful where the hit bit is set
+		
+		bool Hit(int i) const { return (HitMask >> i) & 1u; }
 	};
 	
 	/// Axis-aligned bounding box for limiting unbounded quadrics
@@ -61,6 +197,14 @@ namespace Quadric
 		/// Intersect ray with bounding box (returns entry and exit distances)
 		bool Intersect(const glm::vec3& origin, const glm::vec3& direction, 
 		              float& tMin, float& tMax) const;
+		
+		/// Same test for a prepared ray, without divisions
+		bool Intersect(const Ray& ray, float& tMin, float& tMax) const;
+		
+		/// Intersect a ray packet with the bounding box. Writes N entry and exit
+		/// distances and returns a mask with bit i set if ray i hits.
+		template <int N>
+		uint32_t IntersectPacket(const RayPacket<N>& packet, float* tMin, float* tMax) const;
 	};
 	
 	/// Result of ray-quadric intersection
@@ -92,12 +236,23 @@ namespace Quadric
 		/// Set bounding box (for unbounded surfaces)
 		void SetBoundingBox(const BoundingBox& bbox);
 		
+		/// Get current bounding box
+		const BoundingBox& GetBoundingBox() const { return m_BoundingBox; }
+		
 		/// Enable/disable bounding box
-		void SetBoundingBoxEnabled(bool enabled) { m_UseBoundingBox = enabled; }
+		void SetBoundingBoxEnabled(bool enabled);
 		
 		/// Check if bounding box is enabled
 		bool IsBoundingBoxEnabled() const { return m_UseBoundingBox; }
 		
+		/// Tight bounds used to cull rays before the root solve: the exact
+		/// extent of a closed surface, or the user box shrunk to the part of
+		/// the surface inside it. Kept up to date on every change.
+		const BoundingBox& GetBounds() const { return m_Bounds; }
+		
+		/// Check if tight bounds exist (false for unclipped unbounded surfaces)
+		bool HasBounds() const { return m_HasBounds; }
+		
 		/// Intersect ray with quadric surface
 		/// Returns the closest intersection point if hit
 		IntersectionResult Intersect(const glm::vec3& rayOrigin, 
@@ -105,6 +260,32 @@ namespace Quadric
 		                            float tMin = 0.001f, 
 		                            float tMax = 1000.0f) const;
 		
+		/// Any-hit query for shadow and visibility rays: true if the surface
+		/// blocks the ray anywhere in [tMin, tMax]. Returns on the first valid
+		/// root and skips the hit point and normal, so scenes, instances and
+		/// BVHs can stop at the first blocker instead of the nearest one.
+		bool Occluded(const glm::vec3& rayOrigin,
+		              const glm::vec3& rayDirection,
+		              float tMax,
+		              float tMin = 0.001f) const;
+		
+		/// Intersect a packet of rays sharing one origin with the quadric surface.
+		/// The origin-only terms are computed once per packet. Returns the hit
+		/// mask; use CalculateNormal at the hit points for normals.
+		template <int N>
+		uint32_t IntersectPacket(const RayPacket<N>& packet,
+		                         PacketIntersectionResult<N>& result,
+		                         float tMin = 0.001f,
+		                         float tMax = 1000.0f) const;
+		
+		/// Expand f(O + tD) into at² + bt + c
+		void ExpandRay(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+		               float& a, float& b, float& c) const;
+		
+		/// Solve quadratic equation At² + Bt + C = 0 (linear when A ≈ 0)
+		/// Returns true if real solutions exist, with t0 <= t1
+		bool SolveQuadratic(float A, float B, float C, float& t0, float& t1) const;
+		
 		/// Evaluate quadric function at a point
 		/// f(x,y,z) = Ax² + By² + Cz² + Dxy + Exz + Fyz + Gx + Hy + Iz + J
 		float Evaluate(const glm::vec3& point) const;
@@ -144,14 +325,19 @@ namespace Quadric
 		/// Create a hyperbolic paraboloid (saddle): z = x²/a² - y²/b²
 		static QuadricSurface CreateHyperbolicParaboloid(float a, float b, float height);
 		
+		/// Create a plane n·p - offset = 0 (degree-1 quadric, no bounding box).
+		/// As a CSG solid it is the half-space n·p <= offset.
+		static QuadricSurface CreatePlane(const glm::vec3& normal, float offset);
+	
 	private:
 		QuadricCoefficients m_Coefficients;
 		BoundingBox m_BoundingBox;
 		bool m_UseBoundingBox = false;
+		BoundingBox m_Bounds;
+		bool m_HasBounds = false;
 		
-		/// Solve quadratic equation At² + Bt + C = 0
-		/// Returns true if real solutions exist
-		bool SolveQuadratic(float A, float B, float C, float& t0, float& t1) const;
+		/// Recompute m_Bounds from the coefficients and user box
+		void UpdateBounds();
 	};
 	
 	// ============================================================================
@@ -159,8 +345,20 @@ namespace Quadric
 	// ============================================================================
 	
 	/// Check if quadric represents a bounded surface
+	/// (second-degree part positive or negative definite: an ellipsoid)
 	bool IsQuadricBounded(const QuadricCoefficients& coeffs);
 	
+	/// Exact axis-aligned extent of a bounded quadric, from the matrix form.
+	/// Returns false if the surface is unbounded or empty.
+	bool ComputeBoundedExtent(const QuadricCoefficients& coeffs, BoundingBox& bounds);
+	
+	/// Tightest axis-aligned box around the part of the surface inside clip.
+	/// Returns false if the surface does not meet the clip box.
+	bool ComputeClippedExtent(const QuadricCoefficients& coeffs, const BoundingBox& clip, BoundingBox& bounds);
+	
+	/// Axis-aligned box around a box placed by an affine transform
+	BoundingBox TransformBounds(const BoundingBox& box, const glm::mat4& transform);
+	
 	/// Get a descriptive name for common quadric types
 	const char* GetQuadricTypeName(const QuadricCoefficients& coeffs);
 	
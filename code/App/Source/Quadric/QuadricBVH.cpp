@@ -0,0 +1,208 @@
+// ============================================================================
+// QUADRIC BVH - Implementation
+// ============================================================================
+
+#include "QuadricBVH.h"
+
+namespace Quadric
+{
+	/// Split candidates per axis for the binned SAH
+	static constexpr int SAH_BINS = 12;
+	
+	/// Cost of visiting an interior node relative to one primitive test
+	static constexpr float TRAVERSAL_COST = 0.5f;
+	
+	static float SurfaceArea(const glm::vec3& min, const glm::vec3& max)
+	{
+		glm::vec3 extent = glm::max(max - min, glm::vec3(0.0f));
+		return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+	}
+	
+	/// Box accumulator for the SAH bins
+	struct BinBounds
+	{
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+		int Count = 0;
+		
+		void Grow(const BoundingBox& box)
+		{
+			Min = glm::min(Min, box.Min);
+			Max = glm::max(Max, box.Max);
+		}
+		
+		void Grow(const BinBounds& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+			Count += other.Count;
+		}
+		
+		float Area() const { return Count > 0 ? SurfaceArea(Min, Max) : 0.0f; }
+	};
+	
+	// ============================================================================
+	// CONSTRUCTION
+	// ============================================================================
+	
+	void QuadricBVH::Build(const std::vector<BoundingBox>& bounds)
+	{
+		Clear();
+		if (bounds.empty())
+			return;
+		
+		int count = static_cast<int>(bounds.size());
+		m_Indices.resize(count);
+		
+		std::vector<glm::vec3> centroids(count);
+		for (int i = 0; i < count; i++)
+		{
+			m_Indices[i] = i;
+			centroids[i] = (bounds[i].Min + bounds[i].Max) * 0.5f;
+		}
+		
+		// A binary tree over n leaves has at most 2n - 1 nodes
+		m_Nodes.reserve(2 * count - 1);
+		
+		BVHNode root;
+		root.LeftOrFirst = 0;
+		root.Count = count;
+		UpdateNodeBounds(root, bounds);
+		m_Nodes.push_back(root);
+		
+		Subdivide(0, 1, bounds, centroids);
+	}
+	
+	void QuadricBVH::Clear()
+	{
+		m_Nodes.clear();
+		m_Indices.clear();
+		m_Depth = 0;
+	}
+	
+	void QuadricBVH::UpdateNodeBounds(BVHNode& node, const std::vector<BoundingBox>& bounds) const
+	{
+		BinBounds box;
+		for (int i = node.LeftOrFirst; i < node.LeftOrFirst + node.Count; i++)
+			box.Grow(bounds[m_Indices[i]]);
+		node.Min = box.Min;
+		node.Max = box.Max;
+	}
+	
+	void QuadricBVH::Subdivide(int nodeIndex, int depth, const std::vector<BoundingBox>& bounds,
+	                           const std::vector<glm::vec3>& centroids)
+	{
+		m_Depth = std::max(m_Depth, depth);
+		
+		BVHNode& node = m_Nodes[nodeIndex];
+		int first = node.LeftOrFirst;
+		int count = node.Count;
+		if (count <= 1 || depth >= MAX_DEPTH)
+			return;
+		
+		// Bin by centroid: boxes can overlap, centroids cannot straddle a plane
+		glm::vec3 centroidMin(std::numeric_limits<float>::max());
+		glm::vec3 centroidMax(-std::numeric_limits<float>::max());
+		for (int i = first; i < first + count; i++)
+		{
+			centroidMin = glm::min(centroidMin, centroids[m_Indices[i]]);
+			centroidMax = glm::max(centroidMax, centroids[m_Indices[i]]);
+		}
+		
+		float bestCost = std::numeric_limits<float>::max();
+		int bestAxis = -1;
+		int bestSplit = 0;
+		
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float extent = centroidMax[axis] - centroidMin[axis];
+			if (extent <= 0.0f)
+				continue;
+			
+			BinBounds bins[SAH_BINS];
+			float scale = SAH_BINS / extent;
+			for (int i = first; i < first + count; i++)
+			{
+				int index = m_Indices[i];
+				int bin = std::min(SAH_BINS - 1, static_cast<int>((centroids[index][axis] - centroidMin[axis]) * scale));
+				bins[bin].Grow(bounds[index]);
+				bins[bin].Count++;
+			}
+			
+			// Sweep from both ends so every split plane costs O(1)
+			float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+			int leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+			BinBounds leftBox, rightBox;
+			for (int i = 0; i < SAH_BINS - 1; i++)
+			{
+				leftBox.Grow(bins[i]);
+				leftArea[i] = leftBox.Area();
+				leftCount[i] = leftBox.Count;
+				
+				rightBox.Grow(bins[SAH_BINS - 1 - i]);
+				rightArea[SAH_BINS - 2 - i] = rightBox.Area();
+				rightCount[SAH_BINS - 2 - i] = rightBox.Count;
+			}
+			
+			for (int split = 0; split < SAH_BINS - 1; split++)
+			{
+				if (leftCount[split] == 0 || rightCount[split] == 0)
+					continue;
+				float cost = leftCount[split] * leftArea[split] + rightCount[split] * rightArea[split];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+		
+		// All centroids coincide: nothing can separate them
+		if (bestAxis < 0)
+			return;
+		
+		// Small nodes stay leaves unless splitting is cheaper than testing
+		// every primitive; larger ones are always split to bound leaf size
+		float nodeArea = SurfaceArea(node.Min, node.Max);
+		float splitCost = TRAVERSAL_COST * nodeArea + bestCost;
+		if (count <= MAX_LEAF_SIZE && splitCost >= count * nodeArea)
+			return;
+		
+		// Partition the index range in place around the chosen plane
+		float scale = SAH_BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+		int* begin = m_Indices.data() + first;
+		int* middle = std::partition(begin, begin + count, [&](int index)
+		{
+			int bin = std::min(SAH_BINS - 1, static_cast<int>((centroids[index][bestAxis] - centroidMin[bestAxis]) * scale));
+			return bin <= bestSplit;
+		});
+		int leftCount = static_cast<int>(middle - begin);
+		if (leftCount == 0 || leftCount == count)
+			return;
+		
+		// Children are allocated as a pair so the right one is always left + 1
+		int leftIndex = static_cast<int>(m_Nodes.size());
+		
+		BVHNode leftChild;
+		leftChild.LeftOrFirst = first;
+		leftChild.Count = leftCount;
+		UpdateNodeBounds(leftChild, bounds);
+		
+		BVHNode rightChild;
+		rightChild.LeftOrFirst = first + leftCount;
+		rightChild.Count = count - leftCount;
+		UpdateNodeBounds(rightChild, bounds);
+		
+		m_Nodes.push_back(leftChild);
+		m_Nodes.push_back(rightChild);
+		
+		// push_back may have moved the array; index again instead of using node
+		m_Nodes[nodeIndex].LeftOrFirst = leftIndex;
+		m_Nodes[nodeIndex].Count = 0;
+		
+		Subdivide(leftIndex, depth + 1, bounds, centroids);
+		Subdivide(leftIndex + 1, depth + 1, bounds, centroids);
+	}
+	
+} // namespace Quadric
@@ -0,0 +1,238 @@
+// ============================================================================
+// QUADRIC BVH - Bounding Volume Hierarchy over Quadric Bounds
+// ============================================================================
+// Built from one world-space box per primitive (a surface, an instance or a
+// whole CSG solid) with a binned surface area heuristic. Nodes live in one
+// flat array with siblings stored next to each other, so the same layout can
+// be uploaded to the GPU as two RGBA32F texels per node and traversed there
+// with a small stack.
+//
+// Primitives must have finite bounds: leave unclipped unbounded surfaces out
+// of the tree and test them separately.
+// ============================================================================
+
+#pragma once
+
+#include "Quadric.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace Quadric
+{
+	/// Flat BVH node. Interior nodes point at their left child (the right
+	/// child follows it); leaves point at a range of GetPrimitiveIndices().
+	struct BVHNode
+	{
+		glm::vec3 Min = glm::vec3(0.0f);
+		int LeftOrFirst = 0;   // Left child index, or first primitive of a leaf
+		glm::vec3 Max = glm::vec3(0.0f);
+		int Count = 0;         // Primitives in a leaf, 0 for interior nodes
+		
+		bool IsLeaf() const { return Count > 0; }
+	};
+	
+	/// Nearest hit of a ray against a QuadricBVH
+	struct BVHIntersectionResult : IntersectionResult
+	{
+		int Index = -1;   // Index of the hit primitive (-1 on miss)
+	};
+	
+	// ============================================================================
+	// QUADRIC BVH CLASS
+	// ============================================================================
+	
+	class QuadricBVH
+	{
+	public:
+		/// Nodes are never split below this many primitives unless the SAH
+		/// says the split pays off
+		static constexpr int MAX_LEAF_SIZE = 4;
+		
+		/// Depth limit; traversal stacks of this size never overflow
+		static constexpr int MAX_DEPTH = 32;
+		
+		QuadricBVH() = default;
+		
+		/// Rebuild the tree over one box per primitive
+		void Build(const std::vector<BoundingBox>& bounds);
+		
+		/// Remove all nodes
+		void Clear();
+		
+		bool IsEmpty() const { return m_Nodes.empty(); }
+		
+		/// Flat node array; node 0 is the root
+		const std::vector<BVHNode>& GetNodes() const { return m_Nodes; }
+		
+		/// Primitive indices in leaf order: a leaf covers
+		/// [LeftOrFirst, LeftOrFirst + Count) of this array
+		const std::vector<int>& GetPrimitiveIndices() const { return m_Indices; }
+		
+		/// Deepest leaf (1 for a single-leaf tree)
+		int GetDepth() const { return m_Depth; }
+		
+		/// Closest hit over primitives[i], where i are the indices the tree was
+		/// built with. Primitive needs Intersect(origin, direction, tMin, tMax).
+		template <typename Primitive>
+		BVHIntersectionResult IntersectNearest(const std::vector<Primitive>& primitives,
+		                                       const glm::vec3& rayOrigin,
+		                                       const glm::vec3& rayDirection,
+		                                       float tMin = 0.001f,
+		                                       float tMax = 1000.0f) const;
+		
+		/// Any-hit query over the primitives; returns on the first blocker.
+		/// Primitive needs Occluded(origin, direction, tMax, tMin).
+		template <typename Primitive>
+		bool Occluded(const std::vector<Primitive>& primitives,
+		              const glm::vec3& rayOrigin,
+		              const glm::vec3& rayDirection,
+		              float tMax,
+		              float tMin = 0.001f) const;
+	
+	private:
+		std::vector<BVHNode> m_Nodes;
+		std::vector<int> m_Indices;
+		int m_Depth = 0;
+		
+		void UpdateNodeBounds(BVHNode& node, const std::vector<BoundingBox>& bounds) const;
+		void Subdivide(int nodeIndex, int depth, const std::vector<BoundingBox>& bounds,
+		               const std::vector<glm::vec3>& centroids);
+		
+		/// Visit the leaves whose boxes the ray enters before tMax, near child
+		/// first. visit(first, count, tMax) returns true to stop early and may
+		/// shrink tMax.
+		template <typename Visit>
+		void Traverse(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+		              float tMin, float& tMax, Visit visit) const;
+		
+		/// Slab test against a node box; tNear receives the entry distance
+		static bool IntersectNode(const BVHNode& node, const Ray& ray, float tMin, float tMax, float& tNear)
+		{
+			float tFar;
+			return IntersectSlabs(node.Min, node.Max, ray, tMin, tMax, tNear, tFar);
+		}
+	};
+	
+	// ============================================================================
+	// TRAVERSAL
+	// ============================================================================
+	
+	template <typename Visit>
+	void QuadricBVH::Traverse(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                          float tMin, float& tMax, Visit visit) const
+	{
+		if (m_Nodes.empty())
+			return;
+		
+		// Inverse direction and signs once per ray; node tests are division-free
+		const Ray ray(rayOrigin, rayDirection);
+		
+		// Entry distances ride along so nodes that fall behind a closer hit
+		// found after they were pushed are skipped when popped
+		int stack[MAX_DEPTH];
+		float stackNear[MAX_DEPTH];
+		int stackSize = 0;
+		
+		float tNear;
+		if (!IntersectNode(m_Nodes[0], ray, tMin, tMax, tNear))
+			return;
+		stack[stackSize] = 0;
+		stackNear[stackSize++] = tNear;
+		
+		while (stackSize > 0)
+		{
+			stackSize--;
+			if (stackNear[stackSize] > tMax)
+				continue;
+			
+			const BVHNode& node = m_Nodes[stack[stackSize]];
+			
+			if (node.IsLeaf())
+			{
+				if (visit(node.LeftOrFirst, node.Count, tMax))
+					return;
+				continue;
+			}
+			
+			// Push the far child first so the near one is visited next and
+			// shrinks tMax before the far one is popped
+			int left = node.LeftOrFirst;
+			int right = left + 1;
+			float tLeft, tRight;
+			bool hitLeft = IntersectNode(m_Nodes[left], ray, tMin, tMax, tLeft);
+			bool hitRight = IntersectNode(m_Nodes[right], ray, tMin, tMax, tRight);
+			
+			if (hitLeft && hitRight && tLeft > tRight)
+			{
+				std::swap(left, right);
+				std::swap(tLeft, tRight);
+				std::swap(hitLeft, hitRight);
+			}
+			if (hitRight)
+			{
+				stack[stackSize] = right;
+				stackNear[stackSize++] = tRight;
+			}
+			if (hitLeft)
+			{
+				stack[stackSize] = left;
+				stackNear[stackSize++] = tLeft;
+			}
+		}
+	}
+	
+	template <typename Primitive>
+	BVHIntersectionResult QuadricBVH::IntersectNearest(const std::vector<Primitive>& primitives,
+	                                                   const glm::vec3& rayOrigin,
+	                                                   const glm::vec3& rayDirection,
+	                                                   float tMin, float tMax) const
+	{
+		BVHIntersectionResult result;
+		
+		// tHit shrinks with every hit, so only nodes closer than the current
+		// hit reach a primitive
+		Traverse(rayOrigin, rayDirection, tMin, tMax, [&](int first, int count, float& tHit)
+		{
+			for (int i = first; i < first + count; i++)
+			{
+				int index = m_Indices[i];
+				IntersectionResult hit = primitives[index].Intersect(rayOrigin, rayDirection, tMin, tHit);
+				if (hit.Hit && hit.Distance < tHit)
+				{
+					static_cast<IntersectionResult&>(result) = hit;
+					result.Index = index;
+					tHit = hit.Distance;
+				}
+			}
+			return false;
+		});
+		
+		return result;
+	}
+	
+	template <typename Primitive>
+	bool QuadricBVH::Occluded(const std::vector<Primitive>& primitives,
+	                          const glm::vec3& rayOrigin,
+	                          const glm::vec3& rayDirection,
+	                          float tMax, float tMin) const
+	{
+		bool blocked = false;
+		Traverse(rayOrigin, rayDirection, tMin, tMax, [&](int first, int count, float& tLimit)
+		{
+			for (int i = first; i < first + count; i++)
+			{
+				if (primitives[m_Indices[i]].Occluded(rayOrigin, rayDirection, tLimit, tMin))
+				{
+					blocked = true;
+					return true;
+				}
+			}
+			return false;
+		});
+		
+		return blocked;
+	}
+	
+} // namespace Quadric
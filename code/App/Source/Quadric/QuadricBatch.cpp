@@ -0,0 +1,318 @@
+// ============================================================================
+// QUADRIC BATCH - Implementation
+// ============================================================================
+
+#include "QuadricBatch.h"
+#include "../Math/Simd.h"
+
+#include <cmath>
+#include <limits>
+
+namespace Quadric
+{
+	// Columns are padded to this many lanes so any lane width can load them
+	static constexpr size_t BATCH_PADDING = 8;
+
+	int QuadricBatch::Add(const QuadricSurface& surface)
+	{
+		// Drop the padding from the previous Add before appending
+		size_t padded = m_A.size();
+		if (padded != m_Count)
+		{
+			for (std::vector<float>* column : { &m_A, &m_B, &m_C, &m_D, &m_E, &m_F, &m_G, &m_H, &m_I, &m_J,
+			                                   &m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ, &m_UseBox })
+			{
+				column->resize(m_Count);
+			}
+		}
+
+		const QuadricCoefficients& q = surface.GetCoefficients();
+		m_A.push_back(q.A);
+		m_B.push_back(q.B);
+		m_C.push_back(q.C);
+		m_D.push_back(q.D);
+		m_E.push_back(q.E);
+		m_F.push_back(q.F);
+		m_G.push_back(q.G);
+		m_H.push_back(q.H);
+		m_I.push_back(q.I);
+		m_J.push_back(q.J);
+
+		// Tight bounds both cull and clip: they hold exactly the part of the
+		// surface inside the user box
+		const BoundingBox& box = surface.GetBounds();
+		m_MinX.push_back(box.Min.x);
+		m_MinY.push_back(box.Min.y);
+		m_MinZ.push_back(box.Min.z);
+		m_MaxX.push_back(box.Max.x);
+		m_MaxY.push_back(box.Max.y);
+		m_MaxZ.push_back(box.Max.z);
+		m_UseBox.push_back(surface.HasBounds() ? 1.0f : 0.0f);
+
+		m_Count++;
+		Pad();
+
+		return (int)m_Count - 1;
+	}
+
+	void QuadricBatch::Clear()
+	{
+		for (std::vector<float>* column : { &m_A, &m_B, &m_C, &m_D, &m_E, &m_F, &m_G, &m_H, &m_I, &m_J,
+		                                   &m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ, &m_UseBox })
+		{
+			column->clear();
+		}
+		m_Count = 0;
+	}
+
+	void QuadricBatch::Reserve(size_t count)
+	{
+		size_t padded = (count + BATCH_PADDING - 1) / BATCH_PADDING * BATCH_PADDING;
+		for (std::vector<float>* column : { &m_A, &m_B, &m_C, &m_D, &m_E, &m_F, &m_G, &m_H, &m_I, &m_J,
+		                                   &m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ, &m_UseBox })
+		{
+			column->reserve(padded);
+		}
+	}
+
+	void QuadricBatch::Pad()
+	{
+		size_t padded = (m_Count + BATCH_PADDING - 1) / BATCH_PADDING * BATCH_PADDING;
+		for (std::vector<float>* column : { &m_A, &m_B, &m_C, &m_D, &m_E, &m_F, &m_G, &m_H, &m_I, &m_J,
+		                                   &m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ, &m_UseBox })
+		{
+			column->resize(padded, 0.0f);
+		}
+	}
+
+	// ----------------------------------------------------------------------------
+	// FindNearest
+	// ----------------------------------------------------------------------------
+	// Lane-parallel version of QuadricSurface::Intersect without the normal.
+	// The ray-only products (d.x², o.x·d.y + o.y·d.x, ...) are computed once,
+	// so each quadric costs 25 multiply-adds for the at² + bt + c expansion,
+	// and only for lane groups where some surface survives the box cull.
+	// Returns the index of the nearest surface, or -1.
+	// ----------------------------------------------------------------------------
+	template <typename FloatT>
+	int QuadricBatch::FindNearest(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                              float tMin, float tMax, float& tHit) const
+	{
+		using Simd::fmadd;
+
+		constexpr int WIDTH = sizeof(FloatT) / sizeof(float);
+		const float inf = std::numeric_limits<float>::infinity();
+
+		const glm::vec3& o = rayOrigin;
+		const glm::vec3& d = rayDirection;
+
+		// Coefficient of t² per term
+		const FloatT aXX = FloatT::broadcast(d.x * d.x);
+		const FloatT aYY = FloatT::broadcast(d.y * d.y);
+		const FloatT aZZ = FloatT::broadcast(d.z * d.z);
+		const FloatT aXY = FloatT::broadcast(d.x * d.y);
+		const FloatT aXZ = FloatT::broadcast(d.x * d.z);
+		const FloatT aYZ = FloatT::broadcast(d.y * d.z);
+
+		// Coefficient of t per term
+		const FloatT bXX = FloatT::broadcast(2.0f * o.x * d.x);
+		const FloatT bYY = FloatT::broadcast(2.0f * o.y * d.y);
+		const FloatT bZZ = FloatT::broadcast(2.0f * o.z * d.z);
+		const FloatT bXY = FloatT::broadcast(o.x * d.y + o.y * d.x);
+		const FloatT bXZ = FloatT::broadcast(o.x * d.z + o.z * d.x);
+		const FloatT bYZ = FloatT::broadcast(o.y * d.z + o.z * d.y);
+
+		// Constant term per term
+		const FloatT cXX = FloatT::broadcast(o.x * o.x);
+		const FloatT cYY = FloatT::broadcast(o.y * o.y);
+		const FloatT cZZ = FloatT::broadcast(o.z * o.z);
+		const FloatT cXY = FloatT::broadcast(o.x * o.y);
+		const FloatT cXZ = FloatT::broadcast(o.x * o.z);
+		const FloatT cYZ = FloatT::broadcast(o.y * o.z);
+
+		const FloatT ox = FloatT::broadcast(o.x), oy = FloatT::broadcast(o.y), oz = FloatT::broadcast(o.z);
+		const FloatT dx = FloatT::broadcast(d.x), dy = FloatT::broadcast(d.y), dz = FloatT::broadcast(d.z);
+		const FloatT invDx = FloatT::broadcast(1.0f / d.x);
+		const FloatT invDy = FloatT::broadcast(1.0f / d.y);
+		const FloatT invDz = FloatT::broadcast(1.0f / d.z);
+
+		const FloatT zero = FloatT::broadcast(0.0f);
+		const FloatT half = FloatT::broadcast(0.5f);
+		const FloatT four = FloatT::broadcast(4.0f);
+		const FloatT epsilon = FloatT::broadcast(1e-6f);
+		const FloatT rayTMin = FloatT::broadcast(tMin);
+		const FloatT rayTMax = FloatT::broadcast(tMax);
+		const FloatT noHit = FloatT::broadcast(inf);
+
+		FloatT bestT = noHit;
+		FloatT bestIndex = FloatT::broadcast(-1.0f);
+		size_t lanes = (m_Count + WIDTH - 1) / WIDTH * WIDTH;
+		for (size_t i = 0; i < lanes; i += WIDTH)
+		{
+			// Clip the search range to the tight bounds first, like the cull in
+			// QuadricSurface::Intersect. A root inside the clipped range lies in
+			// the box, so no per-root containment test is needed. Groups whose
+			// bounded lanes all miss skip the expansion entirely.
+			auto useBox = FloatT::load(&m_UseBox[i]) > zero;
+			const FloatT minX = FloatT::load(&m_MinX[i]), maxX = FloatT::load(&m_MaxX[i]);
+			const FloatT minY = FloatT::load(&m_MinY[i]), maxY = FloatT::load(&m_MaxY[i]);
+			const FloatT minZ = FloatT::load(&m_MinZ[i]), maxZ = FloatT::load(&m_MaxZ[i]);
+
+			FloatT sx0 = (minX - ox) * invDx, sx1 = (maxX - ox) * invDx;
+			FloatT sy0 = (minY - oy) * invDy, sy1 = (maxY - oy) * invDy;
+			FloatT sz0 = (minZ - oz) * invDz, sz1 = (maxZ - oz) * invDz;
+
+			FloatT boxNear = Simd::max(Simd::max(Simd::min(sx0, sx1), Simd::min(sy0, sy1)), Simd::min(sz0, sz1));
+			FloatT boxFar = Simd::min(Simd::min(Simd::max(sx0, sx1), Simd::max(sy0, sy1)), Simd::max(sz0, sz1));
+
+			FloatT rangeMin = select(useBox, Simd::max(rayTMin, boxNear), rayTMin);
+			FloatT rangeMax = select(useBox, Simd::min(rayTMax, boxFar), rayTMax);
+
+			auto live = (!useBox) | (rangeMin <= rangeMax);
+			if (Simd::none(live))
+				continue;
+
+			const FloatT A = FloatT::load(&m_A[i]);
+			const FloatT B = FloatT::load(&m_B[i]);
+			const FloatT C = FloatT::load(&m_C[i]);
+			const FloatT D = FloatT::load(&m_D[i]);
+			const FloatT E = FloatT::load(&m_E[i]);
+			const FloatT F = FloatT::load(&m_F[i]);
+			const FloatT G = FloatT::load(&m_G[i]);
+			const FloatT H = FloatT::load(&m_H[i]);
+			const FloatT I = FloatT::load(&m_I[i]);
+			const FloatT J = FloatT::load(&m_J[i]);
+
+			FloatT a = A * aXX;
+			a = fmadd(B, aYY, a);
+			a = fmadd(C, aZZ, a);
+			a = fmadd(D, aXY, a);
+			a = fmadd(E, aXZ, a);
+			a = fmadd(F, aYZ, a);
+
+			FloatT b = A * bXX;
+			b = fmadd(B, bYY, b);
+			b = fmadd(C, bZZ, b);
+			b = fmadd(D, bXY, b);
+			b = fmadd(E, bXZ, b);
+			b = fmadd(F, bYZ, b);
+			b = fmadd(G, dx, b);
+			b = fmadd(H, dy, b);
+			b = fmadd(I, dz, b);
+
+			FloatT c = fmadd(A, cXX, J);
+			c = fmadd(B, cYY, c);
+			c = fmadd(C, cZZ, c);
+			c = fmadd(D, cXY, c);
+			c = fmadd(E, cXZ, c);
+			c = fmadd(F, cYZ, c);
+			c = fmadd(G, ox, c);
+			c = fmadd(H, oy, c);
+			c = fmadd(I, oz, c);
+
+			// Quadratic branch (same root selection as SolveQuadratic)
+			FloatT discriminant = b * b - four * a * c;
+			auto isLinear = Simd::abs(a) < epsilon;
+			auto quadratic = (!isLinear) & (discriminant >= zero);
+			FloatT sqrtDisc = Simd::sqrt(Simd::max(discriminant, zero));
+			FloatT q = select(b < zero, (-b - sqrtDisc) * half, (-b + sqrtDisc) * half);
+			FloatT r0 = q / a;
+			FloatT r1 = c / q;
+
+			FloatT t0 = Simd::min(r0, r1);
+			FloatT t1 = Simd::max(r0, r1);
+			auto hasRoots = quadratic;
+
+			// Linear branch: bt + c = 0 (planes, padding lanes)
+			if (Simd::any(isLinear))
+			{
+				auto linear = isLinear & (!(Simd::abs(b) < epsilon));
+				FloatT rLinear = -c / b;
+				t0 = select(linear, rLinear, t0);
+				t1 = select(linear, rLinear, t1);
+				hasRoots = hasRoots | linear;
+			}
+
+			hasRoots = hasRoots & live;
+			if (Simd::none(hasRoots))
+				continue;
+
+			auto valid0 = hasRoots & (t0 >= rangeMin) & (t0 <= rangeMax);
+			auto valid1 = hasRoots & (t1 >= rangeMin) & (t1 <= rangeMax);
+
+			FloatT t = select(valid0, t0, select(valid1, t1, noHit));
+
+			// Strict compare keeps the lower index on ties
+			auto closer = t < bestT;
+			if (Simd::any(closer))
+			{
+				float indices[WIDTH];
+				for (int lane = 0; lane < WIDTH; lane++)
+					indices[lane] = (float)(i + lane);
+
+				bestT = select(closer, t, bestT);
+				bestIndex = select(closer, FloatT::load(indices), bestIndex);
+			}
+		}
+
+		// Horizontal reduction over the lanes
+		float laneT[WIDTH];
+		float laneIndex[WIDTH];
+		bestT.store(laneT);
+		bestIndex.store(laneIndex);
+
+		int nearest = -1;
+		tHit = inf;
+		for (int lane = 0; lane < WIDTH; lane++)
+		{
+			if (laneIndex[lane] < 0.0f)
+				continue;
+
+			int index = (int)laneIndex[lane];
+			if (laneT[lane] < tHit || (laneT[lane] == tHit && index < nearest))
+			{
+				tHit = laneT[lane];
+				nearest = index;
+			}
+		}
+
+		return nearest;
+	}
+
+	BatchIntersectionResult QuadricBatch::IntersectNearest(const glm::vec3& rayOrigin,
+	                                                      const glm::vec3& rayDirection,
+	                                                      float tMin, float tMax) const
+	{
+		BatchIntersectionResult result;
+
+		if (m_Count == 0)
+			return result;
+
+		float t;
+		int index = FindNearest<Simd::FloatN>(rayOrigin, rayDirection, tMin, tMax, t);
+		if (index < 0)
+			return result;
+
+		// Normal only for the winning surface: ∇f at the hit point
+		glm::vec3 hitPoint = rayOrigin + t * rayDirection;
+		const float x = hitPoint.x, y = hitPoint.y, z = hitPoint.z;
+
+		glm::vec3 normal;
+		normal.x = 2.0f * m_A[index] * x + m_D[index] * y + m_E[index] * z + m_G[index];
+		normal.y = 2.0f * m_B[index] * y + m_D[index] * x + m_F[index] * z + m_H[index];
+		normal.z = 2.0f * m_C[index] * z + m_E[index] * x + m_F[index] * y + m_I[index];
+
+		// Ensure normal points towards ray origin
+		if (glm::dot(normal, rayDirection) > 0.0f)
+			normal = -normal;
+
+		result.Hit = true;
+		result.Distance = t;
+		result.Point = hitPoint;
+		result.Normal = glm::normalize(normal);
+		result.Index = index;
+
+		return result;
+	}
+
+} // namespace Quadric
@@ -0,0 +1,72 @@
+// ============================================================================
+// QUADRIC BATCH - Structure-of-Arrays Quadric Intersection
+// ============================================================================
+// Stores many quadric surfaces column-wise (one array per coefficient) so a
+// single ray can be tested against 4 (SSE) or 8 (AVX2) quadrics per
+// instruction. Only the nearest hit gets a point and normal computed.
+// ============================================================================
+
+#pragma once
+
+#include "Quadric.h"
+
+#include <vector>
+
+namespace Quadric
+{
+	/// Nearest hit of a ray against a QuadricBatch
+	struct BatchIntersectionResult : IntersectionResult
+	{
+		int Index = -1;   // Index of the hit surface in the batch (-1 on miss)
+	};
+
+	// ============================================================================
+	// QUADRIC BATCH CLASS
+	// ============================================================================
+
+	class QuadricBatch
+	{
+	public:
+		QuadricBatch() = default;
+
+		/// Append a surface; returns its index in the batch
+		int Add(const QuadricSurface& surface);
+
+		/// Remove all surfaces
+		void Clear();
+
+		/// Reserve storage for a known number of surfaces
+		void Reserve(size_t count);
+
+		/// Number of surfaces stored (without lane padding)
+		size_t Size() const { return m_Count; }
+
+		/// Intersect ray with every surface and return the closest hit.
+		/// Produces the same hit as calling QuadricSurface::Intersect on each
+		/// surface and keeping the smallest distance.
+		BatchIntersectionResult IntersectNearest(const glm::vec3& rayOrigin,
+		                                         const glm::vec3& rayDirection,
+		                                         float tMin = 0.001f,
+		                                         float tMax = 1000.0f) const;
+
+	private:
+		// Coefficient columns: Ax² + By² + Cz² + Dxy + Exz + Fyz + Gx + Hy + Iz + J
+		std::vector<float> m_A, m_B, m_C, m_D, m_E, m_F, m_G, m_H, m_I, m_J;
+
+		// Tight bounds columns (only tested where m_UseBox is non-zero)
+		std::vector<float> m_MinX, m_MinY, m_MinZ;
+		std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+		std::vector<float> m_UseBox;
+
+		size_t m_Count = 0;
+
+		/// Grow every column to a multiple of the widest lane group. Padding
+		/// lanes have all-zero coefficients, which never produce a root.
+		void Pad();
+
+		template <typename FloatT>
+		int FindNearest(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+		                float tMin, float tMax, float& tHit) const;
+	};
+
+} // namespace Quadric
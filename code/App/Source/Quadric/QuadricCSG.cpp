@@ -0,0 +1,358 @@
+// ============================================================================
+// QUADRIC CSG - Implementation
+// ============================================================================
+
+#include "QuadricCSG.h"
+
+#include <cmath>
+#include <limits>
+
+namespace Quadric
+{
+	static constexpr float INFINITE_T = std::numeric_limits<float>::infinity();
+	
+	// Intervals the ray line spends inside the leaf solid f(O + tD) <= 0
+	static void ComputeLeafIntervals(const QuadricSurface& surface, int leaf,
+	                                 const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                                 std::vector<RayInterval>& intervals)
+	{
+		float a, b, c;
+		surface.ExpandRay(rayOrigin, rayDirection, a, b, c);
+		
+		// Linear along the ray (planes, or rays parallel to a cylinder axis).
+		// Same threshold as SolveQuadratic.
+		if (std::abs(a) < 1e-6f)
+		{
+			if (std::abs(b) < 1e-6f)
+			{
+				if (c <= 0.0f)
+					intervals.push_back({ -INFINITE_T, INFINITE_T, -1, -1 });
+				return;
+			}
+			
+			float t = -c / b;
+			if (b > 0.0f)
+				intervals.push_back({ -INFINITE_T, t, -1, leaf });
+			else
+				intervals.push_back({ t, INFINITE_T, leaf, -1 });
+			return;
+		}
+		
+		float t0, t1;
+		bool hasRoots = surface.SolveQuadratic(a, b, c, t0, t1);
+		
+		if (a > 0.0f)
+		{
+			// Inside between the roots
+			if (hasRoots)
+				intervals.push_back({ t0, t1, leaf, leaf });
+		}
+		else if (!hasRoots)
+		{
+			// Opens downward and never crosses zero: inside everywhere
+			intervals.push_back({ -INFINITE_T, INFINITE_T, -1, -1 });
+		}
+		else
+		{
+			// Inside outside the roots
+			intervals.push_back({ -INFINITE_T, t0, -1, leaf });
+			intervals.push_back({ t1, INFINITE_T, leaf, -1 });
+		}
+	}
+	
+	static bool ApplyOperation(CSGOperation operation, bool inLeft, bool inRight)
+	{
+		switch (operation)
+		{
+		case CSGOperation::Union:        return inLeft || inRight;
+		case CSGOperation::Intersection: return inLeft && inRight;
+		case CSGOperation::Difference:   return inLeft && !inRight;
+		case CSGOperation::Leaf:         break;
+		}
+		return inLeft;
+	}
+	
+	// Merge two sorted, disjoint interval lists by walking their boundaries in
+	// order. Each boundary toggles one side; an output interval opens or
+	// closes whenever the combined inside state changes.
+	static void CombineIntervals(CSGOperation operation,
+	                             const std::vector<RayInterval>& left,
+	                             const std::vector<RayInterval>& right,
+	                             std::vector<RayInterval>& result)
+	{
+		size_t i = 0, j = 0;
+		bool inLeft = false, inRight = false, inside = false;
+		RayInterval current;
+		
+		while (i < left.size() || j < right.size())
+		{
+			bool hasLeft = i < left.size();
+			bool hasRight = j < right.size();
+			float tLeft = hasLeft ? (inLeft ? left[i].Exit : left[i].Enter) : 0.0f;
+			float tRight = hasRight ? (inRight ? right[j].Exit : right[j].Enter) : 0.0f;
+			
+			// On ties take entries first, so touching solids merge without an
+			// internal face and touching at a point yields nothing
+			bool takeLeft = hasLeft && (!hasRight || tLeft < tRight || (tLeft == tRight && !inLeft));
+			
+			float t;
+			int leaf;
+			if (takeLeft)
+			{
+				t = tLeft;
+				leaf = inLeft ? left[i].ExitLeaf : left[i].EnterLeaf;
+				if (inLeft)
+					i++;
+				inLeft = !inLeft;
+			}
+			else
+			{
+				t = tRight;
+				leaf = inRight ? right[j].ExitLeaf : right[j].EnterLeaf;
+				if (inRight)
+					j++;
+				inRight = !inRight;
+			}
+			
+			bool nowInside = ApplyOperation(operation, inLeft, inRight);
+			if (nowInside && !inside)
+			{
+				current.Enter = t;
+				current.EnterLeaf = leaf;
+			}
+			else if (!nowInside && inside)
+			{
+				current.Exit = t;
+				current.ExitLeaf = leaf;
+				if (current.Exit > current.Enter)
+					result.push_back(current);
+			}
+			inside = nowInside;
+		}
+	}
+	
+	// ============================================================================
+	// TREE CONSTRUCTION
+	// ============================================================================
+	
+	int QuadricCSG::AddLeaf(const QuadricSurface& surface)
+	{
+		m_Surfaces.push_back(surface);
+		
+		Node node;
+		node.Leaf = static_cast<int>(m_Surfaces.size()) - 1;
+		m_Nodes.push_back(node);
+		
+		m_Root = static_cast<int>(m_Nodes.size()) - 1;
+		return m_Root;
+	}
+	
+	int QuadricCSG::AddUnion(int left, int right)
+	{
+		return AddNode(CSGOperation::Union, left, right);
+	}
+	
+	int QuadricCSG::AddIntersection(int left, int right)
+	{
+		return AddNode(CSGOperation::Intersection, left, right);
+	}
+	
+	int QuadricCSG::AddDifference(int left, int right)
+	{
+		return AddNode(CSGOperation::Difference, left, right);
+	}
+	
+	int QuadricCSG::AddNode(CSGOperation operation, int left, int right)
+	{
+		Node node;
+		node.Operation = operation;
+		node.Left = left;
+		node.Right = right;
+		m_Nodes.push_back(node);
+		
+		m_Root = static_cast<int>(m_Nodes.size()) - 1;
+		return m_Root;
+	}
+	
+	void QuadricCSG::SetRoot(int node)
+	{
+		if (node >= 0 && node < static_cast<int>(m_Nodes.size()))
+			m_Root = node;
+	}
+	
+	void QuadricCSG::Clear()
+	{
+		m_Surfaces.clear();
+		m_Nodes.clear();
+		m_Root = -1;
+	}
+	
+	// ============================================================================
+	// QUERIES
+	// ============================================================================
+	
+	bool QuadricCSG::Contains(const glm::vec3& point) const
+	{
+		return m_Root >= 0 && ContainsNode(m_Root, point);
+	}
+	
+	bool QuadricCSG::ContainsNode(int node, const glm::vec3& point) const
+	{
+		const Node& n = m_Nodes[node];
+		if (n.Operation == CSGOperation::Leaf)
+			return m_Surfaces[n.Leaf].Evaluate(point) <= 0.0f;
+		
+		return ApplyOperation(n.Operation, ContainsNode(n.Left, point), ContainsNode(n.Right, point));
+	}
+	
+	void QuadricCSG::ComputeIntervals(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                                  std::vector<RayInterval>& intervals) const
+	{
+		intervals.clear();
+		if (m_Root >= 0)
+			ComputeNodeIntervals(m_Root, rayOrigin, rayDirection, intervals);
+	}
+	
+	void QuadricCSG::ComputeNodeIntervals(int node, const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                                      std::vector<RayInterval>& intervals) const
+	{
+		const Node& n = m_Nodes[node];
+		if (n.Operation == CSGOperation::Leaf)
+		{
+			ComputeLeafIntervals(m_Surfaces[n.Leaf], n.Leaf, rayOrigin, rayDirection, intervals);
+			return;
+		}
+		
+		std::vector<RayInterval> left, right;
+		ComputeNodeIntervals(n.Left, rayOrigin, rayDirection, left);
+		
+		// Nothing to intersect with or subtract from
+		if (left.empty() && n.Operation != CSGOperation::Union)
+			return;
+		
+		ComputeNodeIntervals(n.Right, rayOrigin, rayDirection, right);
+		CombineIntervals(n.Operation, left, right, intervals);
+	}
+	
+	bool QuadricCSG::FindBoundary(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+	                              float tMin, float tMax, float& t, int& leaf) const
+	{
+		std::vector<RayInterval> intervals;
+		ComputeIntervals(rayOrigin, rayDirection, intervals);
+		
+		for (const RayInterval& interval : intervals)
+		{
+			if (interval.Enter > tMax)
+				break;
+			
+			// Entering the solid, or leaving it when the ray starts inside
+			if (interval.Enter >= tMin)
+			{
+				t = interval.Enter;
+				leaf = interval.EnterLeaf;
+			}
+			else if (interval.Exit >= tMin && interval.Exit <= tMax)
+			{
+				t = interval.Exit;
+				leaf = interval.ExitLeaf;
+			}
+			else
+			{
+				continue;
+			}
+			
+			if (leaf >= 0)
+				return true;
+		}
+		
+		return false;
+	}
+	
+	IntersectionResult QuadricCSG::Intersect(const glm::vec3& rayOrigin,
+	                                         const glm::vec3& rayDirection,
+	                                         float tMin, float tMax) const
+	{
+		IntersectionResult result;
+		
+		float t;
+		int leaf;
+		if (!FindBoundary(rayOrigin, rayDirection, tMin, tMax, t, leaf))
+			return result;
+		
+		glm::vec3 hitPoint = rayOrigin + t * rayDirection;
+		glm::vec3 normal = m_Surfaces[leaf].CalculateNormal(hitPoint);
+		
+		// Ensure normal points towards ray origin
+		if (glm::dot(normal, rayDirection) > 0.0f)
+			normal = -normal;
+		
+		result.Hit = true;
+		result.Distance = t;
+		result.Point = hitPoint;
+		result.Normal = glm::normalize(normal);
+		
+		return result;
+	}
+	
+	bool QuadricCSG::Occluded(const glm::vec3& rayOrigin,
+	                          const glm::vec3& rayDirection,
+	                          float tMax, float tMin) const
+	{
+		float t;
+		int leaf;
+		return FindBoundary(rayOrigin, rayDirection, tMin, tMax, t, leaf);
+	}
+	
+	// ============================================================================
+	// FACTORY METHODS
+	// ============================================================================
+	
+	QuadricCSG QuadricCSG::CreateCappedCylinder(float radius, float height)
+	{
+		// (x² + y² - r² <= 0) ∩ (z <= h/2) ∩ (-z <= h/2)
+		QuadricCoefficients side;
+		side.A = 1.0f;
+		side.B = 1.0f;
+		side.J = -radius * radius;
+		
+		QuadricCSG csg;
+		int body = csg.AddLeaf(QuadricSurface(side));
+		int top = csg.AddLeaf(QuadricSurface::CreatePlane(glm::vec3(0.0f, 0.0f, 1.0f), height / 2.0f));
+		int bottom = csg.AddLeaf(QuadricSurface::CreatePlane(glm::vec3(0.0f, 0.0f, -1.0f), height / 2.0f));
+		csg.AddIntersection(csg.AddIntersection(body, top), bottom);
+		return csg;
+	}
+	
+	QuadricCSG QuadricCSG::CreateLens(float radius, float thickness)
+	{
+		// Spheres centered at z = ±(r - thickness/2) overlap in |z| <= thickness/2:
+		// x² + y² + z² ∓ 2cz + c² - r² <= 0
+		float c = radius - thickness / 2.0f;
+		
+		QuadricCoefficients front(1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 2.0f * c, c * c - radius * radius);
+		QuadricCoefficients back(1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -2.0f * c, c * c - radius * radius);
+		
+		QuadricCSG csg;
+		csg.AddIntersection(csg.AddLeaf(QuadricSurface(front)), csg.AddLeaf(QuadricSurface(back)));
+		return csg;
+	}
+	
+	QuadricCSG QuadricCSG::CreateClippedCone(float angle, float zMin, float zMax)
+	{
+		// (x² + y² - (z·tan(θ))² <= 0) ∩ (z <= zMax) ∩ (-z <= -zMin)
+		float tanAngle = std::tan(angle);
+		
+		QuadricCoefficients side;
+		side.A = 1.0f;
+		side.B = 1.0f;
+		side.C = -tanAngle * tanAngle;
+		
+		QuadricCSG csg;
+		int body = csg.AddLeaf(QuadricSurface(side));
+		int top = csg.AddLeaf(QuadricSurface::CreatePlane(glm::vec3(0.0f, 0.0f, 1.0f), zMax));
+		int bottom = csg.AddLeaf(QuadricSurface::CreatePlane(glm::vec3(0.0f, 0.0f, -1.0f), -zMin));
+		csg.AddIntersection(csg.AddIntersection(body, top), bottom);
+		return csg;
+	}
+	
+} // namespace Quadric
@@ -0,0 +1,137 @@
+// ============================================================================
+// QUADRIC CSG - Boolean Combinations of Quadric Solids
+// ============================================================================
+// Every leaf is the solid f(p) <= 0 of a QuadricSurface. A ray is cut into
+// the sorted list of intervals it spends inside each leaf, and union,
+// intersection and difference merge those lists. Capped cylinders, lenses
+// and clipped cones become exact solids made of two or three quadrics
+// instead of tessellated meshes.
+//
+// Leaves ignore the surface's bounding box: caps and clipping come from
+// plane leaves (QuadricSurface::CreatePlane) instead. Negating all ten
+// coefficients turns a leaf into its complement.
+// ============================================================================
+
+#pragma once
+
+#include "Quadric.h"
+
+#include <vector>
+
+namespace Quadric
+{
+	/// Node type of a CSG tree
+	enum class CSGOperation
+	{
+		Leaf,
+		Union,
+		Intersection,
+		Difference     // Left minus right
+	};
+	
+	/// Span [Enter, Exit] of a ray inside a solid. The leaf indices record
+	/// which surface bounds each end (-1 for an end at infinity).
+	struct RayInterval
+	{
+		float Enter = 0.0f;
+		float Exit = 0.0f;
+		int EnterLeaf = -1;
+		int ExitLeaf = -1;
+	};
+	
+	// ============================================================================
+	// QUADRIC CSG CLASS
+	// ============================================================================
+	
+	class QuadricCSG
+	{
+	public:
+		QuadricCSG() = default;
+		
+		/// Add a leaf solid (f <= 0); returns its node index
+		int AddLeaf(const QuadricSurface& surface);
+		
+		/// Combine two existing nodes; returns the new node index.
+		/// The most recently added node becomes the root.
+		int AddUnion(int left, int right);
+		int AddIntersection(int left, int right);
+		int AddDifference(int left, int right);
+		
+		/// Choose a different root node
+		void SetRoot(int node);
+		
+		/// Root node index (-1 when empty)
+		int GetRoot() const { return m_Root; }
+		
+		/// Number of nodes and leaf surfaces
+		size_t GetNodeCount() const { return m_Nodes.size(); }
+		size_t GetLeafCount() const { return m_Surfaces.size(); }
+		
+		/// Leaf surface by leaf index (as stored in RayInterval)
+		const QuadricSurface& GetLeaf(int leaf) const { return m_Surfaces[leaf]; }
+		
+		/// Remove all nodes
+		void Clear();
+		
+		/// Check if a point is inside the root solid
+		bool Contains(const glm::vec3& point) const;
+		
+		/// Intervals the whole ray line spends inside the root solid, sorted
+		/// and disjoint. Ends may be ±infinity for unbounded solids.
+		void ComputeIntervals(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+		                      std::vector<RayInterval>& intervals) const;
+		
+		/// Intersect ray with the boundary of the root solid. The normal is
+		/// the gradient of the leaf that owns the hit, facing the ray.
+		IntersectionResult Intersect(const glm::vec3& rayOrigin,
+		                             const glm::vec3& rayDirection,
+		                             float tMin = 0.001f,
+		                             float tMax = 1000.0f) const;
+		
+		/// Any-hit query (see QuadricSurface::Occluded)
+		bool Occluded(const glm::vec3& rayOrigin,
+		              const glm::vec3& rayDirection,
+		              float tMax,
+		              float tMin = 0.001f) const;
+		
+		// ============================================================================
+		// FACTORY METHODS - Common CSG Solids
+		// ============================================================================
+		
+		/// Solid cylinder along Z with flat caps at z = ±height/2
+		static QuadricCSG CreateCappedCylinder(float radius, float height);
+		
+		/// Biconvex lens along Z: two spheres of the given radius, overlapping
+		/// so the lens is thickness deep (thickness < 2·radius)
+		static QuadricCSG CreateLens(float radius, float thickness);
+		
+		/// Cone along Z (apex at the origin) clipped to zMin <= z <= zMax;
+		/// zMin > 0 gives a frustum
+		static QuadricCSG CreateClippedCone(float angle, float zMin, float zMax);
+	
+	private:
+		struct Node
+		{
+			CSGOperation Operation = CSGOperation::Leaf;
+			int Left = -1;
+			int Right = -1;
+			int Leaf = -1;     // Index into m_Surfaces for leaf nodes
+		};
+		
+		std::vector<QuadricSurface> m_Surfaces;
+		std::vector<Node> m_Nodes;
+		int m_Root = -1;
+		
+		int AddNode(CSGOperation operation, int left, int right);
+		
+		/// First boundary of the root solid in [tMin, tMax] and its leaf
+		bool FindBoundary(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+		                  float tMin, float tMax, float& t, int& leaf) const;
+		
+		bool ContainsNode(int node, const glm::vec3& point) const;
+		
+		void ComputeNodeIntervals(int node, const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+		                          std::vector<RayInterval>& intervals) const;
+	};
+	
+} // namespace Quadric
@@ -0,0 +1,62 @@
+// ============================================================================
+// QUADRIC INSTANCE - Implementation
+// ============================================================================
+
+#include "QuadricInstance.h"
+
+namespace Quadric
+{
+	QuadricInstance::QuadricInstance(const QuadricSurface& shape, const glm::mat4& objectToWorld)
+		: m_Shape(&shape)
+		, m_WorldToObject(glm::inverse(objectToWorld))
+	{
+	}
+	
+	void QuadricInstance::SetTransform(const glm::mat4& objectToWorld)
+	{
+		m_WorldToObject = glm::inverse(objectToWorld);
+	}
+	
+	IntersectionResult QuadricInstance::Intersect(const glm::vec3& rayOrigin,
+	                                             const glm::vec3& rayDirection,
+	                                             float tMin, float tMax) const
+	{
+		// Move the ray into object space (direction keeps its length ratio, so t is shared)
+		glm::vec3 localOrigin = glm::vec3(m_WorldToObject * glm::vec4(rayOrigin, 1.0f));
+		glm::vec3 localDirection = glm::vec3(m_WorldToObject * glm::vec4(rayDirection, 0.0f));
+		
+		IntersectionResult result = m_Shape->Intersect(localOrigin, localDirection, tMin, tMax);
+		if (!result.Hit)
+			return result;
+		
+		// Normals transform with the inverse transpose of objectToWorld, i.e.
+		// the transpose of worldToObject. The facing flip done in object space
+		// survives: dot(Wᵀn, d) = dot(n, Wd).
+		result.Point = rayOrigin + result.Distance * rayDirection;
+		result.Normal = glm::normalize(glm::transpose(glm::mat3(m_WorldToObject)) * result.Normal);
+		
+		return result;
+	}
+	
+	bool QuadricInstance::Occluded(const glm::vec3& rayOrigin,
+	                               const glm::vec3& rayDirection,
+	                               float tMax, float tMin) const
+	{
+		glm::vec3 localOrigin = glm::vec3(m_WorldToObject * glm::vec4(rayOrigin, 1.0f));
+		glm::vec3 localDirection = glm::vec3(m_WorldToObject * glm::vec4(rayDirection, 0.0f));
+		
+		return m_Shape->Occluded(localOrigin, localDirection, tMax, tMin);
+	}
+	
+	BoundingBox QuadricInstance::GetBounds() const
+	{
+		return TransformBounds(m_Shape->GetBounds(), GetTransform());
+	}
+	
+	QuadricCoefficients QuadricInstance::GetWorldCoefficients() const
+	{
+		const glm::mat4& W = m_WorldToObject;
+		return QuadricCoefficients::FromMatrix(glm::transpose(W) * m_Shape->GetCoefficients().ToMatrix() * W);
+	}
+	
+} // namespace Quadric
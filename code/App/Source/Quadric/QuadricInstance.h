@@ -0,0 +1,67 @@
+// ============================================================================
+// QUADRIC INSTANCE - Canonical Quadric + Affine Transform
+// ============================================================================
+// An instance references a canonical (object-space) QuadricSurface and places
+// it in the world with an affine transform. Rays are moved into object space
+// instead of re-deriving the ten world-space coefficients, so any number of
+// instances can share one shape and moving or rotating an instance only
+// touches its transform.
+//
+// The ray direction is transformed without normalizing, so hit distances are
+// the same in both spaces.
+// ============================================================================
+
+#pragma once
+
+#include "Quadric.h"
+
+namespace Quadric
+{
+	// ============================================================================
+	// QUADRIC INSTANCE CLASS
+	// ============================================================================
+	
+	class QuadricInstance
+	{
+	public:
+		/// The shape is referenced, not copied; it must outlive the instance
+		QuadricInstance(const QuadricSurface& shape, const glm::mat4& objectToWorld = glm::mat4(1.0f));
+		
+		/// Set object-to-world transform (must be affine and invertible)
+		void SetTransform(const glm::mat4& objectToWorld);
+		
+		/// Get object-to-world transform
+		glm::mat4 GetTransform() const { return glm::inverse(m_WorldToObject); }
+		
+		/// Get world-to-object transform (used to move rays into object space)
+		const glm::mat4& GetInverseTransform() const { return m_WorldToObject; }
+		
+		/// Get the shared canonical shape
+		const QuadricSurface& GetShape() const { return *m_Shape; }
+		
+		/// Intersect world-space ray with the instance.
+		/// The shape's bounding box, if enabled, applies in object space.
+		IntersectionResult Intersect(const glm::vec3& rayOrigin,
+		                             const glm::vec3& rayDirection,
+		                             float tMin = 0.001f,
+		                             float tMax = 1000.0f) const;
+		
+		/// Any-hit query in world space (see QuadricSurface::Occluded)
+		bool Occluded(const glm::vec3& rayOrigin,
+		              const glm::vec3& rayDirection,
+		              float tMax,
+		              float tMin = 0.001f) const;
+		
+		/// World-space box around the shape's tight bounds (meaningful when
+		/// GetShape().HasBounds())
+		BoundingBox GetBounds() const;
+		
+		/// World-space coefficients of the placed surface (Q' = M⁻ᵀ Q M⁻¹)
+		QuadricCoefficients GetWorldCoefficients() const;
+		
+	private:
+		const QuadricSurface* m_Shape;
+		glm::mat4 m_WorldToObject;
+	};
+	
+} // namespace Quadric
@@ -3,8 +3,20 @@
 // ============================================================================
 
 #include "Quadric.h"
+#include "QuadricBatch.h"
+#include "QuadricInstance.h"
+#include "QuadricCSG.h"
+#include "QuadricBVH.h"
+#include "../Math/Vec3Simd.h"
+#include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 #include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 using namespace Quadric;
 
@@ -280,6 +292,1007 @@ void TestAllPresets()
 	}
 }
 
+void TestQuadricBatch()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 8: QuadricBatch vs Scalar Intersect" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	// Scatter translated spheres plus every bounded preset
+	// Sphere at c: x² + y² + z² - 2cx·x - 2cy·y - 2cz·z + |c|² - r² = 0
+	std::vector<QuadricSurface> surfaces;
+	for (int i = 0; i < 29; i++)
+	{
+		glm::vec3 c(float(i % 5) * 2.0f - 4.0f, float((i / 5) % 3) * 2.0f - 2.0f, float(i / 15) * 3.0f - 1.5f);
+		float r = 0.3f + 0.05f * float(i % 4);
+		QuadricCoefficients coeffs(1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+		                           -2.0f * c.x, -2.0f * c.y, -2.0f * c.z,
+		                           glm::dot(c, c) - r * r);
+		surfaces.push_back(QuadricSurface(coeffs));
+	}
+	for (const char* preset : { "cylinder", "cone", "paraboloid", "saddle", "hyperboloid1", "hyperboloid2" })
+		surfaces.push_back(GetPresetQuadric(preset));
+	
+	QuadricBatch batch;
+	for (const QuadricSurface& surface : surfaces)
+		batch.Add(surface);
+	
+	std::cout << "Surfaces: " << batch.Size() << std::endl;
+	
+	// Random rays from a shell of radius 15 towards the scene
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+	const int numRays = 20000;
+	std::vector<glm::vec3> origins(numRays), directions(numRays);
+	for (int i = 0; i < numRays; i++)
+	{
+		glm::vec3 o(uniform(rng), uniform(rng), uniform(rng));
+		origins[i] = glm::normalize(o) * 15.0f;
+		glm::vec3 target(uniform(rng) * 5.0f, uniform(rng) * 3.0f, uniform(rng) * 3.0f);
+		directions[i] = glm::normalize(target - origins[i]);
+	}
+	
+	// Compare hits
+	int hits = 0, mismatches = 0;
+	for (int i = 0; i < numRays; i++)
+	{
+		IntersectionResult expected;
+		expected.Distance = 1e30f;
+		for (const QuadricSurface& surface : surfaces)
+		{
+			IntersectionResult r = surface.Intersect(origins[i], directions[i]);
+			if (r.Hit && r.Distance < expected.Distance)
+				expected = r;
+		}
+		
+		BatchIntersectionResult actual = batch.IntersectNearest(origins[i], directions[i]);
+		if (expected.Hit) hits++;
+		
+		// Relative tolerance: near-tangent roots are ill-conditioned and the
+		// lane math rounds differently from the scalar path. At a tangent hit
+		// the normal is perpendicular to the ray, so its facing flip is
+		// rounding-dependent too; compare normals up to sign.
+		float tolerance = 1e-3f * std::max(1.0f, expected.Distance);
+		bool same = expected.Hit == actual.Hit &&
+		            (!expected.Hit || (std::abs(expected.Distance - actual.Distance) < tolerance &&
+		                               std::abs(glm::dot(expected.Normal, actual.Normal)) > 0.999f));
+		if (!same) mismatches++;
+	}
+	
+	std::cout << "Rays: " << numRays << " | Hits: " << hits << std::endl;
+	if (mismatches == 0)
+		std::cout << "✓ Batch matches scalar results" << std::endl;
+	else
+		std::cout << "✗ " << mismatches << " rays differ from scalar results" << std::endl;
+	
+	// Timing (informational)
+	auto start = std::chrono::high_resolution_clock::now();
+	float checksum = 0.0f;
+	for (int i = 0; i < numRays; i++)
+	{
+		float nearest = 1e30f;
+		for (const QuadricSurface& surface : surfaces)
+		{
+			IntersectionResult r = surface.Intersect(origins[i], directions[i]);
+			if (r.Hit && r.Distance < nearest)
+				nearest = r.Distance;
+		}
+		checksum += nearest < 1e30f ? nearest : 0.0f;
+	}
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < numRays; i++)
+	{
+		BatchIntersectionResult r = batch.IntersectNearest(origins[i], directions[i]);
+		checksum -= r.Hit ? r.Distance : 0.0f;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	
+	double scalarMs = std::chrono::duration<double, std::milli>(middle - start).count();
+	double batchMs = std::chrono::duration<double, std::milli>(end - middle).count();
+	std::cout << std::fixed << std::setprecision(2)
+	          << "  Scalar: " << scalarMs << " ms | Batch: " << batchMs << " ms"
+	          << " | Speedup: " << scalarMs / batchMs << "x" << std::endl;
+	std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+void TestRayPackets()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 9: Ray Packets vs Scalar Intersect" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	const char* presets[] = {
+		"sphere", "ellipsoid", "cylinder", "cone", 
+		"paraboloid", "saddle", "hyperboloid1", "hyperboloid2"
+	};
+	
+	// Pinhole camera looking at the origin; 4x4 pixel tiles share its origin
+	const glm::vec3 eye(3.0f, 2.0f, 8.0f);
+	const glm::vec3 forward = glm::normalize(-eye);
+	const glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+	const glm::vec3 up = glm::cross(right, forward);
+	const int width = 128, height = 128;
+	
+	auto cameraRay = [&](int x, int y)
+	{
+		float u = (float(x) + 0.5f) / float(width) * 2.0f - 1.0f;
+		float v = (float(y) + 0.5f) / float(height) * 2.0f - 1.0f;
+		return glm::normalize(forward + 0.6f * (u * right + v * up));
+	};
+	
+	// 16-ray packets: one 4x4 tile each
+	std::vector<RayPacket<16>> tiles;
+	for (int ty = 0; ty < height; ty += 4)
+	{
+		for (int tx = 0; tx < width; tx += 4)
+		{
+			RayPacket<16> packet;
+			packet.Origin = eye;
+			for (int i = 0; i < 16; i++)
+				packet.SetDirection(i, cameraRay(tx + i % 4, ty + i / 4));
+			tiles.push_back(packet);
+		}
+	}
+	
+	int hits = 0, mismatches = 0;
+	for (const char* preset : presets)
+	{
+		QuadricSurface quadric = GetPresetQuadric(preset);
+		for (const RayPacket<16>& tile : tiles)
+		{
+			PacketIntersectionResult<16> packetHits;
+			quadric.IntersectPacket(tile, packetHits);
+			
+			// The same rays as two 8-ray packets
+			RayPacket<8> halves[2];
+			PacketIntersectionResult<8> halfHits[2];
+			for (int h = 0; h < 2; h++)
+			{
+				halves[h].Origin = tile.Origin;
+				for (int i = 0; i < 8; i++)
+					halves[h].SetDirection(i, tile.GetDirection(h * 8 + i));
+				quadric.IntersectPacket(halves[h], halfHits[h]);
+			}
+			
+			for (int i = 0; i < 16; i++)
+			{
+				IntersectionResult expected = quadric.Intersect(tile.Origin, tile.GetDirection(i));
+				if (expected.Hit) hits++;
+				
+				const PacketIntersectionResult<8>& half = halfHits[i / 8];
+				float tolerance = 1e-3f * std::max(1.0f, expected.Distance);
+				bool same = expected.Hit == packetHits.Hit(i) && expected.Hit == half.Hit(i % 8) &&
+				            (!expected.Hit || (std::abs(expected.Distance - packetHits.Distance[i]) < tolerance &&
+				                               std::abs(expected.Distance - half.Distance[i % 8]) < tolerance));
+				if (!same) mismatches++;
+			}
+		}
+	}
+	
+	std::cout << "Rays per preset: " << tiles.size() * 16 << " | Hits: " << hits << std::endl;
+	if (mismatches == 0)
+		std::cout << "✓ Packets match scalar results" << std::endl;
+	else
+		std::cout << "✗ " << mismatches << " rays differ from scalar results" << std::endl;
+	
+	// Timing (informational)
+	const int repeats = 20;
+	float checksum = 0.0f;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < repeats; r++)
+		for (const char* preset : presets)
+		{
+			QuadricSurface quadric = GetPresetQuadric(preset);
+			for (const RayPacket<16>& tile : tiles)
+				for (int i = 0; i < 16; i++)
+				{
+					IntersectionResult hit = quadric.Intersect(tile.Origin, tile.GetDirection(i));
+					checksum += hit.Hit ? hit.Distance : 0.0f;
+				}
+		}
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < repeats; r++)
+		for (const char* preset : presets)
+		{
+			QuadricSurface quadric = GetPresetQuadric(preset);
+			for (const RayPacket<16>& tile : tiles)
+			{
+				PacketIntersectionResult<16> packetHits;
+				quadric.IntersectPacket(tile, packetHits);
+				for (int i = 0; i < 16; i++)
+					checksum -= packetHits.Hit(i) ? packetHits.Distance[i] : 0.0f;
+			}
+		}
+	auto end = std::chrono::high_resolution_clock::now();
+	
+	double scalarMs = std::chrono::duration<double, std::milli>(middle - start).count();
+	double packetMs = std::chrono::duration<double, std::milli>(end - middle).count();
+	std::cout << std::fixed << std::setprecision(2)
+	          << "  Scalar: " << scalarMs << " ms | Packets: " << packetMs << " ms"
+	          << " | Speedup: " << scalarMs / packetMs << "x" << std::endl;
+	std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+void TestInstances()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 10: Instanced Quadrics" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	// Matrix form round trip
+	QuadricCoefficients general(1.0f, 2.0f, 3.0f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.9f, -1.0f);
+	QuadricCoefficients roundTrip = QuadricCoefficients::FromMatrix(general.ToMatrix());
+	bool matrixOk = roundTrip.A == general.A && roundTrip.D == general.D &&
+	                roundTrip.G == general.G && roundTrip.J == general.J;
+	std::cout << (matrixOk ? "✓" : "✗") << " ToMatrix/FromMatrix round trip" << std::endl;
+	
+	// Unit sphere scaled, rotated and moved vs the same surface baked into world coefficients
+	QuadricSurface unitSphere = QuadricSurface::CreateSphere(1.0f);
+	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, -0.5f, 2.0f));
+	transform = glm::rotate(transform, glm::radians(30.0f), glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)));
+	transform = glm::scale(transform, glm::vec3(2.0f, 1.0f, 0.5f));
+	
+	QuadricInstance instance(unitSphere, transform);
+	QuadricSurface baked(instance.GetWorldCoefficients());
+	
+	std::cout << "Baked world equation:" << std::endl;
+	PrintQuadricEquation(baked.GetCoefficients());
+	
+	int mismatches = 0, hits = 0;
+	for (int i = 0; i < 400; i++)
+	{
+		float u = float(i % 20) / 19.0f * 2.0f - 1.0f;
+		float v = float(i / 20) / 19.0f * 2.0f - 1.0f;
+		glm::vec3 origin(0.0f, 0.0f, 10.0f);
+		glm::vec3 target(1.0f + 2.5f * u, -0.5f + 2.5f * v, 2.0f);
+		glm::vec3 direction = glm::normalize(target - origin);
+		
+		IntersectionResult expected = baked.Intersect(origin, direction);
+		IntersectionResult actual = instance.Intersect(origin, direction);
+		if (expected.Hit) hits++;
+		
+		bool same = expected.Hit == actual.Hit &&
+		            (!expected.Hit || (std::abs(expected.Distance - actual.Distance) < 1e-3f &&
+		                               glm::dot(expected.Normal, actual.Normal) > 0.999f));
+		if (!same) mismatches++;
+	}
+	std::cout << "Rays: 400 | Hits: " << hits << std::endl;
+	if (mismatches == 0)
+		std::cout << "✓ Instance matches baked coefficients" << std::endl;
+	else
+		std::cout << "✗ " << mismatches << " rays differ from baked coefficients" << std::endl;
+	
+	// A field of identical cylinders sharing one canonical shape
+	QuadricSurface cylinder = QuadricSurface::CreateCylinder(0.25f, 2.0f);
+	std::vector<QuadricInstance> field;
+	for (int x = 0; x < 10; x++)
+		for (int y = 0; y < 10; y++)
+			field.emplace_back(cylinder, glm::translate(glm::mat4(1.0f), glm::vec3(x - 4.5f, y - 4.5f, 0.0f)));
+	
+	int fieldHits = 0;
+	for (const QuadricInstance& column : field)
+	{
+		glm::vec3 center = glm::vec3(column.GetTransform()[3]);
+		IntersectionResult hit = column.Intersect(center + glm::vec3(0.1f, -3.0f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f));
+		if (hit.Hit && std::abs(hit.Point.y - (center.y - std::sqrt(0.25f * 0.25f - 0.1f * 0.1f))) < 1e-4f)
+			fieldHits++;
+	}
+	std::cout << "Cylinder field: " << field.size() << " instances of 1 shape" << std::endl;
+	if (fieldHits == (int)field.size())
+		std::cout << "✓ Every instance hit at its own position" << std::endl;
+	else
+		std::cout << "✗ Only " << fieldHits << " instances hit correctly" << std::endl;
+}
+
+void TestTightBounds()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 11: Tight Bounding Boxes" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	auto printBounds = [](const char* name, const QuadricSurface& surface)
+	{
+		const BoundingBox& b = surface.GetBounds();
+		std::cout << std::fixed << std::setprecision(3) << "  " << name << ": ";
+		if (!surface.HasBounds())
+		{
+			std::cout << "unbounded" << std::endl;
+			return;
+		}
+		std::cout << "(" << b.Min.x << ", " << b.Min.y << ", " << b.Min.z << ") - ("
+		          << b.Max.x << ", " << b.Max.y << ", " << b.Max.z << ")" << std::endl;
+	};
+	
+	// Brute-force check: surface points found by axis-aligned rays through the
+	// sample box are all inside the bounds, and the bounds are not much larger
+	auto checkBounds = [](const char* name, const QuadricSurface& surface, const BoundingBox& sampleBox)
+	{
+		std::mt19937 rng(7);
+		std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+		glm::vec3 sampledMin(1e30f), sampledMax(-1e30f);
+		for (int i = 0; i < 20000; i++)
+		{
+			// Random line through the sample box; keep its surface points
+			glm::vec3 p = sampleBox.Min + glm::vec3(uniform(rng), uniform(rng), uniform(rng)) * (sampleBox.Max - sampleBox.Min);
+			glm::vec3 axis(0.0f);
+			axis[i % 3] = 1.0f;
+			for (float sign : { 1.0f, -1.0f })
+			{
+				IntersectionResult hit = surface.Intersect(p, sign * axis, 0.0f, 1e30f);
+				if (!hit.Hit)
+					continue;
+				sampledMin = glm::min(sampledMin, hit.Point);
+				sampledMax = glm::max(sampledMax, hit.Point);
+			}
+		}
+		
+		const BoundingBox& b = surface.GetBounds();
+		glm::vec3 slackMin = sampledMin - b.Min;
+		glm::vec3 slackMax = b.Max - sampledMax;
+		float slack = std::max({ slackMin.x, slackMin.y, slackMin.z, slackMax.x, slackMax.y, slackMax.z });
+		glm::vec3 size = b.Max - b.Min;
+		bool tight = slack < 0.01f * (1.0f + std::max({ size.x, size.y, size.z }));   // Sampling is sparse near the extremes
+		bool enclosing = slackMin.x >= 0.0f && slackMin.y >= 0.0f && slackMin.z >= 0.0f &&
+		                 slackMax.x >= 0.0f && slackMax.y >= 0.0f && slackMax.z >= 0.0f;
+		std::cout << (tight && enclosing ? "  ✓ " : "  ✗ ") << name << " bounds are "
+		          << (enclosing ? "enclosing" : "NOT enclosing") << ", max slack " << slack << std::endl;
+	};
+	
+	// Bounded shapes: exact analytic extent, no user box needed
+	QuadricSurface sphere(QuadricCoefficients(1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, -2.0f, -4.0f, -6.0f, 10.0f));   // Center (1,2,3), r=2
+	printBounds("Sphere c=(1,2,3) r=2", sphere);
+	checkBounds("Sphere", sphere, BoundingBox(glm::vec3(-2.0f), glm::vec3(6.0f)));
+	
+	glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(40.0f), glm::normalize(glm::vec3(1.0f, 2.0f, 0.5f)));
+	QuadricSurface ellipsoid = QuadricSurface::CreateEllipsoid(2.0f, 1.5f, 1.0f);
+	QuadricSurface rotatedEllipsoid(ellipsoid.GetCoefficients().Transformed(rotation));
+	printBounds("Rotated ellipsoid", rotatedEllipsoid);
+	checkBounds("Rotated ellipsoid", rotatedEllipsoid, BoundingBox(glm::vec3(-3.0f), glm::vec3(3.0f)));
+	
+	// Unbounded shapes: user box clipped to the surface
+	const char* presets[] = { "cylinder", "cone", "paraboloid", "saddle", "hyperboloid1", "hyperboloid2" };
+	for (const char* preset : presets)
+	{
+		QuadricSurface surface = GetPresetQuadric(preset);
+		printBounds(preset, surface);
+		checkBounds(preset, surface, surface.GetBoundingBox());
+	}
+	
+	// Fraction of random rays that still reach the root solve
+	QuadricSurface cylinder = GetPresetQuadric("cylinder");
+	std::mt19937 rng(99);
+	std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+	int userBoxHits = 0, tightHits = 0;
+	for (int i = 0; i < 10000; i++)
+	{
+		glm::vec3 origin = glm::normalize(glm::vec3(uniform(rng), uniform(rng), uniform(rng))) * 20.0f;
+		glm::vec3 direction = glm::normalize(glm::vec3(uniform(rng), uniform(rng), uniform(rng)) * 3.0f - origin);
+		float t0, t1;
+		if (cylinder.GetBoundingBox().Intersect(origin, direction, t0, t1)) userBoxHits++;
+		if (cylinder.GetBounds().Intersect(origin, direction, t0, t1)) tightHits++;
+	}
+	std::cout << "  Cylinder rays reaching the solve: " << userBoxHits << " (user box) -> "
+	          << tightHits << " (tight bounds) of 10000" << std::endl;
+}
+
+void TestOcclusion()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 12: Occlusion Queries" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	const char* presets[] = {
+		"sphere", "ellipsoid", "cylinder", "cone", 
+		"paraboloid", "saddle", "hyperboloid1", "hyperboloid2"
+	};
+	
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> segment(0.5f, 25.0f);
+	
+	struct ShadowRay { glm::vec3 Origin, Direction; float TMax; };
+	std::vector<ShadowRay> rays;
+	for (int i = 0; i < 5000; i++)
+	{
+		glm::vec3 origin = glm::vec3(uniform(rng), uniform(rng), uniform(rng)) * 12.0f;
+		glm::vec3 direction = glm::normalize(glm::vec3(uniform(rng), uniform(rng), uniform(rng)));
+		rays.push_back({ origin, direction, segment(rng) });
+	}
+	
+	int blocked = 0;
+	for (const char* preset : presets)
+	{
+		QuadricSurface surface = GetPresetQuadric(preset);
+		
+		// Any-hit must agree with closest-hit over the same segment
+		int mismatches = 0;
+		for (const ShadowRay& ray : rays)
+		{
+			bool expected = surface.Intersect(ray.Origin, ray.Direction, 0.001f, ray.TMax).Hit;
+			if (surface.Occluded(ray.Origin, ray.Direction, ray.TMax) != expected)
+				mismatches++;
+		}
+		
+		std::cout << (mismatches == 0 ? "✓ " : "✗ ") << preset;
+		if (mismatches > 0)
+			std::cout << ": " << mismatches << " rays disagree with Intersect";
+		std::cout << std::endl;
+	}
+	
+	// Instances forward the query in object space
+	QuadricSurface sphere = QuadricSurface::CreateSphere(1.0f);
+	QuadricInstance instance(sphere, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+	bool shortBlocked = instance.Occluded(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 3.0f);
+	bool longBlocked = instance.Occluded(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 10.0f);
+	std::cout << (!shortBlocked && longBlocked ? "✓ " : "✗ ")
+	          << "Instance: segment stops short of the sphere, longer segment is blocked" << std::endl;
+	
+	// Timing (informational). For one surface an any-hit test saves at most
+	// the normal of a hit, which measured nothing; the gain is in a scene,
+	// where a shadow ray may stop at the first blocker but a closest-hit
+	// query has to test everything. Rays run from a floor through a cloud
+	// of spheres to a light above.
+	std::vector<QuadricInstance> cloud;
+	for (int i = 0; i < 64; i++)
+	{
+		glm::vec3 center(uniform(rng) * 4.0f, 4.0f + uniform(rng) * 3.0f, uniform(rng) * 4.0f);
+		cloud.emplace_back(sphere, glm::translate(glm::mat4(1.0f), center) *
+		                           glm::scale(glm::mat4(1.0f), glm::vec3(0.6f)));
+	}
+	
+	std::vector<ShadowRay> shadowRays;
+	for (int i = 0; i < 5000; i++)
+	{
+		glm::vec3 origin(uniform(rng) * 5.0f, 0.0f, uniform(rng) * 5.0f);
+		glm::vec3 light(uniform(rng), 10.0f, uniform(rng));
+		shadowRays.push_back({ origin, glm::normalize(light - origin), glm::length(light - origin) });
+	}
+	
+	auto closestBlocked = [&cloud](const ShadowRay& ray)
+	{
+		float tNearest = ray.TMax;
+		bool hit = false;
+		for (const QuadricInstance& member : cloud)
+		{
+			IntersectionResult result = member.Intersect(ray.Origin, ray.Direction, 0.001f, tNearest);
+			if (result.Hit)
+			{
+				tNearest = result.Distance;
+				hit = true;
+			}
+		}
+		return hit;
+	};
+	auto anyBlocked = [&cloud](const ShadowRay& ray)
+	{
+		for (const QuadricInstance& member : cloud)
+			if (member.Occluded(ray.Origin, ray.Direction, ray.TMax))
+				return true;
+		return false;
+	};
+	
+	int sceneMismatches = 0;
+	int sceneBlocked = 0;
+	for (const ShadowRay& ray : shadowRays)
+	{
+		bool expected = closestBlocked(ray);
+		sceneMismatches += anyBlocked(ray) != expected;
+		sceneBlocked += expected;
+	}
+	std::cout << (sceneMismatches == 0 ? "✓ " : "✗ ") << "Scene: any-hit agrees with closest-hit ("
+	          << sceneBlocked << " of " << shadowRays.size() << " rays blocked)" << std::endl;
+	
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < 5; r++)
+		for (const ShadowRay& ray : shadowRays)
+			blocked += closestBlocked(ray);
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < 5; r++)
+		for (const ShadowRay& ray : shadowRays)
+			blocked -= anyBlocked(ray);
+	auto end = std::chrono::high_resolution_clock::now();
+	double sceneClosestMs = std::chrono::duration<double, std::milli>(middle - start).count();
+	double sceneAnyMs = std::chrono::duration<double, std::milli>(end - middle).count();
+	
+	std::cout << std::fixed << std::setprecision(2)
+	          << "  64-sphere scene - Closest hit: " << sceneClosestMs << " ms | Any hit: " << sceneAnyMs << " ms"
+	          << " | Speedup: " << sceneClosestMs / sceneAnyMs << "x" << std::endl;
+	std::cout << "  (checksum " << blocked << ")" << std::endl;
+}
+
+void TestCSG()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 13: CSG Solids" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	auto check = [](const char* name, const IntersectionResult& hit, float distance, const glm::vec3& normal)
+	{
+		bool ok = hit.Hit && std::abs(hit.Distance - distance) < 1e-3f &&
+		          glm::length(hit.Normal - normal) < 1e-3f;
+		std::cout << (ok ? "✓ " : "✗ ") << name;
+		if (hit.Hit)
+			std::cout << " (t = " << std::setprecision(3) << hit.Distance << ")";
+		std::cout << std::endl;
+	};
+	auto checkMiss = [](const char* name, const IntersectionResult& hit)
+	{
+		std::cout << (!hit.Hit ? "✓ " : "✗ ") << name << std::endl;
+	};
+	
+	// Capped cylinder: r = 1, z ∈ [-1, 1]
+	QuadricCSG cylinder = QuadricCSG::CreateCappedCylinder(1.0f, 2.0f);
+	check("Capped cylinder: cap from above", cylinder.Intersect(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1)), 4.0f, glm::vec3(0, 0, 1));
+	check("Capped cylinder: side", cylinder.Intersect(glm::vec3(5, 0, 0), glm::vec3(-1, 0, 0)), 4.0f, glm::vec3(1, 0, 0));
+	check("Capped cylinder: exit from inside", cylinder.Intersect(glm::vec3(0), glm::vec3(1, 0, 0)), 1.0f, glm::vec3(-1, 0, 0));
+	checkMiss("Capped cylinder: passes above the cap", cylinder.Intersect(glm::vec3(5, 0, 1.5f), glm::vec3(-1, 0, 0)));
+	
+	// Lens: two r = 2 spheres, 1 deep, rim radius sqrt(4 - 1.5²) ≈ 1.32
+	QuadricCSG lens = QuadricCSG::CreateLens(2.0f, 1.0f);
+	check("Lens: front face on axis", lens.Intersect(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1)), 4.5f, glm::vec3(0, 0, 1));
+	checkMiss("Lens: outside the rim", lens.Intersect(glm::vec3(1.4f, 0, 5), glm::vec3(0, 0, -1)));
+	
+	// Frustum: 45° cone clipped to z ∈ [1, 2]
+	QuadricCSG cone = QuadricCSG::CreateClippedCone(0.785398f, 1.0f, 2.0f);
+	check("Clipped cone: top cap", cone.Intersect(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1)), 3.0f, glm::vec3(0, 0, 1));
+	check("Clipped cone: bottom cap", cone.Intersect(glm::vec3(0, 0, -5), glm::vec3(0, 0, 1)), 6.0f, glm::vec3(0, 0, -1));
+	check("Clipped cone: side", cone.Intersect(glm::vec3(5, 0, 1.5f), glm::vec3(-1, 0, 0)), 3.5f, glm::normalize(glm::vec3(1, 0, -1)));
+	
+	// Hollow shell: r = 2 sphere minus r = 1 sphere
+	QuadricCSG shell;
+	int outer = shell.AddLeaf(QuadricSurface::CreateSphere(2.0f));
+	int inner = shell.AddLeaf(QuadricSurface::CreateSphere(1.0f));
+	shell.AddDifference(outer, inner);
+	check("Shell: outer surface", shell.Intersect(glm::vec3(5, 0, 0), glm::vec3(-1, 0, 0)), 3.0f, glm::vec3(1, 0, 0));
+	check("Shell: inner surface from the hole", shell.Intersect(glm::vec3(0), glm::vec3(1, 0, 0)), 1.0f, glm::vec3(-1, 0, 0));
+	
+	// Random rays: every hit must separate outside from inside, and the
+	// any-hit query must agree with Intersect
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+	const QuadricCSG* solids[] = { &cylinder, &lens, &cone, &shell };
+	const char* names[] = { "capped cylinder", "lens", "clipped cone", "shell" };
+	for (int s = 0; s < 4; s++)
+	{
+		int hits = 0, bad = 0, occlusionMismatches = 0;
+		for (int i = 0; i < 5000; i++)
+		{
+			glm::vec3 origin = glm::vec3(uniform(rng), uniform(rng), uniform(rng)) * 4.0f;
+			glm::vec3 direction = glm::normalize(glm::vec3(uniform(rng), uniform(rng), uniform(rng)));
+			
+			IntersectionResult hit = solids[s]->Intersect(origin, direction);
+			if (solids[s]->Occluded(origin, direction, 1000.0f) != hit.Hit)
+				occlusionMismatches++;
+			if (!hit.Hit)
+				continue;
+			
+			hits++;
+			bool before = solids[s]->Contains(hit.Point - direction * 1e-3f);
+			bool after = solids[s]->Contains(hit.Point + direction * 1e-3f);
+			if (before == after)
+				bad++;
+		}
+		
+		// Allow a few grazing hits along edges and tangents
+		bool ok = bad <= hits / 500 && occlusionMismatches == 0;
+		std::cout << (ok ? "✓ " : "✗ ") << "Random rays vs " << names[s] << ": " << hits << " hits, "
+		          << bad << " not on the boundary, " << occlusionMismatches << " any-hit mismatches" << std::endl;
+	}
+	
+	std::cout << "  Capped cylinder: " << cylinder.GetLeafCount() << " quadrics (a tessellated cylinder needs dozens of triangles)" << std::endl;
+}
+
+void TestBVH()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 14: BVH over Thousands of Quadrics" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	// A procedural field of spheres and clipped cylinders sharing two shapes
+	QuadricSurface sphere = QuadricSurface::CreateSphere(1.0f);
+	QuadricSurface cylinder = QuadricSurface::CreateCylinder(0.5f, 2.0f);
+	
+	std::mt19937 rng(2024);
+	std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> size(0.2f, 0.6f);
+	
+	const int numInstances = 4000;
+	std::vector<QuadricInstance> instances;
+	std::vector<BoundingBox> bounds;
+	instances.reserve(numInstances);
+	for (int i = 0; i < numInstances; i++)
+	{
+		glm::vec3 position(uniform(rng) * 50.0f, uniform(rng) * 5.0f, uniform(rng) * 50.0f);
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+		transform = glm::rotate(transform, uniform(rng) * 3.14159f, glm::normalize(glm::vec3(uniform(rng), 1.0f, uniform(rng))));
+		transform = glm::scale(transform, glm::vec3(size(rng)));
+		
+		instances.emplace_back(i % 2 == 0 ? sphere : cylinder, transform);
+		bounds.push_back(instances.back().GetBounds());
+	}
+	
+	auto buildStart = std::chrono::high_resolution_clock::now();
+	QuadricBVH bvh;
+	bvh.Build(bounds);
+	auto buildEnd = std::chrono::high_resolution_clock::now();
+	
+	std::cout << "Instances: " << numInstances << " | Nodes: " << bvh.GetNodes().size()
+	          << " | Depth: " << bvh.GetDepth() << std::endl;
+	
+	// Every primitive appears in exactly one leaf
+	std::vector<int> seen(numInstances, 0);
+	for (const BVHNode& node : bvh.GetNodes())
+		for (int i = node.LeftOrFirst; node.IsLeaf() && i < node.LeftOrFirst + node.Count; i++)
+			seen[bvh.GetPrimitiveIndices()[i]]++;
+	bool covered = std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; });
+	std::cout << (covered && bvh.GetDepth() <= QuadricBVH::MAX_DEPTH ? "✓ " : "✗ ")
+	          << "Each instance is in one leaf, depth within the traversal stack" << std::endl;
+	
+	// Rays into the field from above and from the sides
+	const int numRays = 2000;
+	std::vector<glm::vec3> origins(numRays), directions(numRays);
+	for (int i = 0; i < numRays; i++)
+	{
+		origins[i] = glm::vec3(uniform(rng) * 60.0f, 10.0f + uniform(rng) * 5.0f, uniform(rng) * 60.0f);
+		glm::vec3 target(uniform(rng) * 50.0f, uniform(rng) * 5.0f, uniform(rng) * 50.0f);
+		directions[i] = glm::normalize(target - origins[i]);
+	}
+	
+	auto bruteForce = [&](int ray, float tMax)
+	{
+		BVHIntersectionResult nearest;
+		for (int j = 0; j < numInstances; j++)
+		{
+			IntersectionResult r = instances[j].Intersect(origins[ray], directions[ray], 0.001f, tMax);
+			if (r.Hit && r.Distance < tMax)
+			{
+				static_cast<IntersectionResult&>(nearest) = r;
+				nearest.Index = j;
+				tMax = r.Distance;
+			}
+		}
+		return nearest;
+	};
+	
+	int hits = 0, mismatches = 0, occlusionMismatches = 0;
+	for (int i = 0; i < numRays; i++)
+	{
+		BVHIntersectionResult expected = bruteForce(i, 1000.0f);
+		BVHIntersectionResult actual = bvh.IntersectNearest(instances, origins[i], directions[i]);
+		if (expected.Hit) hits++;
+		
+		float tolerance = 1e-4f * std::max(1.0f, expected.Distance);
+		if (expected.Hit != actual.Hit || (expected.Hit && std::abs(expected.Distance - actual.Distance) > tolerance))
+			mismatches++;
+		
+		// Shadow segment that ends halfway to the nearest hit must be clear
+		float tMax = expected.Hit ? expected.Distance * 0.5f : 1000.0f;
+		if (bvh.Occluded(instances, origins[i], directions[i], tMax) ||
+		    bvh.Occluded(instances, origins[i], directions[i], 1000.0f) != expected.Hit)
+			occlusionMismatches++;
+	}
+	
+	std::cout << "Rays: " << numRays << " | Hits: " << hits << std::endl;
+	std::cout << (mismatches == 0 ? "✓ " : "✗ ") << "BVH nearest hit matches brute force";
+	if (mismatches > 0)
+		std::cout << " (" << mismatches << " rays differ)";
+	std::cout << std::endl;
+	std::cout << (occlusionMismatches == 0 ? "✓ " : "✗ ") << "BVH any-hit matches brute force";
+	if (occlusionMismatches > 0)
+		std::cout << " (" << occlusionMismatches << " rays differ)";
+	std::cout << std::endl;
+	
+	// Timing (informational)
+	auto start = std::chrono::high_resolution_clock::now();
+	float checksum = 0.0f;
+	for (int i = 0; i < numRays; i++)
+	{
+		BVHIntersectionResult r = bruteForce(i, 1000.0f);
+		checksum += r.Hit ? r.Distance : 0.0f;
+	}
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < numRays; i++)
+	{
+		BVHIntersectionResult r = bvh.IntersectNearest(instances, origins[i], directions[i]);
+		checksum -= r.Hit ? r.Distance : 0.0f;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	
+	double buildMs = std::chrono::duration<double, std::milli>(buildEnd - buildStart).count();
+	double bruteMs = std::chrono::duration<double, std::milli>(middle - start).count();
+	double bvhMs = std::chrono::duration<double, std::milli>(end - middle).count();
+	std::cout << std::fixed << std::setprecision(2)
+	          << "  Build: " << buildMs << " ms | Brute force: " << bruteMs << " ms | BVH: " << bvhMs << " ms"
+	          << " | Speedup: " << bruteMs / bvhMs << "x" << std::endl;
+	std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+void TestSlabs()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 15: Division-Free Slab Tests" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	const BoundingBox box(glm::vec3(-1.0f, -2.0f, -0.5f), glm::vec3(1.0f, 2.0f, 0.5f));
+	const float infinity = std::numeric_limits<float>::infinity();
+	
+	// Zero direction components: parallel rays are inside or outside a slab
+	// for all t, rays lying in a face plane count as inside
+	struct EdgeCase
+	{
+		const char* Name;
+		glm::vec3 Origin;
+		glm::vec3 Direction;
+		bool Expected;
+	};
+	const EdgeCase edgeCases[] = {
+		{ "parallel, inside slab",       glm::vec3(0.0f, 0.0f, 5.0f),  glm::vec3(0.0f, 0.0f, -1.0f),  true },
+		{ "parallel, outside slab",      glm::vec3(3.0f, 0.0f, 5.0f),  glm::vec3(0.0f, 0.0f, -1.0f),  false },
+		{ "in face plane x = min",       glm::vec3(-1.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f),  true },
+		{ "in face plane y = max",       glm::vec3(0.0f, 2.0f, 5.0f),  glm::vec3(0.0f, 0.0f, -1.0f),  true },
+		{ "negative zero component",     glm::vec3(0.0f, 0.0f, 5.0f),  glm::vec3(-0.0f, -0.0f, -1.0f), true },
+		{ "along an edge",               glm::vec3(-1.0f, 2.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f),  true },
+		{ "pointing away",               glm::vec3(0.0f, 0.0f, 5.0f),  glm::vec3(0.0f, 0.0f, 1.0f),   false },
+	};
+	
+	RayPacket<8> packet;
+	packet.Origin = glm::vec3(0.0f, 0.0f, 5.0f);
+	int packetExpected = 0;
+	int lane = 0;
+	for (const EdgeCase& edge : edgeCases)
+	{
+		float tNear, tFar;
+		bool hit = box.Intersect(Ray(edge.Origin, edge.Direction), tNear, tFar);
+		bool finite = !hit || (std::isfinite(tNear) && std::isfinite(tFar));
+		std::cout << (hit == edge.Expected && finite ? "  ✓ " : "  ✗ ") << edge.Name << ": "
+		          << (hit ? "hit" : "miss") << std::endl;
+		
+		// Same rays (those starting at the packet origin) through the SIMD path
+		if (edge.Origin == packet.Origin)
+		{
+			packet.SetDirection(lane, edge.Direction);
+			packetExpected |= (edge.Expected ? 1 : 0) << lane;
+			lane++;
+		}
+	}
+	for (; lane < 8; lane++)
+	{
+		// Padding lanes point at the box
+		packet.SetDirection(lane, glm::vec3(0.0f, 0.0f, -1.0f));
+		packetExpected |= 1 << lane;
+	}
+	
+	float packetNear[8], packetFar[8];
+	int packetMask = (int)box.IntersectPacket(packet, packetNear, packetFar);
+	std::cout << (packetMask == packetExpected ? "  ✓ " : "  ✗ ") << "Packet edge cases: mask 0x" << std::hex
+	          << packetMask << " (expected 0x" << packetExpected << ")" << std::dec << std::endl;
+	
+	// Random rays: same answer as the divide-and-sort slab test in double
+	std::mt19937 rng(17);
+	std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+	const int numRays = 200000;
+	std::vector<Ray> rays;
+	rays.reserve(numRays);
+	for (int i = 0; i < numRays; i++)
+	{
+		glm::vec3 origin = glm::vec3(uniform(rng), uniform(rng), uniform(rng)) * 4.0f;
+		glm::vec3 direction = glm::normalize(glm::vec3(uniform(rng), uniform(rng), uniform(rng)));
+		rays.emplace_back(origin, direction);
+	}
+	
+	int mismatches = 0, hits = 0;
+	for (const Ray& ray : rays)
+	{
+		double tNear = -infinity, tFar = infinity;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double t0 = (double(box.Min[axis]) - ray.Origin[axis]) / ray.Direction[axis];
+			double t1 = (double(box.Max[axis]) - ray.Origin[axis]) / ray.Direction[axis];
+			tNear = std::max(tNear, std::min(t0, t1));
+			tFar = std::min(tFar, std::max(t0, t1));
+		}
+		bool expected = tFar >= tNear && tFar >= 0.0;
+		
+		float near, far;
+		bool hit = box.Intersect(ray, near, far);
+		if (hit) hits++;
+		
+		// Grazing rays may flip either way within rounding
+		bool grazing = std::abs(tFar - tNear) < 1e-4 || std::abs(tFar) < 1e-4;
+		if (hit != expected && !grazing)
+			mismatches++;
+		else if (hit && expected && (std::abs(near - tNear) > 1e-4 * (1.0 + std::abs(tNear)) ||
+		                             std::abs(far - tFar) > 1e-4 * (1.0 + std::abs(tFar))))
+			mismatches++;
+	}
+	std::cout << (mismatches == 0 ? "  ✓ " : "  ✗ ") << "Random rays: " << hits << " hits, "
+	          << mismatches << " mismatches vs double-precision reference" << std::endl;
+	
+	// Cost per test on a cache-resident set: reciprocals computed per call
+	// vs once per ray
+	const int timedRays = 4096, repeats = 500;
+	int sink = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		for (int i = 0; i < timedRays; i++)
+		{
+			float t0, t1;
+			sink += box.Intersect(rays[i].Origin, rays[i].Direction, t0, t1) ? 1 : 0;
+		}
+	}
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		for (int i = 0; i < timedRays; i++)
+		{
+			float t0, t1;
+			sink += box.Intersect(rays[i], t0, t1) ? 1 : 0;
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	double perRay = std::chrono::duration<double, std::nano>(middle - start).count() / (double(repeats) * timedRays);
+	double perPrepared = std::chrono::duration<double, std::nano>(end - middle).count() / (double(repeats) * timedRays);
+	std::cout << std::fixed << std::setprecision(2) << "  Box test: " << perRay << " ns (origin/direction) vs "
+	          << perPrepared << " ns (prepared Ray)  [" << sink << "]" << std::endl;
+}
+
+// Compile-time checks that every constexpr operation stays usable in
+// constant expressions (values are exact in float)
+namespace Vec3Checks
+{
+	constexpr bool equal(const Vec3& a, const Vec3& b)
+	{
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+	
+	constexpr Vec3 compoundOps()
+	{
+		Vec3 v(1.0f, 2.0f, 3.0f);
+		v += Vec3(1.0f, 1.0f, 1.0f);
+		v -= Vec3(0.0f, 1.0f, 2.0f);
+		v *= 4.0f;
+		v /= 2.0f;
+		v[2] = 5.0f;
+		return v;
+	}
+	
+	constexpr Vec3 A(1.0f, 2.0f, 3.0f);
+	constexpr Vec3 B(4.0f, -5.0f, 6.0f);
+	
+	static_assert(equal(Vec3(), Vec3(0.0f, 0.0f, 0.0f)), "Vec3 default constructor");
+	static_assert(equal(A + B, Vec3(5.0f, -3.0f, 9.0f)), "Vec3 operator+");
+	static_assert(equal(A - B, Vec3(-3.0f, 7.0f, -3.0f)), "Vec3 operator-");
+	static_assert(equal(A * 2.0f, Vec3(2.0f, 4.0f, 6.0f)), "Vec3 operator*");
+	static_assert(equal(2.0f * A, Vec3(2.0f, 4.0f, 6.0f)), "scalar * Vec3");
+	static_assert(equal(A / 2.0f, Vec3(0.5f, 1.0f, 1.5f)), "Vec3 operator/");
+	static_assert(equal(-A, Vec3(-1.0f, -2.0f, -3.0f)), "Vec3 unary operator-");
+	static_assert(equal(compoundOps(), Vec3(4.0f, 4.0f, 5.0f)), "Vec3 compound assignment and operator[]");
+	static_assert(A.dot(B) == 12.0f, "Vec3::dot");
+	static_assert(equal(A.cross(B), Vec3(27.0f, 6.0f, -13.0f)), "Vec3::cross");
+	static_assert(A.cross(B).dot(A) == 0.0f && A.cross(B).dot(B) == 0.0f, "Vec3::cross is orthogonal");
+	static_assert(A.lengthSquared() == 14.0f, "Vec3::lengthSquared");
+	static_assert(A[0] == 1.0f && A[1] == 2.0f && A[2] == 3.0f, "Vec3::operator[]");
+} // namespace Vec3Checks
+
+static_assert(Vec3Lanes<float>::WIDTH == 1 && Vec3x4::WIDTH == 4 && Vec3x8::WIDTH == 8,
+              "One Vec3 per float lane");
+static_assert(Vec3xN::WIDTH == Simd::NATIVE_WIDTH, "Vec3xN spans the native width");
+
+// Largest difference between lane i of v and the scalar Vec3 s, relative
+// to the size of s
+template <typename F>
+float LaneError(const Vec3Lanes<F>& v, int i, const Vec3& s)
+{
+	Vec3 l = v.lane(i);
+	float scale = 1.0f + std::max({ std::abs(s.x), std::abs(s.y), std::abs(s.z) });
+	return std::max({ std::abs(l.x - s.x), std::abs(l.y - s.y), std::abs(l.z - s.z) }) / scale;
+}
+
+template <typename F>
+float LaneError(F v, int i, float s)
+{
+	float lanes[Vec3Lanes<F>::WIDTH];
+	v.store(lanes);
+	return std::abs(lanes[i] - s) / (1.0f + std::abs(s));
+}
+
+// Every Vec3Lanes<F> operation against scalar Vec3 on random vectors;
+// returns the largest relative error seen
+template <typename F>
+float CompareVec3Lanes(std::mt19937& rng, int rounds)
+{
+	constexpr int W = Vec3Lanes<F>::WIDTH;
+	std::uniform_real_distribution<float> uniform(-4.0f, 4.0f);
+	std::uniform_real_distribution<float> positive(0.5f, 2.0f);
+	float maxError = 0.0f;
+	
+	for (int round = 0; round < rounds; round++)
+	{
+		float ax[W], ay[W], az[W], bx[W], by[W], bz[W], ts[W];
+		Vec3 a[W], b[W];
+		for (int i = 0; i < W; i++)
+		{
+			a[i] = Vec3(uniform(rng), uniform(rng), uniform(rng));
+			b[i] = Vec3(uniform(rng), uniform(rng), uniform(rng));
+			ts[i] = positive(rng);
+		}
+		
+		// Zero-length lanes must come back unchanged from normalized()
+		if (round == 0)
+			a[W - 1] = Vec3();
+		
+		for (int i = 0; i < W; i++)
+		{
+			ax[i] = a[i].x; ay[i] = a[i].y; az[i] = a[i].z;
+			bx[i] = b[i].x; by[i] = b[i].y; bz[i] = b[i].z;
+		}
+		
+		Vec3Lanes<F> va = Vec3Lanes<F>::load(ax, ay, az);
+		Vec3Lanes<F> vb = Vec3Lanes<F>::load(bx, by, bz);
+		F t = F::load(ts);
+		
+		Vec3Lanes<F> sum = va + vb, difference = va - vb, scaled = va * t, leftScaled = t * va;
+		Vec3Lanes<F> divided = va / t, negated = -va, crossed = va.cross(vb), unit = va.normalized();
+		Vec3Lanes<F> picked = Simd::select(va.x > vb.x, va, vb);
+		Vec3Lanes<F> compound = va;
+		compound += vb;
+		compound -= vb * t;
+		compound *= t;
+		F dotted = va.dot(vb), lengths = va.length();
+		
+		Vec3Lanes<F> broadcast = Vec3Lanes<F>::broadcast(b[0]);
+		float sx[W], sy[W], sz[W];
+		va.store(sx, sy, sz);
+		
+		for (int i = 0; i < W; i++)
+		{
+			float errors[] = {
+				LaneError(sum, i, a[i] + b[i]),
+				LaneError(difference, i, a[i] - b[i]),
+				LaneError(scaled, i, a[i] * ts[i]),
+				LaneError(leftScaled, i, ts[i] * a[i]),
+				LaneError(divided, i, a[i] / ts[i]),
+				LaneError(negated, i, -a[i]),
+				LaneError(crossed, i, a[i].cross(b[i])),
+				LaneError(unit, i, a[i].normalized()),
+				LaneError(picked, i, a[i].x > b[i].x ? a[i] : b[i]),
+				LaneError(compound, i, (a[i] + b[i] - b[i] * ts[i]) * ts[i]),
+				LaneError(dotted, i, a[i].dot(b[i])),
+				LaneError(lengths, i, a[i].length()),
+				LaneError(broadcast, i, b[0]),
+				LaneError(va, i, Vec3(sx[i], sy[i], sz[i]))
+			};
+			for (float error : errors)
+				maxError = std::max(maxError, std::isnan(error) ? 1.0f : error);
+		}
+	}
+	return maxError;
+}
+
+void TestVec3Lanes()
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << "TEST 16: Vec3x4 / Vec3x8 Lanes vs Scalar Vec3" << std::endl;
+	std::cout << "========================================" << std::endl;
+	
+	// Float8 is native with AVX2 and two Float4 halves otherwise; both
+	// must agree with scalar Vec3 up to rounding. With FMA the fused dot
+	// products (and the normalizations built on them) reach about 1.1e-6.
+	std::mt19937 rng(16);
+	const float tolerance = 2e-6f;
+	
+	float error4 = CompareVec3Lanes<Simd::Float4>(rng, 2000);
+	float error8 = CompareVec3Lanes<Simd::Float8>(rng, 1000);
+	
+	std::cout << std::scientific << std::setprecision(2);
+	std::cout << (error4 <= tolerance ? "  ✓ " : "  ✗ ") << "Vec3x4 matches Vec3 (max relative error "
+	          << error4 << ")" << std::endl;
+	std::cout << (error8 <= tolerance ? "  ✓ " : "  ✗ ") << "Vec3x8 matches Vec3 (max relative error "
+	          << error8 << ")" << std::endl;
+	std::cout << std::defaultfloat;
+}
+
 int main()
 {
 	std::cout << "╔════════════════════════════════════════╗" << std::endl;
@@ -293,6 +1306,15 @@ int main()
 	TestCone();
 	TestParaboloid();
 	TestAllPresets();
+	TestQuadricBatch();
+	TestRayPackets();
+	TestInstances();
+	TestTightBounds();
+	TestOcclusion();
+	TestCSG();
+	TestBVH();
+	TestSlabs();
+	TestVec3Lanes();
 	TestUserInput();
 	
 	std::cout << "\n========================================" << std::endl;
@@ -12,10 +12,11 @@ if [ ! -d "../../../vendor" ]; then
     echo "⚠ Warning: vendor directory not found"
 fi
 
+# Pass EXTRA_FLAGS="-mavx2 -mfma" to test the 8-wide batch kernel
 echo "→ Compiling Quadric Test..."
-g++ -std=c++17 -Wall \
+g++ -std=c++17 -O2 -Wall $EXTRA_FLAGS \
     -I../../.. \
-    QuadricTest.cpp Quadric.cpp \
+    QuadricTest.cpp Quadric.cpp QuadricBatch.cpp QuadricInstance.cpp QuadricCSG.cpp QuadricBVH.cpp \
     -o quadric_test -lm
 
 if [ $? -eq 0 ]; then
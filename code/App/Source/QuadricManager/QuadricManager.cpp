@@ -1,21 +1,36 @@
 #include "QuadricManager.h"
+#include "Quadric/Quadric.h"
+#include "Quadric/QuadricCSG.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <random>
 #include <string>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <imgui.h>
 
 // ============================================================================
-// CONSTRUCTOR
+// DESTRUCTOR
 // ============================================================================
-QuadricManager::QuadricManager()
+QuadricManager::~QuadricManager()
 {
-	// Zero-initialize all quadrics
-	for (int i = 0; i < MAX_QUADRICS; i++)
-	{
-		m_Quadrics[i] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-		                 glm::vec3(0.0f), glm::vec3(0.0f), 0};
-	}
+	if (m_QuadricTexture) glDeleteTextures(1, &m_QuadricTexture);
+	if (m_BVHTexture) glDeleteTextures(1, &m_BVHTexture);
+}
+
+// ============================================================================
+// INSTANCE TRANSFORM
+// ============================================================================
+glm::mat4 SceneQuadric::GetTransform() const
+{
+	glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+	transform = glm::rotate(transform, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+	transform = glm::rotate(transform, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+	transform = glm::rotate(transform, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+	return glm::scale(transform, scale);
 }
 
 // ============================================================================
@@ -23,28 +38,27 @@ QuadricManager::QuadricManager()
 // ============================================================================
 void QuadricManager::InitializeDefaults()
 {
+	m_Quadrics.assign(2, SceneQuadric{});
+	m_SelectedQuadric = 0;
+	m_GPUDataDirty = true;
+	
 	// Esfera teste usando quádrica (x² + y² + z² = r²)
 	// Posição: lado direito, material dourado
-	// Centro em (2.0, -2.0, 0.0), raio 0.6
-	// Transladar: substituir x→(x-2), y→(y+2), z→z
-	// (x-2)² + (y+2)² + z² = 0.36
-	// x² - 4x + 4 + y² + 4y + 4 + z² = 0.36
-	// x² + y² + z² - 4x + 4y + 7.64 = 0
-	m_Quadrics[0] = {1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, -4.0f, 4.0f, 0.0f, 7.64f,
-	                 glm::vec3(1.4f, -2.6f, -0.6f), glm::vec3(2.6f, -1.4f, 0.6f), 4};
+	// Esfera canônica de raio 0.6, centrada na origem:
+	// x² + y² + z² - 0.36 = 0
+	// A transformação a move para (2.0, -2.0, 0.0)
+	m_Quadrics[0] = {1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -0.36f,
+	                 glm::vec3(-0.6f), glm::vec3(0.6f), 4};
+	m_Quadrics[0].position = glm::vec3(2.0f, -2.0f, 0.0f);
 	
 	// Elipsoide - Esquerda atrás (x²/a² + y²/b² + z²/c² = 1)
-	// a=0.5, b=0.8, c=0.4, centro em (-2.0, -2.0, -2.0)
+	// a=0.5, b=0.8, c=0.4, centrado na origem
 	// Expandir: x²/0.25 + y²/0.64 + z²/0.16 = 1
-	// Multiplicar por 0.16: 0.64x² + 0.25y² + z² = 0.16
-	// Transladar (x→x+2, y→y+2, z→z+2):
-	// 0.64(x+2)² + 0.25(y+2)² + (z+2)² = 0.16
-	// 0.64x² + 2.56x + 2.56 + 0.25y² + y + 1 + z² + 4z + 4 = 0.16
-	// 0.64x² + 0.25y² + z² + 2.56x + y + 4z + 7.4 = 0
-	m_Quadrics[1] = {0.64f, 0.25f, 1.0f, 0.0f, 0.0f, 0.0f, 2.56f, 1.0f, 4.0f, 7.4f,
-	                 glm::vec3(-2.5f, -2.8f, -2.4f), glm::vec3(-1.5f, -1.2f, -1.6f), 8};
-	
-	m_NumQuadrics = 2;
+	// Multiplicar por 0.16: 0.64x² + 0.25y² + z² - 0.16 = 0
+	// A transformação a move para (-2.0, -2.0, -2.0)
+	m_Quadrics[1] = {0.64f, 0.25f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -0.16f,
+	                 glm::vec3(-0.5f, -0.8f, -0.4f), glm::vec3(0.5f, 0.8f, 0.4f), 8};
+	m_Quadrics[1].position = glm::vec3(-2.0f, -2.0f, -2.0f);
 	
 	std::cout << "\n========================================" << std::endl;
 	std::cout << "QUADRICS LOADED:" << std::endl;
@@ -54,6 +68,52 @@ void QuadricManager::InitializeDefaults()
 	std::cout << "========================================\n" << std::endl;
 }
 
+// ============================================================================
+// PROCEDURAL FIELD
+// ============================================================================
+void QuadricManager::GenerateProceduralField(int count, unsigned int seed)
+{
+	count = glm::clamp(count, 1, MAX_QUADRICS);
+	
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+	std::uniform_int_distribution<int> material(0, 9);
+	
+	// Canonical unit shapes; size, placement and orientation come from the
+	// instance transform only
+	const SceneQuadric sphere = {1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f,
+	                             glm::vec3(-1.0f), glm::vec3(1.0f), 0};
+	const SceneQuadric cylinder = {1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f,
+	                               glm::vec3(-1.0f), glm::vec3(1.0f), 0};
+	
+	m_Quadrics.clear();
+	m_Quadrics.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		SceneQuadric q = (i % 2 == 0) ? sphere : cylinder;
+		q.materialIndex = material(rng);
+		q.position = glm::vec3(-3.3f + 6.6f * uniform(rng), -2.9f + 5.6f * uniform(rng), -3.8f + 4.8f * uniform(rng));
+		
+		if (i % 2 == 0)
+		{
+			q.scale = glm::vec3(0.04f + 0.08f * uniform(rng));
+		}
+		else
+		{
+			float radius = 0.02f + 0.04f * uniform(rng);
+			q.scale = glm::vec3(radius, radius, 0.1f + 0.15f * uniform(rng));
+			q.rotation = glm::vec3(360.0f * uniform(rng) - 180.0f, 360.0f * uniform(rng) - 180.0f, 0.0f);
+		}
+		
+		m_Quadrics.push_back(q);
+	}
+	
+	m_SelectedQuadric = 0;
+	m_GPUDataDirty = true;
+	
+	std::cout << "[QuadricManager] Generated field of " << count << " quadrics" << std::endl;
+}
+
 // ============================================================================
 // RENDER IMGUI EDITOR
 // ============================================================================
@@ -74,19 +134,21 @@ bool QuadricManager::RenderEditor()
 	// Quadric selector
 	ImGui::Text("Select Quadric:");
 	ImGui::PushItemWidth(100);
-	if (ImGui::InputInt("##quadric_index", &m_SelectedQuadric))
+	ImGui::InputInt("##quadric_index", &m_SelectedQuadric);
+	m_SelectedQuadric = glm::clamp(m_SelectedQuadric, 0, MAX_QUADRICS - 1);
+	if (m_SelectedQuadric >= GetNumQuadrics())
 	{
-		m_SelectedQuadric = glm::clamp(m_SelectedQuadric, 0, MAX_QUADRICS - 1);
-		if (m_SelectedQuadric >= m_NumQuadrics)
-			m_NumQuadrics = m_SelectedQuadric + 1;
+		// New slots start as all-zero quadrics, which never produce a root
+		m_Quadrics.resize(m_SelectedQuadric + 1, SceneQuadric{});
+		changed = true;
 	}
 	ImGui::PopItemWidth();
 	ImGui::SameLine();
-	ImGui::Text("(0-%d) | Active: %d", MAX_QUADRICS - 1, m_NumQuadrics);
+	ImGui::Text("(0-%d) | Active: %d", MAX_QUADRICS - 1, GetNumQuadrics());
 	
 	ImGui::Separator();
 	
-	Quadric& q = m_Quadrics[m_SelectedQuadric];
+	SceneQuadric& q = m_Quadrics[m_SelectedQuadric];
 	
 	// Quadratic coefficients
 	ImGui::Text("Quadratic Terms:");
@@ -127,7 +189,7 @@ bool QuadricManager::RenderEditor()
 	ImGui::Separator();
 	
 	// Bounding box
-	ImGui::Text("Bounding Box:");
+	ImGui::Text("Bounding Box (object space):");
 	ImGui::PushItemWidth(100);
 	changed |= ImGui::DragFloat3("Min", &q.bboxMin.x, 0.1f, -20.0f, 20.0f, "%.2f");
 	changed |= ImGui::DragFloat3("Max", &q.bboxMax.x, 0.1f, -20.0f, 20.0f, "%.2f");
@@ -135,6 +197,58 @@ bool QuadricManager::RenderEditor()
 	
 	ImGui::Separator();
 	
+	// Instance transform (coefficients stay in object space)
+	ImGui::Text("Transform:");
+	ImGui::PushItemWidth(200);
+	bool transformChanged = false;
+	transformChanged |= ImGui::DragFloat3("Position", &q.position.x, 0.05f, -20.0f, 20.0f, "%.2f");
+	transformChanged |= ImGui::DragFloat3("Rotation", &q.rotation.x, 1.0f, -180.0f, 180.0f, "%.1f°");
+	transformChanged |= ImGui::DragFloat3("Scale", &q.scale.x, 0.01f, 0.01f, 10.0f, "%.2f");
+	ImGui::PopItemWidth();
+	if (ImGui::Button("Reset Transform"))
+	{
+		q.position = glm::vec3(0.0f);
+		q.rotation = glm::vec3(0.0f);
+		q.scale = glm::vec3(1.0f);
+		transformChanged = true;
+	}
+	
+	// A CSG solid moves as one: copy the transform to the rest of its group
+	if (transformChanged && q.csgGroup >= 0)
+	{
+		for (SceneQuadric& member : m_Quadrics)
+		{
+			if (member.csgGroup != q.csgGroup)
+				continue;
+			member.position = q.position;
+			member.rotation = q.rotation;
+			member.scale = q.scale;
+		}
+	}
+	changed |= transformChanged;
+	
+	ImGui::Separator();
+	
+	// CSG group membership
+	ImGui::Text("CSG Group (-1 = none):");
+	ImGui::PushItemWidth(100);
+	if (ImGui::InputInt("##csg_group", &q.csgGroup))
+	{
+		q.csgGroup = glm::max(q.csgGroup, -1);
+		changed = true;
+	}
+	ImGui::PopItemWidth();
+	ImGui::SameLine();
+	if (ImGui::Button("Negate (subtract from group)"))
+	{
+		// f -> -f swaps inside and outside without moving the surface
+		for (float* c : { &q.A, &q.B, &q.C, &q.D, &q.E, &q.F, &q.G, &q.H, &q.I, &q.J })
+			*c = -*c;
+		changed = true;
+	}
+	
+	ImGui::Separator();
+	
 	// Material
 	ImGui::Text("Material:");
 	const char* materials[] = {
@@ -148,8 +262,12 @@ bool QuadricManager::RenderEditor()
 	
 	ImGui::Separator();
 	
-	// Presets
+	// Presets (replace the shape, keep the transform)
 	ImGui::Text("Quick Presets:");
+	glm::vec3 position = q.position;
+	glm::vec3 rotation = q.rotation;
+	glm::vec3 scale = q.scale;
+	int csgGroup = q.csgGroup;
 	
 	// BIG VISIBLE TEST SPHERE
 	if (ImGui::Button("TEST SPHERE (EMISSIVE)"))
@@ -200,67 +318,348 @@ bool QuadricManager::RenderEditor()
 		changed = true;
 	}
 	
+	q.position = position;
+	q.rotation = rotation;
+	q.scale = scale;
+	q.csgGroup = csgGroup;
+	
+	// CSG solids fill consecutive slots from the selected one
+	ImGui::Text("CSG Solids (from slot %d):", m_SelectedQuadric);
+	if (ImGui::Button("Capped Cylinder"))
+	{
+		changed |= LoadIntersectionGroup(m_SelectedQuadric, Quadric::QuadricCSG::CreateCappedCylinder(0.6f, 1.6f),
+		                                 glm::vec3(-0.7f, -0.7f, -0.9f), glm::vec3(0.7f, 0.7f, 0.9f), 3);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Lens"))
+	{
+		changed |= LoadIntersectionGroup(m_SelectedQuadric, Quadric::QuadricCSG::CreateLens(1.5f, 0.6f),
+		                                 glm::vec3(-1.0f, -1.0f, -0.4f), glm::vec3(1.0f, 1.0f, 0.4f), 6);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Clipped Cone"))
+	{
+		changed |= LoadIntersectionGroup(m_SelectedQuadric, Quadric::QuadricCSG::CreateClippedCone(0.5f, 0.5f, 1.5f),
+		                                 glm::vec3(-1.0f, -1.0f, 0.4f), glm::vec3(1.0f, 1.0f, 1.6f), 9);
+	}
+	
 	ImGui::Separator();
 	
 	// Copy equation
-	ImGui::Text("Equation:");
+	ImGui::Text("Equation (object space):");
+	// CSG solids may have grown the array, so look the slot up again
+	const SceneQuadric& shown = m_Quadrics[m_SelectedQuadric];
 	ImGui::TextWrapped("%.3fx² + %.3fy² + %.3fz² + %.3fxy + %.3fxz + %.3fyz + %.3fx + %.3fy + %.3fz + %.3f = 0",
-	                   q.A, q.B, q.C, q.D, q.E, q.F, q.G, q.H, q.I, q.J);
+	                   shown.A, shown.B, shown.C, shown.D, shown.E, shown.F, shown.G, shown.H, shown.I, shown.J);
+	
+	ImGui::Separator();
+	
+	// Large scenes: the BVH keeps thousands of quadrics interactive
+	ImGui::Text("Procedural Field:");
+	ImGui::PushItemWidth(200);
+	ImGui::SliderInt("##field_count", &m_FieldCount, 1, MAX_QUADRICS);
+	ImGui::PopItemWidth();
+	ImGui::SameLine();
+	if (ImGui::Button("Generate"))
+	{
+		GenerateProceduralField(m_FieldCount);
+		changed = true;
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Reset Defaults"))
+	{
+		InitializeDefaults();
+		changed = true;
+	}
+	if (!m_BVH.IsEmpty())
+		ImGui::Text("BVH: %d nodes, depth %d", static_cast<int>(m_BVH.GetNodes().size()), m_BVH.GetDepth());
 	
 	ImGui::End();
 
+	if (changed)
+		m_GPUDataDirty = true;
+
 	return changed;
 }
 
 // ============================================================================
 // UPLOAD QUADRICS TO SHADER
 // ============================================================================
-void QuadricManager::UploadToShader(GLuint shaderProgram) const
+void QuadricManager::UploadToShader(GLuint shaderProgram, const glm::vec3& cameraPosition)
+{
+	if (m_GPUDataDirty)
+		UploadToGPU();
+	
+	if (m_Quadrics.empty())
+	{
+		glUniform1i(glGetUniformLocation(shaderProgram, "uNumQuadrics"), 0);
+		return;
+	}
+	
+	if (!m_OriginTermsValid || cameraPosition != m_OriginTermsPosition)
+		UploadOriginTerms(cameraPosition);
+	
+	// Bind quadric data texture to unit 6
+	glActiveTexture(GL_TEXTURE6);
+	glBindTexture(GL_TEXTURE_2D, m_QuadricTexture);
+	glUniform1i(glGetUniformLocation(shaderProgram, "uQuadricsTex"), 6);
+	
+	// Bind BVH node texture to unit 7
+	glActiveTexture(GL_TEXTURE7);
+	glBindTexture(GL_TEXTURE_2D, m_BVHTexture);
+	glUniform1i(glGetUniformLocation(shaderProgram, "uQuadricBVHTex"), 7);
+	
+	glUniform1i(glGetUniformLocation(shaderProgram, "uNumQuadrics"), GetNumQuadrics());
+}
+
+void QuadricManager::UploadToGPU()
 {
-	GLint uNumQuadricsLoc = glGetUniformLocation(shaderProgram, "uNumQuadrics");
-	glUniform1i(uNumQuadricsLoc, m_NumQuadrics);
+	m_GPUDataDirty = false;
+	
+	if (m_QuadricTexture) glDeleteTextures(1, &m_QuadricTexture);
+	if (m_BVHTexture) glDeleteTextures(1, &m_BVHTexture);
+	m_QuadricTexture = 0;
+	m_BVHTexture = 0;
+	m_BVH.Clear();
+	m_RowSlots.clear();
+	m_OriginTermsValid = false;
+	
+	if (m_Quadrics.empty())
+		return;
 	
-	// Send quadric data as separate uniform arrays
-	for (int i = 0; i < m_NumQuadrics && i < MAX_QUADRICS; i++)
+	// A BVH primitive is an object: a standalone quadric or a whole CSG group.
+	// Group members must stay together so the shader can find them by range.
+	std::vector<std::vector<int>> objects;
+	std::map<int, int> groupObject;
+	for (int i = 0; i < GetNumQuadrics(); i++)
 	{
-		const Quadric& q = m_Quadrics[i];
+		int group = m_Quadrics[i].csgGroup;
+		if (group < 0)
+		{
+			objects.push_back({ i });
+			continue;
+		}
 		
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_A[" + std::to_string(i) + "]").c_str()), q.A);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_B[" + std::to_string(i) + "]").c_str()), q.B);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_C[" + std::to_string(i) + "]").c_str()), q.C);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_D[" + std::to_string(i) + "]").c_str()), q.D);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_E[" + std::to_string(i) + "]").c_str()), q.E);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_F[" + std::to_string(i) + "]").c_str()), q.F);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_G[" + std::to_string(i) + "]").c_str()), q.G);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_H[" + std::to_string(i) + "]").c_str()), q.H);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_I[" + std::to_string(i) + "]").c_str()), q.I);
-		glUniform1f(glGetUniformLocation(shaderProgram, ("uQuadrics_J[" + std::to_string(i) + "]").c_str()), q.J);
-		glUniform3fv(glGetUniformLocation(shaderProgram, ("uQuadrics_bboxMin[" + std::to_string(i) + "]").c_str()), 1, glm::value_ptr(q.bboxMin));
-		glUniform3fv(glGetUniformLocation(shaderProgram, ("uQuadrics_bboxMax[" + std::to_string(i) + "]").c_str()), 1, glm::value_ptr(q.bboxMax));
-		glUniform1i(glGetUniformLocation(shaderProgram, ("uQuadrics_materialIndex[" + std::to_string(i) + "]").c_str()), q.materialIndex);
+		auto found = groupObject.find(group);
+		if (found == groupObject.end())
+		{
+			groupObject[group] = static_cast<int>(objects.size());
+			objects.push_back({ i });
+		}
+		else
+		{
+			objects[found->second].push_back(i);
+		}
 	}
+	
+	// Per-slot culling box (object space) and world-space box. The shader
+	// culls and clips with the box; shrink it to the part of the surface
+	// inside it so fewer rays reach the root solve.
+	std::vector<Quadric::BoundingBox> slotBounds(m_Quadrics.size());
+	std::vector<Quadric::BoundingBox> objectBounds(objects.size());
+	for (size_t o = 0; o < objects.size(); o++)
+	{
+		glm::vec3 worldMin(std::numeric_limits<float>::max());
+		glm::vec3 worldMax(-std::numeric_limits<float>::max());
+		for (int slot : objects[o])
+		{
+			const SceneQuadric& q = m_Quadrics[slot];
+			Quadric::BoundingBox bounds(q.bboxMin, q.bboxMax);
+			Quadric::ComputeClippedExtent(Quadric::QuadricCoefficients(q.A, q.B, q.C, q.D, q.E, q.F, q.G, q.H, q.I, q.J),
+			                              Quadric::BoundingBox(q.bboxMin, q.bboxMax), bounds);
+			slotBounds[slot] = bounds;
+			
+			// Every point of a CSG solid lies on some member inside its box,
+			// so the union of the member boxes bounds the solid
+			Quadric::BoundingBox world = Quadric::TransformBounds(bounds, q.GetTransform());
+			worldMin = glm::min(worldMin, world.Min);
+			worldMax = glm::max(worldMax, world.Max);
+		}
+		objectBounds[o] = Quadric::BoundingBox(worldMin, worldMax);
+	}
+	
+	m_BVH.Build(objectBounds);
+	
+	// Rows follow the leaf order, so every leaf covers a contiguous row range
+	// and every CSG group a contiguous range inside it
+	const std::vector<int>& order = m_BVH.GetPrimitiveIndices();
+	std::vector<int> objectFirstRow(objects.size() + 1);
+	std::vector<float> quadricData(m_Quadrics.size() * 11 * 4);
+	m_RowSlots.resize(m_Quadrics.size());
+	int row = 0;
+	for (size_t k = 0; k < order.size(); k++)
+	{
+		const std::vector<int>& members = objects[order[k]];
+		objectFirstRow[k] = row;
+		int groupFirst = row;
+		
+		for (int slot : members)
+		{
+			const SceneQuadric& q = m_Quadrics[slot];
+			const Quadric::BoundingBox& bounds = slotBounds[slot];
+			
+			// Rays are moved into object space in the shader
+			glm::mat4 worldToObject = glm::inverse(q.GetTransform());
+			
+			// Layout: 11 RGBA texels per row
+			//   0: A B C D   1: E F G H   2: I J, unused
+			//   3: bboxMin, materialIndex   4: bboxMax, unused
+			//   5-7: rows of worldToObject (the last row is 0 0 0 1)
+			//   8: first row and size of the CSG group
+			//   9-10: camera origin terms, written by UploadOriginTerms
+			float* texel = &quadricData[size_t(row) * 11 * 4];
+			const float values[9 * 4] = {
+				q.A, q.B, q.C, q.D,
+				q.E, q.F, q.G, q.H,
+				q.I, q.J, 0.0f, 0.0f,
+				bounds.Min.x, bounds.Min.y, bounds.Min.z, (float)q.materialIndex,
+				bounds.Max.x, bounds.Max.y, bounds.Max.z, 0.0f,
+				worldToObject[0][0], worldToObject[1][0], worldToObject[2][0], worldToObject[3][0],
+				worldToObject[0][1], worldToObject[1][1], worldToObject[2][1], worldToObject[3][1],
+				worldToObject[0][2], worldToObject[1][2], worldToObject[2][2], worldToObject[3][2],
+				(float)groupFirst, (float)members.size(), 0.0f, 0.0f
+			};
+			std::copy(values, values + 9 * 4, texel);
+			m_RowSlots[row] = slot;
+			row++;
+		}
+	}
+	objectFirstRow[objects.size()] = row;
+	
+	// Node layout: 2 RGBA texels (min, left child or first row) and
+	// (max, row count; 0 for interior nodes)
+	const std::vector<Quadric::BVHNode>& nodes = m_BVH.GetNodes();
+	std::vector<float> nodeData(nodes.size() * 2 * 4);
+	for (size_t n = 0; n < nodes.size(); n++)
+	{
+		const Quadric::BVHNode& node = nodes[n];
+		int leftOrFirst = node.LeftOrFirst;
+		int count = 0;
+		if (node.IsLeaf())
+		{
+			leftOrFirst = objectFirstRow[node.LeftOrFirst];
+			count = objectFirstRow[node.LeftOrFirst + node.Count] - leftOrFirst;
+		}
+		
+		float* texel = &nodeData[n * 2 * 4];
+		texel[0] = node.Min.x;
+		texel[1] = node.Min.y;
+		texel[2] = node.Min.z;
+		texel[3] = (float)leftOrFirst;
+		texel[4] = node.Max.x;
+		texel[5] = node.Max.y;
+		texel[6] = node.Max.z;
+		texel[7] = (float)count;
+	}
+	
+	// Create quadric data texture
+	glGenTextures(1, &m_QuadricTexture);
+	glBindTexture(GL_TEXTURE_2D, m_QuadricTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 11, (GLsizei)m_Quadrics.size(), 0, GL_RGBA, GL_FLOAT, quadricData.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);  // Read with texelFetch only
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	
+	// Create BVH node texture
+	glGenTextures(1, &m_BVHTexture);
+	glBindTexture(GL_TEXTURE_2D, m_BVHTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 2, (GLsizei)nodes.size(), 0, GL_RGBA, GL_FLOAT, nodeData.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void QuadricManager::UploadOriginTerms(const glm::vec3& cameraPosition)
+{
+	m_OriginTermsPosition = cameraPosition;
+	m_OriginTermsValid = true;
+	
+	// For o = worldToObject * camera, f(o + t*d) = (dᵀMd) t² + (∇f(o)·d) t + f(o):
+	// only the t² term is left for the shader to compute per pixel
+	//   9: o, f(o)   10: ∇f(o), unused
+	std::vector<float> originData(m_RowSlots.size() * 2 * 4);
+	for (size_t row = 0; row < m_RowSlots.size(); row++)
+	{
+		const SceneQuadric& q = m_Quadrics[m_RowSlots[row]];
+		Quadric::QuadricSurface surface(Quadric::QuadricCoefficients(q.A, q.B, q.C, q.D, q.E, q.F, q.G, q.H, q.I, q.J));
+		glm::vec3 origin = glm::vec3(glm::inverse(q.GetTransform()) * glm::vec4(cameraPosition, 1.0f));
+		glm::vec3 gradient = surface.CalculateNormal(origin);
+		
+		float* texel = &originData[row * 2 * 4];
+		texel[0] = origin.x;
+		texel[1] = origin.y;
+		texel[2] = origin.z;
+		texel[3] = surface.Evaluate(origin);
+		texel[4] = gradient.x;
+		texel[5] = gradient.y;
+		texel[6] = gradient.z;
+		texel[7] = 0.0f;
+	}
+	
+	// Only columns 9-10 change, the rest of the row stays on the GPU
+	glBindTexture(GL_TEXTURE_2D, m_QuadricTexture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 9, 0, 2, (GLsizei)m_RowSlots.size(), GL_RGBA, GL_FLOAT, originData.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// ============================================================================
+// CSG GROUPS
+// ============================================================================
+bool QuadricManager::LoadIntersectionGroup(int first, const Quadric::QuadricCSG& csg,
+                                           const glm::vec3& bboxMin, const glm::vec3& bboxMax, int materialIndex)
+{
+	int count = static_cast<int>(csg.GetLeafCount());
+	if (first < 0 || first + count > MAX_QUADRICS)
+	{
+		std::cerr << "[QuadricManager] CSG solid needs " << count << " free slots from slot " << first << std::endl;
+		return false;
+	}
+	
+	if (first + count > GetNumQuadrics())
+		m_Quadrics.resize(first + count, SceneQuadric{});
+	
+	// The group id is the first slot; all members share its transform
+	const SceneQuadric anchor = m_Quadrics[first];
+	for (int leaf = 0; leaf < count; leaf++)
+	{
+		const Quadric::QuadricCoefficients& c = csg.GetLeaf(leaf).GetCoefficients();
+		SceneQuadric& q = m_Quadrics[first + leaf];
+		q = {c.A, c.B, c.C, c.D, c.E, c.F, c.G, c.H, c.I, c.J, bboxMin, bboxMax, materialIndex};
+		q.position = anchor.position;
+		q.rotation = anchor.rotation;
+		q.scale = anchor.scale;
+		q.csgGroup = first;
+	}
+	
+	m_GPUDataDirty = true;
+	return true;
 }
 
 // ============================================================================
 // ACCESSORS
 // ============================================================================
-const Quadric& QuadricManager::GetQuadric(int index) const
+const SceneQuadric& QuadricManager::GetQuadric(int index) const
 {
-	if (index < 0 || index >= MAX_QUADRICS)
+	if (index < 0 || index >= GetNumQuadrics())
 	{
-		static Quadric empty = {};
+		static SceneQuadric empty = {};
 		return empty;
 	}
 	return m_Quadrics[index];
 }
 
-Quadric& QuadricManager::GetQuadric(int index)
+SceneQuadric& QuadricManager::GetQuadric(int index)
 {
-	if (index < 0 || index >= MAX_QUADRICS)
+	if (index < 0 || index >= GetNumQuadrics())
 	{
-		static Quadric empty = {};
+		static SceneQuadric empty = {};
 		return empty;
 	}
+	m_GPUDataDirty = true;
 	return m_Quadrics[index];
 }
 
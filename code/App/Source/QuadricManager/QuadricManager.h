@@ -1,22 +1,41 @@
 #pragma once
 
+#include "Quadric/QuadricBVH.h"
+
 #include <glm/glm.hpp>
 #include <glad/gl.h>
 #include <string>
 #include <vector>
 
+namespace Quadric { class QuadricCSG; }
+
 // ============================================================================
 // QUADRIC STRUCTURE
 // ============================================================================
-struct Quadric
+// Coefficients and bounding box describe a canonical shape in object space;
+// the instance transform places it in the world, so moving or rotating a
+// quadric never touches its coefficients.
+struct SceneQuadric
 {
 	float A, B, C;      // x², y², z² coefficients
 	float D, E, F;      // xy, xz, yz cross terms
 	float G, H, I;      // x, y, z linear terms
 	float J;            // constant term
-	glm::vec3 bboxMin;  // Bounding box minimum
-	glm::vec3 bboxMax;  // Bounding box maximum
+	glm::vec3 bboxMin;  // Bounding box minimum (object space)
+	glm::vec3 bboxMax;  // Bounding box maximum (object space)
 	int materialIndex;
+
+	// Instance transform (object -> world)
+	glm::vec3 position = glm::vec3(0.0f);
+	glm::vec3 rotation = glm::vec3(0.0f);   // Euler angles in degrees, applied X, then Y, then Z
+	glm::vec3 scale = glm::vec3(1.0f);
+
+	// CSG: quadrics sharing a group >= 0 render the intersection of their
+	// solids (f <= 0). Negate a member's coefficients to subtract it.
+	int csgGroup = -1;
+
+	// Object-to-world matrix: T * Rz * Ry * Rx * S
+	glm::mat4 GetTransform() const;
 };
 
 // ============================================================================
@@ -25,35 +44,70 @@ struct Quadric
 class QuadricManager
 {
 public:
-	static constexpr int MAX_QUADRICS = 8;
+	// Quadrics and BVH nodes are uploaded as data texture rows; the BVH has
+	// up to 2n - 1 nodes and GL 4.1 guarantees 16384 rows
+	static constexpr int MAX_QUADRICS = 8192;
 
-	QuadricManager();
-	~QuadricManager() = default;
+	QuadricManager() = default;
+	~QuadricManager();
 
 	// Initialize with default quadrics
 	void InitializeDefaults();
 
+	// Replace the scene with count small spheres and cylinders scattered
+	// through the Cornell box (for testing large quadric counts)
+	void GenerateProceduralField(int count, unsigned int seed = 1);
+
 	// Render the ImGui editor window
 	// Returns true if any quadric was modified
 	bool RenderEditor();
 
-	// Upload quadric uniforms to shader
-	void UploadToShader(GLuint shaderProgram) const;
+	// Bind quadric data and BVH textures and set their uniforms. Rebuilds the
+	// BVH and re-uploads the textures first if any quadric changed, and
+	// refreshes the origin terms of camera rays when the camera moved.
+	void UploadToShader(GLuint shaderProgram, const glm::vec3& cameraPosition);
 
 	// Accessors
-	int GetNumQuadrics() const { return m_NumQuadrics; }
+	int GetNumQuadrics() const { return static_cast<int>(m_Quadrics.size()); }
 	bool IsEditorVisible() const { return m_ShowEditor; }
 	void SetEditorVisible(bool visible) { m_ShowEditor = visible; }
 	void ToggleEditor() { m_ShowEditor = !m_ShowEditor; }
 
-	// Get quadric for external access if needed
-	const Quadric& GetQuadric(int index) const;
-	Quadric& GetQuadric(int index);
+	// Get quadric for external access if needed (the non-const overload
+	// schedules a re-upload)
+	const SceneQuadric& GetQuadric(int index) const;
+	SceneQuadric& GetQuadric(int index);
+
+	// BVH over the quadric objects (a standalone quadric or a whole CSG group)
+	const Quadric::QuadricBVH& GetBVH() const { return m_BVH; }
 
 private:
-	Quadric m_Quadrics[MAX_QUADRICS];
-	int m_NumQuadrics = 0;
+	// Write the leaves of an intersection-only CSG solid into consecutive
+	// slots starting at first, as one group sharing the box and transform
+	// of slot first. Returns false if the slots do not fit.
+	bool LoadIntersectionGroup(int first, const Quadric::QuadricCSG& csg,
+	                           const glm::vec3& bboxMin, const glm::vec3& bboxMax, int materialIndex);
+
+	// Group slots into objects, rebuild the BVH over their world bounds and
+	// pack quadric rows in leaf order into the data textures
+	void UploadToGPU();
+
+	// Evaluate f and ∇f of every quadric at the camera (in its object space)
+	// and write them to texels 9-10 of each row. Primary rays all start at
+	// the camera, so the shader only computes the direction terms per pixel.
+	void UploadOriginTerms(const glm::vec3& cameraPosition);
+
+	std::vector<SceneQuadric> m_Quadrics;
 	int m_SelectedQuadric = 0;
+	int m_FieldCount = 2000;
 	bool m_ShowEditor = false;
-};
 
+	// GPU data
+	Quadric::QuadricBVH m_BVH;
+	GLuint m_QuadricTexture = 0;   // 11 texels per quadric, rows in BVH leaf order
+	GLuint m_BVHTexture = 0;       // 2 texels per BVH node
+	std::vector<int> m_RowSlots;   // Quadric slot stored in each texture row
+	glm::vec3 m_OriginTermsPosition = glm::vec3(0.0f);
+	bool m_OriginTermsValid = false;
+	bool m_GPUDataDirty = true;
+};
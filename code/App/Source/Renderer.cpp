@@ -98,6 +98,29 @@ bool AttachTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture)
 	return true;
 }
 
+// Adds texture as color attachment index (> 0) and draws to attachments
+// 0..index, for shaders with several outputs
+bool AttachExtraTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture, int index)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.Handle);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + index, GL_TEXTURE_2D, texture.Handle, 0);
+
+	GLenum drawBuffers[8];
+	for (int i = 0; i <= index; i++)
+		drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+	glDrawBuffers(index + 1, drawBuffers);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cerr << "Framebuffer is not complete!" << std::endl;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		return false;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	return true;
+}
+
 void BlitFramebufferToSwapchain(const Framebuffer framebuffer)
 {
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.Handle);
@@ -23,4 +23,5 @@ Texture CreateTexture(int width, int height);
 Texture LoadTexture(const std::filesystem::path& path);
 Framebuffer CreateFramebufferWithTexture(const Texture texture);
 bool AttachTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture);
+bool AttachExtraTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture, int index);
 void BlitFramebufferToSwapchain(const Framebuffer framebuffer);
\ No newline at end of file
@@ -13,6 +13,243 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// ============================================================================
+// MAPPED FILE
+// ============================================================================
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+	
+	Close();
+	m_Mapped = other.m_Mapped;
+	m_Size = other.m_Size;
+	m_Buffer = std::move(other.m_Buffer);
+	m_Data = m_Mapped ? other.m_Data : m_Buffer.data();
+	
+	other.m_Data = nullptr;
+	other.m_Size = 0;
+	other.m_Mapped = false;
+	return *this;
+}
+
+// ----------------------------------------------------------------------------
+// Open
+// ----------------------------------------------------------------------------
+// POSIX: mmap with a sequential-access hint, since parsers read front to
+// back. An empty file cannot be mapped and gets an empty view instead.
+// Elsewhere the file is read into m_Buffer with one read.
+// ----------------------------------------------------------------------------
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+	Close();
+
+#ifndef _WIN32
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+	
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+	{
+		::close(fd);
+		return false;
+	}
+	
+	if (info.st_size > 0)
+	{
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(fd);
+			return false;
+		}
+		
+		madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+		m_Data = static_cast<const char*>(data);
+		m_Size = (size_t)info.st_size;
+		m_Mapped = true;
+	}
+	
+	// The mapping stays valid after the descriptor is closed
+	::close(fd);
+	return true;
+#else
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+		return false;
+	
+	m_Buffer.resize((size_t)file.tellg());
+	file.seekg(0);
+	file.read(m_Buffer.data(), (std::streamsize)m_Buffer.size());
+	m_Data = m_Buffer.data();
+	m_Size = m_Buffer.size();
+	return true;
+#endif
+}
+
+void MappedFile::Close()
+{
+#ifndef _WIN32
+	if (m_Mapped)
+		munmap(const_cast<char*>(m_Data), m_Size);
+#endif
+	
+	m_Data = nullptr;
+	m_Size = 0;
+	m_Mapped = false;
+	m_Buffer.clear();
+	m_Buffer.shrink_to_fit();
+}
+
+// ============================================================================
+// LINE BLOCK READER
+// ============================================================================
+
+LineBlockReader::~LineBlockReader()
+{
+	Close();
+}
+
+bool LineBlockReader::Open(const std::filesystem::path& path, size_t blockBytes)
+{
+	Close();
+	
+	std::error_code error;
+	size_t size = (size_t)std::filesystem::file_size(path, error);
+	if (error)
+		return false;
+	
+	m_File = std::fopen(path.string().c_str(), "rb");
+	if (!m_File)
+		return false;
+	
+	m_FileSize = size;
+	m_BlockBytes = std::max<size_t>(blockBytes, 1);
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+// Next
+// ----------------------------------------------------------------------------
+// Moves the line left over from the previous block to the front of the
+// buffer, fills the rest with one read and hands out everything up to the
+// last newline. If the buffer holds no newline at all, one line is longer
+// than the buffer: it doubles and the read continues. At the end of the
+// file whatever is left is the last block.
+// ----------------------------------------------------------------------------
+bool LineBlockReader::Next(std::string_view& lines)
+{
+	if (!m_File || m_Failed)
+		return false;
+	
+	size_t carry = m_Filled - m_Consumed;
+	if (carry > 0)
+		std::memmove(m_Buffer.data(), m_Buffer.data() + m_Consumed, carry);
+	m_Filled = carry;
+	m_Consumed = 0;
+	
+	// A file smaller than a block gets a buffer of its size (plus one byte,
+	// so the first read already reaches the end)
+	size_t bufferBytes = std::min(m_BlockBytes, m_FileSize + 1);
+	if (m_Buffer.size() < bufferBytes)
+		m_Buffer.resize(bufferBytes);
+	
+	while (true)
+	{
+		if (!m_EndOfFile)
+		{
+			if (m_Filled == m_Buffer.size())
+				m_Buffer.resize(m_Buffer.size() * 2);
+			
+			size_t wanted = m_Buffer.size() - m_Filled;
+			size_t got = std::fread(m_Buffer.data() + m_Filled, 1, wanted, m_File);
+			m_Filled += got;
+			
+			if (got < wanted)
+			{
+				m_EndOfFile = true;
+				m_Failed = std::ferror(m_File) != 0;
+				if (m_Failed)
+					return false;
+			}
+		}
+		
+		if (m_EndOfFile)
+		{
+			lines = std::string_view(m_Buffer.data(), m_Filled);
+			m_Consumed = m_Filled;
+			return m_Filled > 0;
+		}
+		
+		// The carried bytes hold no newline, so only the new ones are searched
+		size_t cut = m_Filled;
+		while (cut > carry && m_Buffer[cut - 1] != '\n')
+			cut--;
+		
+		if (cut > carry)
+		{
+			lines = std::string_view(m_Buffer.data(), cut);
+			m_Consumed = cut;
+			return true;
+		}
+		
+		// No newline yet: everything read so far is one unfinished line
+		carry = m_Filled;
+	}
+}
+
+bool LineBlockReader::Rewind()
+{
+	if (!m_File)
+		return false;
+	
+	std::clearerr(m_File);
+	m_Filled = 0;
+	m_Consumed = 0;
+	m_EndOfFile = false;
+	m_Failed = false;
+	return std::fseek(m_File, 0, SEEK_SET) == 0;
+}
+
+void LineBlockReader::Close()
+{
+	if (m_File)
+		std::fclose(m_File);
+	
+	m_File = nullptr;
+	m_Filled = 0;
+	m_Consumed = 0;
+	m_FileSize = 0;
+	m_EndOfFile = false;
+	m_Failed = false;
+	m_Buffer.clear();
+	m_Buffer.shrink_to_fit();
+}
+
+// ============================================================================
+// FILE MANAGER
+// ============================================================================
 
 // ----------------------------------------------------------------------------
 // ReadTextFile
@@ -63,6 +300,25 @@ std::optional<std::vector<std::string>> FileManager::ReadLines(const std::filesy
 	return lines;
 }
 
+// ----------------------------------------------------------------------------
+// MapFile
+// ----------------------------------------------------------------------------
+// Thin wrapper around MappedFile::Open() that reports the failure like the
+// other readers.
+// ----------------------------------------------------------------------------
+std::optional<MappedFile> FileManager::MapFile(const std::filesystem::path& path)
+{
+	MappedFile file;
+	
+	if (!file.Open(path))
+	{
+		std::cerr << "[FileManager] Failed to open file: " << path.string() << std::endl;
+		return std::nullopt;
+	}
+	
+	return file;
+}
+
 // ----------------------------------------------------------------------------
 // FileExists
 // ----------------------------------------------------------------------------
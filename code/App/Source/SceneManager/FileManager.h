@@ -1,9 +1,108 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <filesystem>
 #include <optional>
+#include <cstdio>
+
+// ============================================================================
+// MAPPED FILE - Read-only view of a whole file
+// ============================================================================
+//
+// Holds a file mapped into memory (mmap on POSIX; on other platforms the
+// file is read into a private buffer instead). Parsers tokenize the view in
+// place with std::string_view, so nothing is copied per line. The view is
+// valid until the MappedFile is closed or destroyed.
+//
+// Move-only. Obtain one through FileManager::MapFile.
+//
+// ============================================================================
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	
+	// Maps path read-only; false (and closed) if it cannot be opened
+	bool Open(const std::filesystem::path& path);
+	
+	// Unmaps the file; the view becomes empty
+	void Close();
+	
+	std::string_view GetView() const { return std::string_view(m_Data, m_Size); }
+	size_t GetSize() const { return m_Size; }
+
+private:
+	const char* m_Data = nullptr;
+	size_t m_Size = 0;
+	bool m_Mapped = false;      // m_Data points into a mapping, not m_Buffer
+	std::string m_Buffer;       // Fallback storage (no mmap, or empty file)
+};
+
+// ============================================================================
+// LINE BLOCK READER - Whole lines in fixed-size reads
+// ============================================================================
+//
+// Reads a file front to back in blocks of a fixed size and hands out each
+// block cut back to its last newline; the unfinished line is carried over
+// to the start of the next block. Memory stays at one block no matter how
+// large the file is (a single line longer than a block grows the buffer
+// to fit it). The last block may end without a newline.
+//
+// Each view is valid until the next call to Next(), Rewind() or Close().
+//
+// USAGE EXAMPLE:
+// --------------
+//   LineBlockReader reader;
+//   if (reader.Open("path/to/scan.obj", 64 << 20)) {
+//       std::string_view lines;
+//       while (reader.Next(lines)) {
+//           // tokenize lines in place
+//       }
+//   }
+//
+// ============================================================================
+class LineBlockReader
+{
+public:
+	LineBlockReader() = default;
+	~LineBlockReader();
+	
+	LineBlockReader(const LineBlockReader&) = delete;
+	LineBlockReader& operator=(const LineBlockReader&) = delete;
+	
+	// Opens path for reading in blockBytes reads; false (and closed) if it
+	// cannot be opened
+	bool Open(const std::filesystem::path& path, size_t blockBytes);
+	
+	// Next run of whole lines; false at the end of the file or on a read error
+	bool Next(std::string_view& lines);
+	
+	// Starts again at the beginning of the file
+	bool Rewind();
+	
+	void Close();
+	
+	size_t GetFileSize() const { return m_FileSize; }
+	bool Failed() const { return m_Failed; }
+
+private:
+	std::FILE* m_File = nullptr;
+	std::vector<char> m_Buffer;     // One block, plus room for a long line
+	size_t m_BlockBytes = 0;
+	size_t m_Filled = 0;            // Bytes of m_Buffer holding file data
+	size_t m_Consumed = 0;          // Bytes already handed out by Next()
+	size_t m_FileSize = 0;
+	bool m_EndOfFile = false;
+	bool m_Failed = false;          // A read failed before the end of file
+};
 
 // ============================================================================
 // FILE MANAGER - Handles file I/O operations
@@ -29,6 +128,15 @@
 //       }
 //   }
 //
+//   // Map a large file and scan it without copying
+//   auto file = FileManager::MapFile("path/to/scan.obj");
+//   if (file.has_value()) {
+//       std::string_view text = file->GetView();
+//       // tokenize text in place
+//   }
+//
+//   // Stream a file larger than memory: see LineBlockReader
+//
 //   // Resolve relative path from OBJ file to MTL file
 //   std::filesystem::path mtlPath = FileManager::ResolvePath(
 //       "models/scene.obj",   // base path
@@ -55,7 +163,7 @@ public:
 	// Notes:
 	//   - Uses std::ifstream with rdbuf() for efficient reading
 	//   - Suitable for small to medium files (shaders, config files)
-	//   - For very large files, consider ReadLines() for streaming
+	//   - For very large files, consider MapFile()
 	// ========================================================================
 	static std::optional<std::string> ReadTextFile(const std::filesystem::path& path);
 	
@@ -75,9 +183,31 @@ public:
 	//   - Each line is stored without the newline character
 	//   - Preserves empty lines
 	//   - Ideal for parsing structured files (OBJ, MTL, CSV)
+	//   - Holds the whole file as strings; stream large files with
+	//     LineBlockReader instead
 	// ========================================================================
 	static std::optional<std::vector<std::string>> ReadLines(const std::filesystem::path& path);
 	
+	// ========================================================================
+	// MapFile
+	// ========================================================================
+	// Maps a file read-only into memory.
+	//
+	// Parameters:
+	//   path - Path to the file (absolute or relative to working directory)
+	//
+	// Returns:
+	//   std::optional<MappedFile> - The mapping if successful, std::nullopt
+	//                               if file cannot be opened
+	//
+	// Notes:
+	//   - No copy and no per-line allocation: pages are read on first touch
+	//   - Line endings are left as they are in the file ("\r\n" included)
+	//   - Preferred over ReadLines() for large files (MTL libraries, caches);
+	//     the pages it touches stay resident until it is closed
+	// ========================================================================
+	static std::optional<MappedFile> MapFile(const std::filesystem::path& path);
+	
 	// ========================================================================
 	// FileExists
 	// ========================================================================
@@ -0,0 +1,395 @@
+// ============================================================================
+// QUADRIC TESSELLATOR - Implementation
+// ============================================================================
+//
+// See QuadricTessellator.h for the meshing scheme and the error metric.
+//
+// CUBE AND TETRAHEDRON NUMBERING:
+// -------------------------------
+// Cube corner c sits at (c & 1, (c >> 1) & 1, (c >> 2) & 1) in grid steps.
+// The six tetrahedra are the monotone paths from corner 0 to corner 7, so
+// every cube face is split along the same diagonal as in its neighbour:
+//
+//   0-1-3-7   0-2-3-7   0-2-6-7   0-4-6-7   0-4-5-7   0-1-5-7
+//
+// ============================================================================
+
+#include "QuadricTessellator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+
+// ============================================================================
+// HELPER FUNCTIONS
+// ============================================================================
+
+namespace
+{
+	constexpr int TETRAHEDRA[6][4] = {
+		{ 0, 1, 3, 7 }, { 0, 2, 3, 7 }, { 0, 2, 6, 7 },
+		{ 0, 4, 6, 7 }, { 0, 4, 5, 7 }, { 0, 1, 5, 7 }
+	};
+	
+	// Surface samples used to estimate the radius of curvature
+	constexpr int CURVATURE_SAMPLE_CELLS = 16;
+	
+	// Fraction of samples allowed to be more curved than the estimate, so a
+	// cusp does not force the finest grid onto the whole surface
+	constexpr float CURVATURE_PERCENTILE = 0.1f;
+	
+	// ------------------------------------------------------------------------
+	// Exact point where the surface crosses the grid edge a -> b
+	// ------------------------------------------------------------------------
+	// fa and fb have opposite signs, so f(a + t(b - a)) has exactly one root
+	// in [0, 1]. Linear interpolation is the fallback for roots lost to
+	// rounding.
+	// ------------------------------------------------------------------------
+	glm::vec3 EdgeCrossing(const Quadric::QuadricSurface& surface,
+	                       const glm::vec3& a, float fa,
+	                       const glm::vec3& b, float fb)
+	{
+		glm::vec3 edge = b - a;
+		float t = fa / (fa - fb);
+		
+		float qa, qb, qc;
+		surface.ExpandRay(a, edge, qa, qb, qc);
+		
+		float t0, t1;
+		if (surface.SolveQuadratic(qa, qb, qc, t0, t1))
+		{
+			constexpr float tolerance = 1e-4f;
+			if (t0 >= -tolerance && t0 <= 1.0f + tolerance)
+				t = t0;
+			else if (t1 >= -tolerance && t1 <= 1.0f + tolerance)
+				t = t1;
+		}
+		
+		return a + std::clamp(t, 0.0f, 1.0f) * edge;
+	}
+	
+	// ------------------------------------------------------------------------
+	// Append a triangle wound counter-clockwise around the gradient
+	// ------------------------------------------------------------------------
+	void EmitTriangle(const Quadric::QuadricSurface& surface,
+	                  glm::vec3 v0, glm::vec3 v1, glm::vec3 v2,
+	                  int materialIndex, std::vector<Triangle>& triangles)
+	{
+		glm::vec3 faceNormal = glm::cross(v1 - v0, v2 - v0);
+		float area2 = glm::dot(faceNormal, faceNormal);
+		if (area2 <= 1e-20f)
+			return;
+		
+		glm::vec3 centroid = (v0 + v1 + v2) / 3.0f;
+		if (glm::dot(faceNormal, surface.CalculateNormal(centroid)) < 0.0f)
+		{
+			std::swap(v1, v2);
+			faceNormal = -faceNormal;
+		}
+		faceNormal /= std::sqrt(area2);
+		
+		// The gradient vanishes at singular points (a cone's apex)
+		auto vertexNormal = [&](const glm::vec3& v)
+		{
+			glm::vec3 gradient = surface.CalculateNormal(v);
+			float length = glm::length(gradient);
+			return length > 1e-8f ? gradient / length : faceNormal;
+		};
+		
+		Triangle triangle;
+		triangle.V0 = v0;
+		triangle.V1 = v1;
+		triangle.V2 = v2;
+		triangle.N0 = vertexNormal(v0);
+		triangle.N1 = vertexNormal(v1);
+		triangle.N2 = vertexNormal(v2);
+		triangle.MaterialIndex = materialIndex;
+		triangles.push_back(triangle);
+	}
+	
+	// ------------------------------------------------------------------------
+	// Marching tetrahedra for one tetrahedron
+	// ------------------------------------------------------------------------
+	void PolygonizeTetrahedron(const Quadric::QuadricSurface& surface,
+	                           const glm::vec3 p[4], const float f[4],
+	                           int materialIndex, std::vector<Triangle>& triangles)
+	{
+		int inside[4], outside[4];
+		int numInside = 0, numOutside = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (f[i] < 0.0f)
+				inside[numInside++] = i;
+			else
+				outside[numOutside++] = i;
+		}
+		
+		auto crossing = [&](int i, int j) { return EdgeCrossing(surface, p[i], f[i], p[j], f[j]); };
+		
+		if (numInside == 1 || numInside == 3)
+		{
+			// One corner on its own: cut it off with a single triangle
+			int lone = (numInside == 1) ? inside[0] : outside[0];
+			const int* others = (numInside == 1) ? outside : inside;
+			EmitTriangle(surface, crossing(lone, others[0]), crossing(lone, others[1]),
+			             crossing(lone, others[2]), materialIndex, triangles);
+		}
+		else if (numInside == 2)
+		{
+			// Two against two: the four crossings form a quad, in cycle order
+			glm::vec3 q0 = crossing(inside[0], outside[0]);
+			glm::vec3 q1 = crossing(inside[0], outside[1]);
+			glm::vec3 q2 = crossing(inside[1], outside[1]);
+			glm::vec3 q3 = crossing(inside[1], outside[0]);
+			EmitTriangle(surface, q0, q1, q2, materialIndex, triangles);
+			EmitTriangle(surface, q0, q2, q3, materialIndex, triangles);
+		}
+	}
+	
+	// ------------------------------------------------------------------------
+	// Widen flat axes of a box so the grid has volume to march through
+	// ------------------------------------------------------------------------
+	Quadric::BoundingBox PadFlatAxes(const Quadric::BoundingBox& box)
+	{
+		glm::vec3 extent = box.Max - box.Min;
+		float largest = std::max({ extent.x, extent.y, extent.z, 1e-3f });
+		
+		Quadric::BoundingBox padded = box;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (extent[axis] < 1e-3f * largest)
+			{
+				padded.Min[axis] -= 1e-3f * largest;
+				padded.Max[axis] += 1e-3f * largest;
+			}
+		}
+		return padded;
+	}
+}
+
+// ============================================================================
+// TESSELLATION
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tessellate
+// ----------------------------------------------------------------------------
+// Samples f once per grid corner, skips cubes whose eight corners share a
+// sign and polygonizes the six tetrahedra of every other cube.
+// ----------------------------------------------------------------------------
+std::vector<Triangle> QuadricTessellator::Tessellate(const Quadric::QuadricSurface& surface,
+                                                     const Quadric::BoundingBox& box,
+                                                     float cellSize,
+                                                     int materialIndex)
+{
+	std::vector<Triangle> triangles;
+	
+	Quadric::BoundingBox grid = PadFlatAxes(box);
+	glm::vec3 extent = grid.Max - grid.Min;
+	if (!(extent.x > 0.0f && extent.y > 0.0f && extent.z > 0.0f))
+		return triangles;
+	
+	// Zero (a camera touching the surface) asks for the finest grid
+	if (!(cellSize > 0.0f))
+		cellSize = 0.0f;
+	
+	int cells[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float count = std::ceil(extent[axis] / cellSize);
+		cells[axis] = static_cast<int>(std::clamp(count, float(MIN_CELLS_PER_AXIS), float(MAX_CELLS_PER_AXIS)));
+	}
+	glm::vec3 step = extent / glm::vec3(cells[0], cells[1], cells[2]);
+	
+	// Corner values, x fastest
+	const int sizeX = cells[0] + 1;
+	const int sizeY = cells[1] + 1;
+	const int sizeZ = cells[2] + 1;
+	std::vector<float> values(static_cast<size_t>(sizeX) * sizeY * sizeZ);
+	auto cornerIndex = [&](int x, int y, int z) { return (static_cast<size_t>(z) * sizeY + y) * sizeX + x; };
+	auto cornerPosition = [&](int x, int y, int z) { return grid.Min + glm::vec3(x, y, z) * step; };
+	
+	for (int z = 0; z < sizeZ; z++)
+		for (int y = 0; y < sizeY; y++)
+			for (int x = 0; x < sizeX; x++)
+				values[cornerIndex(x, y, z)] = surface.Evaluate(cornerPosition(x, y, z));
+	
+	for (int z = 0; z < cells[2]; z++)
+	{
+		for (int y = 0; y < cells[1]; y++)
+		{
+			for (int x = 0; x < cells[0]; x++)
+			{
+				glm::vec3 p[8];
+				float f[8];
+				int numInside = 0;
+				for (int c = 0; c < 8; c++)
+				{
+					int cx = x + (c & 1);
+					int cy = y + ((c >> 1) & 1);
+					int cz = z + ((c >> 2) & 1);
+					p[c] = cornerPosition(cx, cy, cz);
+					f[c] = values[cornerIndex(cx, cy, cz)];
+					numInside += f[c] < 0.0f;
+				}
+				
+				if (numInside == 0 || numInside == 8)
+					continue;
+				
+				for (const auto& tet : TETRAHEDRA)
+				{
+					glm::vec3 tp[4] = { p[tet[0]], p[tet[1]], p[tet[2]], p[tet[3]] };
+					float tf[4] = { f[tet[0]], f[tet[1]], f[tet[2]], f[tet[3]] };
+					PolygonizeTetrahedron(surface, tp, tf, materialIndex, triangles);
+				}
+			}
+		}
+	}
+	
+	return triangles;
+}
+
+// ============================================================================
+// LEVEL OF DETAIL
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// CurvatureRadius
+// ----------------------------------------------------------------------------
+// The Hessian of f is the constant symmetric matrix
+//
+//   | 2A  D   E  |
+//   | D   2B  F  |
+//   | E   F   2C |
+//
+// and the normal curvature at a surface point is at most |H| / |∇f|, with
+// |H| its largest absolute eigenvalue (found by power iteration). The
+// samples are the vertices of a coarse tessellation.
+// ----------------------------------------------------------------------------
+float QuadricTessellator::CurvatureRadius(const Quadric::QuadricSurface& surface,
+                                          const Quadric::BoundingBox& box)
+{
+	const float flat = std::numeric_limits<float>::infinity();
+	glm::vec3 extent = box.Max - box.Min;
+	float largest = std::max({ extent.x, extent.y, extent.z });
+	
+	const Quadric::QuadricCoefficients& q = surface.GetCoefficients();
+	glm::mat3 hessian(glm::vec3(2.0f * q.A, q.D, q.E),
+	                  glm::vec3(q.D, 2.0f * q.B, q.F),
+	                  glm::vec3(q.E, q.F, 2.0f * q.C));
+	
+	// Start off every axis so no eigenvector is missed
+	glm::vec3 v = glm::normalize(glm::vec3(1.0f, 0.7f, 0.4f));
+	float hessianNorm = 0.0f;
+	for (int i = 0; i < 32; i++)
+	{
+		glm::vec3 hv = hessian * v;
+		hessianNorm = glm::length(hv);
+		if (hessianNorm <= 0.0f)
+			break;
+		v = hv / hessianNorm;
+	}
+	
+	if (hessianNorm <= 0.0f)
+		return flat;
+	
+	std::vector<Triangle> samples = Tessellate(surface, box, largest / CURVATURE_SAMPLE_CELLS);
+	if (samples.empty())
+		return flat;
+	
+	std::vector<float> radii;
+	radii.reserve(samples.size() * 3);
+	for (const Triangle& triangle : samples)
+	{
+		for (const glm::vec3& v : { triangle.V0, triangle.V1, triangle.V2 })
+			radii.push_back(glm::length(surface.CalculateNormal(v)) / hessianNorm);
+	}
+	
+	size_t rank = static_cast<size_t>(CURVATURE_PERCENTILE * (radii.size() - 1));
+	std::nth_element(radii.begin(), radii.begin() + rank, radii.end());
+	return radii[rank];
+}
+
+// ----------------------------------------------------------------------------
+// CellSizeForScreenError
+// ----------------------------------------------------------------------------
+float QuadricTessellator::CellSizeForScreenError(const Quadric::QuadricSurface& surface,
+                                                 const Quadric::BoundingBox& box,
+                                                 float distance,
+                                                 const ScreenErrorMetric& metric)
+{
+	return CellSizeForCurvature(CurvatureRadius(surface, box), box, distance, metric);
+}
+
+float QuadricTessellator::CellSizeForCurvature(float radius,
+                                               const Quadric::BoundingBox& box,
+                                               float distance,
+                                               const ScreenErrorMetric& metric)
+{
+	// Planes are flat: one cell per axis would do
+	if (std::isinf(radius))
+	{
+		glm::vec3 extent = box.Max - box.Min;
+		return std::max({ extent.x, extent.y, extent.z });
+	}
+	
+	float pixelSize = 2.0f * std::max(distance, 0.0f) * std::tan(metric.VerticalFOV * 0.5f) /
+	                  static_cast<float>(std::max(metric.ViewportHeight, 1));
+	
+	// Chords run up to a cell diagonal, √3 times the cell size
+	return std::sqrt(8.0f * radius * metric.PixelError * pixelSize / 3.0f);
+}
+
+// ----------------------------------------------------------------------------
+// BuildLODs
+// ----------------------------------------------------------------------------
+// The curvature depends only on the surface, so it is estimated once. Every
+// LOD is then independent and gets its own task. The futures are collected
+// before returning, which keeps the references to surface and box valid for
+// the tasks' whole lifetime.
+// ----------------------------------------------------------------------------
+std::vector<TessellationLOD> QuadricTessellator::BuildLODs(const Quadric::QuadricSurface& surface,
+                                                           const Quadric::BoundingBox& box,
+                                                           const std::vector<float>& distances,
+                                                           const ScreenErrorMetric& metric,
+                                                           int materialIndex)
+{
+	const float radius = CurvatureRadius(surface, box);
+	
+	std::vector<std::future<TessellationLOD>> tasks;
+	tasks.reserve(distances.size());
+	
+	for (float distance : distances)
+	{
+		tasks.push_back(std::async(std::launch::async, [&surface, &box, &metric, radius, distance, materialIndex]()
+		{
+			TessellationLOD lod;
+			lod.Distance = distance;
+			lod.CellSize = CellSizeForCurvature(radius, box, distance, metric);
+			lod.Triangles = Tessellate(surface, box, lod.CellSize, materialIndex);
+			return lod;
+		}));
+	}
+	
+	std::vector<TessellationLOD> lods;
+	lods.reserve(tasks.size());
+	for (auto& task : tasks)
+		lods.push_back(task.get());
+	
+	return lods;
+}
+
+// ----------------------------------------------------------------------------
+// SelectLOD
+// ----------------------------------------------------------------------------
+size_t QuadricTessellator::SelectLOD(const std::vector<TessellationLOD>& lods, float distance)
+{
+	size_t selected = 0;
+	for (size_t i = 0; i < lods.size(); i++)
+	{
+		if (lods[i].Distance <= distance)
+			selected = i;
+	}
+	return selected;
+}
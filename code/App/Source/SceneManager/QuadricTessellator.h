@@ -0,0 +1,200 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "SceneManager.h"
+#include "../Quadric/Quadric.h"
+
+// ============================================================================
+// QUADRIC TESSELLATOR - Screen-Space Adaptive Meshing of Quadric Surfaces
+// ============================================================================
+//
+// Turns a QuadricSurface clipped to a BoundingBox into a Triangle list for the
+// triangle (OBJ scene) path of the path tracer. The mesh density is chosen
+// from the view instead of being baked into an asset file, so a surface seen
+// from far away costs a few dozen triangles and the same surface seen up close
+// gets as many as it needs to look smooth.
+//
+// MESHING:
+// --------
+// The box is covered by a regular grid of cubes and every cube is split into
+// six tetrahedra that share its main diagonal (the split is identical across
+// neighbouring cubes, so the mesh has no cracks). Marching tetrahedra emits
+// one or two triangles where f changes sign inside a tetrahedron.
+//
+// Vertices are exact: f restricted to a grid edge is a quadratic, so the
+// crossing point is solved for with QuadricSurface::ExpandRay and
+// SolveQuadratic instead of being interpolated linearly. Vertex normals are
+// the normalized gradient, and triangles are wound counter-clockwise when
+// seen from the side the gradient points to (f > 0).
+//
+// SCREEN-SPACE ERROR:
+// -------------------
+// A chord of length h across a surface with radius of curvature R deviates
+// from it by about h² / (8R). At distance d, one pixel of a viewport with
+// height H and vertical field of view fov covers
+//
+//   pixelSize = 2 · d · tan(fov / 2) / H
+//
+// Marching tetrahedra edges span at most a cell diagonal (√3 times the cell
+// size), so the deviation stays under pixelError pixels for cells of size
+//
+//   cellSize = sqrt(8 · R · pixelError · pixelSize / 3)
+//
+// The Hessian of a quadric is constant, which gives R >= |∇f| / |H| at every
+// surface point; R is taken from a coarse sampling of the surface inside the
+// box. Cusps (the apex of a cone) are ignored by using a low percentile
+// instead of the minimum, and the grid resolution is clamped to
+// [MIN_CELLS_PER_AXIS, MAX_CELLS_PER_AXIS].
+//
+// USAGE EXAMPLE:
+// --------------
+//   auto sphere = Quadric::QuadricSurface::CreateSphere(2.5f);
+//
+//   ScreenErrorMetric metric;
+//   metric.VerticalFOV = glm::radians(60.0f);
+//   metric.ViewportHeight = 720;
+//
+//   // Finest first; built in parallel
+//   auto lods = QuadricTessellator::BuildLODs(sphere, sphere.GetBounds(),
+//                                             { 4.0f, 8.0f, 16.0f, 32.0f }, metric);
+//
+//   // Per frame
+//   size_t lod = QuadricTessellator::SelectLOD(lods, glm::length(cameraPosition));
+//   sceneManager.SetTriangles(lods[lod].Triangles);
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// ScreenErrorMetric
+// ----------------------------------------------------------------------------
+// Describes the view a mesh is generated for. The tessellation error is
+// measured in pixels of this viewport.
+// ----------------------------------------------------------------------------
+struct ScreenErrorMetric
+{
+	float VerticalFOV = 1.0472f;    // Vertical field of view in radians (60°)
+	int ViewportHeight = 720;       // Viewport height in pixels
+	float PixelError = 0.5f;        // Largest allowed surface deviation in pixels
+};
+
+// ----------------------------------------------------------------------------
+// TessellationLOD
+// ----------------------------------------------------------------------------
+// One level of detail: the mesh is accurate to the metric's pixel error for
+// any camera at least Distance away from the surface.
+// ----------------------------------------------------------------------------
+struct TessellationLOD
+{
+	float Distance = 0.0f;              // Closest viewing distance this LOD is built for
+	float CellSize = 0.0f;              // Grid spacing used to mesh it
+	std::vector<Triangle> Triangles;
+};
+
+// ============================================================================
+// QUADRIC TESSELLATOR CLASS
+// ============================================================================
+class QuadricTessellator
+{
+public:
+	// Grid resolution limits per box axis
+	static constexpr int MIN_CELLS_PER_AXIS = 4;
+	static constexpr int MAX_CELLS_PER_AXIS = 128;
+	
+	// ========================================================================
+	// Tessellate
+	// ========================================================================
+	// Meshes the part of the surface inside a box.
+	//
+	// Parameters:
+	//   surface       - Quadric to mesh (its own bounding box is ignored)
+	//   box           - Region to mesh, usually surface.GetBounds()
+	//   cellSize      - Grid spacing; clamped so each axis gets between
+	//                   MIN_CELLS_PER_AXIS and MAX_CELLS_PER_AXIS cells
+	//                   (0 selects the finest grid)
+	//   materialIndex - Material assigned to every triangle
+	//
+	// Returns:
+	//   std::vector<Triangle> - Triangles with exact vertices and gradient
+	//                           normals (empty if the surface misses the box)
+	//
+	// Notes:
+	//   - The mesh is open where the surface leaves the box, matching the
+	//     clipped surface the path tracer intersects
+	// ========================================================================
+	static std::vector<Triangle> Tessellate(const Quadric::QuadricSurface& surface,
+	                                        const Quadric::BoundingBox& box,
+	                                        float cellSize,
+	                                        int materialIndex = 0);
+	
+	// ========================================================================
+	// CellSizeForScreenError
+	// ========================================================================
+	// Grid spacing that keeps the mesh within metric.PixelError pixels of
+	// the surface when seen from the given distance.
+	//
+	// Parameters:
+	//   surface  - Quadric to mesh
+	//   box      - Region to mesh
+	//   distance - Viewing distance (closest the camera gets to the surface)
+	//   metric   - Viewport the error is measured in
+	//
+	// Returns:
+	//   float - Cell size for Tessellate (before its resolution clamp)
+	// ========================================================================
+	static float CellSizeForScreenError(const Quadric::QuadricSurface& surface,
+	                                    const Quadric::BoundingBox& box,
+	                                    float distance,
+	                                    const ScreenErrorMetric& metric);
+	
+	// ========================================================================
+	// CurvatureRadius / CellSizeForCurvature
+	// ========================================================================
+	// The two halves of CellSizeForScreenError. CurvatureRadius samples the
+	// surface and returns the radius most of it stays above (infinity for
+	// a plane or when box holds no surface). CellSizeForCurvature turns that
+	// radius into a cell size for one distance, so a set of LODs pays for
+	// the sampling once.
+	// ========================================================================
+	static float CurvatureRadius(const Quadric::QuadricSurface& surface,
+	                             const Quadric::BoundingBox& box);
+	static float CellSizeForCurvature(float radius,
+	                                  const Quadric::BoundingBox& box,
+	                                  float distance,
+	                                  const ScreenErrorMetric& metric);
+	
+	// ========================================================================
+	// BuildLODs
+	// ========================================================================
+	// Builds one mesh per viewing distance, each on its own thread.
+	//
+	// Parameters:
+	//   surface       - Quadric to mesh
+	//   box           - Region to mesh
+	//   distances     - Viewing distances, one LOD each (sorted ascending)
+	//   metric        - Viewport the error is measured in
+	//   materialIndex - Material assigned to every triangle
+	//
+	// Returns:
+	//   std::vector<TessellationLOD> - LODs in the order of distances
+	//                                  (finest first)
+	// ========================================================================
+	static std::vector<TessellationLOD> BuildLODs(const Quadric::QuadricSurface& surface,
+	                                              const Quadric::BoundingBox& box,
+	                                              const std::vector<float>& distances,
+	                                              const ScreenErrorMetric& metric,
+	                                              int materialIndex = 0);
+	
+	// ========================================================================
+	// SelectLOD
+	// ========================================================================
+	// Picks the coarsest LOD that is still accurate at a viewing distance.
+	//
+	// Returns:
+	//   size_t - Index into lods (0 when the camera is closer than every
+	//            LOD's Distance, or when lods is empty)
+	// ========================================================================
+	static size_t SelectLOD(const std::vector<TessellationLOD>& lods, float distance);
+};
@@ -0,0 +1,469 @@
+// ============================================================================
+// SCENE CACHE - Implementation
+// ============================================================================
+//
+// See SceneCache.h for the file layout and the validation rules.
+//
+// ============================================================================
+
+#include "SceneCache.h"
+#include "SceneManager.h"
+#include "FileManager.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+// ============================================================================
+// FORMAT
+// ============================================================================
+static constexpr char CACHE_MAGIC[8] = { 'C', 'G', 'S', 'C', 'E', 'N', 'E', '\0' };
+static constexpr uint64_t SOURCE_MISSING = ~uint64_t(0);   // SourceRecord::Size of an absent file
+static constexpr size_t MESH_ALIGNMENT = 16;
+
+struct CacheHeader
+{
+	char Magic[8];
+	uint32_t Version;
+	uint32_t HeaderSize;            // sizeof(CacheHeader) when written
+	uint64_t FileSize;
+	uint64_t Checksum;              // Hash of [HeaderSize, MeshOffset), chained through each mesh array
+	uint64_t TriangleCount;
+	uint64_t VertexCount;
+	uint64_t MeshOffset;            // Start of the mesh block (MESH_ALIGNMENT aligned)
+	uint32_t MaterialCount;
+	uint32_t SourceCount;
+	uint32_t HasCamera;
+	uint32_t HasLight;
+	float Camera[9];                // Position, target, up
+	float Light[3];
+};
+
+// Followed by the path (uint32 length + bytes)
+struct SourceRecord
+{
+	uint64_t Size;                  // SOURCE_MISSING if the file did not exist
+	int64_t WriteTime;              // last_write_time, native clock ticks
+	uint64_t Hash;                  // SceneCache::Hash of the contents
+};
+
+// Preceded by the name (uint32 length + bytes)
+struct MaterialRecord
+{
+	float Albedo[3];
+	float Emission[3];
+	float Roughness;
+	float Metallic;
+	float EmissionStrength;
+	float IOR;
+	float Transmission;
+};
+
+static_assert(std::is_trivially_copyable_v<CacheHeader>);
+static_assert(std::is_trivially_copyable_v<SourceRecord>);
+static_assert(std::is_trivially_copyable_v<MaterialRecord>);
+static_assert(sizeof(glm::uvec4) == 16 && sizeof(glm::vec3) == 12, "mesh arrays are written as they are");
+
+// Bytes of the mesh block
+static uint64_t MeshBytes(uint64_t triangleCount, uint64_t vertexCount)
+{
+	return triangleCount * sizeof(glm::uvec4) + vertexCount * 2 * sizeof(glm::vec3);
+}
+
+// Appends trivially copyable values to a byte buffer
+struct CacheWriter
+{
+	std::vector<uint8_t> Data;
+	
+	template<typename T>
+	void Put(const T& value)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		Data.insert(Data.end(), bytes, bytes + sizeof(T));
+	}
+	
+	void PutString(const std::string& value)
+	{
+		Put(uint32_t(value.size()));
+		Data.insert(Data.end(), value.begin(), value.end());
+	}
+	
+	void Align(size_t alignment)
+	{
+		Data.resize((Data.size() + alignment - 1) / alignment * alignment, 0);
+	}
+};
+
+// Reads values back from the mapping; every Get fails once the data runs out
+struct CacheReader
+{
+	std::string_view Data;
+	size_t Offset = 0;
+	
+	template<typename T>
+	bool Get(T& value)
+	{
+		if (Data.size() - Offset < sizeof(T))
+			return false;
+		std::memcpy(&value, Data.data() + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return true;
+	}
+	
+	// Fills a vector of trivially copyable elements in one copy
+	template<typename T>
+	bool GetArray(std::vector<T>& values, size_t count)
+	{
+		if ((Data.size() - Offset) / sizeof(T) < count)
+			return false;
+		values.resize(count);
+		std::memcpy(values.data(), Data.data() + Offset, count * sizeof(T));
+		Offset += count * sizeof(T);
+		return true;
+	}
+	
+	bool GetString(std::string& value)
+	{
+		uint32_t size = 0;
+		if (!Get(size) || Data.size() - Offset < size)
+			return false;
+		value.assign(Data.data() + Offset, size);
+		Offset += size;
+		return true;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// SourceKey
+// ----------------------------------------------------------------------------
+// How a source path is recorded: absolute and normalized, so "./a.mtl" and
+// "a.mtl" match.
+// ----------------------------------------------------------------------------
+static std::string SourceKey(const std::filesystem::path& path)
+{
+	std::error_code error;
+	std::filesystem::path absolute = std::filesystem::absolute(path, error);
+	return (error ? path : absolute).lexically_normal().string();
+}
+
+static SourceRecord DescribeSource(const std::filesystem::path& path)
+{
+	SourceRecord record = { SOURCE_MISSING, 0, 0 };
+	
+	MappedFile file;
+	if (!file.Open(path))
+		return record;
+	
+	std::error_code error;
+	auto writeTime = std::filesystem::last_write_time(path, error);
+	record.Size = file.GetSize();
+	record.WriteTime = error ? 0 : (int64_t)writeTime.time_since_epoch().count();
+	record.Hash = SceneCache::Hash(file.GetView().data(), file.GetSize());
+	return record;
+}
+
+// ----------------------------------------------------------------------------
+// SourceUnchanged
+// ----------------------------------------------------------------------------
+// Size must match; then either the mtime matches or, failing that, the
+// content hash does.
+// ----------------------------------------------------------------------------
+static bool SourceUnchanged(const SourceRecord& record, const std::filesystem::path& path)
+{
+	std::error_code error;
+	bool exists = std::filesystem::is_regular_file(path, error);
+	
+	if (record.Size == SOURCE_MISSING)
+		return !exists;
+	
+	if (!exists || std::filesystem::file_size(path, error) != record.Size || error)
+		return false;
+	
+	auto writeTime = std::filesystem::last_write_time(path, error);
+	if (!error && (int64_t)writeTime.time_since_epoch().count() == record.WriteTime)
+		return true;
+	
+	MappedFile file;
+	return file.Open(path) && file.GetSize() == record.Size &&
+	       SceneCache::Hash(file.GetView().data(), file.GetSize()) == record.Hash;
+}
+
+// ============================================================================
+// SCENE CACHE IMPLEMENTATION
+// ============================================================================
+
+std::filesystem::path SceneCache::GetCachePath(const std::filesystem::path& sourcePath)
+{
+	std::filesystem::path cachePath = sourcePath;
+	cachePath.replace_extension(".cgscene");
+	return cachePath;
+}
+
+// ----------------------------------------------------------------------------
+// Hash
+// ----------------------------------------------------------------------------
+// Multiply-xorshift over 64-bit words, then the zero-padded tail. seed
+// chains calls, so a checksum can cover data written in several pieces.
+// ----------------------------------------------------------------------------
+uint64_t SceneCache::Hash(const void* data, size_t size, uint64_t seed)
+{
+	constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+	
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t hash = seed ^ (size * MULTIPLIER);
+	
+	auto mix = [&hash](uint64_t word)
+	{
+		hash = (hash ^ word) * MULTIPLIER;
+		hash ^= hash >> 29;
+	};
+	
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t word;
+		std::memcpy(&word, bytes + i, 8);
+		mix(word);
+	}
+	
+	if (i < size)
+	{
+		uint64_t word = 0;
+		std::memcpy(&word, bytes + i, size - i);
+		mix(word);
+	}
+	
+	mix(hash >> 32);
+	return hash;
+}
+
+// ----------------------------------------------------------------------------
+// Write
+// ----------------------------------------------------------------------------
+bool SceneCache::Write(const std::filesystem::path& cachePath, const std::vector<std::filesystem::path>& sources,
+                       const SceneData& scene)
+{
+	const TriangleMesh& mesh = scene.Triangles;
+	
+	CacheHeader header = {};
+	std::memcpy(header.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.Version = VERSION;
+	header.HeaderSize = sizeof(CacheHeader);
+	header.TriangleCount = mesh.size();
+	header.VertexCount = mesh.VertexCount();
+	header.MaterialCount = (uint32_t)scene.Materials.size();
+	header.SourceCount = (uint32_t)sources.size();
+	header.HasCamera = scene.HasCamera;
+	header.HasLight = scene.HasLight;
+	
+	const glm::vec3 camera[3] = { scene.CameraPosition, scene.CameraTarget, scene.CameraUp };
+	std::memcpy(header.Camera, camera, sizeof(header.Camera));
+	std::memcpy(header.Light, &scene.LightPosition, sizeof(header.Light));
+	
+	// Everything between the header and the mesh
+	CacheWriter writer;
+	writer.Put(header);
+	
+	for (const std::filesystem::path& source : sources)
+	{
+		writer.Put(DescribeSource(source));
+		writer.PutString(SourceKey(source));
+	}
+	
+	for (const OBJMaterial& material : scene.Materials)
+	{
+		MaterialRecord record = {
+			{ material.Albedo.r, material.Albedo.g, material.Albedo.b },
+			{ material.Emission.r, material.Emission.g, material.Emission.b },
+			material.Roughness, material.Metallic, material.EmissionStrength, material.IOR, material.Transmission
+		};
+		writer.PutString(material.Name);
+		writer.Put(record);
+	}
+	
+	writer.Align(MESH_ALIGNMENT);
+	
+	// The mesh arrays, in the order MeshBytes counts them
+	const std::pair<const void*, size_t> arrays[] = {
+		{ mesh.Indices.data(), mesh.Indices.size() * sizeof(glm::uvec4) },
+		{ mesh.Positions.data(), mesh.Positions.size() * sizeof(glm::vec3) },
+		{ mesh.Normals.data(), mesh.Normals.size() * sizeof(glm::vec3) },
+	};
+	
+	header.MeshOffset = writer.Data.size();
+	header.FileSize = header.MeshOffset + MeshBytes(header.TriangleCount, header.VertexCount);
+	header.Checksum = Hash(writer.Data.data() + sizeof(CacheHeader), writer.Data.size() - sizeof(CacheHeader));
+	for (const auto& [data, size] : arrays)
+		header.Checksum = Hash(data, size, header.Checksum);
+	std::memcpy(writer.Data.data(), &header, sizeof(CacheHeader));
+	
+	// Write under a unique name and rename, so readers (and other processes
+	// writing the same cache) never see a partial file
+	size_t unique = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+	                (size_t)std::chrono::steady_clock::now().time_since_epoch().count();
+	std::filesystem::path tempPath = cachePath;
+	tempPath += "." + std::to_string(unique) + ".tmp";
+	
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(writer.Data.data()), (std::streamsize)writer.Data.size());
+		for (const auto& [data, size] : arrays)
+			file.write(static_cast<const char*>(data), (std::streamsize)size);
+		if (!file.good())
+		{
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+	}
+	
+	std::error_code error;
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error)
+	{
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+// Read
+// ----------------------------------------------------------------------------
+// Cheap checks first (header, then source sizes and mtimes); the checksum,
+// which touches every page, runs last.
+// ----------------------------------------------------------------------------
+bool SceneCache::Read(const std::filesystem::path& cachePath, const std::filesystem::path& sourcePath,
+                      SceneData& scene)
+{
+	MappedFile mapping;
+	if (!mapping.Open(cachePath))
+		return false;
+	
+	// ========================================================================
+	// Header
+	// ========================================================================
+	CacheReader reader{ mapping.GetView() };
+	CacheHeader header;
+	if (!reader.Get(header) ||
+		std::memcmp(header.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+		header.Version != VERSION || header.HeaderSize != sizeof(CacheHeader) ||
+		header.FileSize != mapping.GetSize() ||
+		header.MeshOffset % MESH_ALIGNMENT != 0 || header.MeshOffset > header.FileSize)
+	{
+		return false;
+	}
+	
+	// Guard the size arithmetic below against absurd counts
+	const uint64_t meshBytes = header.FileSize - header.MeshOffset;
+	if (header.TriangleCount > meshBytes || header.VertexCount > meshBytes ||
+		MeshBytes(header.TriangleCount, header.VertexCount) != meshBytes ||
+		header.MaterialCount > TriangleMesh::MAX_MATERIALS)
+	{
+		return false;
+	}
+	
+	// ========================================================================
+	// Sources
+	// ========================================================================
+	reader.Data = reader.Data.substr(0, header.MeshOffset);
+	const std::string sourceKey = SourceKey(sourcePath);
+	
+	for (uint32_t i = 0; i < header.SourceCount; i++)
+	{
+		SourceRecord record;
+		std::string path;
+		if (!reader.Get(record) || !reader.GetString(path))
+			return false;
+		
+		// The first source is the OBJ the cache belongs to
+		if (i == 0 && path != sourceKey)
+			return false;
+		
+		if (!SourceUnchanged(record, path))
+		{
+			std::cout << "[SceneCache] " << path << " changed, rebuilding " << cachePath.string() << std::endl;
+			return false;
+		}
+	}
+	
+	// ========================================================================
+	// Checksum
+	// ========================================================================
+	// Chained over the same pieces Write hashed
+	const char* base = mapping.GetView().data();
+	const uint64_t arrayBytes[] = {
+		header.TriangleCount * sizeof(glm::uvec4),
+		header.VertexCount * sizeof(glm::vec3),
+		header.VertexCount * sizeof(glm::vec3),
+	};
+	uint64_t checksum = Hash(base + header.HeaderSize, header.MeshOffset - header.HeaderSize);
+	uint64_t offset = header.MeshOffset;
+	for (uint64_t size : arrayBytes)
+	{
+		checksum = Hash(base + offset, size, checksum);
+		offset += size;
+	}
+	
+	if (checksum != header.Checksum)
+	{
+		std::cerr << "[SceneCache] Checksum mismatch, ignoring " << cachePath.string() << std::endl;
+		return false;
+	}
+	
+	// ========================================================================
+	// Scene data
+	// ========================================================================
+	SceneData data;
+	
+	data.Materials.resize(header.MaterialCount);
+	for (OBJMaterial& material : data.Materials)
+	{
+		MaterialRecord record;
+		if (!reader.GetString(material.Name) || !reader.Get(record))
+			return false;
+		
+		material.Albedo = glm::vec3(record.Albedo[0], record.Albedo[1], record.Albedo[2]);
+		material.Emission = glm::vec3(record.Emission[0], record.Emission[1], record.Emission[2]);
+		material.Roughness = record.Roughness;
+		material.Metallic = record.Metallic;
+		material.EmissionStrength = record.EmissionStrength;
+		material.IOR = record.IOR;
+		material.Transmission = record.Transmission;
+	}
+	
+	CacheReader meshReader{ mapping.GetView(), header.MeshOffset };
+	TriangleMesh& mesh = data.Triangles;
+	if (!meshReader.GetArray(mesh.Indices, header.TriangleCount) ||
+		!meshReader.GetArray(mesh.Positions, header.VertexCount) ||
+		!meshReader.GetArray(mesh.Normals, header.VertexCount))
+	{
+		return false;
+	}
+	
+	// Indices come from the file; never let one point past the vertices or
+	// the materials (the renderers index the material table unchecked)
+	for (const glm::uvec4& idx : mesh.Indices)
+	{
+		if (idx.x >= header.VertexCount || idx.y >= header.VertexCount || idx.z >= header.VertexCount ||
+			idx.w >= header.MaterialCount)
+			return false;
+	}
+	
+	data.HasCamera = header.HasCamera != 0;
+	data.CameraPosition = glm::vec3(header.Camera[0], header.Camera[1], header.Camera[2]);
+	data.CameraTarget = glm::vec3(header.Camera[3], header.Camera[4], header.Camera[5]);
+	data.CameraUp = glm::vec3(header.Camera[6], header.Camera[7], header.Camera[8]);
+	data.HasLight = header.HasLight != 0;
+	data.LightPosition = glm::vec3(header.Light[0], header.Light[1], header.Light[2]);
+	
+	scene = std::move(data);
+	return true;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+struct SceneData;
+
+// ============================================================================
+// SCENE CACHE - Binary .cgscene files for instant reloads
+// ============================================================================
+//
+// Parsing and normalizing an OBJ gives the same SceneData every time as long
+// as the OBJ and its MTL files are unchanged. SceneManager therefore stores
+// the result beside the asset (box.obj -> box.cgscene) and, on the next
+// load, maps that file instead of parsing text.
+//
+// FILE LAYOUT:
+// ------------
+//   Header        magic "CGSCENE", format version, sizes, checksum,
+//                 counts, camera and light
+//   Sources       one record per input file: absolute path, size, mtime,
+//                 content hash (the OBJ first, then every MTL it named)
+//   Materials     name and properties of each material
+//   Mesh          the TriangleMesh arrays as they are in memory, one block
+//                 starting 16-byte aligned:
+//                   triangles    (i0, i1, i2, material: 4 x uint32 each,
+//                                 the uTrianglesTex texel layout)
+//                   positions    (3 x float per vertex)
+//                   normals      (3 x float per vertex)
+//
+// A hit is three bulk copies out of the mapping; nothing is parsed,
+// deduplicated, normalized or repacked again, and UploadToGPU sends the
+// arrays to the GPU as they are.
+//
+// VALIDATION:
+// -----------
+// A cache is used only if the header matches this build (magic, version,
+// header size, file size), every source still has the recorded size and
+// either the recorded mtime or the recorded content hash (so a touched or
+// freshly checked-out file does not force a rebuild), and the checksum over
+// everything after the header matches. A source that did not exist when
+// the cache was written must still be missing. Anything else is a miss and
+// the OBJ is parsed again.
+//
+// Files are written in native byte order and are not meant to move between
+// machines.
+//
+// ============================================================================
+
+class SceneCache
+{
+public:
+	static constexpr uint32_t VERSION = 3;
+	
+	// ========================================================================
+	// GetCachePath
+	// ========================================================================
+	// Where the cache of an asset lives: the asset path with its extension
+	// replaced by ".cgscene".
+	// ========================================================================
+	static std::filesystem::path GetCachePath(const std::filesystem::path& sourcePath);
+	
+	// ========================================================================
+	// Write
+	// ========================================================================
+	// Writes the cache of a loaded scene.
+	//
+	// Parameters:
+	//   cachePath - Output file (written to a temporary name, then renamed)
+	//   sources   - Input files, the OBJ first; missing files are recorded
+	//               as missing
+	//   scene     - Normalized scene data
+	//
+	// Returns:
+	//   bool - false if the file could not be written (e.g. read-only
+	//          asset directory); the caller just carries on without cache
+	// ========================================================================
+	static bool Write(const std::filesystem::path& cachePath, const std::vector<std::filesystem::path>& sources,
+	                  const SceneData& scene);
+	
+	// ========================================================================
+	// Read
+	// ========================================================================
+	// Loads a cache if it is valid for sourcePath (see VALIDATION).
+	//
+	// Parameters:
+	//   cachePath  - Cache file
+	//   sourcePath - The OBJ the caller is loading
+	//   scene      - Receives materials, triangles, camera and light
+	//
+	// Returns:
+	//   bool - true on a hit; on a miss scene is left untouched
+	// ========================================================================
+	static bool Read(const std::filesystem::path& cachePath, const std::filesystem::path& sourcePath,
+	                 SceneData& scene);
+	
+	// ========================================================================
+	// Hash
+	// ========================================================================
+	// 64-bit content hash used for sources and the checksum (not
+	// cryptographic; eight bytes per step). Pass a previous result as seed
+	// to hash data in pieces.
+	// ========================================================================
+	static uint64_t Hash(const void* data, size_t size, uint64_t seed = 0);
+};
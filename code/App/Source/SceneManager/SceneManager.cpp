@@ -23,12 +23,13 @@
 //   ┌─────────────────────────────────────────────────────────────────────┐
 //   │                      SceneManager::LoadOBJ()                        │
 //   │  ┌─────────────────────────────────────────────────────────────┐   │
-//   │  │ 1. Read file line by line (FileManager::ReadLines)          │   │
+//   │  │ 1. Read the file in blocks of whole lines (LineBlockReader) │   │
 //   │  │ 2. Parse vertices into m_TempVertices                       │   │
 //   │  │ 3. Parse normals into m_TempNormals                         │   │
 //   │  │ 4. Load MTL file when mtllib encountered                    │   │
 //   │  │ 5. Process faces into Triangle structs                      │   │
-//   │  │ 6. Normalize scene to fit target size                       │   │
+//   │  │ 6. Index them into a TriangleMesh (shared vertices once)    │   │
+//   │  │ 7. Normalize scene to fit target size                       │   │
 //   │  └─────────────────────────────────────────────────────────────┘   │
 //   └─────────────────────────────────────────────────────────────────────┘
 //                                    │
@@ -36,13 +37,12 @@
 //   ┌─────────────────────────────────────────────────────────────────────┐
 //   │                     SceneManager::UploadToGPU()                     │
 //   │  ┌─────────────────────────────────────────────────────────────┐   │
-//   │  │ Pack data into float arrays:                                │   │
-//   │  │   triangleData[i*12..i*12+11] = V0.xyz, V1.xyz, V2.xyz     │   │
-//   │  │   normalData[i*12..i*12+11]   = N0.xyz, N1.xyz, N2.xyz     │   │
-//   │  │   triMatData[i*4..i*4+3]      = materialIndex, 0, 0, 0     │   │
+//   │  │ Pack triangle and material rows:                            │   │
+//   │  │   triangleData[i*4..i*4+3]    = i0, i1, i2, materialIndex   │   │
 //   │  │   materialData[i*12..i*12+11] = albedo, emission, params    │   │
+//   │  │ Positions and normals go up as stored (RGB32F)              │   │
 //   │  │                                                             │   │
-//   │  │ Create GL_TEXTURE_2D with GL_RGBA32F format                 │   │
+//   │  │ Create GL_TEXTURE_2D per array                              │   │
 //   │  │ Use GL_NEAREST filtering (no interpolation for data)        │   │
 //   │  └─────────────────────────────────────────────────────────────┘   │
 //   └─────────────────────────────────────────────────────────────────────┘
@@ -51,10 +51,10 @@
 //   ┌─────────────────────────────────────────────────────────────────────┐
 //   │                    PathTrace.glsl (Shader)                          │
 //   │  ┌─────────────────────────────────────────────────────────────┐   │
-//   │  │ Sample textures to retrieve triangle data:                  │   │
-//   │  │   vec3 v0 = texture(uTrianglesTex, vec2(0.5/3, (i+0.5)/N))  │   │
-//   │  │   vec3 v1 = texture(uTrianglesTex, vec2(1.5/3, (i+0.5)/N))  │   │
-//   │  │   vec3 v2 = texture(uTrianglesTex, vec2(2.5/3, (i+0.5)/N))  │   │
+//   │  │ Fetch texels to retrieve triangle data:                     │   │
+//   │  │   uvec4 tri = texelFetch(uTrianglesTex, ivec2(0, i), 0)     │   │
+//   │  │   vec3 v0 = texelFetch(uPositionsTex,                       │   │
+//   │  │                        ivec2(0, int(tri.x)), 0).xyz         │   │
 //   │  │                                                             │   │
 //   │  │ Perform Möller-Trumbore ray-triangle intersection           │   │
 //   │  └─────────────────────────────────────────────────────────────┘   │
@@ -66,57 +66,312 @@
 #include "FileManager.h"
 
 #include <iostream>
-#include <sstream>
 #include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <thread>
 
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// Split
+// NextLine
 // ----------------------------------------------------------------------------
-// Splits a string by the given delimiter character.
-// Empty tokens are skipped (consecutive delimiters are treated as one).
+// Returns the line at the front of text (without its newline) and advances
+// text past it. Works on the mapped file in place; nothing is copied.
+// ----------------------------------------------------------------------------
+static std::string_view NextLine(std::string_view& text)
+{
+	size_t end = text.find('\n');
+	std::string_view line = text.substr(0, end);
+	text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+	return line;
+}
+
+// ----------------------------------------------------------------------------
+// NextToken
+// ----------------------------------------------------------------------------
+// Returns the next whitespace-separated token of line and advances line past
+// it. Empty once the line is used up (consecutive blanks count as one, and
+// a trailing '\r' from CRLF files is treated as a blank).
 //
 // Example:
-//   Split("v 1.0  2.0 3.0", ' ') returns ["v", "1.0", "2.0", "3.0"]
+//   "v 1.0  2.0 3.0" yields "v", "1.0", "2.0", "3.0", then ""
 // ----------------------------------------------------------------------------
-static std::vector<std::string> Split(const std::string& str, char delimiter = ' ')
+static std::string_view NextToken(std::string_view& line)
 {
-	std::vector<std::string> tokens;
-	std::istringstream stream(str);
-	std::string token;
+	auto isBlank = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
 	
-	while (std::getline(stream, token, delimiter))
-	{
-		if (!token.empty())
-		{
-			tokens.push_back(token);
-		}
-	}
+	size_t start = 0;
+	while (start < line.size() && isBlank(line[start]))
+		start++;
+	
+	size_t end = start;
+	while (end < line.size() && !isBlank(line[end]))
+		end++;
+	
+	std::string_view token = line.substr(start, end - start);
+	line.remove_prefix(end);
+	return token;
+}
+
+// ----------------------------------------------------------------------------
+// ParseFloat / ParseInt
+// ----------------------------------------------------------------------------
+// std::from_chars on a token: no locale, no allocation, no exceptions. A
+// leading '+' is accepted as std::stof/std::stoi did. Malformed numbers
+// read as 0 instead of throwing.
+// ----------------------------------------------------------------------------
+static float ParseFloat(std::string_view token)
+{
+	if (!token.empty() && token[0] == '+')
+		token.remove_prefix(1);
+	
+	float value = 0.0f;
+	std::from_chars(token.data(), token.data() + token.size(), value);
+	return value;
+}
+
+static int ParseInt(std::string_view token)
+{
+	if (!token.empty() && token[0] == '+')
+		token.remove_prefix(1);
+	
+	int value = 0;
+	std::from_chars(token.data(), token.data() + token.size(), value);
+	return value;
+}
+
+// ----------------------------------------------------------------------------
+// ParseVec3
+// ----------------------------------------------------------------------------
+// Reads three floats from line. Returns false if fewer than three tokens
+// are left (the record is skipped, as before).
+// ----------------------------------------------------------------------------
+static bool ParseVec3(std::string_view& line, glm::vec3& v)
+{
+	std::string_view x = NextToken(line);
+	std::string_view y = NextToken(line);
+	std::string_view z = NextToken(line);
 	
-	return tokens;
+	if (z.empty())
+		return false;
+	
+	v = glm::vec3(ParseFloat(x), ParseFloat(y), ParseFloat(z));
+	return true;
 }
 
 // ----------------------------------------------------------------------------
-// Trim
+// ReserveMore
 // ----------------------------------------------------------------------------
-// Removes leading and trailing whitespace from a string.
-// Handles spaces, tabs, carriage returns, and newlines.
+// Makes room for extra more elements. The first call allocates exactly;
+// later ones at least double, since reserve() itself allocates exactly and
+// a vector filled block by block would otherwise be copied every block.
 // ----------------------------------------------------------------------------
-static std::string Trim(const std::string& str)
+template <typename T>
+static void ReserveMore(std::vector<T>& vector, size_t extra)
 {
-	size_t start = str.find_first_not_of(" \t\r\n");
-	size_t end = str.find_last_not_of(" \t\r\n");
+	size_t needed = vector.size() + extra;
+	if (needed > vector.capacity())
+		vector.reserve(vector.capacity() == 0 ? needed : std::max(needed, vector.capacity() * 2));
+}
+
+// ----------------------------------------------------------------------------
+// TriangleOccludes
+// ----------------------------------------------------------------------------
+// Möller-Trumbore test that only answers "is there a hit in [tMin, tMax]".
+// Matches intersectTriangle in PathTrace.glsl but never interpolates the
+// normal or computes the hit point.
+// ----------------------------------------------------------------------------
+static bool TriangleOccludes(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
+                             const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax)
+{
+	glm::vec3 edge1 = v1 - v0;
+	glm::vec3 edge2 = v2 - v0;
+	glm::vec3 h = glm::cross(direction, edge2);
+	float a = glm::dot(edge1, h);
 	
-	if (start == std::string::npos)
-		return "";
+	// Ray parallel to triangle
+	if (std::abs(a) < 1e-4f)
+		return false;
+	
+	float f = 1.0f / a;
+	glm::vec3 s = origin - v0;
+	float u = f * glm::dot(s, h);
+	if (u < 0.0f || u > 1.0f)
+		return false;
 	
-	return str.substr(start, end - start + 1);
+	glm::vec3 q = glm::cross(s, edge1);
+	float v = f * glm::dot(direction, q);
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
+	
+	float t = f * glm::dot(edge2, q);
+	return t >= tMin && t <= tMax;
 }
 
+// ----------------------------------------------------------------------------
+// TriangleIntersect
+// ----------------------------------------------------------------------------
+// Möller-Trumbore test returning the hit distance and barycentrics (u, v)
+// of v1 and v2. Matches intersectTriangle in PathTrace.glsl.
+// ----------------------------------------------------------------------------
+static bool TriangleIntersect(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
+                              const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax,
+                              float& t, float& u, float& v)
+{
+	glm::vec3 edge1 = v1 - v0;
+	glm::vec3 edge2 = v2 - v0;
+	glm::vec3 h = glm::cross(direction, edge2);
+	float a = glm::dot(edge1, h);
+	
+	// Ray parallel to triangle
+	if (std::abs(a) < 1e-4f)
+		return false;
+	
+	float f = 1.0f / a;
+	glm::vec3 s = origin - v0;
+	u = f * glm::dot(s, h);
+	if (u < 0.0f || u > 1.0f)
+		return false;
+	
+	glm::vec3 q = glm::cross(s, edge1);
+	v = f * glm::dot(direction, q);
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
+	
+	t = f * glm::dot(edge2, q);
+	return t >= tMin && t <= tMax;
+}
+
+// ============================================================================
+// INDEXED MESH
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// MeshBuilder
+// ----------------------------------------------------------------------------
+// Appends triangles to a TriangleMesh, sharing every vertex whose position
+// and normal match an existing one bit for bit. Comparing bits keeps -0 and
+// 0 apart and lets the NaN normal of a degenerate face match itself, so the
+// mesh gives back exactly the triangles that went in.
+//
+// The lookup is an open-addressing table of vertex indices over the mesh's
+// own arrays, kept at most half full. Material indices are checked against
+// the scene's material list, which may still grow while an OBJ is read.
+// ----------------------------------------------------------------------------
+class MeshBuilder
+{
+public:
+	MeshBuilder(TriangleMesh& mesh, const std::vector<OBJMaterial>& materials)
+		: m_Mesh(mesh), m_Materials(materials)
+	{
+		Rehash(mesh.VertexCount() * 2);
+	}
+	
+	// Room for triangleCount more triangles (and about vertexCount more
+	// vertices). Repeated calls grow by doubling, so a mesh built in
+	// batches is not copied once per batch.
+	void Reserve(size_t triangleCount, size_t vertexCount = 0)
+	{
+		ReserveMore(m_Mesh.Indices, triangleCount);
+		
+		if (vertexCount > 0)
+		{
+			ReserveMore(m_Mesh.Positions, vertexCount);
+			ReserveMore(m_Mesh.Normals, vertexCount);
+			if ((m_Mesh.VertexCount() + vertexCount) * 2 > m_Slots.size())
+				Rehash((m_Mesh.VertexCount() + vertexCount) * 2);
+		}
+	}
+	
+	void Add(const Triangle& tri)
+	{
+		// Out-of-range indices fall back to the default material
+		bool valid = tri.MaterialIndex >= 0 && size_t(tri.MaterialIndex) < m_Materials.size();
+		m_Mesh.Indices.emplace_back(AddVertex(tri.V0, tri.N0), AddVertex(tri.V1, tri.N1), AddVertex(tri.V2, tri.N2),
+		                            valid ? uint32_t(tri.MaterialIndex) : 0u);
+	}
+	
+	// Drops the slack the vertex arrays grew while building
+	void Finish()
+	{
+		m_Mesh.Positions.shrink_to_fit();
+		m_Mesh.Normals.shrink_to_fit();
+		m_Mesh.Indices.shrink_to_fit();
+		m_Slots = std::vector<uint32_t>();
+	}
+
+private:
+	static size_t HashVertex(const glm::vec3& position, const glm::vec3& normal)
+	{
+		uint32_t bits[6];
+		std::memcpy(bits, &position, sizeof(glm::vec3));
+		std::memcpy(bits + 3, &normal, sizeof(glm::vec3));
+		
+		uint64_t hash = 0;
+		for (uint32_t word : bits)
+		{
+			hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+			hash ^= hash >> 32;
+		}
+		return size_t(hash);
+	}
+	
+	bool SameVertex(uint32_t vertex, const glm::vec3& position, const glm::vec3& normal) const
+	{
+		return std::memcmp(&m_Mesh.Positions[vertex], &position, sizeof(glm::vec3)) == 0 &&
+		       std::memcmp(&m_Mesh.Normals[vertex], &normal, sizeof(glm::vec3)) == 0;
+	}
+	
+	uint32_t AddVertex(const glm::vec3& position, const glm::vec3& normal)
+	{
+		if ((m_Mesh.VertexCount() + 1) * 2 > m_Slots.size())
+			Rehash(m_Slots.size() * 2);
+		
+		size_t mask = m_Slots.size() - 1;
+		size_t slot = HashVertex(position, normal) & mask;
+		
+		// Slots hold vertex index + 1; 0 marks an empty slot
+		while (m_Slots[slot] != 0)
+		{
+			if (SameVertex(m_Slots[slot] - 1, position, normal))
+				return m_Slots[slot] - 1;
+			slot = (slot + 1) & mask;
+		}
+		
+		m_Mesh.Positions.push_back(position);
+		m_Mesh.Normals.push_back(normal);
+		m_Slots[slot] = (uint32_t)m_Mesh.VertexCount();
+		return m_Slots[slot] - 1;
+	}
+	
+	// Resizes the table to a power of two of at least minSlots and
+	// reinserts every vertex
+	void Rehash(size_t minSlots)
+	{
+		size_t slots = 1024;
+		while (slots < minSlots)
+			slots *= 2;
+		
+		m_Slots.assign(slots, 0);
+		size_t mask = slots - 1;
+		for (uint32_t vertex = 0; vertex < m_Mesh.VertexCount(); ++vertex)
+		{
+			size_t slot = HashVertex(m_Mesh.Positions[vertex], m_Mesh.Normals[vertex]) & mask;
+			while (m_Slots[slot] != 0)
+				slot = (slot + 1) & mask;
+			m_Slots[slot] = vertex + 1;
+		}
+	}
+	
+	TriangleMesh& m_Mesh;
+	const std::vector<OBJMaterial>& m_Materials;
+	std::vector<uint32_t> m_Slots;
+};
+
 // ============================================================================
 // SCENE MANAGER IMPLEMENTATION
 // ============================================================================
@@ -140,40 +395,196 @@ void SceneManager::Clear()
 	// Clear temporary parsing buffers
 	m_TempVertices.clear();
 	m_TempNormals.clear();
-	m_TempTexCoords.clear();
 	m_MaterialMap.clear();
 	m_CurrentMaterialIndex = 0;
 	m_CurrentMaterial = nullptr;
 	
+	m_SourceFiles.clear();
+	m_FromSceneCache = false;
+	
 	// Delete GPU textures
 	if (m_TriangleTexture) glDeleteTextures(1, &m_TriangleTexture);
+	if (m_PositionTexture) glDeleteTextures(1, &m_PositionTexture);
 	if (m_NormalTexture) glDeleteTextures(1, &m_NormalTexture);
 	if (m_MaterialTexture) glDeleteTextures(1, &m_MaterialTexture);
-	if (m_TriMatTexture) glDeleteTextures(1, &m_TriMatTexture);
 	
 	m_TriangleTexture = 0;
+	m_PositionTexture = 0;
 	m_NormalTexture = 0;
 	m_MaterialTexture = 0;
-	m_TriMatTexture = 0;
 	m_GPUDataValid = false;
 }
 
+// ============================================================================
+// OBJ PARSING
+// ============================================================================
+//
+// LoadOBJ streams the file in blocks of whole lines (LineBlockReader) and
+// runs three phases on each block, so that large files use every core:
+//
+//   1. Parse (parallel)       The block is cut at line boundaries into one
+//                             chunk per thread. Each chunk collects its own
+//                             v/vn records, the face corners as written,
+//                             and the order-dependent commands (mtllib,
+//                             usemtl, c, lp).
+//   2. Merge (sequential)     Chunk arrays are appended in file order; the
+//                             running totals (prefix sums) become each
+//                             chunk's vertex/normal offsets. The commands are
+//                             applied in file order, which loads MTL files,
+//                             turns usemtl into per-chunk material runs and
+//                             carries the current material into the next
+//                             chunk.
+//   3. Triangulate (parallel) Each chunk resolves its faces against the
+//                             merged arrays.
+//
+// Faces and commands remember how many of their chunk's v/vn records came
+// before them. A negative index n then resolves to offset + count + n + 1,
+// and a positive one must be <= offset + count: exactly what a reader going
+// through the file line by line would compute.
+//
+// Files smaller than two chunks are parsed as one chunk on the calling
+// thread.
+//
+// STREAMING:
+// ----------
+// The merged v/vn arrays and the current material carry over from block to
+// block, so a face may use any vertex before it, however far back. What a
+// block produces is indexed into the mesh before the next block is read,
+// and the v/vn arrays are dropped once the last face is resolved. At any
+// time the loader holds one block of text and its chunks, the v/vn records,
+// and the mesh built so far.
+//
+// A file larger than one block is first counted (v, vn and triangles, see
+// CountOBJ) so that those arrays are reserved once at their final size;
+// growing them by doubling would briefly need two copies and leave up to
+// half of each unused.
+// ============================================================================
+
+// Face corner as written in the file (1-based, negative = relative, 0 = none)
+struct OBJFaceCorner
+{
+	int Vertex;
+	int Normal;
+};
+
+struct OBJFace
+{
+	uint32_t FirstCorner;       // Into OBJChunk::Corners
+	uint32_t CornerCount;
+	uint32_t VertexCount;       // Chunk's v records before this face
+	uint32_t NormalCount;       // Chunk's vn records before this face
+};
+
+// mtllib, usemtl, c or lp, applied in file order by MergeChunks
+struct OBJCommand
+{
+	enum class Type { MaterialLibrary, UseMaterial, Camera, LightPoint };
+	
+	Type Kind;
+	std::string_view Name;      // mtllib/usemtl argument (points into the file)
+	int Indices[3] = {};        // c: eye, target, up; lp: vertex
+	size_t FaceIndex = 0;       // Chunk's faces before this command
+	uint32_t VertexCount = 0;   // Chunk's v records before this command
+	uint32_t NormalCount = 0;   // Chunk's vn records before this command
+};
+
+struct SceneManager::OBJChunk
+{
+	std::string_view Text;
+	
+	// Parse results (chunk-local)
+	std::vector<glm::vec3> Vertices;
+	std::vector<glm::vec3> Normals;
+	std::vector<OBJFaceCorner> Corners;
+	std::vector<OBJFace> Faces;
+	std::vector<OBJCommand> Commands;
+	
+	// Set by MergeChunks
+	size_t VertexOffset = 0;    // v records in earlier chunks
+	size_t NormalOffset = 0;    // vn records in earlier chunks
+	std::vector<std::pair<size_t, int>> MaterialRuns;  // (first face, material index)
+	
+	// Set by ProcessFaces
+	std::vector<Triangle> Triangles;
+	size_t InvalidTriangles = 0;
+};
+
+// Record counts of a whole file (CountOBJ); upper bounds, since records
+// ParseOBJLine rejects are counted as well
+struct SceneManager::OBJCounts
+{
+	size_t Vertices = 0;
+	size_t Normals = 0;
+	size_t Triangles = 0;
+	
+	OBJCounts& operator+=(const OBJCounts& other)
+	{
+		Vertices += other.Vertices;
+		Normals += other.Normals;
+		Triangles += other.Triangles;
+		return *this;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// ParallelFor
+// ----------------------------------------------------------------------------
+// Runs function(i) for i in [0, count), one thread each; index 0 runs on the
+// calling thread, so a single chunk starts no thread at all.
+// ----------------------------------------------------------------------------
+template <typename Function>
+static void ParallelFor(size_t count, const Function& function)
+{
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < count; i++)
+		threads.emplace_back(function, i);
+	
+	if (count > 0)
+		function(size_t(0));
+	
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
 // ----------------------------------------------------------------------------
 // LoadOBJ
 // ----------------------------------------------------------------------------
 // Main entry point for loading an OBJ file.
 //
 // Processing steps:
-//   1. Read all lines from file
+//   1. Open the file for block reads (counting it first if it spans blocks)
 //   2. Create default material (index 0)
-//   3. Parse each line (vertices, normals, faces, materials)
-//   4. Normalize scene to target size
+//   3. Per block: parse, merge and triangulate the chunks, index the
+//      triangles (see OBJ PARSING)
+//   4. Release the v/vn records
+//   5. Normalize scene to target size
 // ----------------------------------------------------------------------------
 bool SceneManager::LoadOBJ(const std::filesystem::path& path)
 {
-	auto lines = FileManager::ReadLines(path);
+	m_FromSceneCache = false;
 	
-	if (!lines.has_value())
+	// The cache holds a whole normalized scene, so it only stands in for a
+	// load into an empty one
+	bool useCache = m_UseSceneCache && m_SceneData.Materials.empty() && m_SceneData.Triangles.empty();
+	std::filesystem::path cachePath = SceneCache::GetCachePath(path);
+	if (useCache && SceneCache::Read(cachePath, path, m_SceneData))
+	{
+		m_BasePath = path;
+		for (size_t i = 0; i < m_SceneData.Materials.size(); ++i)
+		{
+			m_MaterialMap.emplace(m_SceneData.Materials[i].Name, int(i));
+		}
+		m_FromSceneCache = true;
+		
+		std::cout << "[SceneManager] Loaded " << m_SceneData.Triangles.size() << " triangles, "
+				  << m_SceneData.Materials.size() << " materials from scene cache "
+				  << cachePath.string() << std::endl;
+		return !m_SceneData.Triangles.empty();
+	}
+	
+	LineBlockReader reader;
+	
+	if (!reader.Open(path, m_LoadBlockBytes))
 	{
 		std::cerr << "[SceneManager] Failed to load OBJ file: " << path.string() << std::endl;
 		return false;
@@ -181,6 +592,7 @@ bool SceneManager::LoadOBJ(const std::filesystem::path& path)
 	
 	// Store base path for resolving relative MTL paths
 	m_BasePath = path;
+	m_SourceFiles = { path };
 	
 	// Create default material (used when no material is specified)
 	OBJMaterial defaultMat;
@@ -191,29 +603,237 @@ bool SceneManager::LoadOBJ(const std::filesystem::path& path)
 	
 	std::cout << "[SceneManager] Loading OBJ: " << path.string() << std::endl;
 	
-	// Parse each line
-	for (const auto& line : lines.value())
+	MeshBuilder mesh(m_SceneData.Triangles, m_SceneData.Materials);
+	
+	if (reader.GetFileSize() > m_LoadBlockBytes)
 	{
-		ParseOBJLine(line);
+		OBJCounts counts = CountOBJ(reader);
+		reader.Rewind();
+		
+		// Positions are a guess: one mesh vertex per v record
+		ReserveMore(m_TempVertices, counts.Vertices);
+		ReserveMore(m_TempNormals, counts.Normals);
+		mesh.Reserve(counts.Triangles, counts.Vertices);
 	}
 	
+	size_t blockCount = 0;
+	size_t invalidCount = 0;
+	std::string_view block;
+	
+	while (reader.Next(block))
+	{
+		std::vector<OBJChunk> chunks = SplitChunks(block);
+		if (blockCount == 0 && chunks.size() > 1)
+			std::cout << "[SceneManager] Parsing in " << chunks.size() << " chunks" << std::endl;
+		blockCount++;
+		
+		ParallelFor(chunks.size(), [&chunks](size_t i)
+		{
+			std::string_view text = chunks[i].Text;
+			while (!text.empty())
+			{
+				ParseOBJLine(NextLine(text), chunks[i]);
+			}
+		});
+		
+		MergeChunks(chunks);
+		
+		ParallelFor(chunks.size(), [this, &chunks](size_t i)
+		{
+			ProcessFaces(chunks[i]);
+		});
+		
+		// Index the triangles in file order, so vertex numbering does not
+		// depend on the chunking or the block size
+		size_t triangleCount = 0;
+		for (const OBJChunk& chunk : chunks)
+		{
+			triangleCount += chunk.Triangles.size();
+			invalidCount += chunk.InvalidTriangles;
+		}
+		
+		mesh.Reserve(triangleCount);
+		for (OBJChunk& chunk : chunks)
+		{
+			for (const Triangle& tri : chunk.Triangles)
+				mesh.Add(tri);
+			chunk.Triangles = std::vector<Triangle>();
+		}
+	}
+	
+	mesh.Finish();
+	
+	// Every face is resolved; the v/vn records are not needed any more
+	m_TempVertices = std::vector<glm::vec3>();
+	m_TempNormals = std::vector<glm::vec3>();
+	
+	if (reader.Failed())
+	{
+		std::cerr << "[SceneManager] Read error in OBJ file: " << path.string() << std::endl;
+		return false;
+	}
+	
+	if (blockCount > 1)
+		std::cout << "[SceneManager] Read " << blockCount << " blocks" << std::endl;
+	
+	if (invalidCount > 0)
+		std::cerr << "[SceneManager] Skipped " << invalidCount << " triangles with invalid vertex indices" << std::endl;
+	
 	// Normalize scene to fit in a 6x6x6 box centered at origin
 	NormalizeScene(6.0f);
 	
 	std::cout << "[SceneManager] Loaded " << m_SceneData.Triangles.size() << " triangles, "
 			  << m_SceneData.Materials.size() << " materials" << std::endl;
 	
+	if (useCache && !m_SceneData.Triangles.empty())
+	{
+		if (SceneCache::Write(cachePath, m_SourceFiles, m_SceneData))
+			std::cout << "[SceneManager] Wrote scene cache " << cachePath.string() << std::endl;
+		else
+			std::cerr << "[SceneManager] Could not write scene cache " << cachePath.string() << std::endl;
+	}
+	
 	return !m_SceneData.Triangles.empty();
 }
 
+// ----------------------------------------------------------------------------
+// SetLoadThreads
+// ----------------------------------------------------------------------------
+void SceneManager::SetLoadThreads(int threads, size_t minChunkBytes)
+{
+	m_LoadThreads = std::max(threads, 0);
+	m_MinChunkBytes = std::max(minChunkBytes, size_t(1));
+}
+
+// ----------------------------------------------------------------------------
+// SetLoadBlockSize
+// ----------------------------------------------------------------------------
+void SceneManager::SetLoadBlockSize(size_t blockBytes)
+{
+	m_LoadBlockBytes = std::max(blockBytes, size_t(1));
+}
+
+// ----------------------------------------------------------------------------
+// SetTriangles
+// ----------------------------------------------------------------------------
+// Swaps in generated geometry. The material list is left alone so the
+// triangles' MaterialIndex values keep pointing at what LoadMTL read; the
+// GPU copy is stale until the next UploadToGPU.
+// ----------------------------------------------------------------------------
+void SceneManager::SetTriangles(const std::vector<Triangle>& triangles)
+{
+	if (m_SceneData.Materials.empty())
+	{
+		OBJMaterial defaultMat;
+		defaultMat.Name = "default";
+		defaultMat.Albedo = glm::vec3(0.8f);  // Light gray
+		m_SceneData.Materials.push_back(defaultMat);
+		m_MaterialMap["default"] = 0;
+	}
+	
+	m_FromSceneCache = false;
+	m_SceneData.Triangles = TriangleMesh();
+	
+	MeshBuilder mesh(m_SceneData.Triangles, m_SceneData.Materials);
+	mesh.Reserve(triangles.size());
+	for (const Triangle& tri : triangles)
+		mesh.Add(tri);
+	mesh.Finish();
+	
+	m_GPUDataValid = false;
+}
+
+// ----------------------------------------------------------------------------
+// SplitChunks
+// ----------------------------------------------------------------------------
+// Cuts text into one chunk per load thread, but none smaller than
+// m_MinChunkBytes. Each cut is moved forward to just past the next newline,
+// so every line lies in exactly one chunk.
+// ----------------------------------------------------------------------------
+std::vector<SceneManager::OBJChunk> SceneManager::SplitChunks(std::string_view text) const
+{
+	size_t threads = m_LoadThreads > 0 ? size_t(m_LoadThreads)
+	                                   : std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+	size_t count = std::clamp(text.size() / m_MinChunkBytes, size_t(1), threads);
+	
+	std::vector<OBJChunk> chunks(count);
+	size_t begin = 0;
+	
+	for (size_t i = 0; i < count; i++)
+	{
+		size_t end = text.size();
+		if (i + 1 < count)
+		{
+			end = std::max(begin, text.size() / count * (i + 1));
+			end = text.find('\n', end);
+			end = (end == std::string_view::npos) ? text.size() : end + 1;
+		}
+		
+		chunks[i].Text = text.substr(begin, end - begin);
+		begin = end;
+	}
+	
+	return chunks;
+}
+
+// ----------------------------------------------------------------------------
+// CountOBJ
+// ----------------------------------------------------------------------------
+// First pass over a file that spans several blocks: counts the v and vn
+// records and the triangles the faces will fan into. Only tokenizes, no
+// number is converted, and the chunks of each block are counted in
+// parallel. Leaves the reader at the end of the file.
+// ----------------------------------------------------------------------------
+SceneManager::OBJCounts SceneManager::CountOBJ(LineBlockReader& reader) const
+{
+	OBJCounts total;
+	std::string_view block;
+	
+	while (reader.Next(block))
+	{
+		std::vector<OBJChunk> chunks = SplitChunks(block);
+		std::vector<OBJCounts> counts(chunks.size());
+		
+		ParallelFor(chunks.size(), [&chunks, &counts](size_t i)
+		{
+			std::string_view text = chunks[i].Text;
+			while (!text.empty())
+			{
+				std::string_view line = NextLine(text);
+				std::string_view cmd = NextToken(line);
+				
+				if (cmd == "v")
+					counts[i].Vertices++;
+				else if (cmd == "vn")
+					counts[i].Normals++;
+				else if (cmd == "f")
+				{
+					size_t corners = 0;
+					while (!NextToken(line).empty())
+						corners++;
+					if (corners >= 3)
+						counts[i].Triangles += corners - 2;
+				}
+			}
+		});
+		
+		for (const OBJCounts& count : counts)
+			total += count;
+	}
+	
+	return total;
+}
+
 // ----------------------------------------------------------------------------
 // ParseOBJLine
 // ----------------------------------------------------------------------------
-// Parses a single line from an OBJ file.
+// Parses a single line from an OBJ file into chunk. Geometry is stored
+// chunk-local; everything that depends on earlier lines is resolved later
+// by MergeChunks and ProcessFaces.
 //
 // Supported commands:
 //   v x y z       - Vertex position
-//   vn x y z      - Vertex normal  
+//   vn x y z      - Vertex normal
 //   vt u v        - Texture coordinate
 //   f v/vt/vn ... - Face definition
 //   mtllib file   - Material library
@@ -222,20 +842,25 @@ bool SceneManager::LoadOBJ(const std::filesystem::path& path)
 //   lp v          - Light point (custom extension)
 //   g, o, s       - Grouping (ignored)
 // ----------------------------------------------------------------------------
-void SceneManager::ParseOBJLine(const std::string& line)
+void SceneManager::ParseOBJLine(std::string_view line, OBJChunk& chunk)
 {
-	std::string trimmed = Trim(line);
+	std::string_view cmd = NextToken(line);
 	
 	// Skip empty lines and comments
-	if (trimmed.empty() || trimmed[0] == '#')
+	if (cmd.empty() || cmd[0] == '#')
 		return;
 	
-	std::vector<std::string> tokens = Split(trimmed);
-	
-	if (tokens.empty())
-		return;
-	
-	const std::string& cmd = tokens[0];
+	// Records an order-dependent command at the current position
+	auto addCommand = [&chunk](OBJCommand::Type type) -> OBJCommand&
+	{
+		OBJCommand command;
+		command.Kind = type;
+		command.FaceIndex = chunk.Faces.size();
+		command.VertexCount = (uint32_t)chunk.Vertices.size();
+		command.NormalCount = (uint32_t)chunk.Normals.size();
+		chunk.Commands.push_back(command);
+		return chunk.Commands.back();
+	};
 	
 	// ========================================================================
 	// VERTEX POSITION: v x y z [w]
@@ -243,38 +868,32 @@ void SceneManager::ParseOBJLine(const std::string& line)
 	// Defines a vertex in 3D space. The optional w component is ignored.
 	// OBJ indices are 1-based, so the first vertex is index 1.
 	// ========================================================================
-	if (cmd == "v" && tokens.size() >= 4)
+	if (cmd == "v")
 	{
 		glm::vec3 v;
-		v.x = std::stof(tokens[1]);
-		v.y = std::stof(tokens[2]);
-		v.z = std::stof(tokens[3]);
-		m_TempVertices.push_back(v);
+		if (ParseVec3(line, v))
+			chunk.Vertices.push_back(v);
 	}
 	// ========================================================================
 	// VERTEX NORMAL: vn x y z
 	// ========================================================================
 	// Defines a normal vector. Automatically normalized on load.
 	// ========================================================================
-	else if (cmd == "vn" && tokens.size() >= 4)
+	else if (cmd == "vn")
 	{
 		glm::vec3 n;
-		n.x = std::stof(tokens[1]);
-		n.y = std::stof(tokens[2]);
-		n.z = std::stof(tokens[3]);
-		m_TempNormals.push_back(glm::normalize(n));
+		if (ParseVec3(line, n))
+			chunk.Normals.push_back(glm::normalize(n));
 	}
 	// ========================================================================
 	// TEXTURE COORDINATE: vt u v [w]
 	// ========================================================================
-	// Defines a texture coordinate. Currently parsed but not used in shader.
+	// Defines a texture coordinate. Nothing uses them yet, and face corners
+	// keep no vt index, so the record is recognized and not stored.
 	// ========================================================================
-	else if (cmd == "vt" && tokens.size() >= 3)
+	else if (cmd == "vt")
 	{
-		glm::vec2 t;
-		t.x = std::stof(tokens[1]);
-		t.y = std::stof(tokens[2]);
-		m_TempTexCoords.push_back(t);
+		// Texture coordinates - not stored
 	}
 	// ========================================================================
 	// FACE: f v1[/vt1][/vn1] v2[/vt2][/vn2] v3[/vt3][/vn3] ...
@@ -282,9 +901,27 @@ void SceneManager::ParseOBJLine(const std::string& line)
 	// Defines a polygonal face. Automatically triangulated if more than 3 vertices.
 	// Supports formats: f v, f v/vt, f v/vt/vn, f v//vn
 	// ========================================================================
-	else if (cmd == "f" && tokens.size() >= 4)
+	else if (cmd == "f")
 	{
-		ProcessFace(tokens);
+		OBJFace face;
+		face.FirstCorner = (uint32_t)chunk.Corners.size();
+		face.VertexCount = (uint32_t)chunk.Vertices.size();
+		face.NormalCount = (uint32_t)chunk.Normals.size();
+		
+		for (std::string_view token = NextToken(line); !token.empty(); token = NextToken(line))
+		{
+			int vIdx, vtIdx, vnIdx;
+			ParseFaceVertex(token, vIdx, vtIdx, vnIdx);
+			chunk.Corners.push_back({ vIdx, vnIdx });
+		}
+		
+		face.CornerCount = (uint32_t)chunk.Corners.size() - face.FirstCorner;
+		
+		// Fewer than three corners make no triangle
+		if (face.CornerCount >= 3)
+			chunk.Faces.push_back(face);
+		else
+			chunk.Corners.resize(face.FirstCorner);
 	}
 	// ========================================================================
 	// MATERIAL LIBRARY: mtllib filename.mtl
@@ -292,19 +929,22 @@ void SceneManager::ParseOBJLine(const std::string& line)
 	// References an external material library file.
 	// Path is resolved relative to the OBJ file's directory.
 	// ========================================================================
-	else if (cmd == "mtllib" && tokens.size() >= 2)
+	else if (cmd == "mtllib")
 	{
-		std::filesystem::path mtlPath = FileManager::ResolvePath(m_BasePath, tokens[1]);
-		LoadMTL(mtlPath);
+		std::string_view name = NextToken(line);
+		if (!name.empty())
+			addCommand(OBJCommand::Type::MaterialLibrary).Name = name;
 	}
 	// ========================================================================
 	// USE MATERIAL: usemtl material_name
 	// ========================================================================
 	// Sets the active material for subsequent faces.
 	// ========================================================================
-	else if (cmd == "usemtl" && tokens.size() >= 2)
+	else if (cmd == "usemtl")
 	{
-		m_CurrentMaterialIndex = GetMaterialIndex(tokens[1]);
+		std::string_view name = NextToken(line);
+		if (!name.empty())
+			addCommand(OBJCommand::Type::UseMaterial).Name = name;
 	}
 	// ========================================================================
 	// CAMERA (Custom Extension): c eye_idx target_idx up_idx
@@ -313,35 +953,18 @@ void SceneManager::ParseOBJLine(const std::string& line)
 	// Used in Cornell Box OBJ format.
 	// Negative indices are relative to current position (OBJ standard).
 	// ========================================================================
-	else if (cmd == "c" && tokens.size() >= 4)
+	else if (cmd == "c")
 	{
-		int eyeIdx = std::stoi(tokens[1]);
-		int targetIdx = std::stoi(tokens[2]);
-		int upIdx = std::stoi(tokens[3]);
+		std::string_view eye = NextToken(line);
+		std::string_view target = NextToken(line);
+		std::string_view up = NextToken(line);
+		if (up.empty())
+			return;
 		
-		// Handle negative indices (relative to end of list)
-		if (eyeIdx < 0) eyeIdx = (int)m_TempVertices.size() + eyeIdx + 1;
-		if (targetIdx < 0) targetIdx = (int)m_TempVertices.size() + targetIdx + 1;
-		
-		if (eyeIdx > 0 && eyeIdx <= (int)m_TempVertices.size() &&
-			targetIdx > 0 && targetIdx <= (int)m_TempVertices.size())
-		{
-			m_SceneData.CameraPosition = m_TempVertices[eyeIdx - 1];
-			m_SceneData.CameraTarget = m_TempVertices[targetIdx - 1];
-			
-			// Handle normal index for up vector
-			if (upIdx < 0) upIdx = (int)m_TempNormals.size() + upIdx + 1;
-			if (upIdx > 0 && upIdx <= (int)m_TempNormals.size())
-			{
-				m_SceneData.CameraUp = m_TempNormals[upIdx - 1];
-			}
-			
-			m_SceneData.HasCamera = true;
-			std::cout << "[SceneManager] Camera found at: " 
-					  << m_SceneData.CameraPosition.x << ", "
-					  << m_SceneData.CameraPosition.y << ", "
-					  << m_SceneData.CameraPosition.z << std::endl;
-		}
+		OBJCommand& command = addCommand(OBJCommand::Type::Camera);
+		command.Indices[0] = ParseInt(eye);
+		command.Indices[1] = ParseInt(target);
+		command.Indices[2] = ParseInt(up);
 	}
 	// ========================================================================
 	// LIGHT POINT (Custom Extension): lp vertex_idx
@@ -349,20 +972,11 @@ void SceneManager::ParseOBJLine(const std::string& line)
 	// Defines a point light position using a vertex index.
 	// Used in Cornell Box OBJ format.
 	// ========================================================================
-	else if (cmd == "lp" && tokens.size() >= 2)
+	else if (cmd == "lp")
 	{
-		int idx = std::stoi(tokens[1]);
-		if (idx < 0) idx = (int)m_TempVertices.size() + idx + 1;
-		
-		if (idx > 0 && idx <= (int)m_TempVertices.size())
-		{
-			m_SceneData.LightPosition = m_TempVertices[idx - 1];
-			m_SceneData.HasLight = true;
-			std::cout << "[SceneManager] Light found at: "
-					  << m_SceneData.LightPosition.x << ", "
-					  << m_SceneData.LightPosition.y << ", "
-					  << m_SceneData.LightPosition.z << std::endl;
-		}
+		std::string_view vertex = NextToken(line);
+		if (!vertex.empty())
+			addCommand(OBJCommand::Type::LightPoint).Indices[0] = ParseInt(vertex);
 	}
 	// ========================================================================
 	// GROUPING COMMANDS: g, o, s
@@ -377,9 +991,122 @@ void SceneManager::ParseOBJLine(const std::string& line)
 }
 
 // ----------------------------------------------------------------------------
-// ProcessFace
+// MergeChunks
 // ----------------------------------------------------------------------------
-// Processes a face definition and creates Triangle structs.
+// Sequential middle phase: appends the chunk arrays to m_TempVertices/
+// m_TempNormals in file order, recording each chunk's
+// offsets (the prefix sums of the per-chunk counts), then applies the
+// commands in file order.
+//
+// Each chunk's material runs start with the material that was current at
+// the end of the previous chunk, so usemtl carries across chunk boundaries.
+// ----------------------------------------------------------------------------
+void SceneManager::MergeChunks(std::vector<OBJChunk>& chunks)
+{
+	size_t vertexTotal = m_TempVertices.size();
+	size_t normalTotal = m_TempNormals.size();
+	
+	for (OBJChunk& chunk : chunks)
+	{
+		chunk.VertexOffset = vertexTotal;
+		chunk.NormalOffset = normalTotal;
+		vertexTotal += chunk.Vertices.size();
+		normalTotal += chunk.Normals.size();
+	}
+	
+	ReserveMore(m_TempVertices, vertexTotal - m_TempVertices.size());
+	ReserveMore(m_TempNormals, normalTotal - m_TempNormals.size());
+	
+	for (OBJChunk& chunk : chunks)
+	{
+		m_TempVertices.insert(m_TempVertices.end(), chunk.Vertices.begin(), chunk.Vertices.end());
+		m_TempNormals.insert(m_TempNormals.end(), chunk.Normals.begin(), chunk.Normals.end());
+		
+		chunk.Vertices = std::vector<glm::vec3>();
+		chunk.Normals = std::vector<glm::vec3>();
+	}
+	
+	for (OBJChunk& chunk : chunks)
+	{
+		chunk.MaterialRuns.push_back({ 0, m_CurrentMaterialIndex });
+		
+		for (const OBJCommand& command : chunk.Commands)
+		{
+			// v/vn records read so far when the reader reached this command
+			int vertexCount = (int)(chunk.VertexOffset + command.VertexCount);
+			int normalCount = (int)(chunk.NormalOffset + command.NormalCount);
+			
+			switch (command.Kind)
+			{
+			case OBJCommand::Type::MaterialLibrary:
+				LoadMTL(FileManager::ResolvePath(m_BasePath, std::filesystem::path(command.Name)));
+				break;
+			
+			case OBJCommand::Type::UseMaterial:
+				m_CurrentMaterialIndex = GetMaterialIndex(std::string(command.Name));
+				chunk.MaterialRuns.push_back({ command.FaceIndex, m_CurrentMaterialIndex });
+				break;
+			
+			case OBJCommand::Type::Camera:
+			{
+				int eyeIdx = command.Indices[0];
+				int targetIdx = command.Indices[1];
+				int upIdx = command.Indices[2];
+				
+				// Handle negative indices (relative to end of list)
+				if (eyeIdx < 0) eyeIdx = vertexCount + eyeIdx + 1;
+				if (targetIdx < 0) targetIdx = vertexCount + targetIdx + 1;
+				
+				if (eyeIdx > 0 && eyeIdx <= vertexCount &&
+					targetIdx > 0 && targetIdx <= vertexCount)
+				{
+					m_SceneData.CameraPosition = m_TempVertices[eyeIdx - 1];
+					m_SceneData.CameraTarget = m_TempVertices[targetIdx - 1];
+					
+					// Handle normal index for up vector
+					if (upIdx < 0) upIdx = normalCount + upIdx + 1;
+					if (upIdx > 0 && upIdx <= normalCount)
+					{
+						m_SceneData.CameraUp = m_TempNormals[upIdx - 1];
+					}
+					
+					m_SceneData.HasCamera = true;
+					std::cout << "[SceneManager] Camera found at: "
+							  << m_SceneData.CameraPosition.x << ", "
+							  << m_SceneData.CameraPosition.y << ", "
+							  << m_SceneData.CameraPosition.z << std::endl;
+				}
+				break;
+			}
+			
+			case OBJCommand::Type::LightPoint:
+			{
+				int idx = command.Indices[0];
+				if (idx < 0) idx = vertexCount + idx + 1;
+				
+				if (idx > 0 && idx <= vertexCount)
+				{
+					m_SceneData.LightPosition = m_TempVertices[idx - 1];
+					m_SceneData.HasLight = true;
+					std::cout << "[SceneManager] Light found at: "
+							  << m_SceneData.LightPosition.x << ", "
+							  << m_SceneData.LightPosition.y << ", "
+							  << m_SceneData.LightPosition.z << std::endl;
+				}
+				break;
+			}
+			}
+		}
+		
+		chunk.Commands = std::vector<OBJCommand>();
+	}
+}
+
+// ----------------------------------------------------------------------------
+// ProcessFaces
+// ----------------------------------------------------------------------------
+// Turns a chunk's faces into Triangle structs. Reads only the merged
+// vertex/normal arrays and the chunk itself, so chunks run in parallel.
 //
 // Face triangulation:
 //   For polygons with N > 3 vertices, we use fan triangulation:
@@ -393,81 +1120,99 @@ void SceneManager::ParseOBJLine(const std::string& line)
 //   If per-vertex normals are provided (vn), use smooth shading.
 //   Otherwise, compute flat face normal from cross product.
 // ----------------------------------------------------------------------------
-void SceneManager::ProcessFace(const std::vector<std::string>& tokens)
+void SceneManager::ProcessFaces(OBJChunk& chunk) const
 {
-	// tokens[0] is "f", rest are vertex definitions
-	std::vector<int> vertexIndices;
-	std::vector<int> normalIndices;
+	size_t triangleCount = 0;
+	for (const OBJFace& face : chunk.Faces)
+		triangleCount += face.CornerCount - 2;
+	chunk.Triangles.reserve(triangleCount);
 	
-	// Parse each vertex definition
-	for (size_t i = 1; i < tokens.size(); ++i)
-	{
-		int vIdx, vtIdx, vnIdx;
-		ParseFaceVertex(tokens[i], vIdx, vtIdx, vnIdx);
-		
-		// Handle negative indices (relative to current position in list)
-		// -1 means last element, -2 means second to last, etc.
-		if (vIdx < 0) vIdx = (int)m_TempVertices.size() + vIdx + 1;
-		if (vnIdx < 0) vnIdx = (int)m_TempNormals.size() + vnIdx + 1;
-		
-		vertexIndices.push_back(vIdx);
-		normalIndices.push_back(vnIdx);
-	}
+	size_t run = 0;
 	
-	// Triangulate face using fan method
-	// For a polygon with vertices [0,1,2,3,4], creates triangles:
-	// (0,1,2), (0,2,3), (0,3,4)
-	for (size_t i = 1; i + 1 < vertexIndices.size(); ++i)
+	for (size_t f = 0; f < chunk.Faces.size(); ++f)
 	{
-		Triangle tri;
-		
-		// Convert from 1-based OBJ indices to 0-based array indices
-		int idx0 = vertexIndices[0] - 1;
-		int idx1 = vertexIndices[i] - 1;
-		int idx2 = vertexIndices[i + 1] - 1;
-		
-		// Validate vertex indices
-		if (idx0 < 0 || idx0 >= (int)m_TempVertices.size() ||
-			idx1 < 0 || idx1 >= (int)m_TempVertices.size() ||
-			idx2 < 0 || idx2 >= (int)m_TempVertices.size())
-		{
-			std::cerr << "[SceneManager] Invalid vertex index in face" << std::endl;
-			continue;
-		}
+		const OBJFace& face = chunk.Faces[f];
+		const OBJFaceCorner* corners = chunk.Corners.data() + face.FirstCorner;
 		
-		// Store vertex positions
-		tri.V0 = m_TempVertices[idx0];
-		tri.V1 = m_TempVertices[idx1];
-		tri.V2 = m_TempVertices[idx2];
+		// Material in effect for this face
+		while (run + 1 < chunk.MaterialRuns.size() && chunk.MaterialRuns[run + 1].first <= f)
+			run++;
+		int materialIndex = chunk.MaterialRuns[run].second;
 		
-		// Handle normals
-		int nIdx0 = normalIndices[0] - 1;
-		int nIdx1 = normalIndices[i] - 1;
-		int nIdx2 = normalIndices[i + 1] - 1;
+		// Only the v/vn records before the face exist for it; negative
+		// indices count back from there (-1 means last element)
+		int vertexCount = (int)(chunk.VertexOffset + face.VertexCount);
+		int normalCount = (int)(chunk.NormalOffset + face.NormalCount);
 		
-		if (nIdx0 >= 0 && nIdx0 < (int)m_TempNormals.size() &&
-			nIdx1 >= 0 && nIdx1 < (int)m_TempNormals.size() &&
-			nIdx2 >= 0 && nIdx2 < (int)m_TempNormals.size())
+		auto vertexIndex = [&](uint32_t c)
 		{
-			// Use per-vertex normals for smooth shading
-			tri.N0 = m_TempNormals[nIdx0];
-			tri.N1 = m_TempNormals[nIdx1];
-			tri.N2 = m_TempNormals[nIdx2];
-		}
-		else
+			int idx = corners[c].Vertex;
+			return (idx < 0 ? vertexCount + idx + 1 : idx) - 1;
+		};
+		auto normalIndex = [&](uint32_t c)
 		{
-			// Compute face normal for flat shading
-			// Normal = normalize(cross(V1-V0, V2-V0))
-			glm::vec3 edge1 = tri.V1 - tri.V0;
-			glm::vec3 edge2 = tri.V2 - tri.V0;
-			glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
-			tri.N0 = tri.N1 = tri.N2 = faceNormal;
-		}
+			int idx = corners[c].Normal;
+			return (idx < 0 ? normalCount + idx + 1 : idx) - 1;
+		};
 		
-		// Assign current material
-		tri.MaterialIndex = m_CurrentMaterialIndex;
-		m_SceneData.Triangles.push_back(tri);
+		// Triangulate face using fan method
+		// For a polygon with vertices [0,1,2,3,4], creates triangles:
+		// (0,1,2), (0,2,3), (0,3,4)
+		for (uint32_t i = 1; i + 1 < face.CornerCount; ++i)
+		{
+			Triangle tri;
+			
+			// Convert from 1-based OBJ indices to 0-based array indices
+			int idx0 = vertexIndex(0);
+			int idx1 = vertexIndex(i);
+			int idx2 = vertexIndex(i + 1);
+			
+			// Validate vertex indices
+			if (idx0 < 0 || idx0 >= vertexCount ||
+				idx1 < 0 || idx1 >= vertexCount ||
+				idx2 < 0 || idx2 >= vertexCount)
+			{
+				chunk.InvalidTriangles++;
+				continue;
+			}
+			
+			// Store vertex positions
+			tri.V0 = m_TempVertices[idx0];
+			tri.V1 = m_TempVertices[idx1];
+			tri.V2 = m_TempVertices[idx2];
+			
+			// Handle normals
+			int nIdx0 = normalIndex(0);
+			int nIdx1 = normalIndex(i);
+			int nIdx2 = normalIndex(i + 1);
+			
+			if (nIdx0 >= 0 && nIdx0 < normalCount &&
+				nIdx1 >= 0 && nIdx1 < normalCount &&
+				nIdx2 >= 0 && nIdx2 < normalCount)
+			{
+				// Use per-vertex normals for smooth shading
+				tri.N0 = m_TempNormals[nIdx0];
+				tri.N1 = m_TempNormals[nIdx1];
+				tri.N2 = m_TempNormals[nIdx2];
+			}
+			else
+			{
+				// Compute face normal for flat shading
+				// Normal = normalize(cross(V1-V0, V2-V0))
+				glm::vec3 edge1 = tri.V1 - tri.V0;
+				glm::vec3 edge2 = tri.V2 - tri.V0;
+				glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
+				tri.N0 = tri.N1 = tri.N2 = faceNormal;
+			}
+			
+			// Assign current material
+			tri.MaterialIndex = materialIndex;
+			chunk.Triangles.push_back(tri);
+		}
 	}
+	
+	chunk.Corners = std::vector<OBJFaceCorner>();
+	chunk.Faces = std::vector<OBJFace>();
 }
 
 // ----------------------------------------------------------------------------
@@ -480,21 +1225,26 @@ void SceneManager::ProcessFace(const std::vector<std::string>& tokens)
 //   "1/2"      -> vIdx=1, vtIdx=2, vnIdx=0
 //   "1/2/3"    -> vIdx=1, vtIdx=2, vnIdx=3
 //   "1//3"     -> vIdx=1, vtIdx=0, vnIdx=3
+//
+// Fields are split at each '/', so an empty middle field keeps the normal
+// in third place.
 // ----------------------------------------------------------------------------
-void SceneManager::ParseFaceVertex(const std::string& token, int& vIdx, int& vtIdx, int& vnIdx)
+void SceneManager::ParseFaceVertex(std::string_view token, int& vIdx, int& vtIdx, int& vnIdx)
 {
-	vIdx = vtIdx = vnIdx = 0;
-	
-	std::vector<std::string> parts = Split(token, '/');
+	vtIdx = vnIdx = 0;
 	
-	if (parts.size() >= 1 && !parts[0].empty())
-		vIdx = std::stoi(parts[0]);
+	size_t slash = token.find('/');
+	vIdx = ParseInt(token.substr(0, slash));
+	if (slash == std::string_view::npos)
+		return;
 	
-	if (parts.size() >= 2 && !parts[1].empty())
-		vtIdx = std::stoi(parts[1]);
+	token.remove_prefix(slash + 1);
+	slash = token.find('/');
+	vtIdx = ParseInt(token.substr(0, slash));
+	if (slash == std::string_view::npos)
+		return;
 	
-	if (parts.size() >= 3 && !parts[2].empty())
-		vnIdx = std::stoi(parts[2]);
+	vnIdx = ParseInt(token.substr(slash + 1));
 }
 
 // ----------------------------------------------------------------------------
@@ -524,9 +1274,11 @@ int SceneManager::GetMaterialIndex(const std::string& name)
 // ----------------------------------------------------------------------------
 bool SceneManager::LoadMTL(const std::filesystem::path& path)
 {
-	auto lines = FileManager::ReadLines(path);
+	m_SourceFiles.push_back(path);
 	
-	if (!lines.has_value())
+	auto file = FileManager::MapFile(path);
+	
+	if (!file.has_value())
 	{
 		std::cerr << "[SceneManager] Failed to load MTL file: " << path.string() << std::endl;
 		return false;
@@ -534,9 +1286,10 @@ bool SceneManager::LoadMTL(const std::filesystem::path& path)
 	
 	std::cout << "[SceneManager] Loading MTL: " << path.string() << std::endl;
 	
-	for (const auto& line : lines.value())
+	std::string_view text = file->GetView();
+	while (!text.empty())
 	{
-		ParseMTLLine(line);
+		ParseMTLLine(NextLine(text));
 	}
 	
 	m_CurrentMaterial = nullptr;
@@ -563,28 +1316,35 @@ bool SceneManager::LoadMTL(const std::filesystem::path& path)
 //   Metallic  = 1.0 if illum == 3 (mirror)
 //   Transmission = 1.0 - d, or 1.0 if illum == 7 (glass)
 // ----------------------------------------------------------------------------
-void SceneManager::ParseMTLLine(const std::string& line)
+void SceneManager::ParseMTLLine(std::string_view line)
 {
-	std::string trimmed = Trim(line);
+	std::string_view cmd = NextToken(line);
 	
 	// Skip empty lines and comments
-	if (trimmed.empty() || trimmed[0] == '#')
+	if (cmd.empty() || cmd[0] == '#')
 		return;
 	
-	std::vector<std::string> tokens = Split(trimmed);
-	
-	if (tokens.empty())
+	// First argument; the color commands re-read the arguments from args
+	std::string_view args = line;
+	std::string_view value = NextToken(line);
+	if (value.empty())
 		return;
 	
-	const std::string& cmd = tokens[0];
-	
 	// ========================================================================
 	// NEW MATERIAL: newmtl name
 	// ========================================================================
-	if (cmd == "newmtl" && tokens.size() >= 2)
+	if (cmd == "newmtl")
 	{
+		if (m_SceneData.Materials.size() >= TriangleMesh::MAX_MATERIALS)
+		{
+			std::cerr << "[SceneManager] Warning: More than " << TriangleMesh::MAX_MATERIALS
+					  << " materials, ignoring '" << value << "'" << std::endl;
+			m_CurrentMaterial = nullptr;
+			return;
+		}
+		
 		OBJMaterial mat;
-		mat.Name = tokens[1];
+		mat.Name = std::string(value);
 		m_SceneData.Materials.push_back(mat);
 		m_MaterialMap[mat.Name] = (int)m_SceneData.Materials.size() - 1;
 		m_CurrentMaterial = &m_SceneData.Materials.back();
@@ -596,20 +1356,17 @@ void SceneManager::ParseMTLLine(const std::string& line)
 		// ====================================================================
 		// DIFFUSE COLOR: Kd r g b
 		// ====================================================================
-		if (cmd == "Kd" && tokens.size() >= 4)
+		glm::vec3 color;
+		if (cmd == "Kd" && ParseVec3(args, color))
 		{
-			m_CurrentMaterial->Albedo.r = std::stof(tokens[1]);
-			m_CurrentMaterial->Albedo.g = std::stof(tokens[2]);
-			m_CurrentMaterial->Albedo.b = std::stof(tokens[3]);
+			m_CurrentMaterial->Albedo = color;
 		}
 		// ====================================================================
 		// EMISSIVE COLOR: Ke r g b
 		// ====================================================================
-		else if (cmd == "Ke" && tokens.size() >= 4)
+		else if (cmd == "Ke" && ParseVec3(args, color))
 		{
-			m_CurrentMaterial->Emission.r = std::stof(tokens[1]);
-			m_CurrentMaterial->Emission.g = std::stof(tokens[2]);
-			m_CurrentMaterial->Emission.b = std::stof(tokens[3]);
+			m_CurrentMaterial->Emission = color;
 			
 			// Auto-calculate emission strength from color magnitude
 			float emissionMagnitude = glm::length(m_CurrentMaterial->Emission);
@@ -625,9 +1382,9 @@ void SceneManager::ParseMTLLine(const std::string& line)
 		// Convert to roughness: roughness = 1.0 - (Ns / 1000.0)
 		// Clamp to minimum 0.04 to avoid numerical issues.
 		// ====================================================================
-		else if (cmd == "Ns" && tokens.size() >= 2)
+		else if (cmd == "Ns")
 		{
-			float ns = std::stof(tokens[1]);
+			float ns = ParseFloat(value);
 			m_CurrentMaterial->Roughness = 1.0f - std::min(ns / 1000.0f, 1.0f);
 			m_CurrentMaterial->Roughness = std::max(m_CurrentMaterial->Roughness, 0.04f);
 		}
@@ -636,9 +1393,9 @@ void SceneManager::ParseMTLLine(const std::string& line)
 		// ====================================================================
 		// Typical values: air=1.0, water=1.33, glass=1.5, diamond=2.4
 		// ====================================================================
-		else if (cmd == "Ni" && tokens.size() >= 2)
+		else if (cmd == "Ni")
 		{
-			m_CurrentMaterial->IOR = std::stof(tokens[1]);
+			m_CurrentMaterial->IOR = ParseFloat(value);
 		}
 		// ====================================================================
 		// DISSOLVE/TRANSPARENCY: d value or Tr value
@@ -646,17 +1403,17 @@ void SceneManager::ParseMTLLine(const std::string& line)
 		// d = opacity (1.0 = fully opaque, 0.0 = fully transparent)
 		// Tr = transparency (1.0 = fully transparent, 0.0 = fully opaque)
 		// ====================================================================
-		else if ((cmd == "d" || cmd == "Tr") && tokens.size() >= 2)
+		else if (cmd == "d" || cmd == "Tr")
 		{
-			float value = std::stof(tokens[1]);
+			float opacity = ParseFloat(value);
 			// Convert Tr to d (they're inverses)
 			if (cmd == "Tr")
-				value = 1.0f - value;
+				opacity = 1.0f - opacity;
 			
 			// Set transmission if not fully opaque
-			if (value < 0.99f)
+			if (opacity < 0.99f)
 			{
-				m_CurrentMaterial->Transmission = 1.0f - value;
+				m_CurrentMaterial->Transmission = 1.0f - opacity;
 			}
 		}
 		// ====================================================================
@@ -671,9 +1428,9 @@ void SceneManager::ParseMTLLine(const std::string& line)
 		// illum 6: Refraction on, fresnel off, ray trace on
 		// illum 7: Refraction on, fresnel on, ray trace on (GLASS)
 		// ====================================================================
-		else if (cmd == "illum" && tokens.size() >= 2)
+		else if (cmd == "illum")
 		{
-			int illum = std::stoi(tokens[1]);
+			int illum = ParseInt(value);
 			if (illum == 3)
 			{
 				// Mirror-like reflection
@@ -709,15 +1466,10 @@ void SceneManager::NormalizeScene(float targetSize)
 	glm::vec3 minBounds(FLT_MAX);
 	glm::vec3 maxBounds(-FLT_MAX);
 	
-	for (const auto& tri : m_SceneData.Triangles)
+	for (const glm::vec3& position : m_SceneData.Triangles.Positions)
 	{
-		minBounds = glm::min(minBounds, tri.V0);
-		minBounds = glm::min(minBounds, tri.V1);
-		minBounds = glm::min(minBounds, tri.V2);
-		
-		maxBounds = glm::max(maxBounds, tri.V0);
-		maxBounds = glm::max(maxBounds, tri.V1);
-		maxBounds = glm::max(maxBounds, tri.V2);
+		minBounds = glm::min(minBounds, position);
+		maxBounds = glm::max(maxBounds, position);
 	}
 	
 	// Calculate center and scale factor
@@ -735,12 +1487,10 @@ void SceneManager::NormalizeScene(float targetSize)
 			  << center.x << ", " << center.y << ", " << center.z 
 			  << "), scale=" << scale << std::endl;
 	
-	// Transform all triangle vertices
-	for (auto& tri : m_SceneData.Triangles)
+	// Transform all vertices (each shared vertex once)
+	for (glm::vec3& position : m_SceneData.Triangles.Positions)
 	{
-		tri.V0 = (tri.V0 - center) * scale;
-		tri.V1 = (tri.V1 - center) * scale;
-		tri.V2 = (tri.V2 - center) * scale;
+		position = (position - center) * scale;
 	}
 	
 	// Transform camera position and target
@@ -757,6 +1507,69 @@ void SceneManager::NormalizeScene(float targetSize)
 	}
 }
 
+// ============================================================================
+// RAY QUERIES
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Intersect
+// ----------------------------------------------------------------------------
+// Closest-hit query over all triangles. Every triangle is tested, like the
+// linear loop in intersectOBJMesh; tMax shrinks with each hit.
+// ----------------------------------------------------------------------------
+TriangleHit SceneManager::Intersect(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax) const
+{
+	TriangleHit hit;
+	float u = 0.0f, v = 0.0f;
+	
+	const TriangleMesh& mesh = m_SceneData.Triangles;
+	for (size_t i = 0; i < mesh.size(); i++)
+	{
+		const glm::uvec4& idx = mesh.Indices[i];
+		float t, triU, triV;
+		if (!TriangleIntersect(mesh.Positions[idx.x], mesh.Positions[idx.y], mesh.Positions[idx.z],
+		                       origin, direction, tMin, tMax, t, triU, triV))
+			continue;
+		
+		hit.Hit = true;
+		hit.Distance = t;
+		hit.TriangleIndex = i;
+		u = triU;
+		v = triV;
+		tMax = t;
+	}
+	
+	if (!hit.Hit)
+		return hit;
+	
+	// Interpolate the normal of the winner only
+	Triangle tri = mesh[hit.TriangleIndex];
+	float w = 1.0f - u - v;
+	hit.Position = origin + direction * hit.Distance;
+	hit.Normal = glm::normalize(w * tri.N0 + u * tri.N1 + v * tri.N2);
+	hit.MaterialIndex = tri.MaterialIndex;
+	return hit;
+}
+
+// ----------------------------------------------------------------------------
+// Occluded
+// ----------------------------------------------------------------------------
+// Any-hit query over all triangles: stops at the first triangle that blocks
+// the segment, in whatever order the triangles are stored.
+// ----------------------------------------------------------------------------
+bool SceneManager::Occluded(const glm::vec3& origin, const glm::vec3& direction, float tMax, float tMin) const
+{
+	const TriangleMesh& mesh = m_SceneData.Triangles;
+	for (const glm::uvec4& idx : mesh.Indices)
+	{
+		if (TriangleOccludes(mesh.Positions[idx.x], mesh.Positions[idx.y], mesh.Positions[idx.z],
+		                     origin, direction, tMin, tMax))
+			return true;
+	}
+	
+	return false;
+}
+
 // ============================================================================
 // GPU UPLOAD AND BINDING
 // ============================================================================
@@ -764,18 +1577,23 @@ void SceneManager::NormalizeScene(float targetSize)
 // ----------------------------------------------------------------------------
 // UploadToGPU
 // ----------------------------------------------------------------------------
-// Packs scene data into GPU textures for shader access.
+// Uploads the indexed mesh and the materials as GPU textures for shader
+// access. Positions and normals go up straight from the mesh arrays; only
+// the triangle and material rows are packed.
 //
 // TEXTURE LAYOUT:
 //
-// uTrianglesTex (3 x numTriangles):
-//   ┌─────────────┬─────────────┬─────────────┐
-//   │ V0.xyz (0,0)│ V1.xyz (1,0)│ V2.xyz (2,0)│  Triangle 0
-//   ├─────────────┼─────────────┼─────────────┤
-//   │ V0.xyz (0,1)│ V1.xyz (1,1)│ V2.xyz (2,1)│  Triangle 1
-//   ├─────────────┼─────────────┼─────────────┤
-//   │     ...     │     ...     │     ...     │
-//   └─────────────┴─────────────┴─────────────┘
+// uTrianglesTex (1 x numTriangles, RGBA32UI):
+//   ┌──────────────────────────────┐
+//   │ i0, i1, i2, materialIndex    │  Triangle 0
+//   ├──────────────────────────────┤
+//   │ i0, i1, i2, materialIndex    │  Triangle 1
+//   ├──────────────────────────────┤
+//   │             ...              │
+//   └──────────────────────────────┘
+//
+// uPositionsTex / uNormalsTex (1 x numVertices, RGB32F):
+//   Row i = position / normal of vertex i
 //
 // uMaterialsTex (3 x numMaterials):
 //   ┌─────────────────┬─────────────────┬─────────────────┐
@@ -795,98 +1613,45 @@ bool SceneManager::UploadToGPU()
 	
 	// Delete any existing textures
 	if (m_TriangleTexture) glDeleteTextures(1, &m_TriangleTexture);
+	if (m_PositionTexture) glDeleteTextures(1, &m_PositionTexture);
 	if (m_NormalTexture) glDeleteTextures(1, &m_NormalTexture);
 	if (m_MaterialTexture) glDeleteTextures(1, &m_MaterialTexture);
-	if (m_TriMatTexture) glDeleteTextures(1, &m_TriMatTexture);
-	
-	size_t numTriangles = m_SceneData.Triangles.size();
 	
-	// Allocate CPU-side buffers for texture data
-	// Layout: 3 pixels per row (V0, V1, V2), numTriangles rows
-	// Each pixel is RGBA (4 floats)
-	std::vector<float> triangleData(numTriangles * 3 * 4);
-	std::vector<float> normalData(numTriangles * 3 * 4);
-	std::vector<float> triMatData(numTriangles * 4);
+	const TriangleMesh& mesh = m_SceneData.Triangles;
+	size_t numTriangles = mesh.size();
+	size_t numVertices = mesh.VertexCount();
+	size_t numMaterials = m_SceneData.Materials.size();
 	
-	// Pack triangle data into texture format
-	for (size_t i = 0; i < numTriangles; ++i)
-	{
-		const Triangle& tri = m_SceneData.Triangles[i];
-		
-		// Vertex positions (3 vertices * 4 components each)
-		size_t baseIdx = i * 3 * 4;
-		
-		// Vertex 0
-		triangleData[baseIdx + 0] = tri.V0.x;
-		triangleData[baseIdx + 1] = tri.V0.y;
-		triangleData[baseIdx + 2] = tri.V0.z;
-		triangleData[baseIdx + 3] = 1.0f;  // w component (padding)
-		
-		// Vertex 1
-		triangleData[baseIdx + 4] = tri.V1.x;
-		triangleData[baseIdx + 5] = tri.V1.y;
-		triangleData[baseIdx + 6] = tri.V1.z;
-		triangleData[baseIdx + 7] = 1.0f;
-		
-		// Vertex 2
-		triangleData[baseIdx + 8] = tri.V2.x;
-		triangleData[baseIdx + 9] = tri.V2.y;
-		triangleData[baseIdx + 10] = tri.V2.z;
-		triangleData[baseIdx + 11] = 1.0f;
-		
-		// Normal vectors (same layout)
-		normalData[baseIdx + 0] = tri.N0.x;
-		normalData[baseIdx + 1] = tri.N0.y;
-		normalData[baseIdx + 2] = tri.N0.z;
-		normalData[baseIdx + 3] = 0.0f;
-		
-		normalData[baseIdx + 4] = tri.N1.x;
-		normalData[baseIdx + 5] = tri.N1.y;
-		normalData[baseIdx + 6] = tri.N1.z;
-		normalData[baseIdx + 7] = 0.0f;
-		
-		normalData[baseIdx + 8] = tri.N2.x;
-		normalData[baseIdx + 9] = tri.N2.y;
-		normalData[baseIdx + 10] = tri.N2.z;
-		normalData[baseIdx + 11] = 0.0f;
-		
-		// Material index (1 pixel per triangle)
-		size_t matIdx = i * 4;
-		triMatData[matIdx + 0] = (float)tri.MaterialIndex;
-		triMatData[matIdx + 1] = 0.0f;
-		triMatData[matIdx + 2] = 0.0f;
-		triMatData[matIdx + 3] = 0.0f;
-	}
-	
-	// Create triangle vertex texture
+	// Create triangle texture: the (i0, i1, i2, material) records are the
+	// texels, so they go up without a packing step
+	static_assert(sizeof(glm::uvec4) == 4 * sizeof(uint32_t), "one RGBA32UI texel per triangle record");
 	glGenTextures(1, &m_TriangleTexture);
 	glBindTexture(GL_TEXTURE_2D, m_TriangleTexture);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 3, (GLsizei)numTriangles, 0, GL_RGBA, GL_FLOAT, triangleData.data());
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32UI, 1, (GLsizei)numTriangles, 0, GL_RGBA_INTEGER, GL_UNSIGNED_INT, mesh.Indices.data());
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);  // No interpolation!
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	
-	// Create normal texture
-	glGenTextures(1, &m_NormalTexture);
-	glBindTexture(GL_TEXTURE_2D, m_NormalTexture);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 3, (GLsizei)numTriangles, 0, GL_RGBA, GL_FLOAT, normalData.data());
+	// Create vertex position texture (glm::vec3 is three packed floats)
+	glGenTextures(1, &m_PositionTexture);
+	glBindTexture(GL_TEXTURE_2D, m_PositionTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, 1, (GLsizei)numVertices, 0, GL_RGB, GL_FLOAT, mesh.Positions.data());
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	
-	// Create triangle-to-material index texture
-	glGenTextures(1, &m_TriMatTexture);
-	glBindTexture(GL_TEXTURE_2D, m_TriMatTexture);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 1, (GLsizei)numTriangles, 0, GL_RGBA, GL_FLOAT, triMatData.data());
+	// Create vertex normal texture
+	glGenTextures(1, &m_NormalTexture);
+	glBindTexture(GL_TEXTURE_2D, m_NormalTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, 1, (GLsizei)numVertices, 0, GL_RGB, GL_FLOAT, mesh.Normals.data());
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	
 	// Pack and create material texture
-	size_t numMaterials = m_SceneData.Materials.size();
 	std::vector<float> materialData(numMaterials * 3 * 4);
 	
 	for (size_t i = 0; i < numMaterials; ++i)
@@ -926,7 +1691,7 @@ bool SceneManager::UploadToGPU()
 	m_GPUDataValid = true;
 	
 	std::cout << "[SceneManager] Uploaded to GPU: " << numTriangles << " triangles, " 
-			  << numMaterials << " materials" << std::endl;
+			  << numVertices << " vertices, " << numMaterials << " materials" << std::endl;
 	
 	return true;
 }
@@ -936,11 +1701,11 @@ bool SceneManager::UploadToGPU()
 // ----------------------------------------------------------------------------
 // Binds the scene textures to the shader for rendering.
 //
-// Texture unit assignments:
+// Texture unit assignments (uniforms set by SetTextureUnits):
 //   Unit 0, 1: Reserved for accumulation buffers
-//   Unit 2: uTrianglesTex (triangle vertices)
-//   Unit 3: uNormalsTex (triangle normals)
-//   Unit 4: uTriMatTex (triangle material indices)
+//   Unit 2: uTrianglesTex (vertex and material indices)
+//   Unit 3: uPositionsTex (vertex positions)
+//   Unit 4: uNormalsTex (vertex normals)
 //   Unit 5: uMaterialsTex (material properties)
 // ----------------------------------------------------------------------------
 void SceneManager::BindTextures(GLuint shaderProgram) const
@@ -948,26 +1713,36 @@ void SceneManager::BindTextures(GLuint shaderProgram) const
 	if (!m_GPUDataValid)
 		return;
 	
-	// Bind triangle vertex texture to unit 2
+	// Bind triangle texture to unit 2
 	glActiveTexture(GL_TEXTURE2);
 	glBindTexture(GL_TEXTURE_2D, m_TriangleTexture);
-	glUniform1i(glGetUniformLocation(shaderProgram, "uTrianglesTex"), 2);
 	
-	// Bind normal texture to unit 3
+	// Bind vertex position texture to unit 3
 	glActiveTexture(GL_TEXTURE3);
-	glBindTexture(GL_TEXTURE_2D, m_NormalTexture);
-	glUniform1i(glGetUniformLocation(shaderProgram, "uNormalsTex"), 3);
+	glBindTexture(GL_TEXTURE_2D, m_PositionTexture);
 	
-	// Bind triangle material texture to unit 4
+	// Bind vertex normal texture to unit 4
 	glActiveTexture(GL_TEXTURE4);
-	glBindTexture(GL_TEXTURE_2D, m_TriMatTexture);
-	glUniform1i(glGetUniformLocation(shaderProgram, "uTriMatTex"), 4);
+	glBindTexture(GL_TEXTURE_2D, m_NormalTexture);
 	
 	// Bind material texture to unit 5
 	glActiveTexture(GL_TEXTURE5);
 	glBindTexture(GL_TEXTURE_2D, m_MaterialTexture);
-	glUniform1i(glGetUniformLocation(shaderProgram, "uMaterialsTex"), 5);
 	
 	// Pass triangle count to shader
 	glUniform1i(glGetUniformLocation(shaderProgram, "uNumTriangles"), (GLint)m_SceneData.Triangles.size());
 }
+
+// ----------------------------------------------------------------------------
+// SetTextureUnits
+// ----------------------------------------------------------------------------
+// Needed even without an OBJ scene: GL validates every active sampler at
+// draw time, and a usampler2D sharing unit 0 with float samplers fails it.
+// ----------------------------------------------------------------------------
+void SceneManager::SetTextureUnits(GLuint shaderProgram)
+{
+	glUniform1i(glGetUniformLocation(shaderProgram, "uTrianglesTex"), 2);
+	glUniform1i(glGetUniformLocation(shaderProgram, "uPositionsTex"), 3);
+	glUniform1i(glGetUniformLocation(shaderProgram, "uNormalsTex"), 4);
+	glUniform1i(glGetUniformLocation(shaderProgram, "uMaterialsTex"), 5);
+}
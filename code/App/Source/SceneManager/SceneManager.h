@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
 
 #include <glm/glm.hpp>
 
+#include "SceneCache.h"
+
 // Conditional OpenGL inclusion for testing
 #ifdef USE_MOCK_GL
     #include "mock_gl.h"
@@ -14,6 +18,8 @@
     #include <glad/gl.h>
 #endif
 
+class LineBlockReader;
+
 // ============================================================================
 // SCENE MANAGER - OBJ/MTL Scene Loading System
 // ============================================================================
@@ -53,21 +59,19 @@
 //
 // GPU DATA LAYOUT:
 // ----------------
-// Scene data is uploaded to the GPU as 2D textures with RGBA32F format:
+// The indexed mesh (see TriangleMesh) is uploaded to the GPU as 2D textures:
 //
-//   uTrianglesTex (width=3, height=numTriangles):
-//     Each row contains one triangle's three vertices (V0, V1, V2)
-//     Pixel (0,i) = V0.xyz, Pixel (1,i) = V1.xyz, Pixel (2,i) = V2.xyz
+//   uTrianglesTex (width=1, height=numTriangles, RGBA32UI):
+//     Each row contains one triangle's vertex indices and material index
+//     Pixel (0,i) = (i0, i1, i2, materialIndex)
 //
-//   uNormalsTex (width=3, height=numTriangles):
-//     Each row contains one triangle's three vertex normals (N0, N1, N2)
-//     Pixel (0,i) = N0.xyz, Pixel (1,i) = N1.xyz, Pixel (2,i) = N2.xyz
+//   uPositionsTex (width=1, height=numVertices, RGB32F):
+//     Pixel (0,i) = position of vertex i
 //
-//   uTriMatTex (width=1, height=numTriangles):
-//     Each row contains the material index for that triangle
-//     Pixel (0,i).r = materialIndex
+//   uNormalsTex (width=1, height=numVertices, RGB32F):
+//     Pixel (0,i) = normal of vertex i
 //
-//   uMaterialsTex (width=3, height=numMaterials):
+//   uMaterialsTex (width=3, height=numMaterials, RGBA32F):
 //     Each row contains one material's properties:
 //     Pixel (0,i) = (albedo.rgb, roughness)
 //     Pixel (1,i) = (emission.rgb, metallic)
@@ -139,6 +143,81 @@ struct Triangle
 	int MaterialIndex = 0;    // Index into SceneData::Materials array
 };
 
+// ----------------------------------------------------------------------------
+// TriangleMesh
+// ----------------------------------------------------------------------------
+// Indexed triangle storage. Every distinct (position, normal) pair is kept
+// once as a vertex, and a triangle is one 16-byte record (i0, i1, i2,
+// material index): about 28 bytes per triangle on a closed mesh instead of
+// 76 for a Triangle. The records are exactly the uTrianglesTex texels, so
+// UploadToGPU and the scene cache take the array as it is.
+//
+// Reads like the std::vector<Triangle> it replaces: mesh[i] and iteration
+// assemble Triangle values on the fly. Build it through SceneManager
+// (LoadOBJ, SetTriangles), which deduplicates vertices bit-exactly, so
+// mesh[i] returns exactly the triangle that went in.
+// ----------------------------------------------------------------------------
+struct TriangleMesh
+{
+	static constexpr size_t MAX_MATERIALS = 65536;  // Material indices a mesh may use
+	
+	std::vector<glm::vec3> Positions;       // Per vertex
+	std::vector<glm::vec3> Normals;         // Per vertex, same index as Positions
+	std::vector<glm::uvec4> Indices;        // Per triangle: vertex indices (counter-clockwise),
+	                                        // then the index into SceneData::Materials
+	
+	size_t size() const { return Indices.size(); }
+	bool empty() const { return Indices.empty(); }
+	size_t VertexCount() const { return Positions.size(); }
+	
+	Triangle operator[](size_t i) const
+	{
+		const glm::uvec4& idx = Indices[i];
+		Triangle tri;
+		tri.V0 = Positions[idx.x];
+		tri.V1 = Positions[idx.y];
+		tri.V2 = Positions[idx.z];
+		tri.N0 = Normals[idx.x];
+		tri.N1 = Normals[idx.y];
+		tri.N2 = Normals[idx.z];
+		tri.MaterialIndex = int(idx.w);
+		return tri;
+	}
+	
+	// Forward iterator yielding Triangle values
+	class const_iterator
+	{
+	public:
+		const_iterator(const TriangleMesh* mesh, size_t index) : m_Mesh(mesh), m_Index(index) {}
+		Triangle operator*() const { return (*m_Mesh)[m_Index]; }
+		const_iterator& operator++() { ++m_Index; return *this; }
+		bool operator==(const const_iterator& other) const { return m_Index == other.m_Index; }
+		bool operator!=(const const_iterator& other) const { return m_Index != other.m_Index; }
+	
+	private:
+		const TriangleMesh* m_Mesh;
+		size_t m_Index;
+	};
+	
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, size()); }
+};
+
+// ----------------------------------------------------------------------------
+// TriangleHit
+// ----------------------------------------------------------------------------
+// Closest triangle hit of a ray (see SceneManager::Intersect).
+// ----------------------------------------------------------------------------
+struct TriangleHit
+{
+	bool Hit = false;
+	float Distance = 0.0f;                      // Ray parameter t of the hit
+	glm::vec3 Position = glm::vec3(0.0f);
+	glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);  // Interpolated, unit length, not flipped
+	int MaterialIndex = 0;
+	size_t TriangleIndex = 0;
+};
+
 // ----------------------------------------------------------------------------
 // OBJMesh
 // ----------------------------------------------------------------------------
@@ -160,7 +239,7 @@ struct OBJMesh
 struct SceneData
 {
 	std::vector<OBJMaterial> Materials;     // All materials (index 0 = default)
-	std::vector<Triangle> Triangles;        // All triangles (flattened)
+	TriangleMesh Triangles;                 // All triangles (indexed)
 	
 	// Camera data (from custom 'c' command in OBJ)
 	glm::vec3 CameraPosition = glm::vec3(0.0f, 0.0f, 5.0f);
@@ -194,14 +273,73 @@ public:
 	//   bool - true if at least one triangle was loaded successfully
 	//
 	// Notes:
+	//   - The file is streamed in fixed-size blocks of whole lines (see
+	//     SetLoadBlockSize) and tokenized in place, so memory grows with the
+	//     geometry, not the file: text is held one block at a time
+	//   - Large files are parsed in line-aligned chunks on several threads
+	//     (see SetLoadThreads); the result does not depend on the split
 	//   - Automatically loads referenced MTL files (mtllib command)
 	//   - Creates a default gray material if none specified
 	//   - Triangulates polygons with more than 3 vertices (fan method)
 	//   - Normalizes scene to fit in a 6x6x6 unit box centered at origin
 	//   - Handles negative indices (relative to current position)
+	//   - With SetSceneCache(true), reuses a valid .cgscene file beside the
+	//     OBJ instead of parsing, and writes one after parsing otherwise
 	// ========================================================================
 	bool LoadOBJ(const std::filesystem::path& path);
 	
+	// ========================================================================
+	// SetLoadThreads
+	// ========================================================================
+	// Configures parallel OBJ parsing for subsequent LoadOBJ calls.
+	//
+	// Parameters:
+	//   threads       - Maximum number of parsing threads (0 = all hardware
+	//                   threads, 1 = sequential)
+	//   minChunkBytes - Smallest chunk worth a thread; files below twice this
+	//                   size are parsed on the calling thread
+	// ========================================================================
+	static constexpr size_t DEFAULT_MIN_CHUNK_BYTES = 1 << 20;
+	void SetLoadThreads(int threads, size_t minChunkBytes = DEFAULT_MIN_CHUNK_BYTES);
+	
+	// ========================================================================
+	// SetLoadBlockSize
+	// ========================================================================
+	// Sets how much of an OBJ file LoadOBJ reads at a time. Each block is
+	// parsed, merged and triangulated before the next one is read, and its
+	// triangles go straight into the mesh.
+	//
+	// Parameters:
+	//   blockBytes - Bytes per read; a line longer than this is still read
+	//                whole
+	//
+	// Notes:
+	//   - Files larger than one block are counted in a quick first pass, so
+	//     vertex arrays and mesh are allocated once at their final size
+	//   - Smaller blocks lower the peak but leave fewer bytes per parsing
+	//     thread (see SetLoadThreads); the default still gives 16 threads a
+	//     chunk of DEFAULT_MIN_CHUNK_BYTES each
+	// ========================================================================
+	static constexpr size_t DEFAULT_LOAD_BLOCK_BYTES = 16 << 20;
+	void SetLoadBlockSize(size_t blockBytes);
+	
+	// ========================================================================
+	// SetSceneCache
+	// ========================================================================
+	// Enables the binary scene cache for subsequent LoadOBJ calls (see
+	// SceneCache.h). Off by default.
+	//
+	// Notes:
+	//   - Only used when LoadOBJ starts from an empty scene, since the cache
+	//     holds the whole normalized scene
+	//   - A cache that cannot be written (read-only directory) is skipped
+	//     silently apart from a log line
+	// ========================================================================
+	void SetSceneCache(bool enabled) { m_UseSceneCache = enabled; }
+	
+	// True if the last LoadOBJ was served from the scene cache
+	bool IsFromSceneCache() const { return m_FromSceneCache; }
+	
 	// ========================================================================
 	// LoadMTL
 	// ========================================================================
@@ -220,6 +358,25 @@ public:
 	// ========================================================================
 	bool LoadMTL(const std::filesystem::path& path);
 	
+	// ========================================================================
+	// SetTriangles
+	// ========================================================================
+	// Replaces the scene geometry with generated triangles (for example a
+	// tessellated quadric from QuadricTessellator).
+	//
+	// Parameters:
+	//   triangles - New triangle list; MaterialIndex refers to the materials
+	//               already loaded (LoadMTL)
+	//
+	// Notes:
+	//   - Materials, camera and light are kept
+	//   - Creates the default gray material if no material is loaded yet
+	//   - Geometry is used as given (no normalization); shared vertices
+	//     are indexed as in LoadOBJ
+	//   - Call UploadToGPU afterwards to replace the GPU copy
+	// ========================================================================
+	void SetTriangles(const std::vector<Triangle>& triangles);
+	
 	// ========================================================================
 	// GetSceneData
 	// ========================================================================
@@ -239,7 +396,7 @@ public:
 	//   bool - true if upload was successful
 	//
 	// Notes:
-	//   - Creates four RGBA32F textures (triangles, normals, tri-mat, materials)
+	//   - Creates four textures (triangles, positions, normals, materials)
 	//   - Deletes any previously uploaded textures
 	//   - Must be called after LoadOBJ and before BindTextures
 	//   - See GPU DATA LAYOUT section for texture format details
@@ -256,15 +413,26 @@ public:
 	//
 	// Notes:
 	//   - Binds textures to units 2-5 (0-1 reserved for accumulation)
-	//   - Sets the following uniforms:
-	//       uTrianglesTex  (sampler2D) - texture unit 2
-	//       uNormalsTex    (sampler2D) - texture unit 3
-	//       uTriMatTex     (sampler2D) - texture unit 4
-	//       uMaterialsTex  (sampler2D) - texture unit 5
-	//       uNumTriangles  (int)       - number of triangles
+	//   - Sets uNumTriangles (int) to the number of triangles
+	//   - The sampler uniforms are set by SetTextureUnits, not here
 	// ========================================================================
 	void BindTextures(GLuint shaderProgram) const;
 	
+	// ========================================================================
+	// SetTextureUnits
+	// ========================================================================
+	// Points the scene sampler uniforms at their texture units:
+	//   uTrianglesTex  (usampler2D) - texture unit 2
+	//   uPositionsTex  (sampler2D)  - texture unit 3
+	//   uNormalsTex    (sampler2D)  - texture unit 4
+	//   uMaterialsTex  (sampler2D)  - texture unit 5
+	//
+	// Call it for every draw, OBJ scene or not: left at the default unit 0,
+	// the usampler2D uTrianglesTex shares a unit with float samplers, which
+	// makes the draw an INVALID_OPERATION (macOS skips it).
+	// ========================================================================
+	static void SetTextureUnits(GLuint shaderProgram);
+	
 	// ========================================================================
 	// GetTriangleCount / GetMaterialCount
 	// ========================================================================
@@ -273,6 +441,48 @@ public:
 	size_t GetTriangleCount() const { return m_SceneData.Triangles.size(); }
 	size_t GetMaterialCount() const { return m_SceneData.Materials.size(); }
 	
+	// ========================================================================
+	// Intersect
+	// ========================================================================
+	// Closest-hit query against the loaded triangles, for CPU rendering.
+	//
+	// Parameters:
+	//   origin    - Ray origin
+	//   direction - Ray direction (need not be normalized; t scales with it)
+	//   tMin      - Start of the tested segment (skips self-intersection)
+	//   tMax      - End of the tested segment
+	//
+	// Returns:
+	//   TriangleHit - Nearest hit with tMin <= t <= tMax (Hit = false if none)
+	//
+	// Notes:
+	//   - Same Möller-Trumbore test and normal interpolation as
+	//     intersectTriangle in PathTrace.glsl
+	// ========================================================================
+	TriangleHit Intersect(const glm::vec3& origin, const glm::vec3& direction,
+	                      float tMin = 0.001f, float tMax = 1000.0f) const;
+	
+	// ========================================================================
+	// Occluded
+	// ========================================================================
+	// Any-hit query for shadow and visibility rays against the loaded
+	// triangles.
+	//
+	// Parameters:
+	//   origin    - Ray origin
+	//   direction - Ray direction (need not be normalized; t scales with it)
+	//   tMax      - End of the tested segment (e.g. distance to the light)
+	//   tMin      - Start of the tested segment (skips self-intersection)
+	//
+	// Returns:
+	//   bool - true if any triangle is hit with tMin <= t <= tMax
+	//
+	// Notes:
+	//   - Returns on the first blocking triangle; no hit point, normal or
+	//     material is computed
+	// ========================================================================
+	bool Occluded(const glm::vec3& origin, const glm::vec3& direction, float tMax, float tMin = 0.001f) const;
+	
 	// ========================================================================
 	// Clear
 	// ========================================================================
@@ -286,21 +496,25 @@ public:
 	void Clear();
 
 private:
-	// Parsing helpers
-	void ParseOBJLine(const std::string& line);
-	void ParseMTLLine(const std::string& line);
-	void ProcessFace(const std::vector<std::string>& tokens);
-	void ParseFaceVertex(const std::string& token, int& vIdx, int& vtIdx, int& vnIdx);
+	// Parsing helpers (see OBJ PARSING in SceneManager.cpp)
+	struct OBJChunk;
+	struct OBJCounts;
+	OBJCounts CountOBJ(LineBlockReader& reader) const;
+	std::vector<OBJChunk> SplitChunks(std::string_view text) const;
+	static void ParseOBJLine(std::string_view line, OBJChunk& chunk);
+	static void ParseFaceVertex(std::string_view token, int& vIdx, int& vtIdx, int& vnIdx);
+	void MergeChunks(std::vector<OBJChunk>& chunks);
+	void ProcessFaces(OBJChunk& chunk) const;
+	void ParseMTLLine(std::string_view line);
 	int GetMaterialIndex(const std::string& name);
 	void NormalizeScene(float targetSize = 6.0f);
-	
+
 private:
 	SceneData m_SceneData;
 	
 	// Temporary parsing state
 	std::vector<glm::vec3> m_TempVertices;      // v commands
 	std::vector<glm::vec3> m_TempNormals;       // vn commands
-	std::vector<glm::vec2> m_TempTexCoords;     // vt commands
 	std::unordered_map<std::string, int> m_MaterialMap;  // name -> index
 	int m_CurrentMaterialIndex = 0;
 	std::filesystem::path m_BasePath;
@@ -308,10 +522,20 @@ private:
 	// MTL parsing state
 	OBJMaterial* m_CurrentMaterial = nullptr;
 	
+	// Parallel OBJ parsing (SetLoadThreads)
+	int m_LoadThreads = 0;
+	size_t m_MinChunkBytes = DEFAULT_MIN_CHUNK_BYTES;
+	size_t m_LoadBlockBytes = DEFAULT_LOAD_BLOCK_BYTES;
+	
+	// Scene cache (SetSceneCache)
+	bool m_UseSceneCache = false;
+	bool m_FromSceneCache = false;
+	std::vector<std::filesystem::path> m_SourceFiles;   // OBJ, then MTLs it named
+	
 	// GPU resources (OpenGL texture handles)
-	GLuint m_TriangleTexture = 0;    // Triangle vertex positions
-	GLuint m_NormalTexture = 0;      // Triangle vertex normals
+	GLuint m_TriangleTexture = 0;    // Vertex indices + material index per triangle
+	GLuint m_PositionTexture = 0;    // Vertex positions
+	GLuint m_NormalTexture = 0;      // Vertex normals
 	GLuint m_MaterialTexture = 0;    // Material properties
-	GLuint m_TriMatTexture = 0;      // Triangle-to-material index mapping
 	bool m_GPUDataValid = false;
 };
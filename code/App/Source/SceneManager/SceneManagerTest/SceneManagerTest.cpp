@@ -10,6 +10,8 @@
 //   - Custom extensions (camera, light point)
 //   - Scene normalization
 //   - Error handling
+//   - Occlusion (any-hit) ray queries
+//   - Quadric tessellation and level of detail
 //
 // Test files are located in ./test_assets/
 //
@@ -20,6 +22,7 @@
 
 #include "../SceneManager.h"
 #include "../FileManager.h"
+#include "../QuadricTessellator.h"
 
 #include <iostream>
 #include <iomanip>
@@ -28,6 +31,7 @@
 #include <vector>
 #include <functional>
 #include <filesystem>
+#include <fstream>
 
 // ============================================================================
 // TEST FRAMEWORK
@@ -502,6 +506,192 @@ void TestFaceFormats()
 	EndTest();
 }
 
+void TestTokenizer()
+{
+	BeginTest("Tokenizer handles CRLF, tabs, signs and v//vn");
+	
+	SceneManager manager;
+	bool loaded = manager.LoadOBJ(GetTestAssetPath("test_tokenizer.obj"));
+	
+	AssertTrue(loaded, "CRLF/tab OBJ should load successfully");
+	AssertEqual(size_t{1}, manager.GetTriangleCount(), "Should have 1 triangle");
+	
+	if (manager.GetTriangleCount() == 1)
+	{
+		const Triangle& tri = manager.GetSceneData().Triangles[0];
+		AssertVec3Equal(glm::vec3(0.0f, 0.0f, -1.0f), tri.N0, "N0 comes from vn, not the face normal");
+		AssertVec3Equal(glm::vec3(0.0f, 0.0f, -1.0f), tri.N2, "N2 comes from vn, not the face normal");
+		AssertFloatEqual(6.0f, tri.V1.x - tri.V0.x, "'+1.0' parses as 1 (normalized to 6 units)");
+	}
+	
+	EndTest();
+}
+
+void TestChunkedParsing()
+{
+	BeginTest("Parallel chunked parsing matches sequential parsing");
+	
+	// One-byte minimum chunks put only a line or two in each chunk, so
+	// negative indices and usemtl state cross chunk boundaries
+	for (const char* asset : { "test_negative_indices.obj", "test_all_materials.obj", "test_with_camera.obj" })
+	{
+		SceneManager sequential;
+		sequential.SetLoadThreads(1);
+		sequential.LoadOBJ(GetTestAssetPath(asset));
+		
+		SceneManager chunked;
+		chunked.SetLoadThreads(16, 1);
+		chunked.LoadOBJ(GetTestAssetPath(asset));
+		
+		const SceneData& a = sequential.GetSceneData();
+		const SceneData& b = chunked.GetSceneData();
+		AssertEqual(a.Triangles.size(), b.Triangles.size(), std::string(asset) + ": same triangle count");
+		
+		bool identical = a.Triangles.size() == b.Triangles.size();
+		for (size_t i = 0; identical && i < a.Triangles.size(); i++)
+		{
+			const Triangle& x = a.Triangles[i];
+			const Triangle& y = b.Triangles[i];
+			identical = x.V0 == y.V0 && x.V1 == y.V1 && x.V2 == y.V2 &&
+			            x.N0 == y.N0 && x.N1 == y.N1 && x.N2 == y.N2 &&
+			            x.MaterialIndex == y.MaterialIndex;
+		}
+		AssertTrue(identical, std::string(asset) + ": identical triangles and materials");
+		AssertTrue(a.HasCamera == b.HasCamera && a.CameraPosition == b.CameraPosition,
+		           std::string(asset) + ": same camera");
+	}
+	
+	EndTest();
+}
+
+void TestStreamedParsing()
+{
+	BeginTest("Streaming in small blocks matches loading in one block");
+	
+	// Blocks of a few bytes end mid-line and hold lines longer than the
+	// block, so carried lines, buffer growth and the counting pass all run
+	std::filesystem::path noNewline = std::filesystem::temp_directory_path() / "scene_manager_stream_test.obj";
+	{
+		std::ofstream obj(noNewline, std::ios::binary);
+		obj << "v 0 0 0\r\nv 1 0 0\r\nv 0 1 0\r\nv 1 1 0\r\nusemtl unknown\r\nf 1 2 3\r\nf -3 -1 -2";
+	}
+	
+	for (const std::filesystem::path& path : { GetTestAssetPath("test_negative_indices.obj"),
+	                                           GetTestAssetPath("test_all_materials.obj"),
+	                                           GetTestAssetPath("test_with_camera.obj"), noNewline })
+	{
+		std::string asset = path.filename().string();
+		
+		SceneManager whole;
+		whole.LoadOBJ(path);
+		const SceneData& a = whole.GetSceneData();
+		
+		for (size_t blockBytes : { size_t(1), size_t(7), size_t(64) })
+		{
+			SceneManager streamed;
+			streamed.SetLoadBlockSize(blockBytes);
+			streamed.LoadOBJ(path);
+			
+			const SceneData& b = streamed.GetSceneData();
+			std::string label = asset + " in " + std::to_string(blockBytes) + "-byte blocks";
+			
+			bool identical = a.Triangles.size() == b.Triangles.size() && !a.Triangles.empty();
+			for (size_t i = 0; identical && i < a.Triangles.size(); i++)
+			{
+				const Triangle& x = a.Triangles[i];
+				const Triangle& y = b.Triangles[i];
+				identical = x.V0 == y.V0 && x.V1 == y.V1 && x.V2 == y.V2 &&
+				            x.N0 == y.N0 && x.N1 == y.N1 && x.N2 == y.N2 &&
+				            x.MaterialIndex == y.MaterialIndex;
+			}
+			AssertTrue(identical, label + ": identical triangles and materials");
+			AssertTrue(a.HasCamera == b.HasCamera && a.CameraPosition == b.CameraPosition,
+			           label + ": same camera");
+		}
+	}
+	
+	std::filesystem::remove(noNewline);
+	
+	EndTest();
+}
+
+void TestSceneCache()
+{
+	BeginTest("Scene cache reload and invalidation");
+	
+	// Work on copies so the test can edit the sources and drop .cgscene files
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "scene_manager_cache_test";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+	std::filesystem::copy_file(GetTestAssetPath("test_with_camera.obj"), dir / "scene.obj");
+	std::filesystem::copy_file(GetTestAssetPath("quadric_materials.mtl"), dir / "quadric_materials.mtl");
+	
+	SceneManager parsed;
+	parsed.SetSceneCache(true);
+	AssertTrue(parsed.LoadOBJ(dir / "scene.obj"), "First load should succeed");
+	AssertTrue(!parsed.IsFromSceneCache(), "First load should parse the OBJ");
+	AssertTrue(std::filesystem::exists(dir / "scene.cgscene"), "First load should write scene.cgscene");
+	
+	SceneManager cached;
+	cached.SetSceneCache(true);
+	AssertTrue(cached.LoadOBJ(dir / "scene.obj"), "Second load should succeed");
+	AssertTrue(cached.IsFromSceneCache(), "Second load should come from the cache");
+	
+	const SceneData& a = parsed.GetSceneData();
+	const SceneData& b = cached.GetSceneData();
+	AssertEqual(a.Triangles.size(), b.Triangles.size(), "Same triangle count");
+	AssertEqual(a.Materials.size(), b.Materials.size(), "Same material count");
+	
+	bool identical = a.Triangles.size() == b.Triangles.size() && a.Materials.size() == b.Materials.size();
+	for (size_t i = 0; identical && i < a.Triangles.size(); i++)
+	{
+		const Triangle& x = a.Triangles[i];
+		const Triangle& y = b.Triangles[i];
+		identical = x.V0 == y.V0 && x.V1 == y.V1 && x.V2 == y.V2 &&
+		            x.N0 == y.N0 && x.N1 == y.N1 && x.N2 == y.N2 &&
+		            x.MaterialIndex == y.MaterialIndex;
+	}
+	for (size_t i = 0; identical && i < a.Materials.size(); i++)
+	{
+		const OBJMaterial& x = a.Materials[i];
+		const OBJMaterial& y = b.Materials[i];
+		identical = x.Name == y.Name && x.Albedo == y.Albedo && x.Emission == y.Emission &&
+		            x.EmissionStrength == y.EmissionStrength && x.Roughness == y.Roughness &&
+		            x.Metallic == y.Metallic && x.IOR == y.IOR && x.Transmission == y.Transmission;
+	}
+	AssertTrue(identical, "Cached triangles and materials should be identical");
+	AssertTrue(b.HasCamera && a.CameraPosition == b.CameraPosition && a.CameraTarget == b.CameraTarget,
+	           "Cached camera should be identical");
+	
+	// Editing the MTL or the OBJ invalidates the cache
+	{
+		std::ofstream mtl(dir / "quadric_materials.mtl", std::ios::app);
+		mtl << "\n# edited\n";
+	}
+	SceneManager editedMTL;
+	editedMTL.SetSceneCache(true);
+	editedMTL.LoadOBJ(dir / "scene.obj");
+	AssertTrue(!editedMTL.IsFromSceneCache(), "Edited MTL should force a reparse");
+	
+	{
+		std::ofstream obj(dir / "scene.obj", std::ios::app);
+		obj << "\n# edited\n";
+	}
+	SceneManager editedOBJ;
+	editedOBJ.SetSceneCache(true);
+	editedOBJ.LoadOBJ(dir / "scene.obj");
+	AssertTrue(!editedOBJ.IsFromSceneCache(), "Edited OBJ should force a reparse");
+	
+	// Without SetSceneCache the cache is neither read nor required
+	SceneManager uncached;
+	uncached.LoadOBJ(dir / "scene.obj");
+	AssertTrue(!uncached.IsFromSceneCache(), "Cache should be off by default");
+	
+	std::filesystem::remove_all(dir);
+	
+	EndTest();
+}
+
 // ----------------------------------------------------------------------------
 // TEST SUITE 4: Material Parsing Tests
 // ----------------------------------------------------------------------------
@@ -972,6 +1162,50 @@ void TestMaterialDataIntegrity()
 	EndTest();
 }
 
+void TestIndexedMesh()
+{
+	BeginTest("Indexed mesh shares vertices and keeps triangles exact");
+	
+	SceneManager manager;
+	manager.LoadOBJ(GetTestAssetPath("sphere.obj"));
+	
+	const TriangleMesh& mesh = manager.GetSceneData().Triangles;
+	AssertEqual(sizeof(glm::uvec4), sizeof(mesh.Indices[0]), "One 16-byte (i0, i1, i2, material) record per triangle");
+	AssertEqual(mesh.Positions.size(), mesh.Normals.size(), "One normal per vertex");
+	AssertTrue(mesh.VertexCount() < mesh.size() * 3, "Shared vertices are stored once");
+	
+	bool indicesValid = true;
+	for (const glm::uvec4& idx : mesh.Indices)
+	{
+		indicesValid = indicesValid && idx.x < mesh.VertexCount() && idx.y < mesh.VertexCount() &&
+		               idx.z < mesh.VertexCount() && idx.w < manager.GetSceneData().Materials.size();
+	}
+	AssertTrue(indicesValid, "All indices refer to stored vertices");
+	
+	// SetTriangles indexes as well; reading back gives the input triangles
+	// (material 1 must exist, or it falls back to the default)
+	auto sphere = Quadric::QuadricSurface::CreateSphere(1.0f);
+	auto triangles = QuadricTessellator::Tessellate(sphere, sphere.GetBounds(), 0.5f, 1);
+	SceneManager generated;
+	generated.LoadMTL(GetTestAssetPath("quadric_materials.mtl"));
+	generated.SetTriangles(triangles);
+	
+	const TriangleMesh& indexed = generated.GetSceneData().Triangles;
+	bool identical = indexed.size() == triangles.size();
+	for (size_t i = 0; identical && i < triangles.size(); i++)
+	{
+		Triangle x = indexed[i];
+		const Triangle& y = triangles[i];
+		identical = x.V0 == y.V0 && x.V1 == y.V1 && x.V2 == y.V2 &&
+		            x.N0 == y.N0 && x.N1 == y.N1 && x.N2 == y.N2 &&
+		            x.MaterialIndex == y.MaterialIndex;
+	}
+	AssertTrue(identical, "Indexed triangles equal the input triangles");
+	AssertTrue(indexed.VertexCount() < triangles.size() * 3, "Tessellation vertices are shared");
+	
+	EndTest();
+}
+
 // ----------------------------------------------------------------------------
 // TEST SUITE 10: GetSceneData Access Tests
 // ----------------------------------------------------------------------------
@@ -992,6 +1226,218 @@ void TestGetSceneDataAccess()
 	EndTest();
 }
 
+// ----------------------------------------------------------------------------
+// TEST SUITE 11: Ray Query Tests
+// ----------------------------------------------------------------------------
+
+void TestOcclusionQuery()
+{
+	BeginTest("Occluded finds blocking triangles within the segment");
+	
+	// box.obj is normalized to the cube [-3, 3]³
+	SceneManager manager;
+	manager.LoadOBJ(GetTestAssetPath("box.obj"));
+	
+	glm::vec3 outside(0.0f, 0.0f, 10.0f);
+	glm::vec3 towardBox(0.0f, 0.0f, -1.0f);
+	
+	AssertFalse(manager.Occluded(outside, towardBox, 5.0f), "Segment ending before the box face is not blocked");
+	AssertTrue(manager.Occluded(outside, towardBox, 8.0f), "Segment crossing the box face is blocked");
+	AssertFalse(manager.Occluded(outside, -towardBox, 100.0f), "Ray pointing away from the box is not blocked");
+	AssertTrue(manager.Occluded(glm::vec3(0.0f), glm::vec3(1.0f, 0.2f, 0.1f), 100.0f), "Ray from inside the box hits a wall");
+	
+	SceneManager empty;
+	AssertFalse(empty.Occluded(outside, towardBox, 100.0f), "Empty scene never occludes");
+	
+	EndTest();
+}
+
+void TestClosestHitQuery()
+{
+	BeginTest("Intersect returns the nearest triangle and its normal");
+	
+	SceneManager manager;
+	manager.LoadOBJ(GetTestAssetPath("box.obj"));
+	
+	// Enters through the +Z face of [-3, 3]³ at t = 7, not the -Z face behind it
+	TriangleHit hit = manager.Intersect(glm::vec3(0.2f, 0.1f, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+	AssertTrue(hit.Hit, "Ray toward the box hits");
+	AssertFloatEqual(7.0f, hit.Distance, "Nearest face is hit first");
+	AssertVec3Equal(glm::vec3(0.2f, 0.1f, 3.0f), hit.Position, "Hit point lies on the +Z face");
+	AssertFloatEqual(1.0f, std::abs(hit.Normal.z), "Normal is perpendicular to the face");
+	AssertFloatEqual(1.0f, glm::length(hit.Normal), "Normal is unit length");
+	
+	AssertFalse(manager.Intersect(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f), 0.001f, 5.0f).Hit,
+	            "Hits beyond tMax are ignored");
+	AssertFalse(manager.Intersect(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f, 0.0f, 1.0f)).Hit,
+	            "Ray pointing away from the box misses");
+	
+	EndTest();
+}
+
+// ----------------------------------------------------------------------------
+// TEST SUITE 12: Quadric Tessellation Tests
+// ----------------------------------------------------------------------------
+
+void TestTessellatedSphere()
+{
+	BeginTest("Tessellated sphere lies on the surface with outward normals");
+	
+	auto sphere = Quadric::QuadricSurface::CreateSphere(2.0f);
+	auto triangles = QuadricTessellator::Tessellate(sphere, sphere.GetBounds(), 0.25f, 3);
+	
+	AssertGreaterThan(static_cast<int>(triangles.size()), 100, "Sphere produces triangles");
+	
+	float maxRadiusError = 0.0f;
+	float minNormalAgreement = 1.0f;
+	float minWindingAgreement = 1.0f;
+	bool materialsSet = true;
+	for (const Triangle& tri : triangles)
+	{
+		for (const glm::vec3& v : { tri.V0, tri.V1, tri.V2 })
+			maxRadiusError = std::max(maxRadiusError, std::abs(glm::length(v) - 2.0f));
+		
+		minNormalAgreement = std::min(minNormalAgreement, glm::dot(tri.N0, glm::normalize(tri.V0)));
+		
+		glm::vec3 face = glm::normalize(glm::cross(tri.V1 - tri.V0, tri.V2 - tri.V0));
+		minWindingAgreement = std::min(minWindingAgreement, glm::dot(face, tri.N0));
+		materialsSet = materialsSet && tri.MaterialIndex == 3;
+	}
+	
+	AssertTrue(maxRadiusError < 1e-4f, "Vertices are exact surface points");
+	AssertTrue(minNormalAgreement > 0.9999f, "Vertex normals are the radial direction");
+	AssertTrue(minWindingAgreement > 0.0f, "Triangles wind counter-clockwise seen from outside");
+	AssertTrue(materialsSet, "Every triangle gets the requested material");
+	
+	EndTest();
+}
+
+void TestTessellatedClippedCylinder()
+{
+	BeginTest("Tessellated cylinder stays inside its clip box");
+	
+	// x² + y² = 1 clipped to |z| <= 1
+	auto cylinder = Quadric::QuadricSurface::CreateCylinder(1.0f, 2.0f);
+	auto triangles = QuadricTessellator::Tessellate(cylinder, cylinder.GetBounds(), 0.2f);
+	
+	AssertGreaterThan(static_cast<int>(triangles.size()), 0, "Cylinder produces triangles");
+	
+	bool onSurface = true;
+	bool insideBox = true;
+	for (const Triangle& tri : triangles)
+	{
+		for (const glm::vec3& v : { tri.V0, tri.V1, tri.V2 })
+		{
+			onSurface = onSurface && std::abs(v.x * v.x + v.y * v.y - 1.0f) < 1e-4f;
+			insideBox = insideBox && std::abs(v.z) <= 1.0f + 1e-5f;
+		}
+	}
+	
+	AssertTrue(onSurface, "Vertices lie on the cylinder");
+	AssertTrue(insideBox, "No vertex leaves the clip range");
+	
+	EndTest();
+}
+
+void TestTessellationScreenError()
+{
+	BeginTest("LOD meshes meet the screen-space error bound");
+	
+	const float radius = 2.0f;
+	auto sphere = Quadric::QuadricSurface::CreateSphere(radius);
+	
+	ScreenErrorMetric metric;
+	metric.VerticalFOV = glm::radians(60.0f);
+	metric.ViewportHeight = 720;
+	metric.PixelError = 1.0f;
+	
+	std::vector<float> distances = { 4.0f, 16.0f, 64.0f };
+	auto lods = QuadricTessellator::BuildLODs(sphere, sphere.GetBounds(), distances, metric);
+	
+	AssertEqual(distances.size(), lods.size(), "One LOD per distance");
+	
+	for (size_t i = 0; i < lods.size(); i++)
+	{
+		float pixelSize = 2.0f * distances[i] * std::tan(metric.VerticalFOV * 0.5f) / metric.ViewportHeight;
+		
+		// Deepest point of a flat triangle below the sphere is near its centroid
+		float maxDeviation = 0.0f;
+		for (const Triangle& tri : lods[i].Triangles)
+		{
+			glm::vec3 centroid = (tri.V0 + tri.V1 + tri.V2) / 3.0f;
+			maxDeviation = std::max(maxDeviation, radius - glm::length(centroid));
+		}
+		
+		AssertTrue(maxDeviation <= metric.PixelError * pixelSize,
+		           "LOD " + std::to_string(i) + " deviates less than one pixel");
+	}
+	
+	AssertTrue(lods[0].Triangles.size() > lods[1].Triangles.size() &&
+	           lods[1].Triangles.size() > lods[2].Triangles.size(),
+	           "Farther LODs use fewer triangles");
+	AssertTrue(lods[0].CellSize < lods[2].CellSize, "Farther LODs use larger cells");
+	
+	// BuildLODs samples the curvature once; the cells match the one-shot query
+	bool sameCells = true;
+	for (size_t i = 0; i < lods.size(); i++)
+		sameCells = sameCells && lods[i].CellSize ==
+		            QuadricTessellator::CellSizeForScreenError(sphere, sphere.GetBounds(), distances[i], metric);
+	AssertTrue(sameCells, "LOD cells equal CellSizeForScreenError");
+	
+	auto plane = Quadric::QuadricSurface::CreatePlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f);
+	AssertTrue(std::isinf(QuadricTessellator::CurvatureRadius(plane, sphere.GetBounds())), "Planes have no curvature");
+	
+	EndTest();
+}
+
+void TestLODSelection()
+{
+	BeginTest("SelectLOD picks the coarsest accurate level");
+	
+	std::vector<TessellationLOD> lods(3);
+	lods[0].Distance = 4.0f;
+	lods[1].Distance = 16.0f;
+	lods[2].Distance = 64.0f;
+	
+	AssertEqual(size_t(0), QuadricTessellator::SelectLOD(lods, 1.0f), "Closer than every LOD uses the finest");
+	AssertEqual(size_t(0), QuadricTessellator::SelectLOD(lods, 10.0f), "Between 4 and 16 uses LOD 0");
+	AssertEqual(size_t(1), QuadricTessellator::SelectLOD(lods, 16.0f), "At 16 uses LOD 1");
+	AssertEqual(size_t(2), QuadricTessellator::SelectLOD(lods, 500.0f), "Far away uses the coarsest");
+	AssertEqual(size_t(0), QuadricTessellator::SelectLOD({}, 10.0f), "No LODs selects index 0");
+	
+	EndTest();
+}
+
+void TestSetTriangles()
+{
+	BeginTest("SetTriangles replaces geometry and keeps materials");
+	
+	SceneManager manager;
+	manager.LoadMTL(GetTestAssetPath("quadric_materials.mtl"));
+	size_t materialCount = manager.GetMaterialCount();
+	
+	auto sphere = Quadric::QuadricSurface::CreateSphere(1.0f);
+	auto triangles = QuadricTessellator::Tessellate(sphere, sphere.GetBounds(), 0.5f, 1);
+	manager.SetTriangles(triangles);
+	
+	AssertEqual(triangles.size(), manager.GetTriangleCount(), "Triangle count matches the tessellation");
+	AssertEqual(materialCount, manager.GetMaterialCount(), "Loaded materials are kept");
+	
+	SceneManager empty;
+	empty.SetTriangles(triangles);
+	AssertEqual(size_t(1), empty.GetMaterialCount(), "Default material is created when none is loaded");
+	
+	// Indices past the material list would be read unchecked by the renderers
+	std::vector<Triangle> stray(triangles.begin(), triangles.begin() + 2);
+	stray[0].MaterialIndex = static_cast<int>(materialCount);
+	stray[1].MaterialIndex = static_cast<int>(materialCount) - 1;
+	manager.SetTriangles(stray);
+	AssertEqual(0, manager.GetSceneData().Triangles[0].MaterialIndex, "Index past the materials falls back to the default");
+	AssertEqual(static_cast<int>(materialCount) - 1, manager.GetSceneData().Triangles[1].MaterialIndex, "Last material is kept");
+	
+	EndTest();
+}
+
 // ============================================================================
 // MAIN - Run All Tests
 // ============================================================================
@@ -1027,6 +1473,10 @@ int main()
 	TestPolygonTriangulation();
 	TestNegativeIndices();
 	TestFaceFormats();
+	TestTokenizer();
+	TestChunkedParsing();
+	TestStreamedParsing();
+	TestSceneCache();
 	
 	// Suite 4: Material Parsing Tests
 	PrintSectionHeader("SUITE 4: Material Parsing Tests");
@@ -1062,11 +1512,25 @@ int main()
 	PrintSectionHeader("SUITE 9: Data Integrity Tests");
 	TestTriangleDataIntegrity();
 	TestMaterialDataIntegrity();
+	TestIndexedMesh();
 	
 	// Suite 10: GetSceneData Access Tests
 	PrintSectionHeader("SUITE 10: API Access Tests");
 	TestGetSceneDataAccess();
 	
+	// Suite 11: Ray Query Tests
+	PrintSectionHeader("SUITE 11: Ray Query Tests");
+	TestOcclusionQuery();
+	TestClosestHitQuery();
+	
+	// Suite 12: Quadric Tessellation Tests
+	PrintSectionHeader("SUITE 12: Quadric Tessellation Tests");
+	TestTessellatedSphere();
+	TestTessellatedClippedCylinder();
+	TestTessellationScreenError();
+	TestLODSelection();
+	TestSetTriangles();
+	
 	// Print summary
 	PrintSummary();
 	